@@ -0,0 +1,180 @@
+/**
+ * @file lsda_decode.bench.cpp
+ * @author SAFE Group
+ * @brief Throughput of LEB128 decoding and of whole exception table parsing
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Build with -DSAFE_BENCHMARKS=ON and run `lsda_decode_bench [lsdas]`.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <print>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "abi_parse.hpp"
+#include "leb128.hpp"
+
+namespace {
+
+void put_uleb(std::vector<uint8_t>& p_out, uint64_t p_value)
+{
+    do {
+        uint8_t byte = p_value & 0x7f;
+        p_value >>= 7;
+        p_out.push_back(p_value != 0 ? byte | 0x80 : byte);
+    } while (p_value != 0);
+}
+
+void put_u32(std::vector<uint8_t>& p_out, uint32_t p_value)
+{
+    for (int i = 0; i < 4; ++i) {
+        p_out.push_back(static_cast<uint8_t>(p_value >> (8 * i)));
+    }
+}
+
+// One LSDA per function, as GCC lays them out: call sites with a catch
+// (action 1) or a cleanup, one action record and a one-entry type table
+std::vector<std::byte> make_table(size_t p_lsdas,
+                                  uint8_t p_call_enc,
+                                  std::mt19937_64& p_random)
+{
+    std::vector<uint8_t> table;
+    std::uniform_int_distribution<uint32_t> offset(0, 1 << 20);
+    std::uniform_int_distribution<size_t> call_sites(4, 64);
+    for (size_t lsda = 0; lsda < p_lsdas; ++lsda) {
+        std::vector<uint8_t> sites;
+        const size_t count = call_sites(p_random);
+        for (size_t i = 0; i < count; ++i) {
+            for (int field = 0; field < 3; ++field) {
+                const uint32_t value = offset(p_random);
+                if (p_call_enc == 0x01) {
+                    put_uleb(sites, value);
+                } else {
+                    put_u32(sites, value);
+                }
+            }
+            sites.push_back(i % 2 == 0 ? 1 : 0);  // action
+        }
+
+        std::vector<uint8_t> after_tt_off;
+        after_tt_off.push_back(p_call_enc);
+        put_uleb(after_tt_off, sites.size());
+        after_tt_off.insert(after_tt_off.end(), sites.begin(), sites.end());
+        after_tt_off.insert(after_tt_off.end(), { 0x01, 0x00 });  // actions
+        put_u32(after_tt_off, 0x1000);  // type table entry
+
+        table.insert(table.end(), { 0xff, 0x9b });
+        put_uleb(table, after_tt_off.size());
+        table.insert(table.end(), after_tt_off.begin(), after_tt_off.end());
+    }
+
+    std::vector<std::byte> bytes(table.size());
+    std::ranges::transform(
+      table, bytes.begin(), [](uint8_t b) { return std::byte{ b }; });
+    return bytes;
+}
+
+// the decoder LsdaParser used before: one byte and one check per step
+uint64_t byte_loop_uleb(std::span<const uint8_t> p_buf, size_t& p_index)
+{
+    uint64_t result = 0;
+    int shift = 0;
+    while (p_index < p_buf.size()) {
+        const uint8_t byte = p_buf[p_index++];
+        result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+        shift += 7;
+    }
+    return result;
+}
+
+template<class Body>
+double best_seconds(Body&& p_body, int p_runs = 5)
+{
+    double best = 1e30;
+    for (int run = 0; run < p_runs; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        p_body();
+        const std::chrono::duration<double> elapsed
+          = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+    const size_t lsdas = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    std::mt19937_64 random(42);
+
+    // LEB128: 4M numbers of 1 to 4 bytes, as in GCC call-site tables
+    std::vector<uint8_t> numbers;
+    std::uniform_int_distribution<int> bits(1, 28);
+    for (int i = 0; i < 4'000'000; ++i) {
+        put_uleb(numbers, random() & ((uint64_t{ 1 } << bits(random)) - 1));
+    }
+    numbers.resize(numbers.size() + 8);  // keep the word loads in bounds
+    const size_t encoded_size = numbers.size() - 8;
+
+    uint64_t checksum = 0;
+    const double loop_time = best_seconds([&] {
+        size_t i = 0;
+        while (i < encoded_size) {
+            checksum += byte_loop_uleb(numbers, i);
+        }
+    });
+    const double word_time = best_seconds([&] {
+        size_t i = 0;
+        while (i < encoded_size) {
+            const auto decoded = leb128::decode_unsigned(numbers.data() + i);
+            checksum += decoded.value;
+            i += decoded.length;
+        }
+    });
+    const double megabytes = static_cast<double>(encoded_size) / 1e6;
+    std::println("ULEB128, {:.1f} MB:", megabytes);
+    std::println("  byte loop      {:8.1f} MB/s", megabytes / loop_time);
+    std::println("  word at a time {:8.1f} MB/s ({:.2f}x)",
+                 megabytes / word_time,
+                 loop_time / word_time);
+
+    // whole tables: uleb128 and udata4 take the specialized call-site
+    // decoders, sdata4 the run-time DW_EH_PE switch in r_encode. The udata4
+    // and sdata4 tables come from the same seed, so they hold the same
+    // call-site bytes and differ only in the encoding byte of each LSDA.
+    std::println("Exception table of {} LSDAs, scan + parallel parse:", lsdas);
+    const std::mt19937_64 table_seed = random;
+    for (auto [encoding, name] :
+         { std::pair{ uint8_t{ 0x01 }, "uleb128" },
+           std::pair{ uint8_t{ 0x03 }, "udata4" },
+           std::pair{ uint8_t{ 0x0b }, "udata4 as sdata4" } }) {
+        std::mt19937_64 table_random = table_seed;
+        const auto table = make_table(lsdas, encoding, table_random);
+        size_t parsed = 0;
+        const double seconds = best_seconds([&] {
+            LsdaTable all(table, 0);
+            parsed = all.size() - all.get_failures();
+        });
+        std::println("  {:16} {:6.1f} MB in {:7.2f} ms, {:8.1f} MB/s, "
+                     "{} parsed",
+                     name,
+                     static_cast<double>(table.size()) / 1e6,
+                     seconds * 1e3,
+                     static_cast<double>(table.size()) / 1e6 / seconds,
+                     parsed);
+    }
+    return checksum == 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+/**
+ * @file lsda_decode.fuzz.cpp
+ * @author SAFE Group
+ * @brief libFuzzer target for the non-throwing LSDA decoder
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Build with clang and -DSAFE_FUZZ=ON, then run
+ * `lsda_decode_fuzz -max_len=4096 -timeout=1 corpus/`. Seed the corpus
+ * with .gcc_except_table sections, e.g.
+ * `objcopy -O binary --only-section=.gcc_except_table a.out seed`.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "abi_parse.hpp"
+
+namespace {
+
+// touches everything a caller reads, so the sanitizers see every access
+void consume(const LsdaParser& p_lsda)
+{
+    for (const auto& scope : p_lsda.get_scopes()) {
+        for (const auto& handler : p_lsda.handlers(scope)) {
+            std::ignore = p_lsda.resolve_type(handler.type_index);
+        }
+        std::ignore = p_lsda.lookup(scope.start);
+    }
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* p_data, size_t p_size)
+{
+    // the input is an exception table mapped at an arbitrary address
+    const std::span<const std::byte> table(
+      reinterpret_cast<const std::byte*>(p_data), p_size);
+
+    if (auto lsda = LsdaParser::decode(table, 0, 0x1000); lsda.has_value()) {
+        consume(*lsda);
+    }
+
+    LsdaTable lsdas(table, 0x1000);
+    for (size_t offset : lsdas.get_offsets()) {
+        if (const LsdaParser* lsda = lsdas.find(offset); lsda != nullptr) {
+            consume(*lsda);
+        }
+    }
+    return 0;
+}
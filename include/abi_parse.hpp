@@ -10,9 +10,15 @@
  */
 
 #pragma once
+#include <bit>
 #include <cstdint>
+#include <cstddef>
+#include <expected>
+#include <functional>
 #include <optional>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // single entry in LSDA call site
@@ -22,6 +28,7 @@ struct CallSite
     uint64_t length;       // length of protected range
     uint64_t landing_pad;  // landing pad address
     int64_t action;        // offset into to action table
+    uint32_t size;         // bytes of the record in the call-site table
 };
 
 // action within call site table
@@ -44,21 +51,97 @@ struct ScopeHandler
 {
     HandlerType type;
     int64_t type_index;    // unampped LSDA integer
-    uint64_t landing_pad;  // landing pad address from callsite
+};
+
+// a run of handlers in the flat handler pool of an LsdaParser
+struct HandlerRange
+{
+    uint32_t first;  // index of the first handler
+    uint32_t count;  // handlers in the chain
 };
 
 struct Scope
 {
     uint64_t start;
     uint64_t end;
-    std::vector<ScopeHandler> handlers;
+    uint64_t landing_pad;  // landing pad address from callsite
+    uint32_t chain;        // index of its handlers in get_handler_chains()
+};
+
+// the call site covering a PC
+struct CallSiteMatch
+{
+    uint64_t landing_pad;  // 0 if the call site only lets exceptions pass
+    std::span<const ScopeHandler> handlers;  // empty without landing pad
+};
+
+// why an LSDA could not be decoded, or what was skipped while decoding it
+enum class LsdaError
+{
+    Truncated,            // a read went past the end of the LSDA
+    BadLeb128,            // a LEB128 number wider than 64 bits
+    UnsupportedEncoding,  // a DW_EH_PE form the decoder does not know
+    BadOffset,            // an LSDA offset outside the exception table
+    BadCallSiteTable,     // call sites do not end where their table does
+    BadActionTable,       // action records overlap the type table
+    BadTypeTable,         // type table or filter outside the LSDA
+    DanglingAction,       // an action or next offset reaches no record
+    ActionCycle,          // an action chain leads back into itself
+    UnresolvedType        // an indirect type entry's slot has no value
+};
+
+const char* to_string(LsdaError error);
+
+struct LsdaDiagnostic
+{
+    size_t offset;     // byte offset in the exception table
+    LsdaError reason;
+};
+
+// reads the pointer stored at an address of the loaded image, e.g.
+// safe::LoadedImage::read_pointer; nullopt if it cannot be known
+using PointerReader = std::function<std::optional<uint64_t>(uint64_t)>;
+
+// where a single LSDA lives and how its pointers are read
+struct LsdaContext
+{
+    uint64_t table_address = 0;  // address of the first byte of the table
+    PointerReader read_pointer;  // dereferences DW_EH_PE_indirect entries
+    uint8_t pointer_size = 8;    // DW_EH_PE_absptr width: 4 on ELFCLASS32
+    std::endian order = std::endian::little;  // of the fixed-width values
 };
 
 class LsdaParser
 {
   public:
-    explicit LsdaParser(const std::vector<std::byte>& lsda_data);
-    explicit LsdaParser(const std::vector<uint8_t>& lsda_data);
+    // the parser decodes in place: the bytes are borrowed, not copied, and
+    // must outlive it
+    explicit LsdaParser(std::span<const std::byte> lsda_data);
+    explicit LsdaParser(std::span<const uint8_t> lsda_data);
+    // parses only the LSDA at lsda_offset in an exception table located at
+    // table_address, e.g. the one an FDE points to. pcrel type table
+    // entries become absolute addresses. Indirect (DW_EH_PE_indirect)
+    // entries are dereferenced through read_pointer, once, so that
+    // resolve_type() returns the typeinfo address; without it they stay
+    // the address of their GOT or .data.rel.ro slot.
+    LsdaParser(std::span<const std::byte> table,
+               size_t lsda_offset,
+               uint64_t table_address,
+               const PointerReader& read_pointer = {});
+
+    // the constructors throw std::runtime_error on malformed input; decode
+    // reports it instead, for sweeps over many untrusted tables
+    static std::expected<LsdaParser, LsdaDiagnostic> decode(
+      std::span<const std::byte> table,
+      size_t lsda_offset,
+      uint64_t table_address,
+      const PointerReader& read_pointer = {});
+    // as above, for LSDAs outside .gcc_except_table or of 32-bit targets,
+    // e.g. the ones embedded in .ARM.extab
+    static std::expected<LsdaParser, LsdaDiagnostic> decode(
+      std::span<const std::byte> table,
+      size_t lsda_offset,
+      const LsdaContext& context);
 
     std::optional<uint64_t> resolve_type(int64_t type_index) const;
     void print_call_sites(const std::string& filename) const;
@@ -67,11 +150,30 @@ class LsdaParser
     std::vector<CallSite> call_sites;  // parsed call site records
     std::vector<Action> actions;       // parsed action records
     std::vector<uint64_t> type_table;  // parsed type table entries
-    const std::vector<Scope> get_scopes() const noexcept
+    const std::vector<Scope>& get_scopes() const noexcept
     {
         return scopes;
     }
 
+    // handler chains shared by every call site with the same action, as
+    // ranges of one contiguous handler array
+    const std::vector<HandlerRange>& get_handler_chains() const noexcept
+    {
+        return handler_chains;
+    }
+
+    std::span<const ScopeHandler> handlers(const Scope& scope) const
+    {
+        const HandlerRange& chain = handler_chains[scope.chain];
+        return std::span(handler_pool).subspan(chain.first, chain.count);
+    }
+
+    // the call site covering pc, an offset from the function start (the
+    // return address minus one for a call). nullopt if no call site covers
+    // it, in which case unwinding calls std::terminate. Binary search,
+    // does not allocate.
+    std::optional<CallSiteMatch> lookup(uint64_t pc) const;
+
     const std::vector<CallSite>& get_call_sites() const noexcept
     {
         return call_sites;
@@ -82,15 +184,45 @@ class LsdaParser
         return actions;
     }
 
+    // the decoded bytes, inside the borrowed input
+    std::span<const uint8_t> get_bytes() const noexcept
+    {
+        return data;
+    }
+
+    // records the decoder skipped, e.g. dangling or cyclic action chains
+    const std::vector<LsdaDiagnostic>& get_diagnostics() const noexcept
+    {
+        return diagnostics;
+    }
+
   private:
+    friend class LsdaTable;
+
+    LsdaParser() = default;
+
     void parse();
     void build_scopes();
 
-    void check(size_t n)
-      const;  // checks that n bytes remains in LSDA buffer before read
+    // checks that n bytes remain in the LSDA buffer before a read
+    bool check(size_t n);
+    // records the first error and moves to the end, so every loop stops
+    void fail(LsdaError reason);
+    void warn(LsdaError reason, size_t offset);
+    bool failed() const noexcept
+    {
+        return error.has_value();
+    }
 
-    std::vector<uint8_t> data;  // LSDA data taken in
+    std::span<const uint8_t> data;  // borrowed LSDA bytes
     size_t index{ 0 };          // the parsing offset
+    uint64_t base_address{ 0 };  // address of data[0], single LSDA only
+    bool single_lsda{ false };   // data holds exactly one LSDA
+    size_t origin{ 0 };          // offset of data[0] in the exception table
+    size_t action_table{ 0 };    // offset of the action table in data
+
+    std::optional<LsdaDiagnostic> error;       // why decoding stopped
+    std::vector<LsdaDiagnostic> diagnostics;  // what it skipped
 
     uint8_t read8();    // reads 1 byte
     uint16_t read16();  // reads 2 bytes
@@ -98,12 +230,27 @@ class LsdaParser
     uint64_t read64();  // reads 8 bytes
 
     std::vector<Scope> scopes;
+    std::vector<ScopeHandler> handler_pool;    // every chain, back to back
+    std::vector<HandlerRange> handler_chains;  // one range per chain
+    bool sorted_call_sites{ true };            // as the ABI requires
+    std::unordered_map<int64_t, size_t> action_by_offset;  // entry_offset
+
+    void index_actions();
+
+    uint64_t uleb();  // reads a ULEB128 at index
+    int64_t sleb();   // reads a SLEB128 at index
 
-    // decoders
-    static uint64_t read_uleb128(const std::vector<uint8_t>& data,
-                                 size_t& index);
-    static int64_t read_sleb128(const std::vector<uint8_t>& data,
-                                size_t& index);
+    // decoders; nullopt if the number is truncated or wider than 64 bits
+    static std::optional<uint64_t> read_uleb128(std::span<const uint8_t> data,
+                                                size_t& index);
+    static std::optional<int64_t> read_sleb128(std::span<const uint8_t> data,
+                                               size_t& index);
+
+    // bytes from the start of an LSDA to the end of its last table. The
+    // diagnostic offset counts from the start of the LSDA.
+    static std::expected<size_t, LsdaDiagnostic> lsda_size(
+      std::span<const uint8_t> lsda,
+      uint8_t pointer_size = 8);
 
     // encoded value reader
     uint64_t r_encode(uint8_t encoding,
@@ -111,5 +258,72 @@ class LsdaParser
 
     void parse_header(uint8_t& start_enc, uint8_t& tt_enc, uint64_t& tt_off);
     void parse_call_sites(uint8_t call_enc, uint64_t table_len);
+    // Order is the byte order of udata4 fields; the other encodings ignore it
+    template<uint8_t Encoding, std::endian Order = std::endian::little>
+    void parse_call_sites_as(uint8_t call_enc, size_t end);
+    template<uint8_t Encoding, std::endian Order = std::endian::little>
+    uint64_t read_call_site_field(uint8_t call_enc);
     void parse_actions_tail(size_t table_start, size_t limit_end);
-};
\ No newline at end of file
+    void parse_action_chains(size_t table_start);
+    void parse_type_table(uint8_t tt_enc, size_t tt_base);
+
+    // positions in type_table of indirect entries that did not resolve
+    std::vector<uint32_t> unresolved_types;
+    const PointerReader* pointer_reader{ nullptr };  // during parse() only
+    uint8_t pointer_size{ 8 };                        // DW_EH_PE_absptr
+    std::endian order{ std::endian::little };  // of udata2/4/8 and absptr
+};
+
+// every LSDA of a .gcc_except_table, parsed in parallel and looked up by
+// offset in the table
+class LsdaTable
+{
+  public:
+    // parses the LSDAs at the given offsets, e.g. those .eh_frame points to
+    LsdaTable(std::span<const std::byte> table,
+              uint64_t table_address,
+              std::vector<size_t> lsda_offsets,
+              const PointerReader& read_pointer = {});
+    // parses every LSDA found by walking the table
+    LsdaTable(std::span<const std::byte> table,
+              uint64_t table_address,
+              const PointerReader& read_pointer = {});
+
+    // offsets of the LSDAs in table, found by walking it from the start.
+    // Stops at the first bytes that do not decode as an LSDA.
+    static std::vector<size_t> scan_offsets(std::span<const std::byte> table);
+
+    // the LSDA at offset, or nullptr if there is none or it failed to parse
+    const LsdaParser* find(size_t offset) const;
+
+    const std::vector<size_t>& get_offsets() const noexcept
+    {
+        return offsets;
+    }
+
+    size_t size() const noexcept
+    {
+        return offsets.size();
+    }
+
+    size_t get_failures() const noexcept
+    {
+        return failures;
+    }
+
+    // why each failed LSDA was rejected, in table order
+    const std::vector<LsdaDiagnostic>& get_diagnostics() const noexcept
+    {
+        return diagnostics;
+    }
+
+  private:
+    void parse_all(std::span<const std::byte> table,
+                   uint64_t table_address,
+                   const PointerReader& read_pointer);
+
+    std::vector<size_t> offsets;                  // sorted, unique
+    std::vector<std::optional<LsdaParser>> lsdas;  // parallel to offsets
+    size_t failures{ 0 };                          // LSDAs that failed
+    std::vector<LsdaDiagnostic> diagnostics;       // one per failure
+};
@@ -0,0 +1,82 @@
+/**
+ * @file archive.hpp
+ * @author SAFE Group
+ * @brief Static (ar) archive reader header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @enum archive_error
+ * @brief Error codes for archive parsing.
+ */
+enum class archive_error : uint8_t
+{
+    NOT_AN_ARCHIVE,  //!< Missing "!<arch>\n" magic
+    THIN_ARCHIVE,    //!< Thin archives only reference external files
+    BAD_HEADER,      //!< Member header is malformed or truncated
+    BAD_NAME,        //!< Long name offset points outside the name table
+    TRUNCATED        //!< Member data extends past the end of the file
+};
+
+/**
+ * @struct archive_member_s
+ * @brief One file stored in an archive.
+ */
+struct archive_member_s
+{
+    std::string name;                 //!< Member file name
+    std::span<const std::byte> data;  //!< Member bytes inside the archive
+};
+
+/**
+ * @class Archive
+ * @brief Index of the members of a static library (ar archive).
+ *
+ * Understands the System V / GNU format used by GNU ar and llvm-ar: the
+ * "/" and "/SYM64/" symbol tables are skipped, long names are resolved
+ * through the "//" table, and BSD "#1/<len>" names are read from the start
+ * of the member data. Member data is not copied; the spans point into the
+ * archive image, which must outlive the Archive.
+ */
+class Archive
+{
+  public:
+    /**
+     * @brief Checks for the "!<arch>\n" magic.
+     */
+    [[nodiscard]] static bool is_archive(std::span<const std::byte> p_image);
+
+    /**
+     * @brief Indexes the members of p_image.
+     *
+     * @param p_image Bytes of the whole archive.
+     * @return std::expected<Archive, archive_error> The index, or the first
+     * structural problem found.
+     */
+    [[nodiscard]] static std::expected<Archive, archive_error> parse(
+      std::span<const std::byte> p_image);
+
+    /**
+     * @brief Regular members, in archive order.
+     */
+    [[nodiscard]] std::span<const archive_member_s> members() const noexcept
+    {
+        return m_members;
+    }
+
+  private:
+    std::vector<archive_member_s> m_members;
+};
@@ -0,0 +1,161 @@
+/**
+ * @file arm_exidx.hpp
+ * @author SAFE Group
+ * @brief ARM EHABI .ARM.exidx / .ARM.extab parser header file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "elf_parser.hpp"
+#include "elf_reader.hpp"
+
+/**
+ * @enum arm_exidx_error
+ * @brief Error codes for .ARM.exidx / .ARM.extab parsing.
+ */
+enum class arm_exidx_error : uint8_t
+{
+    TRUNCATED,               //!< An entry extends past its section
+    BAD_PREL31,              //!< A function word has bit 31 set
+    BAD_EXTAB_POINTER,       //!< An entry points outside .ARM.extab
+    UNSUPPORTED_PERSONALITY  //!< Compact model index other than 0, 1 or 2
+};
+
+/**
+ * @enum exidx_model
+ * @brief How an index entry describes the unwinding of its function.
+ */
+enum class exidx_model : uint8_t
+{
+    CANT_UNWIND,  //!< EXIDX_CANTUNWIND: the function cannot be unwound
+    INLINE,       //!< __aeabi_unwind_cpp_pr0 data packed in the index entry
+    COMPACT,      //!< .ARM.extab entry for __aeabi_unwind_cpp_pr0/1/2
+    GENERIC       //!< .ARM.extab entry naming its personality routine
+};
+
+/**
+ * @struct exidx_entry_s
+ * @brief One decoded .ARM.exidx entry, and its .ARM.extab entry if any.
+ */
+struct exidx_entry_s
+{
+    uint64_t offset = 0;    //!< Offset of the entry in .ARM.exidx
+    uint64_t pc_begin = 0;  //!< First address covered
+    uint64_t pc_end = 0;    //!< Start of the next entry's function
+    exidx_model model = exidx_model::CANT_UNWIND;
+    //! INLINE and COMPACT: index of the __aeabi_unwind_cpp_prN routine
+    uint8_t personality_index = 0;
+    std::optional<uint64_t> personality;  //!< GENERIC: routine address
+    std::optional<uint64_t> extab;        //!< Address of the .ARM.extab entry
+    //! Unwind instructions in execution order, including any trailing
+    //! 0xb0 (finish) padding
+    std::vector<uint8_t> opcodes;
+    //! Address of the data after the unwind instructions: for GENERIC
+    //! entries the LSDA of the personality routine (a GCC LSDA for
+    //! __gxx_personality_v0), for COMPACT ones the pr1/pr2 descriptors
+    std::optional<uint64_t> lsda;
+};
+
+/**
+ * @class ArmExidx
+ * @brief Index from code addresses to the ARM EHABI unwind entry, and so
+ * the LSDA, covering them.
+ *
+ * .ARM.exidx is a table of (function, unwind data) word pairs sorted by
+ * function address; each function extends to the start of the next one.
+ * find() binary searches that table in place and decodes only the entry it
+ * lands on, so lookups are O(log n) without building an index. Words are
+ * read in the byte order of the file. The spans point into the section
+ * data, which must outlive the ArmExidx.
+ *
+ * LSDAs embedded in .ARM.extab use 4-byte DW_EH_PE_absptr values in the
+ * byte order of the file; decode them with LsdaParser::decode and an
+ * LsdaContext whose pointer_size is 4 and order is that of the file.
+ */
+class ArmExidx
+{
+  public:
+    /**
+     * @brief Indexes p_exidx.
+     *
+     * @param p_exidx The .ARM.exidx section.
+     * @param p_extab The .ARM.extab section, if the file has one. Files
+     * whose entries are all inline or EXIDX_CANTUNWIND need none.
+     * @param p_encoding Class and byte order of the file.
+     * @return std::expected<ArmExidx, arm_exidx_error> The index, or the
+     * first structural problem of .ARM.exidx. Bad .ARM.extab entries are
+     * reported by entry_at() when they are decoded.
+     */
+    [[nodiscard]] static std::expected<ArmExidx, arm_exidx_error> parse(
+      section_view_s p_exidx,
+      std::optional<section_view_s> p_extab,
+      elf_reader::encoding_s p_encoding);
+
+    /**
+     * @brief Finds the entry covering p_pc.
+     *
+     * @return std::optional<exidx_entry_s> The entry, which may be
+     * EXIDX_CANTUNWIND, or nullopt if p_pc precedes every function or its
+     * entry cannot be decoded.
+     */
+    [[nodiscard]] std::optional<exidx_entry_s> find(uint64_t p_pc) const;
+
+    /**
+     * @brief Decodes the p_index-th entry of .ARM.exidx.
+     */
+    [[nodiscard]] std::expected<exidx_entry_s, arm_exidx_error> entry_at(
+      size_t p_index) const;
+
+    /**
+     * @brief Decodes every entry, in address order.
+     */
+    [[nodiscard]] std::expected<std::vector<exidx_entry_s>, arm_exidx_error>
+    entries() const;
+
+    /**
+     * @brief Number of entries in .ARM.exidx.
+     */
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return m_count;
+    }
+
+    /**
+     * @brief The .ARM.extab section, for locating LSDAs in its data.
+     */
+    [[nodiscard]] const section_view_s& extab() const noexcept
+    {
+        return m_extab;
+    }
+
+    /**
+     * @brief Class and byte order the tables are read in.
+     */
+    [[nodiscard]] elf_reader::encoding_s encoding() const noexcept
+    {
+        return m_encoding;
+    }
+
+  private:
+    uint32_t m_word(std::span<const std::byte> p_data, size_t p_offset) const;
+    uint64_t m_function(size_t p_index) const;
+    std::expected<void, arm_exidx_error> m_decode_extab(
+      exidx_entry_s& p_entry) const;
+
+    section_view_s m_exidx{};
+    section_view_s m_extab{};
+    elf_reader::encoding_s m_encoding{};
+    size_t m_count = 0;
+};
@@ -0,0 +1,118 @@
+/**
+ * @file dead_cleanup.hpp
+ * @author SAFE Group
+ * @brief Cleanup landing pads that no exception can reach header file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "elf_parser.hpp"
+#include "symbol_table.hpp"
+
+namespace safe {
+
+/**
+ * @struct cleanup_savings_s
+ * @brief Bytes that marking the callees of dead cleanup regions noexcept
+ * would save.
+ */
+struct cleanup_savings_s
+{
+    uint64_t call_sites = 0;    //!< Call-site records of the dead regions
+    uint64_t landing_pads = 0;  //!< Pads only dead regions lead to
+    //! The rest of an LSDA left without any landing pad, which the function
+    //! would no longer need
+    uint64_t except_table = 0;
+
+    /**
+     * @brief Sum of every column.
+     */
+    [[nodiscard]] uint64_t total() const noexcept
+    {
+        return call_sites + landing_pads + except_table;
+    }
+
+    cleanup_savings_s& operator+=(const cleanup_savings_s& p_other) noexcept;
+};
+
+/**
+ * @struct dead_cleanup_s
+ * @brief A cleanup-only call site whose calls cannot throw.
+ */
+struct dead_cleanup_s
+{
+    uint64_t start = 0;        //!< First address of the region
+    uint64_t end = 0;          //!< One past its last address
+    uint64_t landing_pad = 0;  //!< Address of the cleanup
+    std::vector<std::string> callees;  //!< Demangled names of its calls
+};
+
+/**
+ * @struct dead_cleanup_function_s
+ * @brief The dead cleanup regions of one function.
+ */
+struct dead_cleanup_function_s
+{
+    uint64_t address = 0;        //!< Start of the function
+    std::string name;            //!< Demangled name, or the address in hex
+    size_t cleanup_regions = 0;  //!< Cleanup-only call sites examined
+    std::vector<dead_cleanup_s> dead;  //!< In address order
+    cleanup_savings_s savings;
+};
+
+/**
+ * @struct noexcept_candidate_s
+ * @brief A callee that cannot throw but is not known to the compiler as
+ * such.
+ */
+struct noexcept_candidate_s
+{
+    std::string name;    //!< Demangled name
+    size_t regions = 0;  //!< Dead cleanup regions calling it
+};
+
+/**
+ * @struct dead_cleanup_report_s
+ * @brief The dead cleanup regions of an image.
+ */
+struct dead_cleanup_report_s
+{
+    bool supported = false;      //!< See ThrowSummary::supported()
+    size_t cleanup_regions = 0;  //!< Cleanup-only call sites examined
+    size_t dead_regions = 0;     //!< Of which can never run
+    std::vector<dead_cleanup_function_s> functions;  //!< Largest savings first
+    std::vector<noexcept_candidate_s> callees;       //!< Most regions first
+    cleanup_savings_s savings;   //!< Over every function
+    size_t undecodable = 0;      //!< LSDAs that could not be decoded
+};
+
+/**
+ * @brief Finds the LSDA call sites whose only action is a cleanup and whose
+ * calls can all be shown not to throw (ThrowSummary), so their landing pad
+ * never runs.
+ *
+ * A region counts as dead only if it ends at the return address of a call
+ * and no call in it may throw. A landing pad is dead once every call site
+ * leading to it is, catch handlers included. When no live call site with a
+ * landing pad remains, the whole LSDA would go. Landing pad sizes are
+ * estimated by landing_pads().
+ *
+ * @param p_elf Parser over an ET_EXEC or ET_DYN file.
+ * @param p_symbols Symbols naming its functions.
+ * @return dead_cleanup_report_s The dead regions and the bytes they cost.
+ */
+[[nodiscard]] dead_cleanup_report_s find_dead_cleanups(
+  const ElfParser& p_elf,
+  const SymbolTable& p_symbols);
+
+}  // namespace safe
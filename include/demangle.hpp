@@ -0,0 +1,29 @@
+/**
+ * @file demangle.hpp
+ * @author SAFE Group
+ * @brief Itanium C++ ABI symbol name demangling header file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace safe {
+
+/**
+ * @brief Demangles a symbol name with the C++ runtime's demangler.
+ *
+ * @param p_name Mangled name; it need not be null terminated.
+ * @return std::optional<std::string> The demangled name, or std::nullopt if
+ * p_name is not a mangled C++ name.
+ */
+[[nodiscard]] std::optional<std::string> demangle(std::string_view p_name);
+
+}  // namespace safe
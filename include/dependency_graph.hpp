@@ -0,0 +1,167 @@
+/**
+ * @file dependency_graph.hpp
+ * @author SAFE Group
+ * @brief Shared-library dependency resolution header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "elf_parser.hpp"
+#include "parallel.hpp"
+
+namespace safe {
+
+/**
+ * @struct dependency_options_s
+ * @brief Where and how DependencyGraph looks for shared objects.
+ */
+struct dependency_options_s
+{
+    /// Directory that every absolute library path is resolved under
+    std::filesystem::path sysroot = "/";
+    /// Default library directories, searched after DT_RUNPATH / DT_RPATH
+    std::vector<std::filesystem::path> search_dirs = {
+        "/lib",
+        "/lib64",
+        "/lib/x86_64-linux-gnu",
+        "/lib/aarch64-linux-gnu",
+        "/lib/arm-linux-gnueabihf",
+        "/usr/lib",
+        "/usr/lib64",
+        "/usr/lib/x86_64-linux-gnu",
+        "/usr/lib/aarch64-linux-gnu",
+        "/usr/lib/arm-linux-gnueabihf",
+        "/usr/local/lib",
+    };
+    /// Upper bound on worker threads; 0 means the hardware concurrency
+    size_t max_threads = 0;
+};
+
+/**
+ * @struct shared_object_s
+ * @brief One ELF file in the dependency graph.
+ */
+struct shared_object_s
+{
+    std::filesystem::path path;          //!< Path the file was found at
+    std::unique_ptr<ElfParser> elf;      //!< Lazily loading parser
+    std::vector<std::string> needed;     //!< DT_NEEDED names, in order
+    std::vector<size_t> dependencies;    //!< Indices of resolved DT_NEEDED
+    std::vector<std::string> unresolved; //!< DT_NEEDED names not found
+};
+
+/**
+ * @class DependencyGraph
+ * @brief Loads executables and the closure of their DT_NEEDED libraries.
+ *
+ * Libraries are resolved against a sysroot the way the dynamic loader would:
+ * names containing a '/' are taken as paths, other names are searched for in
+ * the object's DT_RUNPATH (or DT_RPATH) with $ORIGIN expanded, then in the
+ * default search directories. Every absolute search directory, and every
+ * absolute symbolic link target of a library file, is re-rooted under the
+ * sysroot. Candidates whose ELF class or machine differ from the object that
+ * needs them are skipped, like the loader does.
+ *
+ * Each file is identified by its device and inode and parsed exactly once, no
+ * matter how many roots or libraries depend on it or through which path it is
+ * reached. Loading proceeds level by level: the newly discovered objects of a
+ * level are parsed and their DT_NEEDED entries resolved concurrently.
+ */
+class DependencyGraph
+{
+  public:
+    explicit DependencyGraph(dependency_options_s p_options = {});
+
+    /**
+     * @brief Loads the given files and every library they transitively need.
+     *
+     * Files that are already part of the graph are not parsed again.
+     *
+     * @param p_roots Executables or shared objects to start from.
+     * @return std::vector<size_t> Object index of each root, in order. Roots
+     * that do not exist or are not ELF files are skipped.
+     */
+    std::vector<size_t> load(std::span<const std::filesystem::path> p_roots);
+
+    /**
+     * @brief Resolves one DT_NEEDED name as seen from p_from.
+     *
+     * @param p_needed Library name or path from DT_NEEDED.
+     * @param p_from Object that needs the library; provides DT_RUNPATH and
+     * $ORIGIN.
+     * @return std::optional<std::filesystem::path> Path of the first
+     * compatible ELF file, with symbolic links followed, or nullopt.
+     */
+    [[nodiscard]] std::optional<std::filesystem::path> resolve(
+      std::string_view p_needed,
+      const shared_object_s& p_from) const;
+
+    /**
+     * @brief All loaded objects, roots first, then in discovery order.
+     */
+    [[nodiscard]] std::span<const shared_object_s> objects() const noexcept
+    {
+        return m_objects;
+    }
+
+    /**
+     * @brief Runs p_analysis on every loaded object concurrently.
+     *
+     * @param p_analysis Callable taking a const shared_object_s&. It is
+     * called from several threads at once, each call with a different object.
+     * @return std::vector<R> One result per object, in objects() order.
+     */
+    template<class Analysis>
+    auto analyze(Analysis&& p_analysis) const
+    {
+        using result_t = std::invoke_result_t<Analysis&, const shared_object_s&>;
+        std::vector<std::optional<result_t>> slots(m_objects.size());
+        parallel_for(
+          m_objects.size(),
+          [&](size_t i) { slots[i].emplace(p_analysis(m_objects[i])); },
+          m_options.max_threads);
+
+        std::vector<result_t> results;
+        results.reserve(slots.size());
+        for (auto& slot : slots) {
+            results.push_back(std::move(*slot));
+        }
+        return results;
+    }
+
+  private:
+    /**
+     * @brief Returns the index of the object at p_path, adding it to the
+     * graph (unparsed) when it is new.
+     *
+     * @return std::pair<size_t, bool> Object index, and true if it was added.
+     */
+    std::pair<size_t, bool> m_intern(const std::filesystem::path& p_path);
+
+    std::filesystem::path m_in_sysroot(const std::filesystem::path& p_path) const;
+    std::filesystem::path m_follow_links(std::filesystem::path p_path) const;
+
+    dependency_options_s m_options;
+    std::vector<shared_object_s> m_objects;
+    std::map<std::pair<uint64_t, uint64_t>, size_t> m_ids;  //!< (dev, ino)
+};
+
+}  // namespace safe
@@ -0,0 +1,104 @@
+/**
+ * @file dispatch_cost.hpp
+ * @author SAFE Group
+ * @brief Per-function table lookup cost of exception dispatch header file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "eh_frame.hpp"
+#include "elf_parser.hpp"
+
+namespace safe {
+
+/**
+ * @enum fde_search
+ * @brief How libgcc's unwinder finds the FDE of a frame.
+ */
+enum class fde_search
+{
+    HDR_TABLE,   //!< Binary search of the .eh_frame_hdr table
+    REGISTERED,  //!< Frames registered by crtbegin, sorted on the first throw
+    LINEAR       //!< Walk of .eh_frame up to the matching FDE
+};
+
+/**
+ * @struct dispatch_cost_s
+ * @brief Table entries examined to dispatch an exception through one
+ * function.
+ */
+struct dispatch_cost_s
+{
+    uint64_t pc_begin = 0;   //!< Start of the function
+    uint64_t pc_end = 0;     //!< One past its last instruction
+    size_t call_sites = 0;   //!< Records in its LSDA, 0 without one
+    //! Call-site records the personality routine reads for the costliest
+    //! call site, and for the average one
+    size_t worst_records = 0;
+    double mean_records = 0;
+    uint64_t worst_bytes = 0;  //!< Call-site table bytes of the worst case
+    uint64_t worst_pc = 0;     //!< Return address of the worst case
+    //! FDEs compared to find the function: binary search steps, or its
+    //! position in .eh_frame for a linear walk
+    size_t fde_lookup = 0;
+
+    /**
+     * @brief FDE comparisons and call-site records of the worst case.
+     */
+    [[nodiscard]] size_t worst_steps() const noexcept
+    {
+        return fde_lookup + worst_records;
+    }
+};
+
+/**
+ * @struct dispatch_cost_report_s
+ * @brief Dispatch cost of every function with an FDE.
+ */
+struct dispatch_cost_report_s
+{
+    fde_search search = fde_search::LINEAR;  //!< How FDEs are found
+    size_t fdes = 0;  //!< FDEs the unwinder searches
+    std::vector<dispatch_cost_s> functions;  //!< Costliest first
+    size_t undecodable = 0;  //!< FDEs or LSDAs that are malformed
+};
+
+/**
+ * @brief Models the table lookups of libgcc's unwinder and
+ * __gxx_personality_v0 for each frame an exception passes through.
+ *
+ * The unwinder finds the FDE of the frame first: a binary search of the
+ * .eh_frame_hdr table when there is one. Without it, static images whose
+ * crtbegin registers .eh_frame with __register_frame_info have their FDEs
+ * sorted on the first throw and binary searched after; otherwise the walk
+ * of .eh_frame stops at the matching FDE.
+ *
+ * The personality routine then reads the call-site table from its first
+ * record and stops at the one covering the return address minus one, or at
+ * the first record starting past it, since the table is sorted. Each call
+ * site of the LSDA is taken in turn as the return address.
+ *
+ * @param p_eh_frame Index of .eh_frame, with its .eh_frame_hdr if any.
+ * @param p_except_table The .gcc_except_table section, if any.
+ * @param p_pointer_size Width of DW_EH_PE_absptr in the LSDAs.
+ * @param p_registered Whether the image registers its frames, i.e. defines
+ * __register_frame_info.
+ * @return dispatch_cost_report_s Functions sorted by worst_steps().
+ */
+[[nodiscard]] dispatch_cost_report_s profile_dispatch_cost(
+  const EhFrame& p_eh_frame,
+  std::optional<section_view_s> p_except_table,
+  uint8_t p_pointer_size = 8,
+  bool p_registered = false);
+
+}  // namespace safe
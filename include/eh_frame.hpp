@@ -0,0 +1,233 @@
+/**
+ * @file eh_frame.hpp
+ * @author SAFE Group
+ * @brief .eh_frame / .eh_frame_hdr parser header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "elf_parser.hpp"
+#include "elf_reader.hpp"
+
+/**
+ * @namespace dw_eh_pe
+ * @brief DW_EH_PE pointer encodings used by .eh_frame, .eh_frame_hdr and
+ * the LSDA. The low nibble is the format, bits 4-6 the application and bit
+ * 7 the indirection flag.
+ */
+namespace dw_eh_pe {
+constexpr uint8_t absptr = 0x00;
+constexpr uint8_t uleb128 = 0x01;
+constexpr uint8_t udata2 = 0x02;
+constexpr uint8_t udata4 = 0x03;
+constexpr uint8_t udata8 = 0x04;
+constexpr uint8_t sleb128 = 0x09;
+constexpr uint8_t sdata2 = 0x0a;
+constexpr uint8_t sdata4 = 0x0b;
+constexpr uint8_t sdata8 = 0x0c;
+
+constexpr uint8_t pcrel = 0x10;
+constexpr uint8_t textrel = 0x20;
+constexpr uint8_t datarel = 0x30;
+constexpr uint8_t funcrel = 0x40;
+constexpr uint8_t aligned = 0x50;
+
+constexpr uint8_t indirect = 0x80;
+constexpr uint8_t omit = 0xff;
+}  // namespace dw_eh_pe
+
+/**
+ * @enum eh_frame_error
+ * @brief Error codes for .eh_frame parsing.
+ */
+enum class eh_frame_error : uint8_t
+{
+    TRUNCATED,                 //!< A record extends past the section
+    BAD_CIE_POINTER,           //!< An FDE does not point at a CIE
+    UNSUPPORTED_VERSION,       //!< CIE version other than 1, 3 or 4
+    UNSUPPORTED_AUGMENTATION,  //!< Unknown augmentation without 'z'
+    UNSUPPORTED_ENCODING,      //!< Pointer encoding that cannot be decoded
+    UNSUPPORTED_INSTRUCTION    //!< CFA opcode that cannot be decoded
+};
+
+/**
+ * @struct cie_s
+ * @brief A Common Information Entry.
+ */
+struct cie_s
+{
+    uint64_t offset = 0;             //!< Offset of the CIE in .eh_frame
+    uint64_t size = 0;               //!< Bytes of the record, length included
+    uint8_t version = 0;             //!< 1, 3 or 4
+    std::string_view augmentation;   //!< e.g. "zPLR"
+    uint64_t code_alignment = 0;     //!< Code alignment factor
+    int64_t data_alignment = 0;      //!< Data alignment factor
+    uint64_t return_address = 0;     //!< Return address register
+    uint8_t fde_encoding = dw_eh_pe::absptr;  //!< 'R', pc_begin encoding
+    uint8_t lsda_encoding = dw_eh_pe::omit;   //!< 'L', LSDA pointer encoding
+    uint8_t personality_encoding = dw_eh_pe::omit;  //!< 'P' encoding
+    //! 'P', the personality routine, or the address of a pointer to it when
+    //! personality_encoding has dw_eh_pe::indirect set
+    std::optional<uint64_t> personality;
+    bool signal_frame = false;                //!< 'S'
+    std::span<const std::byte> instructions;  //!< Initial CFA instructions
+};
+
+/**
+ * @struct fde_s
+ * @brief A Frame Description Entry.
+ */
+struct fde_s
+{
+    uint64_t offset = 0;      //!< Offset of the FDE in .eh_frame
+    uint64_t size = 0;        //!< Bytes of the record, length included
+    uint64_t cie_offset = 0;  //!< Offset of its CIE in .eh_frame
+    uint64_t pc_begin = 0;    //!< First address covered
+    uint64_t pc_end = 0;      //!< One past the last address covered
+    std::optional<uint64_t> lsda;             //!< Address of the LSDA
+    std::span<const std::byte> instructions;  //!< CFA instructions
+};
+
+/**
+ * @class EhFrame
+ * @brief Index from code addresses to the FDE, and so the LSDA, covering
+ * them.
+ *
+ * find() binary searches the sorted (initial location, FDE address) table
+ * of .eh_frame_hdr and decodes only the FDE it lands on, plus that FDE's
+ * CIE. Without a usable .eh_frame_hdr (static or relocatable links often
+ * have none) parse() walks .eh_frame once and keeps the FDE ranges sorted
+ * instead, so lookups stay O(log n) either way.
+ *
+ * The CIE augmentations z, P, L, R and S are understood, as well as the
+ * AArch64 B and G markers; other augmentations are skipped through the 'z'
+ * length. Pointers are decoded for the class and byte order of the ELF
+ * file. The spans point into the section data, which must outlive the
+ * EhFrame.
+ */
+class EhFrame
+{
+  public:
+    /**
+     * @brief Indexes p_eh_frame.
+     *
+     * @param p_eh_frame The .eh_frame section.
+     * @param p_eh_frame_hdr The .eh_frame_hdr section, if the file has one.
+     * @param p_encoding Class and byte order of the file.
+     * @return std::expected<EhFrame, eh_frame_error> The index, or the first
+     * structural problem found. A malformed .eh_frame_hdr is not an error:
+     * the index then falls back to walking .eh_frame.
+     */
+    [[nodiscard]] static std::expected<EhFrame, eh_frame_error> parse(
+      section_view_s p_eh_frame,
+      std::optional<section_view_s> p_eh_frame_hdr,
+      elf_reader::encoding_s p_encoding);
+
+    /**
+     * @brief Finds the FDE covering p_pc.
+     *
+     * @return std::optional<fde_s> The FDE, or nullopt if no FDE covers the
+     * address or the FDE cannot be decoded.
+     */
+    [[nodiscard]] std::optional<fde_s> find(uint64_t p_pc) const;
+
+    /**
+     * @brief Decodes the CIE at p_offset in .eh_frame.
+     */
+    [[nodiscard]] std::expected<cie_s, eh_frame_error> cie_at(
+      uint64_t p_offset) const;
+
+    /**
+     * @brief Decodes the FDE at p_offset in .eh_frame.
+     */
+    [[nodiscard]] std::expected<fde_s, eh_frame_error> fde_at(
+      uint64_t p_offset) const;
+
+    /**
+     * @brief Counts the CFA instructions an unwinder interprets to find the
+     * register rules at each of p_pcs in p_fde.
+     *
+     * As in libgcc's execute_cfa_program, the CIE's initial instructions
+     * run in full, then the FDE's run while the current location is below
+     * the address: the instruction that advances to or past it is counted,
+     * the ones after it are not. The count at pc_begin is therefore that of
+     * the CIE alone.
+     *
+     * @param p_fde An FDE of this .eh_frame.
+     * @param p_pcs Addresses in ascending order, e.g. return addresses.
+     * @return std::expected<std::vector<size_t>, eh_frame_error> The count
+     * for each address, or the first problem met while walking the
+     * instructions that reach the last one.
+     */
+    [[nodiscard]] std::expected<std::vector<size_t>, eh_frame_error>
+    cfa_instruction_counts(const fde_s& p_fde,
+                           std::span<const uint64_t> p_pcs) const;
+
+    /**
+     * @brief Decodes every FDE, in section order.
+     */
+    [[nodiscard]] std::expected<std::vector<fde_s>, eh_frame_error> fdes()
+      const;
+
+    /**
+     * @brief Number of FDEs that find() can reach.
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * @brief Whether find() searches the .eh_frame_hdr table.
+     */
+    [[nodiscard]] bool has_search_table() const noexcept
+    {
+        return m_table_count != 0;
+    }
+
+    /**
+     * @brief Class and byte order the tables are read in.
+     */
+    [[nodiscard]] elf_reader::encoding_s encoding() const noexcept
+    {
+        return m_encoding;
+    }
+
+    /**
+     * @brief Bytes of one .eh_frame_hdr search table entry, or 0 without a
+     * search table.
+     */
+    [[nodiscard]] size_t search_table_entry_size() const noexcept
+    {
+        return m_table_entry_size;
+    }
+
+  private:
+    struct range_s
+    {
+        uint64_t pc_begin;
+        uint64_t pc_end;
+        uint64_t offset;  // of the FDE in .eh_frame
+    };
+
+    bool m_index_search_table(section_view_s p_eh_frame_hdr);
+
+    section_view_s m_eh_frame{};
+    section_view_s m_eh_frame_hdr{};
+    elf_reader::encoding_s m_encoding{};
+    size_t m_table_offset = 0;  // of the search table in .eh_frame_hdr
+    uint8_t m_table_encoding = dw_eh_pe::omit;
+    size_t m_table_entry_size = 0;  // both fields of one entry
+    size_t m_table_count = 0;
+    std::vector<range_s> m_ranges;  // sorted; only without a search table
+};
@@ -0,0 +1,146 @@
+/**
+ * @file eh_size.hpp
+ * @author SAFE Group
+ * @brief Per-function attribution of exception handling bytes header file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "abi_parse.hpp"
+#include "elf_parser.hpp"
+#include "symbol_table.hpp"
+
+namespace safe {
+
+/**
+ * @struct eh_bytes_s
+ * @brief Exception handling bytes, by section.
+ */
+struct eh_bytes_s
+{
+    uint64_t except_table = 0;  //!< .gcc_except_table (the LSDA)
+    uint64_t eh_frame = 0;      //!< .eh_frame (the FDE, or CIEs)
+    uint64_t eh_frame_hdr = 0;  //!< .eh_frame_hdr search table
+    uint64_t arm_exidx = 0;     //!< .ARM.exidx
+    uint64_t arm_extab = 0;     //!< .ARM.extab, embedded LSDA included
+    uint64_t landing_pads = 0;  //!< Estimated landing pad code in .text
+
+    /**
+     * @brief Sum of every column.
+     */
+    [[nodiscard]] uint64_t total() const noexcept
+    {
+        return except_table + eh_frame + eh_frame_hdr + arm_exidx + arm_extab
+               + landing_pads;
+    }
+
+    eh_bytes_s& operator+=(const eh_bytes_s& p_other) noexcept;
+};
+
+/**
+ * @struct eh_function_bytes_s
+ * @brief Exception handling bytes owned by one function.
+ */
+struct eh_function_bytes_s
+{
+    uint64_t address = 0;  //!< Start of the function
+    std::string name;      //!< Demangled name, or the address in hex
+    std::string family;    //!< template_family() of the name
+    eh_bytes_s bytes;
+};
+
+/**
+ * @struct eh_runtime_bytes_s
+ * @brief A routine of the unwinder, the personality or the C++ ABI runtime
+ * linked into the image.
+ */
+struct eh_runtime_bytes_s
+{
+    std::string name;  //!< Symbol name
+    uint64_t size = 0;  //!< st_size
+};
+
+/**
+ * @struct eh_size_report_s
+ * @brief Where the exception handling bytes of an image go.
+ */
+struct eh_size_report_s
+{
+    std::vector<eh_function_bytes_s> functions;  //!< Largest total first
+    //! CIEs, section headers, alignment padding and whatever no FDE or index
+    //! entry reaches. With functions, adds up to the section sizes.
+    eh_bytes_s shared;
+    std::vector<eh_runtime_bytes_s> runtime;  //!< Largest first
+};
+
+/**
+ * @struct landing_pad_s
+ * @brief Estimated extent of a landing pad.
+ */
+struct landing_pad_s
+{
+    uint64_t address = 0;  //!< First instruction of the pad
+    uint64_t size = 0;     //!< Bytes up to the next pad or the function end
+};
+
+/**
+ * @brief The landing pads of an LSDA, each running to the next one or to the
+ * end of the function.
+ *
+ * @param p_lsda The function's LSDA.
+ * @param p_function Start of the function, the base of the call sites.
+ * @param p_function_end One past its last instruction. Pads at or past it
+ * (in a .cold part, say) are left out.
+ * @return std::vector<landing_pad_s> Distinct pads, by address.
+ */
+[[nodiscard]] std::vector<landing_pad_s> landing_pads(
+  const LsdaParser& p_lsda,
+  uint64_t p_function,
+  uint64_t p_function_end);
+
+/**
+ * @brief Attributes every byte of .gcc_except_table, .eh_frame,
+ * .eh_frame_hdr, .ARM.exidx and .ARM.extab to the function it describes.
+ *
+ * Records are tied to a function through their FDE or .ARM.exidx entry.
+ * Landing pad code is estimated by landing_pads().
+ *
+ * @param p_elf Parser over an ET_EXEC or ET_DYN file.
+ * @param p_symbols Symbols naming the functions and runtime routines.
+ * @return eh_size_report_s The attribution.
+ */
+[[nodiscard]] eh_size_report_s attribute_eh_bytes(
+  const ElfParser& p_elf,
+  const SymbolTable& p_symbols);
+
+/**
+ * @brief Groups p_functions by family.
+ *
+ * @return std::vector<eh_function_bytes_s> One entry per family, with the
+ * summed bytes and the family as name, largest total first.
+ */
+[[nodiscard]] std::vector<eh_function_bytes_s> group_by_family(
+  const std::vector<eh_function_bytes_s>& p_functions);
+
+/**
+ * @brief Name shared by the instantiations of a template: every template
+ * argument list becomes "<>" and the parameter list and qualifiers are
+ * dropped, e.g. "std::vector<int>::push_back(int const&)" becomes
+ * "std::vector<>::push_back".
+ *
+ * @param p_demangled A demangled function name.
+ */
+[[nodiscard]] std::string template_family(std::string_view p_demangled);
+
+}  // namespace safe
@@ -11,19 +11,23 @@
 
 #pragma once
 
-#include <fcntl.h>
-#include <unistd.h>
-
 #include <expected>
 #include <gelf.h>
-#include <libelf.h>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <print>
 #include <span>
+#include <string>
 #include <string_view>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
+#include "elf_reader.hpp"
+#include "mapped_file.hpp"
+#include "symbol_table.hpp"
+
 /**
  * @enum elf_parser_error
  * @brief Error codes for ELF parsing operations.
@@ -39,6 +43,50 @@ enum class elf_parser_error : uint8_t
     EMPTY_SYMBOL          //!< Symbol table vector is empty
 };
 
+/**
+ * @enum elf_load_mode
+ * @brief Controls when ElfParser decodes tables beyond the section headers.
+ */
+enum class elf_load_mode : uint8_t
+{
+    EAGER,  //!< Decode program headers and symbols during construction
+    LAZY    //!< Decode program headers and symbols on first request
+};
+
+/**
+ * @struct elf_parser_options_s
+ * @brief Construction options for ElfParser.
+ */
+struct elf_parser_options_s
+{
+    elf_load_mode mode = elf_load_mode::EAGER;  //!< When to decode tables
+
+    /**
+     * Roots of separate debug file trees (e.g. "/usr/lib/debug"), searched
+     * for ".build-id/xx/yyyy.debug" and for the .gnu_debuglink file name
+     * when the file has no .symtab of its own.
+     */
+    std::vector<std::string> debug_directories = {};
+
+    /**
+     * Check the CRC-32 of a debug file found through .gnu_debuglink when the
+     * binary has no build ID, as gdb does. This reads the whole debug file,
+     * .debug_* sections included. Turned off, the file name alone is
+     * matched and a warning names the file accepted unchecked.
+     */
+    bool verify_debuglink_crc = true;
+};
+
+/**
+ * @struct debug_link_s
+ * @brief Contents of a .gnu_debuglink section.
+ */
+struct debug_link_s
+{
+    std::string_view file;  //!< Debug file name, without directories
+    uint32_t crc;           //!< CRC-32 of the whole debug file
+};
+
 /**
  * @struct symbol_s
  * @brief Structure representing an ELF symbol table entry.
@@ -63,15 +111,36 @@ struct section_s
     std::vector<std::byte> data;  //!< Section data bytes
 };
 
+/**
+ * @struct section_view_s
+ * @brief Non-owning view of an ELF section inside the memory-mapped file.
+ *
+ * The data span points directly into the parser's file mapping and stays
+ * valid for as long as the ElfParser that produced it is alive.
+ */
+struct section_view_s
+{
+    GElf_Shdr header;                  //!< Section header information
+    std::span<const std::byte> data;  //!< Section bytes inside the mapping
+};
+
 /**
  * @class ElfParser
  * @brief Parser for ELF (Executable and Linkable Format) files.
  *
  * This class provides functionality to parse and extract information from ELF
- * binary files, supporting both 32-bit and 64-bit architectures. It uses the
- * libelf library to read ELF headers, sections, program headers, and symbol
- * tables. All sections, program headers, and symbols are loaded upon
- * construction for efficient querying.
+ * binary files, supporting both 32-bit and 64-bit architectures in either byte
+ * order. Headers, sections, program headers, and symbol tables are read with
+ * the in-tree elf_reader templates directly from the mapped file; the
+ * results are exposed through the class-neutral GElf_* structures. By default all sections, program headers, and symbols are loaded
+ * upon construction for efficient querying. In elf_load_mode::LAZY only the
+ * ELF header and section header table are read up front; program headers and
+ * the symbol table are decoded by the first getter that needs them and cached.
+ *
+ * The file is memory-mapped once and every section is kept as a view into
+ * that mapping, so section data is never copied unless a caller asks for an
+ * owning copy through get_section(). All lookup methods are const and may be
+ * called concurrently from several threads.
  */
 class ElfParser
 {
@@ -80,37 +149,61 @@ class ElfParser
      * @brief Constructs an ElfParser and opens the specified ELF file.
      *
      * Opens the ELF file, validates it, and automatically loads all headers:
-     * - Initializes the libelf library with elf_version(EV_CURRENT)
-     * - Opens the file in read-only mode using open()
-     * - Validates the file is a proper ELF object with elf_kind()
+     * - Opens the file and maps it read-only into memory (MappedFile)
+     * - Validates the ELF magic, class and data encoding with
+     *   elf_reader::identify()
      * - Loads ELF header via m_load_elf_header()
-     * - Loads all section headers and data via m_load_section_header()
-     * - Loads all program headers via m_load_program_header()
-     * - Loads symbol table via m_load_symbol_table()
+     * - Loads all section headers and data views via m_load_section_header()
+     * - Loads all program headers via m_load_program_header() (EAGER only)
+     * - Loads symbol table via m_load_symbol_table() (EAGER only)
+     *
+     * In LAZY mode the mapping is also advised as randomly accessed so the
+     * kernel does not read ahead into sections that are never used.
      *
      * Prints ELF class information (32-bit or 64-bit) to stdout upon successful
      * initialization.
      *
      * @param p_file_name Path to the ELF file to be parsed.
+     * @param p_options Load options, see elf_parser_options_s.
      * @throws std::runtime_error Caught internally, prints error and calls
      * exit(EXIT_FAILURE) for:
-     *         - ELF library initialization failures
-     *         - elf_begin() failures
-     *         - Non-ELF object files
-     * @throws std::system_error Caught internally, prints error and calls
-     * exit(EXIT_FAILURE) for:
-     *         - File open failures
+     *         - Non-ELF object files or unknown class / data encoding
+     * @note Prints the failing step and calls exit(EXIT_FAILURE) if the file
+     * cannot be opened or mapped.
      */
-    ElfParser(std::string_view p_file_name);
+    ElfParser(std::string_view p_file_name,
+              elf_parser_options_s p_options = {});
+
+    /**
+     * @brief Constructs an ElfParser over an ELF image already in memory.
+     *
+     * Used for objects that are not files of their own, such as the members
+     * of an ar archive. The image is not copied; it must outlive the parser
+     * and every view obtained from it. Loading otherwise works as for the
+     * file constructor.
+     *
+     * @param p_image Bytes of the whole ELF object.
+     * @param p_name Name used in messages (e.g. "libfoo.a(bar.o)").
+     * @param p_options Load options, see elf_parser_options_s.
+     * @throws std::runtime_error Caught internally, prints error and calls
+     * exit(EXIT_FAILURE) for images that are not ELF objects. Check with
+     * elf_reader::identify() first when the input is not known to be ELF.
+     */
+    ElfParser(std::span<const std::byte> p_image,
+              std::string_view p_name,
+              elf_parser_options_s p_options = {});
 
     /**
      * @brief Destroys the ElfParser and releases associated resources.
      *
-     * Closes the ELF descriptor using elf_end() and the file descriptor using
-     * close(). Prints "ELF file closed." confirmation message to stdout.
+     * Releases the file mapping, if this parser owns one. Prints "ELF file
+     * closed." confirmation message to stdout.
      */
     ~ElfParser();
 
+    ElfParser(const ElfParser&) = delete;
+    ElfParser& operator=(const ElfParser&) = delete;
+
     /**
      * @brief Retrieves the ELF file header.
      *
@@ -125,7 +218,20 @@ class ElfParser
      * success, or UNLOADED_ELF_HEADER error if the header was not loaded during
      * construction.
      */
-    std::expected<GElf_Ehdr, elf_parser_error> get_elf_header();
+    std::expected<GElf_Ehdr, elf_parser_error> get_elf_header() const;
+
+    /**
+     * @brief Retrieves the ELF class and byte order of the file.
+     *
+     * Callers that decode raw section bytes themselves (e.g. relocation or
+     * note sections) pass this to elf_reader::visit().
+     *
+     * @return elf_reader::encoding_s Class and byte order from e_ident.
+     */
+    elf_reader::encoding_s get_encoding() const
+    {
+        return m_encoding;
+    }
 
     /**
      * @brief Retrieves a specific section by name.
@@ -135,6 +241,9 @@ class ElfParser
      * - Section header with type, flags, alignment, addresses, and sizes
      * - Section data as a vector of bytes (empty for SHT_NOBITS sections)
      *
+     * The returned data is an owning copy of the mapped bytes. Prefer
+     * get_section_view() when the parser outlives the use of the data.
+     *
      * @param p_section Name of the section to retrieve (e.g., ".text", ".data",
      * ".symtab").
      * @return std::expected<section_s, elf_parser_error> The section structure
@@ -142,7 +251,48 @@ class ElfParser
      * if the named section does not exist.
      */
     std::expected<section_s, elf_parser_error> get_section(
-      std::string_view p_section);
+      std::string_view p_section) const;
+
+    /**
+     * @brief Retrieves a zero-copy view of a specific section by name.
+     *
+     * Same lookup as get_section(), but the returned data span points into the
+     * memory-mapped file instead of a copy. The span is empty for SHT_NOBITS
+     * sections and remains valid for the lifetime of this parser.
+     *
+     * @param p_section Name of the section to retrieve (e.g., ".text").
+     * @return std::expected<section_view_s, elf_parser_error> The section view
+     * on success, or EMPTY_SECTION if m_sections is empty, or SECTION_NOT_FOUND
+     * if the named section does not exist.
+     */
+    std::expected<section_view_s, elf_parser_error> get_section_view(
+      std::string_view p_section) const;
+
+    /**
+     * @brief Retrieves a zero-copy view of a section by index.
+     *
+     * Relocatable objects can hold several sections with the same name (one
+     * ".group" per COMDAT group, for instance), which the name lookup cannot
+     * tell apart; sh_link and sh_info fields refer to sections by index.
+     *
+     * @param p_index Section header index, as in get_section_headers().
+     * @return std::expected<section_view_s, elf_parser_error> The section view
+     * on success, or SECTION_NOT_FOUND if p_index is 0 or out of range.
+     */
+    std::expected<section_view_s, elf_parser_error> get_section_view(
+      size_t p_index) const;
+
+    /**
+     * @brief Retrieves all section headers ordered by section index.
+     *
+     * Entry i is the header of section i, so symbol st_shndx values and
+     * sh_link fields index directly into the span. Entry 0 is the null
+     * section header.
+     *
+     * @return std::span<const GElf_Shdr> Section headers by index; empty if
+     * the section header table could not be read.
+     */
+    std::span<const GElf_Shdr> get_section_headers() const;
 
     /**
      * @brief Retrieves all program headers.
@@ -154,11 +304,14 @@ class ElfParser
      * - File size and memory size
      * - Alignment
      *
-     * @return std::expected<std::span<GElf_Phdr>, elf_parser_error> A span of
-     * program headers on success, or EMPTY_PROGRAM if m_program_header vector
-     * is empty.
+     * In LAZY mode the first call decodes the program header table.
+     *
+     * @return std::expected<std::span<const GElf_Phdr>, elf_parser_error> A
+     * span of program headers on success, or EMPTY_PROGRAM if m_program_header
+     * vector is empty.
      */
-    std::expected<std::span<GElf_Phdr>, elf_parser_error> get_program_header();
+    std::expected<std::span<const GElf_Phdr>, elf_parser_error>
+    get_program_header() const;
 
     /**
      * @brief Retrieves the symbol table.
@@ -169,46 +322,236 @@ class ElfParser
      * - Symbol values (addresses or constants)
      * - Symbol type and binding information (st_info)
      *
-     * @return std::expected<std::span<symbol_s>, elf_parser_error> A span of
-     * symbols on success, or EMPTY_SYMBOL if m_symbol_table vector is empty.
+     * In LAZY mode the first call decodes the symbol table. Concurrent first
+     * calls are serialized, later calls only return the cached table.
+     *
+     * @return std::expected<std::span<const symbol_s>, elf_parser_error> A
+     * span of symbols on success, or EMPTY_SYMBOL if m_symbol_table vector is
+     * empty.
      * @note Returns empty vector (EMPTY_SYMBOL) if .symtab or .strtab sections
      * are not present.
      */
-    std::expected<std::span<symbol_s>, elf_parser_error> get_symbol_table();
+    std::expected<std::span<const symbol_s>, elf_parser_error>
+    get_symbol_table() const;
+
+    /**
+     * @brief Retrieves the compact structure-of-arrays symbol table.
+     *
+     * Same symbols as get_symbol_table(), stored column by column with names
+     * as string_views into the mapped .strtab. Building it allocates no
+     * per-symbol strings, which makes it the preferred table for analyses
+     * over large binaries.
+     *
+     * In LAZY mode the first call decodes .symtab.
+     *
+     * @return std::expected<const SymbolTable*, elf_parser_error> Non-null
+     * pointer to the table owned by this parser on success, or EMPTY_SYMBOL
+     * if .symtab or .strtab are not present.
+     */
+    std::expected<const SymbolTable*, elf_parser_error>
+    get_compact_symbol_table() const;
+
+    /**
+     * @brief Retrieves the compact dynamic symbol table.
+     *
+     * Decodes .dynsym with names from its linked .dynstr. Stripped and
+     * dynamically linked binaries keep this table when .symtab is gone. Name
+     * lookups on it go through the binary's .gnu.hash or .hash section when
+     * present. Decoded on first use and cached.
+     *
+     * @return std::expected<const SymbolTable*, elf_parser_error> Non-null
+     * pointer to the table owned by this parser on success, or EMPTY_SYMBOL
+     * if the binary has no dynamic symbol table.
+     */
+    std::expected<const SymbolTable*, elf_parser_error>
+    get_dynamic_symbol_table() const;
+
+    /**
+     * @brief Retrieves the DT_NEEDED entries of the dynamic section.
+     *
+     * @return std::vector<std::string_view> Names of the shared objects this
+     * binary depends on, in dynamic section order, as views into .dynstr.
+     * Empty for statically linked binaries.
+     */
+    std::vector<std::string_view> get_needed_libraries() const;
+
+    /**
+     * @brief Retrieves the library search paths of the dynamic section.
+     *
+     * DT_RUNPATH entries are returned when present; otherwise DT_RPATH. Each
+     * colon-separated entry is returned separately and unexpanded (e.g. still
+     * containing $ORIGIN).
+     *
+     * @return std::vector<std::string_view> Search paths as views into
+     * .dynstr.
+     */
+    std::vector<std::string_view> get_run_paths() const;
+
+    /**
+     * @brief Finds a symbol by name in O(1).
+     *
+     * Looks the name up in the prebuilt name index of .symtab. Binaries
+     * without .symtab fall back to .dynsym, searched through the binary's own
+     * .gnu.hash (or SysV .hash) section when it has one.
+     *
+     * @param p_name Exact (mangled) symbol name.
+     * @return std::expected<symbol_s, elf_parser_error> The first symbol with
+     * that name on success, EMPTY_SYMBOL if the binary has no symbol table, or
+     * SYMBOL_NOT_FOUND if no symbol has that name.
+     */
+    std::expected<symbol_s, elf_parser_error> find_symbol(
+      std::string_view p_name) const;
+
+    /**
+     * @brief Retrieves the build ID from the NT_GNU_BUILD_ID note.
+     *
+     * @return std::span<const std::byte> The build ID bytes inside the
+     * mapping; empty if the file has no build ID note.
+     */
+    std::span<const std::byte> get_build_id() const;
+
+    /**
+     * @brief Retrieves the .gnu_debuglink section.
+     *
+     * @return std::optional<debug_link_s> The debug file name and CRC, or
+     * nullopt if the section is missing or malformed.
+     */
+    std::optional<debug_link_s> get_debug_link() const;
+
+    /**
+     * @brief Path of the separate debug file the symbol table was read from.
+     *
+     * Stripped binaries have no .symtab. When elf_parser_options_s lists
+     * debug directories, or the .gnu_debuglink file sits next to the binary,
+     * the symbol table request looks for a debug file in gdb's order:
+     * - <dir>/.build-id/<first byte>/<remaining bytes>.debug for each
+     *   debug directory,
+     * - the debuglink name in the binary's directory, in its ".debug"
+     *   subdirectory, and under each debug directory followed by the
+     *   binary's absolute directory.
+     *
+     * A candidate is accepted when it has a .symtab and its build ID matches,
+     * or, for binaries without a build ID, when it bears the debuglink name
+     * and its CRC-32 matches (unless verify_debuglink_crc is off). The
+     * .symtab and build ID checks read only the candidate's section headers
+     * and notes, and the CRC only runs for binaries without a build ID.
+     * Otherwise only the symbol and string tables are read; the file is
+     * mapped for random access so its .debug_* sections are never paged in.
+     * Code and exception tables still come from this file.
+     *
+     * Triggers the lazy symbol table load.
+     *
+     * @return std::optional<std::string> The debug file path, or nullopt if
+     * the file has its own .symtab or no matching debug file was found.
+     */
+    std::optional<std::string> get_debug_file() const;
+
+    /**
+     * @brief Drops the resident pages of data that has been consumed.
+     *
+     * p_bytes may be any range handed out by this parser (a section view,
+     * .symtab of the debug file, ...). The data stays valid: released pages
+     * are read from the file again if they are touched later. Does nothing
+     * for in-memory images.
+     *
+     * @param p_bytes Bytes inside this parser's file mappings.
+     */
+    void release_pages(std::span<const std::byte> p_bytes) const noexcept
+    {
+        m_mapping.release(p_bytes);
+        m_debug_mapping.release(p_bytes);
+    }
+
+    /**
+     * @brief Drops every resident page of the file mappings.
+     *
+     * Same as release_pages(p_bytes) over the whole file and debug file.
+     * Decoded tables (headers, symbol columns) are not affected.
+     */
+    void release_pages() const noexcept
+    {
+        m_mapping.release(m_mapping.bytes());
+        m_debug_mapping.release(m_debug_mapping.bytes());
+    }
 
   private:
-    int m_elf_class;  //!< ELF class identifier (ELFCLASS32 or ELFCLASS64).
-    int m_file;       //!< File descriptor for the opened ELF file.
+    elf_reader::encoding_s m_encoding;  //!< ELF class and byte order.
     std::string m_file_name;  //!< Path to the ELF file being analyzed.
 
-    Elf* m_elf;              //!< Libelf handle for the ELF file.
+    MappedFile m_mapping;  //!< File mapping; empty for in-memory images.
+    const std::byte* m_image = nullptr;  //!< Start of the ELF image.
+    size_t m_image_size = 0;             //!< Size of the image in bytes.
+    elf_parser_options_s m_options;  //!< Options given at construction.
+
     GElf_Ehdr m_elf_header;  //!< Parsed ELF file header structure.
 
     /**
      * @brief Collection of parsed program headers indexed by position.
      *
      * Stores all program headers (PT_LOAD, PT_DYNAMIC, etc.) in order.
-     * Populated during construction by m_load_program_header().
+     * Populated once by m_load_program_header(), either during construction
+     * or on the first get_program_header() call in LAZY mode.
      */
-    std::vector<GElf_Phdr> m_program_header;
+    mutable std::vector<GElf_Phdr> m_program_header;
+    mutable std::once_flag m_program_header_once;  //!< Guards the lazy load.
 
     /**
-     * @brief Map of section names to their structures.
+     * @brief Map of section names to their views.
      *
      * Provides O(1) lookup of sections by name. Keys are string_views
      * pointing to section names from the string table. Each value contains
-     * both the section header and its data. Populated during construction
-     * by m_load_section_header().
+     * the section header and a span over its bytes in the file mapping.
+     * Populated during construction by m_load_section_header().
      */
-    std::unordered_map<std::string_view, section_s> m_sections;
+    std::unordered_map<std::string_view, section_view_s> m_sections;
 
     /**
-     * @brief Collection of parsed symbol table entries.
+     * @brief Section headers and data views indexed by section number.
      *
-     * Stores all symbols from the .symtab section with names resolved from
-     * .strtab. Populated during construction by m_load_symbol_table().
+     * Populated during construction by m_load_section_header(), alongside
+     * m_sections.
      */
-    std::vector<symbol_s> m_symbol_table;
+    std::vector<GElf_Shdr> m_section_headers;
+    std::vector<std::span<const std::byte>> m_section_data;
+
+    /**
+     * @brief Compact symbol table decoded from .symtab.
+     *
+     * Names are views into the mapped .strtab. Populated once by
+     * m_load_symbol_table(), either during construction or on the first
+     * symbol table request in LAZY mode.
+     */
+    mutable SymbolTable m_compact_symbol_table;
+    mutable std::once_flag m_symbol_table_once;  //!< Guards the lazy load.
+
+    /**
+     * @brief Collection of owning symbol table entries.
+     *
+     * Materialized from m_compact_symbol_table by m_load_symbol_records()
+     * for callers of get_symbol_table().
+     */
+    mutable std::vector<symbol_s> m_symbol_table;
+    mutable std::once_flag m_symbol_records_once;  //!< Guards the lazy load.
+
+    /**
+     * @brief Compact dynamic symbol table decoded from .dynsym.
+     *
+     * Names are views into the linked .dynstr. Lookups go through .gnu.hash
+     * or .hash when present. Populated once by
+     * m_load_dynamic_symbol_table() on first use.
+     */
+    mutable SymbolTable m_dynamic_symbol_table;
+    mutable std::once_flag m_dynamic_symbol_table_once;  //!< Guards the load.
+
+    /**
+     * @brief Separate debug file supplying .symtab for a stripped file.
+     *
+     * Opened by m_load_symbol_table() only when this file has no .symtab.
+     * m_compact_symbol_table then holds views into m_debug_mapping, so both
+     * live as long as this parser.
+     */
+    mutable MappedFile m_debug_mapping;
+    mutable std::unique_ptr<ElfParser> m_debug_file;
 
     /**
      * @brief Flag indicating whether the ELF header has been successfully
@@ -220,32 +563,42 @@ class ElfParser
      */
     bool m_elf_header_loaded;
 
+    /**
+     * @brief Shared tail of both constructors: validates the image and
+     * loads the headers (and, in EAGER mode, the tables).
+     */
+    void m_initialize();
+
     /**
      * @brief Parses and loads the ELF file header.
      *
-     * Calls gelf_getehdr() to read the ELF header from m_elf and stores it
-     * in m_elf_header. Sets m_elf_header_loaded to true on success, false on
-     * failure.
+     * Reads the ELF header of the mapped file in its own class and byte order
+     * and stores it in m_elf_header. Sets m_elf_header_loaded to true on
+     * success, false on failure.
      *
-     * @note Prints error message to stderr using elf_errmsg(-1) if
-     * gelf_getehdr() fails, but does not throw an exception or exit.
+     * @note Prints an error message to stderr if the file is too small for
+     * the header, but does not throw an exception or exit.
      */
     void m_load_elf_header();
 
     /**
      * @brief Parses and loads all section headers and their data.
      *
-     * Iterates through all sections using elf_nextscn(), extracting for each:
-     * - Section header via gelf_getshdr()
-     * - Section name from string table via elf_strptr() using e_shstrndx
-     * - Section data via elf_getdata()
+     * Walks the section header table at e_shoff, extracting for each section
+     * after the null section:
+     * - Section header, widened to GElf_Shdr
+     * - Section name from the string table at e_shstrndx (SHN_XINDEX and
+     *   e_shnum == 0 extended numbering are followed through section 0)
+     * - Section data as a span of the file mapping at sh_offset/sh_size
      *
      * Special handling:
-     * - SHT_NOBITS sections store empty data vectors
+     * - SHT_NOBITS sections store empty data spans
+     * - Sections extending past the end of the file are skipped
      * - Failed sections print error to stderr but iteration continues
      *
-     * Populates m_sections map with section_s structures containing both
-     * headers and data.
+     * Populates m_sections map with section_view_s structures containing both
+     * headers and data views, and m_section_headers with every header at its
+     * section index.
      *
      * @note Requires m_elf_header_loaded to be true. Prints error to stderr and
      * returns early if header not loaded. Individual section failures print
@@ -256,33 +609,81 @@ class ElfParser
     /**
      * @brief Parses and loads all program headers.
      *
-     * Iterates through all program headers using gelf_getphdr() based on
-     * e_phnum from m_elf_header. Stores each successfully retrieved program
-     * header in m_program_header vector.
+     * Walks the e_phnum program headers at e_phoff and stores each, widened
+     * to GElf_Phdr, in m_program_header.
      *
      * @note Requires m_elf_header_loaded to be true. Prints error to stderr and
-     * returns early if header not loaded. Individual program header failures
-     * print errors but don't stop processing remaining headers.
+     * returns early if header not loaded, or if the table lies outside the
+     * file.
      */
-    void m_load_program_header();
+    void m_load_program_header() const;
 
     /**
      * @brief Parses and loads the symbol table.
      *
-     * Searches for .symtab and .strtab sections in m_sections. If both exist:
+     * Searches for .symtab and .strtab sections in m_sections. If both exist,
+     * decodes .symtab into m_compact_symbol_table:
      * - Calculates symbol count using sh_size / sh_entsize from .symtab header
-     * - Iterates through symbol entries, casting raw bytes to GElf_Sym
-     * structures
-     * - Resolves symbol names from .strtab using st_name offset
-     * - Creates symbol_s structures with name, value (st_value), and info
-     * (st_info)
-     * - Empty string used for symbols with st_name == 0
+     * - Reads each entry's value, size, info, other and shndx in the file's
+     *   class and byte order into columns
+     * - Resolves symbol names as views into .strtab using st_name offset
+     * - Empty name used for symbols with st_name == 0
+     *
+     * If this file has no .symtab, the tables are read from the separate
+     * debug file found by m_open_debug_file() instead.
      *
-     * Populates m_symbol_table with all parsed symbols. Returns silently
-     * without loading any symbols if either .symtab or .strtab is missing.
+     * Returns silently without loading any symbols if either .symtab or
+     * .strtab is missing.
      *
      * @note Does not print errors if sections are missing, allowing ELF files
      * without symbol tables to parse successfully.
      */
-    void m_load_symbol_table();
+    void m_load_symbol_table() const;
+
+    /**
+     * @brief Materializes m_symbol_table from the compact symbol table.
+     *
+     * Creates one symbol_s with an owning name per symbol. Only runs for
+     * callers of get_symbol_table().
+     */
+    void m_load_symbol_records() const;
+
+    /**
+     * @brief Parses and loads the dynamic symbol table.
+     *
+     * Decodes the SHT_DYNSYM section with names from the string table in its
+     * sh_link. If a .gnu.hash (preferred) or .hash section links to it, that
+     * section is attached to the table for name lookups.
+     *
+     * @note Returns silently without loading any symbols if there is no
+     * dynamic symbol table.
+     */
+    void m_load_dynamic_symbol_table() const;
+
+    /**
+     * @brief Finds the view of the section at p_index.
+     *
+     * @return std::optional<section_view_s> The section, or nullopt if no
+     * section with that index was loaded.
+     */
+    std::optional<section_view_s> m_section_at(size_t p_index) const;
+
+    /**
+     * @brief Collects the string values of all dynamic entries with p_tag.
+     *
+     * @param p_tag Dynamic tag whose d_val is a .dynstr offset (DT_NEEDED,
+     * DT_RUNPATH, DT_RPATH, ...).
+     * @return std::vector<std::string_view> Strings as views into the string
+     * table linked to the SHT_DYNAMIC section.
+     */
+    std::vector<std::string_view> m_dynamic_strings(int64_t p_tag) const;
+
+    /**
+     * @brief Searches the debug directories for this file's debug file.
+     *
+     * On success, stores the mapping and a LAZY parser over it in
+     * m_debug_mapping and m_debug_file. See get_debug_file() for the search
+     * order and matching rules.
+     */
+    void m_open_debug_file() const;
 };
@@ -0,0 +1,799 @@
+/**
+ * @file elf_reader.hpp
+ * @author SAFE Group
+ * @brief Header-only ELF record reader templated on class and byte order
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <span>
+
+#include <gelf.h>
+
+/**
+ * @namespace elf_reader
+ * @brief Zero-copy access to ELF records inside a mapped file.
+ *
+ * Every record type has a constexpr layout per ELF class (field offsets and
+ * widths), checked against the C structures at compile time. A record_ref
+ * is a pointer into the mapping; its accessors load one field and byte-swap
+ * it only when the file's byte order differs from the host's, so no record
+ * is ever converted as a whole. record_span walks a table of such records
+ * with the stride given by the section or header (sh_entsize, e_phentsize).
+ *
+ * The class and byte order are template parameters so each combination is
+ * compiled into straight-line loads. visit() picks the combination of a file
+ * at run time.
+ */
+namespace elf_reader {
+
+/**
+ * @struct encoding_s
+ * @brief ELF class and data encoding taken from e_ident.
+ */
+struct encoding_s
+{
+    unsigned char elf_class = ELFCLASS64;     //!< ELFCLASS32 or ELFCLASS64
+    std::endian order = std::endian::native;  //!< ELFDATA2LSB or ELFDATA2MSB
+
+    bool operator==(const encoding_s&) const = default;
+};
+
+/**
+ * @brief Loads a T stored in p_order at p_data, which may be unaligned.
+ */
+template<class T, std::endian Order>
+[[nodiscard]] inline T load(const std::byte* p_data) noexcept
+{
+    T value;
+    std::memcpy(&value, p_data, sizeof(T));
+    if constexpr (Order != std::endian::native && sizeof(T) > 1) {
+        value = std::byteswap(value);
+    }
+    return value;
+}
+
+/**
+ * @brief Stores p_value in p_order at p_data, which may be unaligned.
+ */
+template<class T, std::endian Order>
+inline void store(std::byte* p_data, T p_value) noexcept
+{
+    if constexpr (Order != std::endian::native && sizeof(T) > 1) {
+        p_value = std::byteswap(p_value);
+    }
+    std::memcpy(p_data, &p_value, sizeof(T));
+}
+
+/**
+ * @brief A field of width sizeof(T) at byte offset Offset of a record.
+ */
+template<class T, size_t Offset>
+struct field
+{
+    using type = T;
+    static constexpr size_t offset = Offset;
+};
+
+/**
+ * @brief Record layouts. Each defines its size and one field per member.
+ */
+template<unsigned char Class>
+struct ehdr_layout;
+template<unsigned char Class>
+struct shdr_layout;
+template<unsigned char Class>
+struct phdr_layout;
+template<unsigned char Class>
+struct sym_layout;
+template<unsigned char Class>
+struct dyn_layout;
+template<unsigned char Class>
+struct rel_layout;
+template<unsigned char Class>
+struct rela_layout;
+
+template<>
+struct ehdr_layout<ELFCLASS32>
+{
+    static constexpr size_t size = 52;
+    using e_type = field<uint16_t, 16>;
+    using e_machine = field<uint16_t, 18>;
+    using e_version = field<uint32_t, 20>;
+    using e_entry = field<uint32_t, 24>;
+    using e_phoff = field<uint32_t, 28>;
+    using e_shoff = field<uint32_t, 32>;
+    using e_flags = field<uint32_t, 36>;
+    using e_ehsize = field<uint16_t, 40>;
+    using e_phentsize = field<uint16_t, 42>;
+    using e_phnum = field<uint16_t, 44>;
+    using e_shentsize = field<uint16_t, 46>;
+    using e_shnum = field<uint16_t, 48>;
+    using e_shstrndx = field<uint16_t, 50>;
+};
+
+template<>
+struct ehdr_layout<ELFCLASS64>
+{
+    static constexpr size_t size = 64;
+    using e_type = field<uint16_t, 16>;
+    using e_machine = field<uint16_t, 18>;
+    using e_version = field<uint32_t, 20>;
+    using e_entry = field<uint64_t, 24>;
+    using e_phoff = field<uint64_t, 32>;
+    using e_shoff = field<uint64_t, 40>;
+    using e_flags = field<uint32_t, 48>;
+    using e_ehsize = field<uint16_t, 52>;
+    using e_phentsize = field<uint16_t, 54>;
+    using e_phnum = field<uint16_t, 56>;
+    using e_shentsize = field<uint16_t, 58>;
+    using e_shnum = field<uint16_t, 60>;
+    using e_shstrndx = field<uint16_t, 62>;
+};
+
+template<>
+struct shdr_layout<ELFCLASS32>
+{
+    static constexpr size_t size = 40;
+    using sh_name = field<uint32_t, 0>;
+    using sh_type = field<uint32_t, 4>;
+    using sh_flags = field<uint32_t, 8>;
+    using sh_addr = field<uint32_t, 12>;
+    using sh_offset = field<uint32_t, 16>;
+    using sh_size = field<uint32_t, 20>;
+    using sh_link = field<uint32_t, 24>;
+    using sh_info = field<uint32_t, 28>;
+    using sh_addralign = field<uint32_t, 32>;
+    using sh_entsize = field<uint32_t, 36>;
+};
+
+template<>
+struct shdr_layout<ELFCLASS64>
+{
+    static constexpr size_t size = 64;
+    using sh_name = field<uint32_t, 0>;
+    using sh_type = field<uint32_t, 4>;
+    using sh_flags = field<uint64_t, 8>;
+    using sh_addr = field<uint64_t, 16>;
+    using sh_offset = field<uint64_t, 24>;
+    using sh_size = field<uint64_t, 32>;
+    using sh_link = field<uint32_t, 40>;
+    using sh_info = field<uint32_t, 44>;
+    using sh_addralign = field<uint64_t, 48>;
+    using sh_entsize = field<uint64_t, 56>;
+};
+
+template<>
+struct phdr_layout<ELFCLASS32>
+{
+    static constexpr size_t size = 32;
+    using p_type = field<uint32_t, 0>;
+    using p_offset = field<uint32_t, 4>;
+    using p_vaddr = field<uint32_t, 8>;
+    using p_paddr = field<uint32_t, 12>;
+    using p_filesz = field<uint32_t, 16>;
+    using p_memsz = field<uint32_t, 20>;
+    using p_flags = field<uint32_t, 24>;
+    using p_align = field<uint32_t, 28>;
+};
+
+template<>
+struct phdr_layout<ELFCLASS64>
+{
+    static constexpr size_t size = 56;
+    using p_type = field<uint32_t, 0>;
+    using p_flags = field<uint32_t, 4>;
+    using p_offset = field<uint64_t, 8>;
+    using p_vaddr = field<uint64_t, 16>;
+    using p_paddr = field<uint64_t, 24>;
+    using p_filesz = field<uint64_t, 32>;
+    using p_memsz = field<uint64_t, 40>;
+    using p_align = field<uint64_t, 48>;
+};
+
+template<>
+struct sym_layout<ELFCLASS32>
+{
+    static constexpr size_t size = 16;
+    using st_name = field<uint32_t, 0>;
+    using st_value = field<uint32_t, 4>;
+    using st_size = field<uint32_t, 8>;
+    using st_info = field<uint8_t, 12>;
+    using st_other = field<uint8_t, 13>;
+    using st_shndx = field<uint16_t, 14>;
+};
+
+template<>
+struct sym_layout<ELFCLASS64>
+{
+    static constexpr size_t size = 24;
+    using st_name = field<uint32_t, 0>;
+    using st_info = field<uint8_t, 4>;
+    using st_other = field<uint8_t, 5>;
+    using st_shndx = field<uint16_t, 6>;
+    using st_value = field<uint64_t, 8>;
+    using st_size = field<uint64_t, 16>;
+};
+
+template<>
+struct dyn_layout<ELFCLASS32>
+{
+    static constexpr size_t size = 8;
+    using d_tag = field<int32_t, 0>;
+    using d_val = field<uint32_t, 4>;
+};
+
+template<>
+struct dyn_layout<ELFCLASS64>
+{
+    static constexpr size_t size = 16;
+    using d_tag = field<int64_t, 0>;
+    using d_val = field<uint64_t, 8>;
+};
+
+template<>
+struct rel_layout<ELFCLASS32>
+{
+    static constexpr size_t size = 8;
+    using r_offset = field<uint32_t, 0>;
+    using r_info = field<uint32_t, 4>;
+};
+
+template<>
+struct rel_layout<ELFCLASS64>
+{
+    static constexpr size_t size = 16;
+    using r_offset = field<uint64_t, 0>;
+    using r_info = field<uint64_t, 8>;
+};
+
+template<>
+struct rela_layout<ELFCLASS32> : rel_layout<ELFCLASS32>
+{
+    static constexpr size_t size = 12;
+    using r_addend = field<int32_t, 8>;
+};
+
+template<>
+struct rela_layout<ELFCLASS64> : rel_layout<ELFCLASS64>
+{
+    static constexpr size_t size = 24;
+    using r_addend = field<int64_t, 16>;
+};
+
+/**
+ * @brief Note header; identical in both classes.
+ */
+struct nhdr_layout
+{
+    static constexpr size_t size = 12;
+    using n_namesz = field<uint32_t, 0>;
+    using n_descsz = field<uint32_t, 4>;
+    using n_type = field<uint32_t, 8>;
+};
+
+// The layouts must agree with the C structures of the host's <elf.h>
+#define SAFE_ELF_CHECK_FIELD(layout, record, member)                          \
+    static_assert(layout::member::offset == offsetof(record, member)          \
+                  && sizeof(layout::member::type) == sizeof(record::member))
+SAFE_ELF_CHECK_FIELD(ehdr_layout<ELFCLASS32>, Elf32_Ehdr, e_entry);
+SAFE_ELF_CHECK_FIELD(ehdr_layout<ELFCLASS32>, Elf32_Ehdr, e_shstrndx);
+SAFE_ELF_CHECK_FIELD(ehdr_layout<ELFCLASS64>, Elf64_Ehdr, e_entry);
+SAFE_ELF_CHECK_FIELD(ehdr_layout<ELFCLASS64>, Elf64_Ehdr, e_shstrndx);
+SAFE_ELF_CHECK_FIELD(shdr_layout<ELFCLASS32>, Elf32_Shdr, sh_offset);
+SAFE_ELF_CHECK_FIELD(shdr_layout<ELFCLASS32>, Elf32_Shdr, sh_entsize);
+SAFE_ELF_CHECK_FIELD(shdr_layout<ELFCLASS64>, Elf64_Shdr, sh_offset);
+SAFE_ELF_CHECK_FIELD(shdr_layout<ELFCLASS64>, Elf64_Shdr, sh_entsize);
+SAFE_ELF_CHECK_FIELD(phdr_layout<ELFCLASS32>, Elf32_Phdr, p_flags);
+SAFE_ELF_CHECK_FIELD(phdr_layout<ELFCLASS32>, Elf32_Phdr, p_align);
+SAFE_ELF_CHECK_FIELD(phdr_layout<ELFCLASS64>, Elf64_Phdr, p_flags);
+SAFE_ELF_CHECK_FIELD(phdr_layout<ELFCLASS64>, Elf64_Phdr, p_align);
+SAFE_ELF_CHECK_FIELD(sym_layout<ELFCLASS32>, Elf32_Sym, st_value);
+SAFE_ELF_CHECK_FIELD(sym_layout<ELFCLASS32>, Elf32_Sym, st_shndx);
+SAFE_ELF_CHECK_FIELD(sym_layout<ELFCLASS64>, Elf64_Sym, st_value);
+SAFE_ELF_CHECK_FIELD(sym_layout<ELFCLASS64>, Elf64_Sym, st_shndx);
+SAFE_ELF_CHECK_FIELD(rela_layout<ELFCLASS32>, Elf32_Rela, r_addend);
+SAFE_ELF_CHECK_FIELD(rela_layout<ELFCLASS64>, Elf64_Rela, r_addend);
+#undef SAFE_ELF_CHECK_FIELD
+static_assert(ehdr_layout<ELFCLASS32>::size == sizeof(Elf32_Ehdr));
+static_assert(ehdr_layout<ELFCLASS64>::size == sizeof(Elf64_Ehdr));
+static_assert(shdr_layout<ELFCLASS32>::size == sizeof(Elf32_Shdr));
+static_assert(shdr_layout<ELFCLASS64>::size == sizeof(Elf64_Shdr));
+static_assert(phdr_layout<ELFCLASS32>::size == sizeof(Elf32_Phdr));
+static_assert(phdr_layout<ELFCLASS64>::size == sizeof(Elf64_Phdr));
+static_assert(sym_layout<ELFCLASS32>::size == sizeof(Elf32_Sym));
+static_assert(sym_layout<ELFCLASS64>::size == sizeof(Elf64_Sym));
+static_assert(dyn_layout<ELFCLASS32>::size == sizeof(Elf32_Dyn));
+static_assert(dyn_layout<ELFCLASS64>::size == sizeof(Elf64_Dyn));
+static_assert(rel_layout<ELFCLASS32>::size == sizeof(Elf32_Rel));
+static_assert(rel_layout<ELFCLASS64>::size == sizeof(Elf64_Rel));
+static_assert(rela_layout<ELFCLASS32>::size == sizeof(Elf32_Rela));
+static_assert(rela_layout<ELFCLASS64>::size == sizeof(Elf64_Rela));
+
+/**
+ * @class record_ref
+ * @brief Pointer to one record of type Layout stored in byte order Order.
+ *
+ * The pointed-to bytes must hold at least Layout::size bytes and outlive the
+ * reference.
+ */
+template<class Layout, std::endian Order>
+class record_ref
+{
+  public:
+    using layout = Layout;
+    static constexpr size_t size = Layout::size;
+
+    constexpr explicit record_ref(const std::byte* p_data) noexcept
+      : m_data(p_data)
+    {
+    }
+
+    template<class Field>
+    [[nodiscard]] typename Field::type get() const noexcept
+    {
+        static_assert(Field::offset + sizeof(typename Field::type) <= size);
+        return load<typename Field::type, Order>(m_data + Field::offset);
+    }
+
+    [[nodiscard]] const std::byte* data() const noexcept
+    {
+        return m_data;
+    }
+
+  private:
+    const std::byte* m_data;
+};
+
+template<unsigned char Class, std::endian Order>
+struct ehdr_ref : record_ref<ehdr_layout<Class>, Order>
+{
+    using L = ehdr_layout<Class>;
+    using record_ref<L, Order>::record_ref;
+
+    // clang-format off
+    uint16_t e_type() const { return this->template get<typename L::e_type>(); }
+    uint16_t e_machine() const { return this->template get<typename L::e_machine>(); }
+    uint64_t e_entry() const { return this->template get<typename L::e_entry>(); }
+    uint64_t e_phoff() const { return this->template get<typename L::e_phoff>(); }
+    uint64_t e_shoff() const { return this->template get<typename L::e_shoff>(); }
+    uint32_t e_flags() const { return this->template get<typename L::e_flags>(); }
+    uint16_t e_phentsize() const { return this->template get<typename L::e_phentsize>(); }
+    uint16_t e_phnum() const { return this->template get<typename L::e_phnum>(); }
+    uint16_t e_shentsize() const { return this->template get<typename L::e_shentsize>(); }
+    uint16_t e_shnum() const { return this->template get<typename L::e_shnum>(); }
+    uint16_t e_shstrndx() const { return this->template get<typename L::e_shstrndx>(); }
+    // clang-format on
+
+    [[nodiscard]] GElf_Ehdr to_gelf() const
+    {
+        GElf_Ehdr out{};
+        std::memcpy(out.e_ident, this->data(), EI_NIDENT);
+        out.e_type = e_type();
+        out.e_machine = e_machine();
+        out.e_version = this->template get<typename L::e_version>();
+        out.e_entry = e_entry();
+        out.e_phoff = e_phoff();
+        out.e_shoff = e_shoff();
+        out.e_flags = e_flags();
+        out.e_ehsize = this->template get<typename L::e_ehsize>();
+        out.e_phentsize = e_phentsize();
+        out.e_phnum = e_phnum();
+        out.e_shentsize = e_shentsize();
+        out.e_shnum = e_shnum();
+        out.e_shstrndx = e_shstrndx();
+        return out;
+    }
+};
+
+template<unsigned char Class, std::endian Order>
+struct shdr_ref : record_ref<shdr_layout<Class>, Order>
+{
+    using L = shdr_layout<Class>;
+    using record_ref<L, Order>::record_ref;
+
+    // clang-format off
+    uint32_t sh_name() const { return this->template get<typename L::sh_name>(); }
+    uint32_t sh_type() const { return this->template get<typename L::sh_type>(); }
+    uint64_t sh_flags() const { return this->template get<typename L::sh_flags>(); }
+    uint64_t sh_addr() const { return this->template get<typename L::sh_addr>(); }
+    uint64_t sh_offset() const { return this->template get<typename L::sh_offset>(); }
+    uint64_t sh_size() const { return this->template get<typename L::sh_size>(); }
+    uint32_t sh_link() const { return this->template get<typename L::sh_link>(); }
+    uint32_t sh_info() const { return this->template get<typename L::sh_info>(); }
+    uint64_t sh_addralign() const { return this->template get<typename L::sh_addralign>(); }
+    uint64_t sh_entsize() const { return this->template get<typename L::sh_entsize>(); }
+    // clang-format on
+
+    [[nodiscard]] GElf_Shdr to_gelf() const
+    {
+        return GElf_Shdr{ sh_name(), sh_type(),   sh_flags(),     sh_addr(),
+                          sh_offset(), sh_size(), sh_link(),      sh_info(),
+                          sh_addralign(),         sh_entsize() };
+    }
+};
+
+template<unsigned char Class, std::endian Order>
+struct phdr_ref : record_ref<phdr_layout<Class>, Order>
+{
+    using L = phdr_layout<Class>;
+    using record_ref<L, Order>::record_ref;
+
+    // clang-format off
+    uint32_t p_type() const { return this->template get<typename L::p_type>(); }
+    uint32_t p_flags() const { return this->template get<typename L::p_flags>(); }
+    uint64_t p_offset() const { return this->template get<typename L::p_offset>(); }
+    uint64_t p_vaddr() const { return this->template get<typename L::p_vaddr>(); }
+    uint64_t p_paddr() const { return this->template get<typename L::p_paddr>(); }
+    uint64_t p_filesz() const { return this->template get<typename L::p_filesz>(); }
+    uint64_t p_memsz() const { return this->template get<typename L::p_memsz>(); }
+    uint64_t p_align() const { return this->template get<typename L::p_align>(); }
+    // clang-format on
+
+    [[nodiscard]] GElf_Phdr to_gelf() const
+    {
+        return GElf_Phdr{ p_type(),  p_flags(),  p_offset(), p_vaddr(),
+                          p_paddr(), p_filesz(), p_memsz(),  p_align() };
+    }
+};
+
+template<unsigned char Class, std::endian Order>
+struct sym_ref : record_ref<sym_layout<Class>, Order>
+{
+    using L = sym_layout<Class>;
+    using record_ref<L, Order>::record_ref;
+
+    // clang-format off
+    uint32_t st_name() const { return this->template get<typename L::st_name>(); }
+    uint64_t st_value() const { return this->template get<typename L::st_value>(); }
+    uint64_t st_size() const { return this->template get<typename L::st_size>(); }
+    unsigned char st_info() const { return this->template get<typename L::st_info>(); }
+    unsigned char st_other() const { return this->template get<typename L::st_other>(); }
+    uint16_t st_shndx() const { return this->template get<typename L::st_shndx>(); }
+    // clang-format on
+};
+
+template<unsigned char Class, std::endian Order>
+struct dyn_ref : record_ref<dyn_layout<Class>, Order>
+{
+    using L = dyn_layout<Class>;
+    using record_ref<L, Order>::record_ref;
+
+    // clang-format off
+    int64_t d_tag() const { return this->template get<typename L::d_tag>(); }
+    uint64_t d_val() const { return this->template get<typename L::d_val>(); }
+    // clang-format on
+};
+
+/**
+ * @brief Relocation without addend. r_info splits differently per class.
+ */
+template<unsigned char Class, std::endian Order, class Layout = rel_layout<Class>>
+struct rel_ref : record_ref<Layout, Order>
+{
+    using L = Layout;
+    using record_ref<L, Order>::record_ref;
+
+    // clang-format off
+    uint64_t r_offset() const { return this->template get<typename L::r_offset>(); }
+    uint64_t r_info() const { return this->template get<typename L::r_info>(); }
+    // clang-format on
+
+    [[nodiscard]] uint32_t r_sym() const
+    {
+        if constexpr (Class == ELFCLASS32) {
+            return static_cast<uint32_t>(r_info() >> 8);
+        } else {
+            return static_cast<uint32_t>(r_info() >> 32);
+        }
+    }
+
+    [[nodiscard]] uint32_t r_type() const
+    {
+        if constexpr (Class == ELFCLASS32) {
+            return static_cast<uint32_t>(r_info() & 0xff);
+        } else {
+            return static_cast<uint32_t>(r_info() & 0xffffffff);
+        }
+    }
+};
+
+template<unsigned char Class, std::endian Order>
+struct rela_ref : rel_ref<Class, Order, rela_layout<Class>>
+{
+    using L = rela_layout<Class>;
+    using rel_ref<Class, Order, L>::rel_ref;
+
+    [[nodiscard]] int64_t r_addend() const
+    {
+        return this->template get<typename L::r_addend>();
+    }
+};
+
+template<std::endian Order>
+struct nhdr_ref : record_ref<nhdr_layout, Order>
+{
+    using L = nhdr_layout;
+    using record_ref<L, Order>::record_ref;
+
+    // clang-format off
+    uint32_t n_namesz() const { return this->template get<typename L::n_namesz>(); }
+    uint32_t n_descsz() const { return this->template get<typename L::n_descsz>(); }
+    uint32_t n_type() const { return this->template get<typename L::n_type>(); }
+    // clang-format on
+};
+
+/**
+ * @class record_span
+ * @brief Table of Ref records laid out every p_stride bytes.
+ *
+ * A stride smaller than the record (e.g. a bogus sh_entsize of 0) yields an
+ * empty span rather than overlapping reads. Trailing bytes that do not fill
+ * a whole record are ignored.
+ */
+template<class Ref>
+class record_span
+{
+  public:
+    class iterator
+    {
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Ref;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Ref;
+
+        iterator() = default;
+        iterator(const std::byte* p_data, size_t p_stride)
+          : m_data(p_data)
+          , m_stride(p_stride)
+        {
+        }
+
+        Ref operator*() const
+        {
+            return Ref(m_data);
+        }
+        iterator& operator++()
+        {
+            m_data += m_stride;
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+        bool operator==(const iterator& p_other) const
+        {
+            return m_data == p_other.m_data;
+        }
+
+      private:
+        const std::byte* m_data = nullptr;
+        size_t m_stride = 0;
+    };
+
+    record_span() = default;
+
+    explicit record_span(std::span<const std::byte> p_bytes,
+                         size_t p_stride = Ref::size)
+      : m_data(p_bytes.data())
+      , m_stride(p_stride)
+    {
+        // the last record only needs Ref::size bytes, not a whole stride
+        if (p_stride >= Ref::size && p_bytes.size() >= Ref::size) {
+            m_count = (p_bytes.size() - Ref::size) / p_stride + 1;
+        }
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return m_count;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_count == 0;
+    }
+
+    [[nodiscard]] Ref operator[](size_t p_index) const
+    {
+        return Ref(m_data + p_index * m_stride);
+    }
+
+    [[nodiscard]] iterator begin() const
+    {
+        return { m_data, m_stride };
+    }
+
+    [[nodiscard]] iterator end() const
+    {
+        return { m_data + m_count * m_stride, m_stride };
+    }
+
+  private:
+    const std::byte* m_data = nullptr;
+    size_t m_stride = Ref::size;
+    size_t m_count = 0;
+};
+
+/**
+ * @brief Bounds-checked sub-span of p_image; empty if out of range.
+ */
+[[nodiscard]] inline std::span<const std::byte> slice(
+  std::span<const std::byte> p_image,
+  uint64_t p_offset,
+  uint64_t p_size)
+{
+    if (p_offset > p_image.size() || p_size > p_image.size() - p_offset) {
+        return {};
+    }
+    return p_image.subspan(p_offset, p_size);
+}
+
+/**
+ * @struct elf_file
+ * @brief Record types and table accessors for one class and byte order.
+ */
+template<unsigned char Class, std::endian Order>
+struct elf_file
+{
+    static constexpr encoding_s encoding{ Class, Order };
+
+    using ehdr = ehdr_ref<Class, Order>;
+    using shdr = shdr_ref<Class, Order>;
+    using phdr = phdr_ref<Class, Order>;
+    using sym = sym_ref<Class, Order>;
+    using dyn = dyn_ref<Class, Order>;
+    using rel = rel_ref<Class, Order>;
+    using rela = rela_ref<Class, Order>;
+    using nhdr = nhdr_ref<Order>;
+
+    /**
+     * @brief The ELF header, or nullopt if the image is too small.
+     */
+    [[nodiscard]] static std::optional<ehdr> header(
+      std::span<const std::byte> p_image)
+    {
+        if (p_image.size() < ehdr::size) {
+            return std::nullopt;
+        }
+        return ehdr(p_image.data());
+    }
+
+    /**
+     * @brief The section header table, including section 0.
+     *
+     * Handles extended numbering (e_shnum == 0 with the real count in
+     * section 0's sh_size). Empty if the table lies outside the image.
+     */
+    [[nodiscard]] static record_span<shdr> sections(
+      std::span<const std::byte> p_image,
+      const ehdr& p_header)
+    {
+        const uint64_t offset = p_header.e_shoff();
+        const size_t stride = p_header.e_shentsize();
+        if (offset == 0 || stride < shdr::size) {
+            return {};
+        }
+
+        uint64_t count = p_header.e_shnum();
+        if (count == 0) {
+            auto first = slice(p_image, offset, shdr::size);
+            if (first.empty()) {
+                return {};
+            }
+            count = shdr(first.data()).sh_size();
+        }
+        if (count == 0 || count > p_image.size() / stride) {
+            return {};
+        }
+        return record_span<shdr>(
+          slice(p_image, offset, (count - 1) * stride + shdr::size), stride);
+    }
+
+    /**
+     * @brief Index of the section name string table, following
+     * SHN_XINDEX to section 0's sh_link.
+     */
+    [[nodiscard]] static size_t name_table_index(
+      const ehdr& p_header,
+      const record_span<shdr>& p_sections)
+    {
+        if (p_header.e_shstrndx() == SHN_XINDEX && !p_sections.empty()) {
+            return p_sections[0].sh_link();
+        }
+        return p_header.e_shstrndx();
+    }
+
+    /**
+     * @brief The program header table. Empty if it lies outside the image.
+     */
+    [[nodiscard]] static record_span<phdr> segments(
+      std::span<const std::byte> p_image,
+      const ehdr& p_header)
+    {
+        const size_t stride = p_header.e_phentsize();
+        const uint64_t count = p_header.e_phnum();
+        if (p_header.e_phoff() == 0 || count == 0 || stride < phdr::size) {
+            return {};
+        }
+        return record_span<phdr>(
+          slice(p_image, p_header.e_phoff(), (count - 1) * stride + phdr::size),
+          stride);
+    }
+};
+
+/**
+ * @brief Reads the class and byte order from e_ident.
+ *
+ * @return std::optional<encoding_s> nullopt unless the image starts with the
+ * ELF magic and names a known class and data encoding.
+ */
+[[nodiscard]] inline std::optional<encoding_s> identify(
+  std::span<const std::byte> p_image)
+{
+    if (p_image.size() < EI_NIDENT) {
+        return std::nullopt;
+    }
+    auto ident = [&p_image](size_t i) {
+        return static_cast<unsigned char>(p_image[i]);
+    };
+    if (ident(EI_MAG0) != ELFMAG0 || ident(EI_MAG1) != ELFMAG1
+        || ident(EI_MAG2) != ELFMAG2 || ident(EI_MAG3) != ELFMAG3) {
+        return std::nullopt;
+    }
+
+    encoding_s encoding;
+    encoding.elf_class = ident(EI_CLASS);
+    if (encoding.elf_class != ELFCLASS32 && encoding.elf_class != ELFCLASS64) {
+        return std::nullopt;
+    }
+    switch (ident(EI_DATA)) {
+        case ELFDATA2LSB:
+            encoding.order = std::endian::little;
+            break;
+        case ELFDATA2MSB:
+            encoding.order = std::endian::big;
+            break;
+        default:
+            return std::nullopt;
+    }
+    return encoding;
+}
+
+/**
+ * @brief Calls p_visitor with the elf_file<Class, Order> matching
+ * p_encoding, so the visitor body is instantiated once per combination.
+ */
+template<class Visitor>
+decltype(auto) visit(encoding_s p_encoding, Visitor&& p_visitor)
+{
+    const bool big = p_encoding.order == std::endian::big;
+    if (p_encoding.elf_class == ELFCLASS32) {
+        if (big) {
+            return p_visitor(elf_file<ELFCLASS32, std::endian::big>{});
+        }
+        return p_visitor(elf_file<ELFCLASS32, std::endian::little>{});
+    }
+    if (big) {
+        return p_visitor(elf_file<ELFCLASS64, std::endian::big>{});
+    }
+    return p_visitor(elf_file<ELFCLASS64, std::endian::little>{});
+}
+
+}  // namespace elf_reader
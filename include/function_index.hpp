@@ -0,0 +1,99 @@
+/**
+ * @file function_index.hpp
+ * @author SAFE Group
+ * @brief Address-ordered function interval index header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <gelf.h>
+
+#include "symbol_table.hpp"
+
+/**
+ * @struct function_extent_s
+ * @brief Address range [start, end) covered by one function symbol.
+ */
+struct function_extent_s
+{
+    uint64_t start;   //!< First address of the function
+    uint64_t end;     //!< One past the last address of the function
+    uint32_t symbol;  //!< Index of the function in the SymbolTable
+    bool inferred;    //!< True when st_size was 0 and end was recovered
+};
+
+/**
+ * @class FunctionIndex
+ * @brief Address-sorted interval index over the defined functions of a
+ * symbol table.
+ *
+ * Built once from a SymbolTable, it answers "which function contains this
+ * address" in O(log n). Many assembly and compiler-generated symbols have an
+ * st_size of 0; their extent is recovered from the start of the next
+ * function, or from the end of the section that contains them when they are
+ * the last function in it.
+ *
+ * Symbols sharing a start address (aliases) are folded into one interval.
+ * The sized, global symbol is preferred as the representative. Extents may
+ * nest or overlap, e.g. a local label symbol inside a hand-written
+ * function; an address past the end of a nested one still belongs to the
+ * function around it.
+ */
+class FunctionIndex
+{
+  public:
+    FunctionIndex() = default;
+
+    /**
+     * @brief Builds the index from all defined STT_FUNC symbols.
+     *
+     * @param p_symbols Symbol table to index. Only symbol indices are kept,
+     * so the table does not need to outlive the index.
+     * @param p_sections Section headers used to bound inferred extents. The
+     * section containing a function is found by address, so any subset of
+     * the file's sections may be given (e.g. only .text).
+     */
+    FunctionIndex(const SymbolTable& p_symbols,
+                  std::span<const GElf_Shdr> p_sections);
+
+    /**
+     * @brief Finds the function whose extent contains p_address.
+     *
+     * @param p_address Virtual address to look up.
+     * @return std::optional<function_extent_s> The containing function that
+     * starts last, or nullopt if the address falls outside every known
+     * function.
+     */
+    [[nodiscard]] std::optional<function_extent_s> function_at(
+      uint64_t p_address) const;
+
+    /**
+     * @brief All indexed functions, sorted by start address.
+     */
+    [[nodiscard]] std::span<const function_extent_s> functions() const noexcept
+    {
+        return m_extents;
+    }
+
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return m_extents.size();
+    }
+
+  private:
+    std::vector<uint64_t> m_starts;  //!< Start addresses, for binary search
+    std::vector<function_extent_s> m_extents;  //!< Matching extents
+    //! Largest end among m_extents[0..i], so lookups past the end of a
+    //! nested function know whether an enclosing one remains
+    std::vector<uint64_t> m_max_ends;
+};
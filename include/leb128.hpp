@@ -0,0 +1,97 @@
+/**
+ * @file leb128.hpp
+ * @author SAFE Group
+ * @brief Header-only word-at-a-time LEB128 decoders
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @namespace leb128
+ * @brief Branch-light LEB128 decoding for numbers of up to 8 bytes.
+ *
+ * Instead of testing the continuation bit of one byte per iteration, the
+ * decoders load 8 bytes as a little-endian word, find the terminating byte
+ * from the clear high bits with one count-trailing-zeros, and compact the
+ * 7-bit groups with three mask-and-shift steps. Callers must guarantee that
+ * 8 bytes are readable and fall back to a byte loop near the end of a
+ * buffer or when the number is longer than 8 bytes (values of 2^56 and
+ * above), which exception tables never contain in practice.
+ */
+namespace leb128 {
+
+/**
+ * @struct decoded_s
+ * @brief A decoded number and the bytes it occupied.
+ */
+struct decoded_s
+{
+    uint64_t value = 0;  //!< Decoded value, sign-extended for signed reads
+    size_t length = 0;   //!< Bytes consumed; 0 if longer than 8 bytes
+};
+
+/**
+ * @brief Loads 8 bytes at p_data in little-endian order.
+ */
+[[nodiscard]] inline uint64_t load_word(const uint8_t* p_data) noexcept
+{
+    uint64_t word = 0;
+    std::memcpy(&word, p_data, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) {
+        word = std::byteswap(word);
+    }
+    return word;
+}
+
+/**
+ * @brief Decodes an unsigned LEB128 number from the 8 bytes at p_data.
+ *
+ * @return decoded_s The value and its length, or a length of 0 if no byte
+ * of the word ends the number.
+ */
+[[nodiscard]] inline decoded_s decode_unsigned(const uint8_t* p_data) noexcept
+{
+    uint64_t word = load_word(p_data);
+    const uint64_t stops = ~word & 0x8080'8080'8080'8080;
+    if (stops == 0) {
+        return {};
+    }
+    // bit 7 of byte k is bit 8k + 7 of the word
+    const auto length = static_cast<size_t>(std::countr_zero(stops) + 1) / 8;
+    if (length < 8) {
+        word &= (uint64_t{ 1 } << (8 * length)) - 1;
+    }
+    word &= 0x7f7f'7f7f'7f7f'7f7f;
+    word = (word & 0x007f'007f'007f'007f) | ((word & 0x7f00'7f00'7f00'7f00) >> 1);
+    word = (word & 0x0000'3fff'0000'3fff) | ((word & 0x3fff'0000'3fff'0000) >> 2);
+    word = (word & 0x0000'0000'0fff'ffff) | ((word & 0x0fff'ffff'0000'0000) >> 4);
+    return { word, length };
+}
+
+/**
+ * @brief Decodes a signed LEB128 number from the 8 bytes at p_data.
+ *
+ * @return decoded_s The sign-extended value and its length, or a length of
+ * 0 if no byte of the word ends the number.
+ */
+[[nodiscard]] inline decoded_s decode_signed(const uint8_t* p_data) noexcept
+{
+    decoded_s decoded = decode_unsigned(p_data);
+    const size_t bits = 7 * decoded.length;
+    if (decoded.length != 0 && (decoded.value >> (bits - 1)) & 1) {
+        decoded.value |= ~uint64_t{ 0 } << bits;
+    }
+    return decoded;
+}
+
+}  // namespace leb128
@@ -0,0 +1,123 @@
+/**
+ * @file loaded_image.hpp
+ * @author SAFE Group
+ * @brief Relocated view of a linked ELF image header file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "elf_parser.hpp"
+
+namespace safe {
+
+/**
+ * @class LoadedImage
+ * @brief Pointer-sized slots of a linked executable or shared object, with
+ * the values the dynamic loader would store in them.
+ *
+ * PIE and shared objects reach typeinfo objects through slots in .got and
+ * .data.rel.ro (e.g. the DW.ref.* entries that DW_EH_PE_indirect type table
+ * entries point to). The file only holds placeholders there; the loader
+ * fills them in from the dynamic relocations. This class applies those
+ * relocations once, at construction, with the image loaded at its link
+ * address:
+ * - R_*_RELATIVE slots hold the addend (or, for REL, the stored value).
+ * - R_*_GLOB_DAT, R_*_JUMP_SLOT and absolute relocations hold the symbol's
+ *   value plus addend, if .dynsym defines the symbol in this image.
+ *
+ * Slots relocated against undefined symbols (typeinfo that lives in
+ * libstdc++, say) or by R_*_IRELATIVE have no value that can be known
+ * statically. Other slots read the bytes of their section.
+ *
+ * Supported machines: EM_X86_64, EM_386, EM_ARM and EM_AARCH64.
+ */
+class LoadedImage
+{
+  public:
+    /**
+     * @brief Applies the dynamic relocations of p_elf.
+     *
+     * @param p_elf Parser over an ET_EXEC or ET_DYN file. Must outlive this
+     * object, whose section data points into its mapping.
+     */
+    explicit LoadedImage(const ElfParser& p_elf);
+
+    /**
+     * @brief Reads the pointer at p_address, as relocated by the loader.
+     *
+     * @param p_address Link-time address of a pointer-sized slot.
+     * @return std::optional<uint64_t> The pointer, or nullopt if the slot
+     * lies outside every allocated section, is null, or is relocated against
+     * a symbol this image does not define.
+     */
+    [[nodiscard]] std::optional<uint64_t> read_pointer(
+      uint64_t p_address) const;
+
+    /**
+     * @brief Size of a pointer in bytes: 4 for ELFCLASS32, 8 for ELFCLASS64.
+     */
+    [[nodiscard]] size_t pointer_size() const noexcept
+    {
+        return m_encoding.elf_class == ELFCLASS32 ? 4 : 8;
+    }
+
+    /**
+     * @brief Number of distinct slots written by dynamic relocations.
+     */
+    [[nodiscard]] size_t relocated_slots() const noexcept
+    {
+        return m_slots.size();
+    }
+
+    /**
+     * @brief Number of those slots whose value cannot be known statically.
+     */
+    [[nodiscard]] size_t unresolved_slots() const noexcept
+    {
+        return m_unresolved_slots;
+    }
+
+  private:
+    /**
+     * @struct segment_s
+     * @brief An allocated section at its link address.
+     */
+    struct segment_s
+    {
+        uint64_t address;                  //!< sh_addr
+        uint64_t size;                     //!< sh_size
+        std::span<const std::byte> data;  //!< Empty for SHT_NOBITS
+    };
+
+    /**
+     * @struct slot_s
+     * @brief A pointer written by a dynamic relocation.
+     */
+    struct slot_s
+    {
+        uint64_t address;               //!< r_offset
+        std::optional<uint64_t> value;  //!< nullopt if unknowable
+    };
+
+    void m_load_segments(const ElfParser& p_elf);
+    void m_load_relocations(const ElfParser& p_elf);
+    std::optional<uint64_t> m_stored_pointer(uint64_t p_address) const;
+
+    elf_reader::encoding_s m_encoding;
+    std::vector<segment_s> m_segments;  //!< Sorted by address
+    std::vector<slot_s> m_slots;        //!< Sorted by address, unique
+    size_t m_unresolved_slots = 0;
+};
+
+}  // namespace safe
@@ -0,0 +1,78 @@
+/**
+ * @file mapped_file.hpp
+ * @author SAFE Group
+ * @brief Read-only memory mapping of a whole file header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+/**
+ * @class MappedFile
+ * @brief Owns a read-only, private mapping of a whole file.
+ *
+ * The mapping and the file descriptor are released by the destructor. Moving
+ * transfers ownership; the moved-from object is empty.
+ */
+class MappedFile
+{
+  public:
+    MappedFile() = default;
+
+    /**
+     * @brief Opens and maps p_path.
+     *
+     * @param p_path Path of the file to map.
+     * @param p_random_access Advise the kernel that the mapping is read at
+     * random, so it does not read ahead into parts that are never touched.
+     * @return std::expected<MappedFile, std::system_error> The mapping, or
+     * the failing step ("Open failed.", "Stat failed.", "File is empty.",
+     * "Mmap failed.") with its errno.
+     */
+    static std::expected<MappedFile, std::system_error> open(
+      std::string_view p_path,
+      bool p_random_access = false);
+
+    MappedFile(MappedFile&& p_other) noexcept;
+    MappedFile& operator=(MappedFile&& p_other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    /**
+     * @brief The mapped bytes; empty for a default-constructed object.
+     */
+    [[nodiscard]] std::span<const std::byte> bytes() const noexcept
+    {
+        return { m_data, m_size };
+    }
+
+    /**
+     * @brief Drops the resident pages of p_bytes from memory.
+     *
+     * The mapping is read-only and private, so released pages are read back
+     * from the file on the next access; this only lowers the resident set.
+     * Pages only partly covered by p_bytes are kept, as are bytes outside
+     * the mapping.
+     *
+     * @param p_bytes A range of bytes(), typically one that has been consumed.
+     */
+    void release(std::span<const std::byte> p_bytes) const noexcept;
+
+  private:
+    void m_release() noexcept;
+
+    int m_file = -1;             //!< File descriptor of the mapped file.
+    std::byte* m_data = nullptr;  //!< Start of the mapping.
+    size_t m_size = 0;            //!< Size of the mapping in bytes.
+};
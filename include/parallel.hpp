@@ -0,0 +1,104 @@
+/**
+ * @file parallel.hpp
+ * @author SAFE Group
+ * @brief Minimal fork-join helpers shared by the analysis passes
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace safe {
+
+/**
+ * @brief Number of worker threads to use for p_count independent tasks.
+ *
+ * @param p_count Number of tasks.
+ * @param p_max_threads Upper bound on workers; 0 means the hardware
+ * concurrency.
+ * @return size_t At least 1 and at most p_count (when p_count > 0).
+ */
+inline size_t worker_count(size_t p_count, size_t p_max_threads = 0)
+{
+    size_t limit = p_max_threads;
+    if (limit == 0) {
+        limit = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    return std::max<size_t>(1, std::min(limit, p_count));
+}
+
+/**
+ * @brief Calls p_body(i) for every i in [0, p_count) on a pool of threads.
+ *
+ * Indices are handed out one at a time from a shared counter, so uneven task
+ * sizes balance across workers. Returns once every call has finished. If any
+ * call throws, the remaining indices are skipped and the first exception is
+ * rethrown on the calling thread.
+ *
+ * @param p_count Number of indices.
+ * @param p_body Callable taking a size_t; called concurrently, so it must
+ * only touch shared state that is safe to share.
+ * @param p_max_threads Upper bound on workers; 0 means the hardware
+ * concurrency. With one worker everything runs on the calling thread.
+ */
+template<class Body>
+void parallel_for(size_t p_count, Body&& p_body, size_t p_max_threads = 0)
+{
+    const size_t workers = worker_count(p_count, p_max_threads);
+    if (workers <= 1) {
+        for (size_t i = 0; i < p_count; i++) {
+            p_body(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{ 0 };
+    std::atomic<bool> failed{ false };
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    auto run = [&] {
+        while (!failed.load(std::memory_order_relaxed)) {
+            const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= p_count) {
+                return;
+            }
+            try {
+                p_body(i);
+            } catch (...) {
+                std::lock_guard lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t t = 1; t < workers; t++) {
+        threads.emplace_back(run);
+    }
+    run();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace safe
@@ -0,0 +1,175 @@
+/**
+ * @file relocatable.hpp
+ * @author SAFE Group
+ * @brief Relocatable (ET_REL) object loading header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "elf_parser.hpp"
+
+namespace safe {
+
+/**
+ * @struct comdat_group_s
+ * @brief A COMDAT section group (SHT_GROUP with GRP_COMDAT).
+ *
+ * The linker keeps the first group with a given signature and discards the
+ * others, which is how inline functions and template instantiations emitted
+ * by several translation units end up in the program once.
+ */
+struct comdat_group_s
+{
+    std::string signature;           //!< Name of the signature symbol
+    std::vector<uint32_t> sections;  //!< Indices of the member sections
+};
+
+/**
+ * @class RelocatableObject
+ * @brief Lays out the allocated sections of an ET_REL object and applies its
+ * relocations, so the object can be analyzed like a linked binary.
+ *
+ * Compilers emit one section per function under -ffunction-sections or for
+ * COMDAT code (".text._Z3foov", ".gcc_except_table._Z3foov"), and every
+ * reference between them is left to the linker. This class assigns the
+ * sections synthetic addresses, starting at base_address in the order
+ * executable sections, exception tables, other data, then SHT_NOBITS, and
+ * patches the section bytes with the resolved relocations. Symbol values
+ * are rebased onto those addresses.
+ *
+ * Undefined and common symbols, and symbols defined in discarded COMDAT
+ * sections, each get a 16-byte slot after the last section, shared by all
+ * references to the same name. A reference to an external typeinfo object
+ * therefore lands on that symbol's value, which is what Validator matches.
+ *
+ * Supported relocations:
+ * - EM_X86_64: 64, PC64, 32, 32S, PC32, PLT32 and the GOTPCREL family. GOT
+ *   loads are resolved to the symbol itself, as linker relaxation would.
+ * - EM_ARM: ABS32, REL32, PREL31, CALL, JUMP24, PC24, THM_CALL and
+ *   THM_JUMP24. TARGET1 and TARGET2 are resolved as ABS32, which is what
+ *   bare-metal (arm-none-eabi) links use.
+ *
+ * Other relocations are left unapplied and counted.
+ */
+class RelocatableObject
+{
+  public:
+    /**
+     * @brief First synthetic section address.
+     */
+    static constexpr uint64_t base_address = 0x10000;
+
+    /**
+     * @brief Collects the COMDAT groups of p_elf, in section order.
+     *
+     * @param p_elf Parser over an ET_REL object.
+     * @return std::vector<comdat_group_s> Groups with their signatures;
+     * empty if the object has none.
+     */
+    [[nodiscard]] static std::vector<comdat_group_s> comdat_groups(
+      const ElfParser& p_elf);
+
+    /**
+     * @brief Lays out and relocates p_elf.
+     *
+     * @param p_elf Parser over an ET_REL object. Only read during
+     * construction.
+     * @param p_discarded_groups Signatures of COMDAT groups that another
+     * object already provides. Their sections are dropped and symbols
+     * defined in them become external.
+     */
+    explicit RelocatableObject(
+      const ElfParser& p_elf,
+      const std::unordered_set<std::string>& p_discarded_groups = {});
+
+    /**
+     * @brief Symbol table with values rebased onto the synthetic layout.
+     *
+     * Indexed like the object's .symtab. Symbols resolved to an external
+     * slot keep shndx SHN_UNDEF.
+     */
+    [[nodiscard]] std::span<const symbol_s> symbols() const noexcept
+    {
+        return m_symbols;
+    }
+
+    /**
+     * @brief All executable sections as one relocated section.
+     *
+     * The header has sh_addr set to base_address and the EXECINSTR flag, so
+     * it can be handed to Validator in place of a linked .text. The data
+     * stays valid for the lifetime of this object.
+     */
+    [[nodiscard]] section_view_s text() const;
+
+    /**
+     * @brief All .gcc_except_table sections as one relocated section.
+     *
+     * The data is empty if the object has no exception tables.
+     */
+    [[nodiscard]] section_view_s except_table() const;
+
+    /**
+     * @brief Synthetic address of section p_index.
+     *
+     * @return std::optional<uint64_t> The address, or nullopt if the section
+     * is not allocated or was discarded.
+     */
+    [[nodiscard]] std::optional<uint64_t> section_address(
+      size_t p_index) const;
+
+    /**
+     * @brief Number of relocations that were left unapplied because of an
+     * unsupported type or an out-of-range offset.
+     */
+    [[nodiscard]] size_t unsupported_relocations() const noexcept
+    {
+        return m_unsupported_relocations;
+    }
+
+    /**
+     * @brief Number of sections dropped as duplicate COMDAT members.
+     */
+    [[nodiscard]] size_t discarded_sections() const noexcept
+    {
+        return m_discarded_sections;
+    }
+
+  private:
+    void m_layout(const ElfParser& p_elf,
+                  const std::vector<bool>& p_discarded);
+    void m_resolve_symbols(const ElfParser& p_elf,
+                           const std::vector<bool>& p_discarded);
+    void m_relocate(const ElfParser& p_elf);
+    uint64_t m_slot(const std::string& p_name);
+    section_view_s m_view(uint64_t p_begin,
+                          uint64_t p_end,
+                          uint64_t p_flags) const;
+
+    std::vector<std::byte> m_image;  //!< Bytes from base_address onward
+    std::vector<std::optional<uint64_t>> m_addresses;  //!< By section index
+    uint64_t m_text_end = base_address;
+    uint64_t m_except_begin = base_address;
+    uint64_t m_except_end = base_address;
+    uint64_t m_next_slot = base_address;  //!< Next free external slot
+    std::unordered_map<std::string, uint64_t> m_slots;  //!< Name -> slot
+    std::vector<symbol_s> m_symbols;
+    size_t m_unsupported_relocations = 0;
+    size_t m_discarded_sections = 0;
+};
+
+}  // namespace safe
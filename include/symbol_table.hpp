@@ -0,0 +1,295 @@
+/**
+ * @file symbol_table.hpp
+ * @author SAFE Group
+ * @brief Compact structure-of-arrays ELF symbol table header file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "elf_reader.hpp"
+
+struct symbol_s;
+
+/**
+ * @class ElfHashTable
+ * @brief Read-only view over a binary's own .gnu.hash or SysV .hash section.
+ *
+ * Both tables index the dynamic symbol table they are linked to (sh_link),
+ * so lookups resolve names against that table's name column. The section
+ * bytes must outlive the view.
+ */
+class ElfHashTable
+{
+  public:
+    /**
+     * @brief Creates a view over a .gnu.hash section.
+     *
+     * @param p_section Raw section bytes.
+     * @param p_bloom_word_size Size of one bloom filter word: 8 for ELFCLASS64
+     * and 4 for ELFCLASS32.
+     * @param p_order Byte order of the file.
+     * @return std::optional<ElfHashTable> The view, or nullopt if the section
+     * is too small for the sizes in its header.
+     */
+    static std::optional<ElfHashTable> gnu(
+      std::span<const std::byte> p_section,
+      size_t p_bloom_word_size,
+      std::endian p_order = std::endian::native);
+
+    /**
+     * @brief Creates a view over a SysV .hash section.
+     *
+     * @param p_section Raw section bytes.
+     * @param p_order Byte order of the file.
+     * @return std::optional<ElfHashTable> The view, or nullopt if the section
+     * is too small for the sizes in its header.
+     */
+    static std::optional<ElfHashTable> sysv(
+      std::span<const std::byte> p_section,
+      std::endian p_order = std::endian::native);
+
+    /**
+     * @brief Looks up a symbol name.
+     *
+     * @param p_name Symbol name to find.
+     * @param p_names Name column of the dynamic symbol table this hash
+     * section is linked to.
+     * @return std::optional<uint32_t> Index of the symbol, or nullopt. For
+     * .gnu.hash only defined symbols are hashed, so undefined symbols are
+     * never found.
+     */
+    [[nodiscard]] std::optional<uint32_t> find(
+      std::string_view p_name,
+      std::span<const std::string_view> p_names) const;
+
+    /**
+     * @brief Hash function used by .gnu.hash (DJB, h * 33 + c).
+     */
+    [[nodiscard]] static uint32_t gnu_hash(std::string_view p_name);
+
+    /**
+     * @brief Hash function used by SysV .hash.
+     */
+    [[nodiscard]] static uint32_t sysv_hash(std::string_view p_name);
+
+  private:
+    ElfHashTable() = default;
+
+    uint32_t m_word(size_t p_offset) const;
+    uint64_t m_bloom_word(size_t p_index) const;
+
+    std::span<const std::byte> m_section;  //!< Raw hash section bytes
+    bool m_is_gnu = false;                 //!< .gnu.hash or SysV .hash
+    bool m_swap = false;                   //!< File is not host byte order
+    uint32_t m_bucket_count = 0;           //!< nbucket
+    uint32_t m_chain_count = 0;            //!< nchain (SysV only)
+    uint32_t m_symbol_offset = 0;          //!< symoffset (GNU only)
+    uint32_t m_bloom_size = 0;             //!< Bloom words (GNU only)
+    uint32_t m_bloom_shift = 0;            //!< Bloom shift (GNU only)
+    size_t m_bloom_word_size = 0;          //!< Bytes per bloom word
+    size_t m_buckets_offset = 0;           //!< Byte offset of bucket[0]
+    size_t m_chain_offset = 0;             //!< Byte offset of chain[0]
+};
+
+/**
+ * @class SymbolTable
+ * @brief Structure-of-arrays view of an ELF symbol table.
+ *
+ * Every symbol field lives in its own contiguous column, indexed by the
+ * symbol's position in the original table. Names are string_views into the
+ * retained string table (or into the strings of the symbol_s records the
+ * table was built from), so building the table allocates one array per
+ * column and no per-symbol strings.
+ *
+ * Filters such as "defined STT_FUNC" only touch the info and shndx columns,
+ * which keeps them to tight linear scans over small integers.
+ *
+ * Name lookups through find() are O(1): either through the binary's own
+ * .gnu.hash / .hash section given at construction, or through an
+ * open-addressing hash over the name column built once by the constructor.
+ *
+ * @note Every name view is followed by a NUL byte in its backing storage, so
+ * name(i).data() may be passed to C APIs such as abi::__cxa_demangle().
+ */
+class SymbolTable
+{
+  public:
+    SymbolTable() = default;
+
+    /**
+     * @brief Decodes a raw ELF symbol table section.
+     *
+     * Records are read in place in the file's class and byte order. Names
+     * are resolved against p_strtab and kept as views into it; the string
+     * table bytes must outlive this object. Names whose offset lies outside
+     * the string table decode as empty.
+     *
+     * @param p_symtab Raw bytes of the .symtab (or .dynsym) section.
+     * @param p_entsize Size of one symbol record (sh_entsize).
+     * @param p_strtab Raw bytes of the linked string table.
+     * @param p_encoding ELF class and byte order of the file.
+     * @param p_hash The binary's hash section for this table, if any. When
+     * given, find() uses it and no name index is built.
+     */
+    SymbolTable(std::span<const std::byte> p_symtab,
+                size_t p_entsize,
+                std::span<const std::byte> p_strtab,
+                elf_reader::encoding_s p_encoding = {},
+                std::optional<ElfHashTable> p_hash = std::nullopt);
+
+    /**
+     * @brief Builds the columns from existing symbol_s records.
+     *
+     * Names are views into the records' strings, which must outlive this
+     * object.
+     *
+     * @param p_symbols Symbol records to index.
+     */
+    explicit SymbolTable(std::span<const symbol_s> p_symbols);
+
+    /**
+     * @brief Number of symbols in the table, including the null symbol.
+     */
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return m_names.size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return m_names.empty();
+    }
+
+    [[nodiscard]] std::string_view name(size_t p_index) const
+    {
+        return m_names[p_index];
+    }
+
+    [[nodiscard]] uint64_t value(size_t p_index) const
+    {
+        return m_values[p_index];
+    }
+
+    [[nodiscard]] uint64_t symbol_size(size_t p_index) const
+    {
+        return m_sizes[p_index];
+    }
+
+    [[nodiscard]] unsigned char info(size_t p_index) const
+    {
+        return m_infos[p_index];
+    }
+
+    [[nodiscard]] unsigned char other(size_t p_index) const
+    {
+        return m_others[p_index];
+    }
+
+    [[nodiscard]] uint16_t shndx(size_t p_index) const
+    {
+        return m_shndx[p_index];
+    }
+
+    /**
+     * @brief Column accessors for callers that scan a whole field.
+     */
+    [[nodiscard]] std::span<const std::string_view> names() const noexcept
+    {
+        return m_names;
+    }
+
+    [[nodiscard]] std::span<const uint64_t> values() const noexcept
+    {
+        return m_values;
+    }
+
+    [[nodiscard]] std::span<const uint64_t> sizes() const noexcept
+    {
+        return m_sizes;
+    }
+
+    [[nodiscard]] std::span<const unsigned char> infos() const noexcept
+    {
+        return m_infos;
+    }
+
+    [[nodiscard]] std::span<const uint16_t> section_indices() const noexcept
+    {
+        return m_shndx;
+    }
+
+    /**
+     * @brief Finds a symbol by name in O(1).
+     *
+     * @param p_name Exact (mangled) symbol name.
+     * @return std::optional<uint32_t> Index of the first symbol with that
+     * name, or nullopt if there is none.
+     */
+    [[nodiscard]] std::optional<uint32_t> find(std::string_view p_name) const;
+
+    /**
+     * @brief Materializes a single owning symbol_s record.
+     *
+     * @param p_index Index of the symbol.
+     * @return symbol_s A copy of the symbol with an owning name.
+     */
+    [[nodiscard]] symbol_s to_symbol(size_t p_index) const;
+
+    /**
+     * @brief Collects the indices of all defined symbols of one type.
+     *
+     * A symbol matches when ELF_ST_TYPE(info) equals p_type and shndx is not
+     * SHN_UNDEF. Only the info and shndx columns are read.
+     *
+     * @param p_type Symbol type, e.g. STT_FUNC or STT_OBJECT.
+     * @return std::vector<uint32_t> Matching symbol indices in table order.
+     */
+    [[nodiscard]] std::vector<uint32_t> defined_of_type(
+      unsigned char p_type) const;
+
+    /**
+     * @brief Collects the indices of all symbols whose name starts with
+     * p_prefix, in table order.
+     */
+    [[nodiscard]] std::vector<uint32_t> with_prefix(
+      std::string_view p_prefix) const;
+
+  private:
+    /**
+     * @brief One open-addressing slot: the name hash and index + 1 of the
+     * symbol, 0 marking an empty slot.
+     */
+    struct name_slot_s
+    {
+        uint32_t hash;
+        uint32_t index_plus_one;
+    };
+
+    void m_reserve(size_t p_count);
+    void m_build_name_index();
+
+    std::vector<std::string_view> m_names;  //!< Views into the string table
+    std::vector<uint64_t> m_values;         //!< st_value
+    std::vector<uint64_t> m_sizes;          //!< st_size
+    std::vector<unsigned char> m_infos;     //!< st_info (type and binding)
+    std::vector<unsigned char> m_others;    //!< st_other (visibility)
+    std::vector<uint16_t> m_shndx;          //!< st_shndx
+
+    std::optional<ElfHashTable> m_hash;     //!< Binary's own hash section
+    std::vector<name_slot_s> m_name_slots;  //!< Own name index (linear probe)
+    unsigned m_slot_shift = 64;             //!< 64 - log2(slot count)
+};
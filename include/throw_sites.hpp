@@ -0,0 +1,108 @@
+/**
+ * @file throw_sites.hpp
+ * @author SAFE Group
+ * @brief Typeinfo and exception size of each __cxa_throw call header file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "elf_parser.hpp"
+#include "symbol_table.hpp"
+
+namespace safe {
+
+/**
+ * @struct throw_site_s
+ * @brief A call to __cxa_throw and the arguments recovered for it.
+ */
+struct throw_site_s
+{
+    uint64_t function = 0;  //!< Start of the function making the call
+    uint64_t call = 0;      //!< Address of the call instruction
+    //! Address of the typeinfo passed in rsi; nullopt when it is loaded
+    //! from a GOT slot or could not be recovered
+    std::optional<uint64_t> typeinfo;
+    //! Mangled typeinfo symbol, e.g. _ZTIi; empty if unknown
+    std::string_view typeinfo_name;
+    //! Bytes passed to the __cxa_allocate_exception before the call
+    std::optional<uint64_t> exception_size;
+
+    /**
+     * @brief Whether the thrown type is known.
+     */
+    [[nodiscard]] bool resolved() const noexcept
+    {
+        return !typeinfo_name.empty();
+    }
+};
+
+/**
+ * @struct throw_site_report_s
+ * @brief Every __cxa_throw call of an image.
+ */
+struct throw_site_report_s
+{
+    bool supported = false;  //!< Whether the machine's code was decoded
+    std::vector<throw_site_s> sites;  //!< By function, then by call address
+    size_t functions = 0;     //!< Functions decoded: those with a throw site
+    uint64_t decoded_bytes = 0;  //!< Code bytes the decoder went through
+    size_t unresolved = 0;    //!< Sites whose thrown type is unknown
+};
+
+/**
+ * @struct throw_site_options_s
+ * @brief How find_throw_sites() walks the code.
+ */
+struct throw_site_options_s
+{
+    //! Scan each code section in windows of about this many bytes, cut at
+    //! function boundaries; 0 scans a section at once
+    size_t window_size = 0;
+    //! Called with the bytes of each window once its throw sites are
+    //! decoded, so the caller can drop them from memory
+    std::function<void(std::span<const std::byte>)> release = nullptr;
+};
+
+/**
+ * @brief Finds each call to __cxa_throw in p_elf and recovers the typeinfo
+ * it throws and the size of the exception object.
+ *
+ * The calls are located by their call rel32 or call *slot(%rip) encoding,
+ * direct or through the PLT, and only the functions holding one are
+ * decoded. From each call, the typeinfo is sliced backward within the basic
+ * block through the register copies feeding rsi, down to the lea, load from
+ * a GOT slot or immediate that defines it. Blocks start at the branch
+ * targets found in the function and after jmp, ret and __cxa_throw; jump
+ * table targets are not known. The exception size is the edi immediate of
+ * the last __cxa_allocate_exception call before the throw, if no other
+ * throw comes in between.
+ *
+ * Only EM_X86_64 code is decoded; ARM passes the typeinfo in r1, which is
+ * left to an ARM decoder.
+ *
+ * @param p_elf Parser over an ET_EXEC or ET_DYN file.
+ * @param p_symbols Symbols naming its functions and typeinfo objects. Both
+ * must outlive the report, whose names point into them.
+ * @param p_options Windowing of the scan. A window is scanned and its
+ * throwing functions decoded before the next one is touched.
+ * @return throw_site_report_s
+ */
+[[nodiscard]] throw_site_report_s find_throw_sites(
+  const ElfParser& p_elf,
+  const SymbolTable& p_symbols,
+  const throw_site_options_s& p_options = {});
+
+}  // namespace safe
@@ -0,0 +1,207 @@
+/**
+ * @file throw_summary.hpp
+ * @author SAFE Group
+ * @brief Call graph and may-throw summary of a linked image header file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "elf_parser.hpp"
+#include "elf_reader.hpp"
+#include "function_index.hpp"
+#include "symbol_table.hpp"
+#include "x86_decoder.hpp"
+
+namespace safe {
+
+/**
+ * @struct machine_call_s
+ * @brief A call, or tail call, found in the code of an image.
+ */
+struct machine_call_s
+{
+    uint64_t address = 0;         //!< First byte of the instruction
+    uint64_t return_address = 0;  //!< Byte after it
+    //! Called function or PLT entry; for calls through a GOT slot, the slot.
+    //! nullopt for calls through a register or computed address, and for
+    //! calls and jumps into no known function.
+    std::optional<uint64_t> target;
+    bool tail = false;  //!< A jmp or jcc out of the function, not a call
+};
+
+/**
+ * @struct external_targets_s
+ * @brief Where the calls of an image into other objects go.
+ */
+struct external_targets_s
+{
+    //! PLT entries and GOT slots, by address, to the symbol they reach
+    std::unordered_map<uint64_t, std::string_view> names;
+    std::vector<std::pair<uint64_t, uint64_t>> plt;  //!< PLT sections
+
+    /**
+     * @brief Whether p_address lies in a PLT section.
+     */
+    [[nodiscard]] bool in_plt(uint64_t p_address) const;
+};
+
+/**
+ * @brief Names the PLT entries and GOT slots of p_elf from their
+ * R_X86_64_JUMP_SLOT and GLOB_DAT relocations.
+ *
+ * @param p_elf Parser over an ET_EXEC or ET_DYN file. The names point into
+ * its dynamic symbol table.
+ * @return external_targets_s Empty without a dynamic symbol table.
+ */
+[[nodiscard]] external_targets_s load_external_targets(
+  const ElfParser& p_elf);
+
+/**
+ * @brief Reads the rel32 displacement of an x86-64 call, jmp or
+ * RIP-relative operand, which may be unaligned.
+ */
+[[nodiscard]] inline int32_t read_rel32(const std::byte* p_data)
+{
+    return elf_reader::load<int32_t, std::endian::little>(p_data);
+}
+
+/**
+ * @class ThrowSummary
+ * @brief Which functions of an image may let an exception escape.
+ *
+ * The calls are found by decoding every function with sweep_x86_64(): call
+ * rel32 to the start of a function or a PLT entry, indirect calls and jumps
+ * (0xff /2 to /5), and jmp or jcc, rel8 or rel32, leaving the function.
+ * Such a jump, to a .cold part say, is a tail call of the function it lands
+ * in. PLT entries and calls and jumps through GOT slots are named from their
+ * R_X86_64_JUMP_SLOT and GLOB_DAT relocations; any other indirect call or
+ * jump, jump tables included, may throw.
+ *
+ * A function may throw if it calls __cxa_throw, __cxa_rethrow or
+ * _Unwind_RaiseException, makes an indirect call, calls an external C++
+ * (mangled) function, or calls a function that may throw, and the
+ * exception can leave it from that call:
+ * - a function without an FDE stops the unwinder,
+ * - a function with an LSDA calls std::terminate for calls no call site
+ *   covers (noexcept functions),
+ * - everything else, caught or not, is assumed to escape.
+ *
+ * External C functions are assumed not to throw, except the few that call
+ * back into user code (qsort, bsearch, pthread_once). Calls to
+ * _Unwind_Resume continue an exception that one of the function's calls
+ * already raised and add nothing. Forced unwinding by pthread_cancel is not
+ * modelled.
+ *
+ * Only EM_X86_64 code is scanned; on other machines every function may
+ * throw.
+ */
+class ThrowSummary
+{
+  public:
+    /**
+     * @brief Scans the code of p_elf and computes the summary.
+     *
+     * @param p_elf Parser over an ET_EXEC or ET_DYN file.
+     * @param p_symbols Symbols naming its functions. Both must outlive this
+     * object, whose names point into them.
+     */
+    ThrowSummary(const ElfParser& p_elf, const SymbolTable& p_symbols);
+
+    /**
+     * @brief Whether the machine's code could be scanned.
+     */
+    [[nodiscard]] bool supported() const noexcept
+    {
+        return m_supported;
+    }
+
+    /**
+     * @brief Whether an exception may escape the function at p_function.
+     *
+     * @return true also for addresses that start no known function.
+     */
+    [[nodiscard]] bool may_throw(uint64_t p_function) const;
+
+    /**
+     * @brief Whether an exception may escape the callee of p_call.
+     */
+    [[nodiscard]] bool may_throw(const machine_call_s& p_call) const;
+
+    /**
+     * @brief The calls whose return address lies in (p_begin, p_end], that
+     * is, the calls an LSDA call site [p_begin, p_end) covers.
+     *
+     * @return std::span<const machine_call_s> Sorted by return address.
+     */
+    [[nodiscard]] std::span<const machine_call_s> calls_returning_in(
+      uint64_t p_begin,
+      uint64_t p_end) const;
+
+    /**
+     * @brief Symbol or PLT name of the callee of p_call, empty if unknown.
+     */
+    [[nodiscard]] std::string_view callee_name(
+      const machine_call_s& p_call) const;
+
+    /**
+     * @brief Every call found, sorted by return address.
+     */
+    [[nodiscard]] std::span<const machine_call_s> calls() const noexcept
+    {
+        return m_calls;
+    }
+
+    /**
+     * @brief The functions the summary is over.
+     */
+    [[nodiscard]] const FunctionIndex& functions() const noexcept
+    {
+        return m_functions;
+    }
+
+  private:
+    /**
+     * @struct unwind_info_s
+     * @brief What the unwind tables say about one function.
+     */
+    struct unwind_info_s
+    {
+        bool has_fde = true;    //!< Assumed when .eh_frame is unusable
+        bool has_lsda = false;  //!< Calls no call site covers terminate
+        //! [start, end) of the LSDA call sites, absolute and sorted
+        std::vector<std::pair<uint64_t, uint64_t>> call_sites;
+    };
+
+    void m_scan_code(const ElfParser& p_elf);
+    void m_record_transfer(const function_extent_s& p_function,
+                           const x86_instruction_s& p_instruction);
+    void m_load_unwind_info(const ElfParser& p_elf,
+                            std::vector<unwind_info_s>& p_info) const;
+    void m_propagate(const std::vector<unwind_info_s>& p_info);
+    std::optional<size_t> m_function_starting_at(uint64_t p_address) const;
+    std::optional<size_t> m_function_containing(uint64_t p_address) const;
+
+    const SymbolTable* m_symbols;
+    FunctionIndex m_functions;
+    bool m_supported = false;
+    external_targets_s m_external;  //!< PLT entries and GOT slots
+    std::vector<machine_call_s> m_calls;  //!< Sorted by return address
+    std::vector<bool> m_may_throw;        //!< Per m_functions entry
+};
+
+}  // namespace safe
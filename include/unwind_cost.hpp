@@ -0,0 +1,72 @@
+/**
+ * @file unwind_cost.hpp
+ * @author SAFE Group
+ * @brief Per-function CFA interpretation cost of an unwind step header file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "eh_frame.hpp"
+#include "elf_parser.hpp"
+
+namespace safe {
+
+/**
+ * @struct unwind_cost_s
+ * @brief Worst-case cost of unwinding through one function.
+ */
+struct unwind_cost_s
+{
+    uint64_t pc_begin = 0;         //!< Start of the function
+    uint64_t pc_end = 0;           //!< One past its last instruction
+    size_t cie_instructions = 0;   //!< Initial instructions, run every step
+    size_t worst_instructions = 0;  //!< CIE and FDE instructions, worst case
+    uint64_t worst_pc = 0;          //!< Return address of that worst case
+    //! LSDA call sites examined; 0 if the function has no LSDA, in which
+    //! case the worst case assumes a call at its last instruction
+    size_t call_sites = 0;
+};
+
+/**
+ * @struct unwind_cost_report_s
+ * @brief Cost of every function with an FDE.
+ */
+struct unwind_cost_report_s
+{
+    std::vector<unwind_cost_s> functions;  //!< Costliest first
+    size_t undecodable = 0;  //!< FDEs whose CFA program or LSDA is malformed
+};
+
+/**
+ * @brief Measures how many CFA instructions the unwinder interprets for one
+ * step through each function, at the costliest place it can be called from.
+ *
+ * Each call site of a function's LSDA can be the return address of the
+ * frame being unwound. The unwinder interprets the CIE's initial
+ * instructions and the FDE's up to that address
+ * (EhFrame::cfa_instruction_counts), so the cost only grows towards the
+ * end of a call site: the end of every call site is measured and the
+ * maximum kept. Functions without an LSDA are only unwound through, from
+ * any call they make, and are charged their whole CFA program.
+ *
+ * @param p_eh_frame Index of .eh_frame.
+ * @param p_except_table The .gcc_except_table section, if any.
+ * @param p_pointer_size Width of DW_EH_PE_absptr in the LSDAs.
+ * @return unwind_cost_report_s Functions sorted by worst_instructions.
+ */
+[[nodiscard]] unwind_cost_report_s profile_unwind_cost(
+  const EhFrame& p_eh_frame,
+  std::optional<section_view_s> p_except_table,
+  uint8_t p_pointer_size = 8);
+
+}  // namespace safe
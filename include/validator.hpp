@@ -1,13 +1,16 @@
 #pragma once
-#include <cxxabi.h>
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cstdint>
 #include <cstdlib>
 #include <expected>
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <optional>
 #include <print>
 #include <span>
@@ -18,8 +21,15 @@
 #include <vector>
 
 #include "abi_parse.hpp"
+#include "arm_exidx.hpp"
+#include "demangle.hpp"
+#include "eh_frame.hpp"
 #include "elf_parser.hpp"
+#include "function_index.hpp"
 #include "gelf.h"
+#include "symbol_table.hpp"
+#include "throw_sites.hpp"
+#include "x86_decoder.hpp"
 
 namespace safe {
 
@@ -38,7 +48,7 @@ struct CatchRecord
     HandlerType kind;           // Catch / Cleanup / Filter
     std::uint64_t range_begin;  // scope.start
     std::uint64_t range_end;    // scope.end
-    std::uint64_t landing_pad;  // handler.landing_pad
+    std::uint64_t landing_pad;  // scope.landing_pad
     std::int64_t type_index;    // handler.type_index
 };
 
@@ -48,18 +58,65 @@ struct ThrowCatchMatch
     std::vector<const CatchRecord*> handlers; // matching catch handlers
 };
 
+struct validator_options_s
+{
+    // Write ../logs/function_binary.txt and ../logs/RTTI_typeinfo.txt. The
+    // paths are shared, so turn this off when several Validators run at once.
+    bool write_logs = true;
+
+    // Scan .text in windows of at most this many bytes, cut at function
+    // boundaries, instead of in symbol table order. 0 disables windowing.
+    std::size_t window_size = 0;
+
+    // Called with the bytes of each window once find_thrown_functions() is
+    // done with them, so the caller can drop them from memory.
+    std::function<void(std::span<const std::byte>)> release = nullptr;
+
+    // e_machine of the image. x86-64 code is decoded instruction by
+    // instruction and only its RIP-relative operands and call/jmp rel32
+    // targets are looked up; ARM code loads addresses from literal pools, so
+    // its aligned words are looked up; other machines keep the byte-by-byte
+    // scan.
+    std::uint16_t machine = EM_X86_64;
+
+    // Byte order of the image, which the ARM literal pool words are in.
+    std::endian order = std::endian::little;
+};
+
 class Validator
 {
   public:
-    Validator(std::span<symbol_s> p_sym, section_s p_text)
-      : m_sym(p_sym)
-      , m_text(std::move(p_text))
+    Validator(const SymbolTable& p_sym,
+              section_view_s p_text,
+              validator_options_s p_options = {})
+      : m_sym(&p_sym)
+      , m_text(p_text)
+      , m_options(p_options)
     {
-        std::filesystem::create_directories("../logs");
-        std::ofstream out("../logs/function_binary.txt");
-        out.close();
-        collect_rtti_sym();
+        initialize();
     }
+    // symbol_s variant: indexes the records in a table of its own
+    Validator(std::span<const symbol_s> p_sym,
+              section_view_s p_text,
+              validator_options_s p_options = {})
+      : m_owned_sym(std::in_place, p_sym)
+      , m_sym(&*m_owned_sym)
+      , m_text(p_text)
+      , m_options(p_options)
+    {
+        initialize();
+    }
+    // owning variant: keeps its own copy of the .text bytes
+    Validator(std::span<const symbol_s> p_sym,
+              section_s p_text,
+              validator_options_s p_options = {})
+      : Validator(p_sym, section_view_s{ p_text.header, {} }, p_options)
+    {
+        m_text_storage = std::move(p_text.data);
+        m_text.data = m_text_storage;
+    }
+    Validator(const Validator&) = delete;
+    Validator& operator=(const Validator&) = delete;
     ~Validator() = default;
     std::optional<std::vector<symbol_s>> find_typeinfo(std::string_view func_name);
     std::optional<std::string> demangle(const char* mangled);
@@ -71,18 +128,84 @@ class Validator
     using Result = std::expected<std::vector<ThrowCatchMatch>, CorrelateError>;
 
     void load_lsda(const LsdaParser& lsda);
+    // Per-function LSDAs: analyze_exceptions() finds the function's FDE and
+    // parses only the LSDA it points to, on first use, unless lsdas already
+    // holds it. Takes precedence over load_lsda(). The sections and lsdas
+    // must outlive the Validator. read_pointer resolves indirect type table
+    // entries, as for LsdaParser.
+    void load_eh_frame(const EhFrame& eh_frame,
+                       section_view_s except_table,
+                       const LsdaTable* lsdas = nullptr,
+                       PointerReader read_pointer = {});
+    // The same for ARM EHABI images, whose LSDAs follow the unwind
+    // instructions of their .ARM.extab entries and hold 4-byte pointers in
+    // the file's byte order. The index must outlive the Validator.
+    void load_arm_exidx(const ArmExidx& exidx, PointerReader read_pointer = {});
     Result analyze_exceptions(std::string_view func_name) const;
+    // Throw sites from find_throw_sites(), sorted by function. find_typeinfo()
+    // then returns the typeinfo passed to each __cxa_throw of the function,
+    // not every RTTI symbol it refers to, which includes its catch clauses.
+    // Functions with a site of unknown type keep the reference scan. The
+    // sites must outlive the Validator.
+    void load_throw_sites(std::span<const throw_site_s> throw_sites);
 
     const std::vector<CatchRecord>& records() const noexcept { return m_records; }
 
   private:
-    std::span<symbol_s> m_sym;
-    section_s m_text;
-    std::unordered_map<std::uint64_t, symbol_s> rtti_sym;
+    std::optional<SymbolTable> m_owned_sym;    // only used by symbol_s ctors
+    const SymbolTable* m_sym;
+    section_view_s m_text;                     // view into the ELF mapping
+    std::vector<std::byte> m_text_storage;     // only used by owning ctor
+    validator_options_s m_options;
+    FunctionIndex m_functions;  // extents of functions inside .text
+    std::unordered_map<std::uint64_t, std::uint32_t> rtti_sym;  // addr -> index
     const LsdaParser* m_lsda = nullptr;   
     std::vector<CatchRecord> m_records;   // flattened handler table
 
+    struct function_lsda_s
+    {
+        std::optional<LsdaParser> owned;   // unless m_lsdas had it
+        const LsdaParser* lsda;
+        std::vector<CatchRecord> records;  // flattened, for this LSDA only
+    };
+    const EhFrame* m_eh_frame = nullptr;
+    section_view_s m_except_table{};
+    const LsdaTable* m_lsdas = nullptr;
+    const ArmExidx* m_arm_exidx = nullptr;  // instead of m_eh_frame
+    PointerReader m_read_pointer;  // for LSDAs that m_lsdas lacks
+    std::optional<std::span<const throw_site_s>> m_throw_sites;
+    // LSDA address -> parsed LSDA; nullptr if it failed to parse
+    mutable std::unordered_map<std::uint64_t,
+                               std::unique_ptr<function_lsda_s>>
+      m_function_lsda;
+
+    void initialize();
+    std::ofstream open_log(std::string_view file_name,
+                           std::ios::openmode mode = std::ios::out) const;
     void collect_rtti_sym();
+    std::optional<std::size_t> find_symbol_index(std::string_view name) const;
+    // offset and size of a function inside .text; nullopt if outside it
+    std::optional<std::pair<std::size_t, std::size_t>> function_bytes(
+      std::size_t sym_index) const;
+    std::vector<symbol_s> find_thrown_functions_windowed();
+    std::optional<std::vector<symbol_s>> find_typeinfo_at(std::size_t sym_index);
+    // adds the RTTI symbol at target_addr, if any, to thrown
+    void probe_typeinfo(std::uint64_t target_addr,
+                        std::vector<symbol_s>& thrown,
+                        std::ofstream& out);
+    void add_thrown(std::uint32_t rtti_index,
+                    std::vector<symbol_s>& thrown,
+                    std::ofstream& out);
+    static void append_records(const LsdaParser& lsda,
+                               std::vector<CatchRecord>& records);
+    const function_lsda_s* lsda_for(std::uint64_t func_addr) const;
+    // the LSDA address and the context to decode it in; nullopt if the
+    // function has none
+    std::optional<std::pair<std::uint64_t, LsdaContext>> lsda_location(
+      std::uint64_t func_addr) const;
+    Result match_handlers(const std::vector<symbol_s>& thrown,
+                          const std::vector<CatchRecord>& records,
+                          const LsdaParser& lsda) const;
 };
 
 }  // namespace safe
@@ -0,0 +1,116 @@
+/**
+ * @file x86_decoder.hpp
+ * @author SAFE Group
+ * @brief x86-64 instruction length decoder header file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace safe {
+
+/**
+ * @struct x86_instruction_s
+ * @brief The parts of a decoded x86-64 instruction the analyses use.
+ *
+ * Registers are numbered as in the encoding, REX or VEX extension included:
+ * 0 rax, 1 rcx, 2 rdx, 3 rbx, 4 rsp, 5 rbp, 6 rsi, 7 rdi, 8-15 r8-r15.
+ */
+struct x86_instruction_s
+{
+    uint64_t address = 0;  //!< First byte, prefixes included
+    uint8_t length = 0;    //!< Bytes, at most 15
+    //! Opcode map: 0 one-byte, 1 0F, 2 0F 38, 3 0F 3A; VEX, EVEX and XOP
+    //! instructions keep the map they select
+    uint8_t map = 0;
+    uint8_t opcode = 0;               //!< Opcode byte within the map
+    bool rex_w = false;               //!< 64-bit operand size
+    bool operand_size_16 = false;     //!< 0x66 prefix
+    bool vector = false;              //!< VEX, EVEX or XOP encoded
+    std::optional<uint8_t> modrm;     //!< The ModRM byte, if any
+    //! ModRM.reg, or the register in the low opcode bits (push, pop, mov
+    //! immediate, xchg, bswap)
+    uint8_t reg = 0;
+    //! ModRM.rm when it names a register (mod == 3)
+    std::optional<uint8_t> rm_register;
+    std::optional<uint64_t> rip_target;     //!< RIP-relative operand address
+    std::optional<uint64_t> branch_target;  //!< call, jmp, jcc and loop target
+    std::optional<int64_t> immediate;       //!< Sign-extended immediate
+};
+
+/**
+ * @enum x86_reference_kind
+ * @brief How an instruction refers to an address.
+ */
+enum class x86_reference_kind : uint8_t
+{
+    ADDRESS,  //!< lea of a RIP-relative operand
+    MEMORY,   //!< Other RIP-relative memory operand, e.g. mov
+    CALL,     //!< call rel32
+    JUMP      //!< jmp rel32
+};
+
+/**
+ * @struct x86_reference_s
+ * @brief An address an instruction refers to.
+ */
+struct x86_reference_s
+{
+    uint64_t instruction = 0;  //!< Address of the referring instruction
+    uint64_t target = 0;       //!< Address referred to
+    x86_reference_kind kind = x86_reference_kind::ADDRESS;
+};
+
+/**
+ * @brief Decodes the instruction at the start of p_code.
+ *
+ * Handles the legacy prefixes, REX, VEX, EVEX and XOP, the one-byte, 0F,
+ * 0F 38 and 0F 3A maps, ModRM, SIB, displacements and immediates, as in
+ * 64-bit mode. Only the length and the operands above are recovered.
+ *
+ * @param p_code Bytes starting at the instruction.
+ * @param p_address Address of p_code[0].
+ * @return std::optional<x86_instruction_s> The instruction, or nullopt if
+ * the bytes are not a valid 64-bit mode instruction or are truncated.
+ */
+[[nodiscard]] std::optional<x86_instruction_s> decode_x86_64(
+  std::span<const std::byte> p_code,
+  uint64_t p_address);
+
+/**
+ * @brief Decodes p_code from its first byte to its end, one instruction
+ * after the other.
+ *
+ * A byte that starts no valid instruction (padding or data) is skipped on
+ * its own, so the sweep resynchronizes on the next one.
+ *
+ * @param p_code Code of one function, say.
+ * @param p_address Address of p_code[0].
+ * @return std::vector<x86_instruction_s> The instructions, by address.
+ */
+[[nodiscard]] std::vector<x86_instruction_s> sweep_x86_64(
+  std::span<const std::byte> p_code,
+  uint64_t p_address);
+
+/**
+ * @brief The RIP-relative operands and the call and jmp rel32 targets of
+ * p_code, found by sweep_x86_64().
+ *
+ * @return std::vector<x86_reference_s> The references, by instruction
+ * address.
+ */
+[[nodiscard]] std::vector<x86_reference_s> x86_references(
+  std::span<const std::byte> p_code,
+  uint64_t p_address);
+
+}  // namespace safe
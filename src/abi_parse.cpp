@@ -10,21 +10,86 @@
  **/
 
 #include "abi_parse.hpp"
+#include "elf_reader.hpp"
+#include "leb128.hpp"
+#include "parallel.hpp"
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <set>
 
-void LsdaParser::check(size_t n) const
+namespace {
+// where the next field of a chain points, relative to the action table.
+// Computed modulo 2^64 so that hostile offsets cannot overflow.
+int64_t chain_target(const Action& a)
 {
-    if (index + n > data.size()) {
-        throw std::runtime_error("LSDA read out of bounds");
+    return static_cast<int64_t>(static_cast<uint64_t>(a.next_field_offset)
+                                + static_cast<uint64_t>(a.next_offset));
+}
+
+// shift of the i-th byte of a width-byte value stored in order
+int byte_shift(std::endian order, int i, int width)
+{
+    return (order == std::endian::little ? i : width - 1 - i) * 8;
+}
+}  // namespace
+
+const char* to_string(LsdaError error)
+{
+    switch (error) {
+        case LsdaError::Truncated:
+            return "LSDA read out of bounds";
+        case LsdaError::BadLeb128:
+            return "LEB128 number wider than 64 bits";
+        case LsdaError::UnsupportedEncoding:
+            return "unsupported DW_EH_PE form";
+        case LsdaError::BadOffset:
+            return "LSDA offset beyond exception table";
+        case LsdaError::BadCallSiteTable:
+            return "call site table does not end at its length";
+        case LsdaError::BadActionTable:
+            return "action table overlaps the type table";
+        case LsdaError::BadTypeTable:
+            return "type table outside the LSDA";
+        case LsdaError::DanglingAction:
+            return "action offset reaches no record";
+        case LsdaError::ActionCycle:
+            return "action chain loops";
+        case LsdaError::UnresolvedType:
+            return "type table slot has no static value";
+    }
+    return "unknown LSDA error";
+}
+
+bool LsdaParser::check(size_t n)
+{
+    if (n > data.size() - std::min(index, data.size())) {
+        fail(LsdaError::Truncated);
+        return false;
+    }
+    return true;
+}
+
+void LsdaParser::fail(LsdaError reason)
+{
+    if (!error.has_value()) {
+        error = LsdaDiagnostic{ origin + index, reason };
     }
+    index = data.size();
+}
+
+void LsdaParser::warn(LsdaError reason, size_t offset)
+{
+    diagnostics.push_back({ origin + offset, reason });
 }
 
 // reads 1 byte and then it goes forward with cursor
 uint8_t LsdaParser::read8()
 {
-    check(1);
+    if (!check(1)) {
+        return 0;
+    }
     return data[index++];
 }
 
@@ -32,161 +97,453 @@ uint8_t LsdaParser::read8()
 
 uint16_t LsdaParser::read16()
 {
-    check(2);
+    if (!check(2)) {
+        return 0;
+    }
     uint16_t v = 0;
     for (int i = 0; i < 2; ++i) {
-        v |= static_cast<uint16_t>(data[index++]) << (i * 8);
+        v |= static_cast<uint16_t>(data[index++]) << byte_shift(order, i, 2);
     }
     return v;
 }
 // reads 4 bytes and makes a 32 bit integer
 uint32_t LsdaParser::read32()
 {
-    check(4);
+    if (!check(4)) {
+        return 0;
+    }
     uint32_t v = 0;
     for (int i = 0; i < 4; ++i) {
-        v |= static_cast<uint32_t>(data[index++]) << (i * 8);
+        v |= static_cast<uint32_t>(data[index++]) << byte_shift(order, i, 4);
     }
     return v;
 }
 // reads 8 bytes and makes a 64 bit integer
 uint64_t LsdaParser::read64()
 {
-    check(8);
+    if (!check(8)) {
+        return 0;
+    }
     uint64_t value = 0;
     for (int i = 0; i < 8; ++i) {
-        value |= (static_cast<uint64_t>(data[index++]) << (i * 8));
+        value |= static_cast<uint64_t>(data[index++])
+                 << byte_shift(order, i, 8);
     }
     return value;
 }
 
+uint64_t LsdaParser::uleb()
+{
+    const size_t start = index;
+    auto value = read_uleb128(data, index);
+    if (!value.has_value()) {
+        const bool truncated = index >= data.size();
+        index = start;
+        fail(truncated ? LsdaError::Truncated : LsdaError::BadLeb128);
+        return 0;
+    }
+    return *value;
+}
+
+int64_t LsdaParser::sleb()
+{
+    const size_t start = index;
+    auto value = read_sleb128(data, index);
+    if (!value.has_value()) {
+        const bool truncated = index >= data.size();
+        index = start;
+        fail(truncated ? LsdaError::Truncated : LsdaError::BadLeb128);
+        return 0;
+    }
+    return *value;
+}
+
+void LsdaParser::index_actions()
+{
+    action_by_offset.clear();
+    action_by_offset.reserve(actions.size());
+    for (size_t i = 0; i < actions.size(); ++i) {
+        action_by_offset.emplace(actions[i].entry_offset, i);
+    }
+}
+
 void LsdaParser::build_scopes()
 {
     scopes.clear();
+    handler_pool.clear();
+    handler_chains.clear();
+    scopes.reserve(call_sites.size());
+    sorted_call_sites = std::ranges::is_sorted(call_sites, {}, &CallSite::start);
 
-    for (const auto& cs : call_sites) {
-        if (cs.landing_pad == 0) {
-            continue;
+    // many call sites share an action chain, so each is resolved only once
+    std::unordered_map<int64_t, uint32_t> chain_by_action;
+    auto intern = [&](int64_t action) {
+        action = std::max<int64_t>(action, 0);
+        auto [chain, inserted] = chain_by_action.try_emplace(
+          action, static_cast<uint32_t>(handler_chains.size()));
+        if (!inserted) {
+            return chain->second;
         }
 
-        Scope s;
-        s.start = cs.start;
-        s.end = cs.start + cs.length;
-
+        const auto first_handler = static_cast<uint32_t>(handler_pool.size());
         // LSDA: action is a byte offset into the action table (0 = none)
-        if (cs.action <= 0) {
+        auto first = action_by_offset.end();
+        if (action > 0) {
+            first = action_by_offset.find(action - 1);
+            if (first == action_by_offset.end()) {
+                // treated as a cleanup
+                warn(LsdaError::DanglingAction,
+                     action_table + static_cast<size_t>(action) - 1);
+            }
+        }
+        if (first == action_by_offset.end()) {
             // landing_pad != 0 means there is a cleanup landing pad
-            ScopeHandler h{};
-            h.type = HandlerType::Cleanup;
-            h.type_index = 0;
-            h.landing_pad = cs.landing_pad;
-            s.handlers.push_back(h);
+            handler_pool.push_back({ HandlerType::Cleanup, 0 });
+        } else {
+            // Follow action chain using resolved next_index. A chain visits
+            // each record at most once unless the next offsets form a cycle.
+            auto action_index = static_cast<int64_t>(first->second);
+            while (action_index >= 0) {
+                if (handler_pool.size() - first_handler == actions.size()) {
+                    warn(LsdaError::ActionCycle,
+                         action_table + static_cast<size_t>(action) - 1);
+                    break;
+                }
+                const Action& a = actions[static_cast<size_t>(action_index)];
 
-            scopes.push_back(std::move(s));
-            continue;
-        }
-        const int64_t action_offset = cs.action - 1;
+                ScopeHandler h;
+                h.type_index = a.type;
+                if (a.type == 0) {
+                    h.type = HandlerType::Cleanup;
+                } else if (a.type > 0) {
+                    h.type = HandlerType::Catch;
+                } else {  // a.type < 0
+                    h.type = HandlerType::Filter;
+                }
 
-        // Map offset -> first action index
-        int64_t action_index = -1;
-        for (size_t i = 0; i < actions.size(); ++i) {
-            if (actions[i].entry_offset == action_offset) {
-                action_index = static_cast<int64_t>(i);
-                break;
+                handler_pool.push_back(h);
+                action_index = a.next_index;
             }
         }
+        handler_chains.push_back(
+          { first_handler,
+            static_cast<uint32_t>(handler_pool.size()) - first_handler });
+        return chain->second;
+    };
 
-        if (action_index < 0) {
-            std::cerr << "... not found ... adding cleanup handler\n";
-
-            ScopeHandler h{};
-            h.type = HandlerType::Cleanup;
-            h.type_index = 0;
-            h.landing_pad = cs.landing_pad;
-            s.handlers.push_back(h);
-
-            scopes.push_back(std::move(s));
+    for (const auto& cs : call_sites) {
+        if (cs.landing_pad == 0) {
             continue;
         }
+        scopes.push_back({ cs.start,
+                           cs.start + cs.length,
+                           cs.landing_pad,
+                           intern(cs.action) });
+    }
+}
 
-        // Follow action chain using resolved next_index
-        while (action_index >= 0) {
-            const Action& a = actions[static_cast<size_t>(action_index)];
-
-            ScopeHandler h;
-            h.type_index = a.type;
-            h.landing_pad = cs.landing_pad;
-
-            if (a.type == 0) {
-                h.type = HandlerType::Cleanup;
-            } else if (a.type > 0) {
-                h.type = HandlerType::Catch;
-            } else {  // a.type < 0
-                h.type = HandlerType::Filter;
-            }
+LsdaParser::LsdaParser(std::span<const std::byte> lsda_data)
+  : data(reinterpret_cast<const uint8_t*>(lsda_data.data()), lsda_data.size())
+{
+    std::cout << "Parsing LSDA...\n\n";
+    parse();
+    if (failed()) {
+        throw std::runtime_error(to_string(error->reason));
+    }
+}
 
-            s.handlers.push_back(h);
-            action_index
-              = a.next_index;  // <- offset logic now hidden in next_index
-        }
+LsdaParser::LsdaParser(std::span<const uint8_t> lsda_data)
+  : data(lsda_data)
+{
+    std::cout << "Parsing LSDA...\n\n";
+    parse();
+    if (failed()) {
+        throw std::runtime_error(to_string(error->reason));
+    }
+}
 
-        scopes.push_back(std::move(s));
+LsdaParser::LsdaParser(std::span<const std::byte> table,
+                       size_t lsda_offset,
+                       uint64_t table_address,
+                       const PointerReader& read_pointer)
+{
+    auto decoded = decode(table, lsda_offset, table_address, read_pointer);
+    if (!decoded.has_value()) {
+        throw std::runtime_error(to_string(decoded.error().reason));
     }
+    *this = std::move(*decoded);
 }
 
-LsdaParser::LsdaParser(const std::vector<std::byte>& lsda_data)
+std::expected<LsdaParser, LsdaDiagnostic> LsdaParser::decode(
+  std::span<const std::byte> table,
+  size_t lsda_offset,
+  uint64_t table_address,
+  const PointerReader& read_pointer)
 {
-    data.reserve(lsda_data.size());
-    for (std::byte b : lsda_data) {
-        data.push_back(static_cast<uint8_t>(b));
+    return decode(table, lsda_offset, LsdaContext{ table_address, read_pointer });
+}
+
+std::expected<LsdaParser, LsdaDiagnostic> LsdaParser::decode(
+  std::span<const std::byte> table,
+  size_t lsda_offset,
+  const LsdaContext& context)
+{
+    if (context.pointer_size != 4 && context.pointer_size != 8) {
+        return std::unexpected(
+          LsdaDiagnostic{ lsda_offset, LsdaError::UnsupportedEncoding });
     }
-    parse();
+    if (lsda_offset >= table.size()) {
+        return std::unexpected(
+          LsdaDiagnostic{ lsda_offset, LsdaError::BadOffset });
+    }
+    const std::span<const uint8_t> lsda(
+      reinterpret_cast<const uint8_t*>(table.data()) + lsda_offset,
+      table.size() - lsda_offset);
+    auto size = lsda_size(lsda, context.pointer_size);
+    if (!size.has_value()) {
+        return std::unexpected(LsdaDiagnostic{
+          lsda_offset + size.error().offset, size.error().reason });
+    }
+
+    LsdaParser parser;
+    parser.data = lsda.first(*size);
+    parser.base_address = context.table_address + lsda_offset;
+    parser.single_lsda = true;
+    parser.origin = lsda_offset;
+    parser.pointer_size = context.pointer_size;
+    parser.order = context.order;
+    if (context.read_pointer) {
+        parser.pointer_reader = &context.read_pointer;
+    }
+    parser.parse();
+    parser.pointer_reader = nullptr;
+    if (parser.failed()) {
+        return std::unexpected(*parser.error);
+    }
+    return parser;
 }
 
-LsdaParser::LsdaParser(const std::vector<uint8_t>& lsda_data)
+std::expected<size_t, LsdaDiagnostic> LsdaParser::lsda_size(
+  std::span<const uint8_t> lsda,
+  uint8_t pointer_size)
 {
-    data = lsda_data;  // copy into owned storage
-    parse();
+    size_t i = 0;
+    std::optional<LsdaDiagnostic> error;
+    auto fail = [&](LsdaError reason) {
+        if (!error.has_value()) {
+            error = LsdaDiagnostic{ i, reason };
+        }
+        i = lsda.size();
+    };
+    auto byte = [&]() -> uint8_t {
+        if (i >= lsda.size()) {
+            fail(LsdaError::Truncated);
+            return 0;
+        }
+        return lsda[i++];
+    };
+    auto uleb = [&]() -> uint64_t {
+        const size_t start = i;
+        auto value = read_uleb128(lsda, i);
+        if (!value.has_value()) {
+            const bool truncated = i >= lsda.size();
+            i = start;
+            fail(truncated ? LsdaError::Truncated : LsdaError::BadLeb128);
+            return 0;
+        }
+        return *value;
+    };
+    auto sleb = [&]() -> int64_t {
+        const size_t start = i;
+        auto value = read_sleb128(lsda, i);
+        if (!value.has_value()) {
+            const bool truncated = i >= lsda.size();
+            i = start;
+            fail(truncated ? LsdaError::Truncated : LsdaError::BadLeb128);
+            return 0;
+        }
+        return *value;
+    };
+    auto skip = [&](uint8_t encoding) {
+        switch (encoding & 0x0F) {
+            case 0x01:
+                std::ignore = uleb();
+                break;
+            case 0x09:
+                std::ignore = sleb();
+                break;
+            case 0x02:
+            case 0x0A:
+                i += 2;
+                break;
+            case 0x03:
+            case 0x0B:
+                i += 4;
+                break;
+            case 0x00:
+                i += pointer_size;
+                break;
+            case 0x04:
+            case 0x0C:
+                i += 8;
+                break;
+            default:
+                fail(LsdaError::UnsupportedEncoding);
+                break;
+        }
+    };
+
+    const uint8_t start_enc = byte();
+    if (start_enc != 0xFF) {
+        skip(start_enc);
+    }
+    size_t tt_base = 0;
+    const uint8_t tt_enc = byte();
+    if (tt_enc != 0xFF) {
+        const uint64_t tt_off = uleb();
+        if (tt_off > lsda.size() - std::min(i, lsda.size())) {
+            fail(LsdaError::BadTypeTable);
+        }
+        tt_base = i + static_cast<size_t>(tt_off);  // the type table ends here
+    }
+    size_t end = tt_base;
+    const uint8_t call_enc = byte();
+    const uint64_t call_site_len = uleb();
+    if (call_site_len > lsda.size() - std::min(i, lsda.size())) {
+        fail(LsdaError::BadCallSiteTable);
+    }
+    if (error.has_value()) {
+        return std::unexpected(*error);
+    }
+    const size_t call_site_end = i + static_cast<size_t>(call_site_len);
+    end = std::max(end, call_site_end);
+
+    // the action table has no length; it ends with the last record that a
+    // call site reaches
+    std::vector<size_t> pending;
+    while (i < call_site_end) {
+        skip(call_enc);  // start
+        skip(call_enc);  // length
+        skip(call_enc);  // landing pad
+        const int64_t action = sleb();
+        if (action > 0 && static_cast<uint64_t>(action) <= lsda.size()) {
+            pending.push_back(call_site_end + static_cast<size_t>(action) - 1);
+        }
+    }
+    if (error.has_value()) {
+        return std::unexpected(*error);
+    }
+    if (i != call_site_end) {
+        return std::unexpected(
+          LsdaDiagnostic{ call_site_end, LsdaError::BadCallSiteTable });
+    }
+    // call sites mostly share a handful of actions
+    std::ranges::sort(pending);
+    const auto repeated = std::ranges::unique(pending);
+    pending.erase(repeated.begin(), repeated.end());
+    std::set<size_t> seen;
+    while (!pending.empty() && !error.has_value()) {
+        i = pending.back();
+        pending.pop_back();
+        if (i >= lsda.size() || !seen.insert(i).second) {
+            continue;
+        }
+        const int64_t type = sleb();
+        const size_t next_field = i;
+        if (type < 0 && tt_enc != 0xFF) {
+            // exception specifications follow the type table as
+            // zero-terminated ULEB128 lists
+            if (static_cast<uint64_t>(-(type + 1)) >= lsda.size() - tt_base) {
+                fail(LsdaError::BadTypeTable);
+                break;
+            }
+            size_t spec = tt_base + static_cast<size_t>(-(type + 1));
+            while (spec < lsda.size() && read_uleb128(lsda, spec).value_or(0)
+                                           != 0) {
+            }
+            end = std::max(end, spec);
+        }
+        const int64_t next = sleb();
+        end = std::max(end, i);
+        if (next != 0) {
+            // modulo 2^64: a target before the LSDA wraps past its end
+            pending.push_back(next_field + static_cast<size_t>(next));
+        }
+    }
+    if (error.has_value()) {
+        return std::unexpected(*error);
+    }
+
+    if (end > lsda.size()) {
+        return std::unexpected(LsdaDiagnostic{ end, LsdaError::Truncated });
+    }
+    return end;
 }
 
-uint64_t LsdaParser::read_uleb128(const std::vector<uint8_t>& buf, size_t& i)
+std::optional<uint64_t> LsdaParser::read_uleb128(std::span<const uint8_t> buf,
+                                                 size_t& i)
 {
+    // most LSDA numbers fit one byte; the rest are decoded a word at a time
+    // unless the buffer ends within 8 bytes
+    if (i < buf.size() && buf[i] < 0x80) {
+        return buf[i++];
+    }
+    if (i < buf.size() && buf.size() - i >= 8) {
+        const auto decoded = leb128::decode_unsigned(buf.data() + i);
+        if (decoded.length != 0) {
+            i += decoded.length;
+            return decoded.value;
+        }
+    }
+
     uint64_t result = 0;
     int shift = 0;
     while (i < buf.size()) {
         uint8_t byte = buf[i++];
         result |= static_cast<uint64_t>(byte & 0x7F) << shift;
         if ((byte & 0x80) == 0) {
-            break;
+            return result;
         }
         shift += 7;
         if (shift >= 64) {
-            throw std::runtime_error("ULEB128 overflow");
+            return std::nullopt;  // overflow
         }
     }
-    return result;
+    return std::nullopt;  // truncated
 }
 
-int64_t LsdaParser::read_sleb128(const std::vector<uint8_t>& buf, size_t& i)
+std::optional<int64_t> LsdaParser::read_sleb128(std::span<const uint8_t> buf,
+                                                size_t& i)
 {
-    int64_t result = 0;
+    if (i < buf.size() && buf[i] < 0x80) {
+        const int64_t byte = buf[i++];
+        return (byte & 0x40) != 0 ? byte - 0x80 : byte;
+    }
+    if (i < buf.size() && buf.size() - i >= 8) {
+        const auto decoded = leb128::decode_signed(buf.data() + i);
+        if (decoded.length != 0) {
+            i += decoded.length;
+            return static_cast<int64_t>(decoded.value);
+        }
+    }
+
+    uint64_t result = 0;
     int shift = 0;
-    uint8_t byte = 0;
     while (i < buf.size()) {
-        byte = buf[i++];
-        result |= static_cast<int64_t>(byte & 0x7F) << shift;
+        const uint8_t byte = buf[i++];
+        result |= static_cast<uint64_t>(byte & 0x7F) << shift;
         shift += 7;
         if ((byte & 0x80) == 0) {
-            break;
+            if ((shift < 64) && (byte & 0x40)) {
+                result |= ~uint64_t{ 0 } << shift;
+            }
+            return static_cast<int64_t>(result);
         }
         if (shift >= 64) {
-            throw std::runtime_error("SLEB128 overflow");
+            return std::nullopt;  // overflow
         }
     }
-    if ((shift < 64) && (byte & 0x40)) {
-        result |= -(1LL << shift);
-    }
-    return result;
+    return std::nullopt;  // truncated
 }
 
 // read encode value
@@ -204,10 +561,10 @@ uint64_t LsdaParser::r_encode(uint8_t encoding, uint64_t pcrel)
 
     switch (form) {
         case 0x00:  // absptr
-            value = read64();
+            value = pointer_size == 4 ? read32() : read64();
             break;
         case 0x01:  // uleb128
-            value = read_uleb128(data, index);
+            value = uleb();
             break;
         case 0x02:  // udata2
             value = read16();
@@ -219,7 +576,10 @@ uint64_t LsdaParser::r_encode(uint8_t encoding, uint64_t pcrel)
             value = read64();
             break;
         case 0x09:  // sleb128
-            value = static_cast<uint64_t>(read_sleb128(data, index));
+            value = static_cast<uint64_t>(sleb());
+            break;
+        case 0x0A:  // sdata2
+            value = static_cast<int16_t>(read16());
             break;
         case 0x0B:  // sdata4
             value = static_cast<int32_t>(read32());
@@ -228,7 +588,8 @@ uint64_t LsdaParser::r_encode(uint8_t encoding, uint64_t pcrel)
             value = static_cast<int64_t>(read64());
             break;
         default:
-            throw std::runtime_error("unsupported DW_EH_PE form");
+            fail(LsdaError::UnsupportedEncoding);
+            return 0;
     }
 
     // if (indirect) {
@@ -249,65 +610,76 @@ void LsdaParser::parse()
     actions.clear();
     type_table.clear();
     scopes.clear();
+    diagnostics.clear();
+    unresolved_types.clear();
+    error.reset();
     index = 0;
 
-    // print status
-    std::cout << "Parsing LSDA...\n\n";
-
     // header
     uint8_t start_enc = 0xFF;
     uint8_t tt_enc = 0xFF;
     uint64_t tt_off = 0;
     parse_header(start_enc, tt_enc, tt_off);
+    if (tt_off > data.size() - index) {
+        fail(LsdaError::BadTypeTable);
+    }
 
     const size_t tt_start
       = (tt_enc != 0xFF) ? (index + static_cast<size_t>(tt_off)) : data.size();
 
     // callsite table descriptor
     const uint8_t call_enc = read8();
-    const uint64_t call_site_len = read_uleb128(data, index);
-    const size_t call_site_end = index + static_cast<size_t>(call_site_len);
-    if (call_site_end > data.size()) {
-        throw std::runtime_error("call site table went over LSDA size");
+    const uint64_t call_site_len = uleb();
+    if (call_site_len > data.size() - index) {
+        fail(LsdaError::BadCallSiteTable);
+    }
+    if (failed()) {
+        return;
     }
 
     parse_call_sites(call_enc, call_site_len);
+    if (failed()) {
+        return;
+    }
 
     // index is at beginning of action table
     const size_t actions_start = index;
+    action_table = actions_start;
+    if (single_lsda) {
+        parse_action_chains(actions_start);
+        if (tt_enc != 0xFF && !failed()) {
+            parse_type_table(tt_enc, tt_start);
+        }
+        if (!failed()) {
+            build_scopes();
+        }
+        return;
+    }
+
     // remaining bytes = action table
     const size_t actions_limit = std::min(tt_start, data.size());
     if (index > actions_limit) {
-        throw std::runtime_error("actions start past type table");
+        fail(LsdaError::BadActionTable);
+        return;
     }
     parse_actions_tail(actions_start, actions_limit);
+    if (failed()) {
+        return;
+    }
 
-    // parse type table if given
+    // parse type table if given; a truncated last entry is skipped
     if (tt_enc != 0xFF) {
-        if (tt_start > data.size()) {
-            throw std::runtime_error("type table start beyond LSDA size");
-        }
-
         index = tt_start;
         while (index < data.size()) {
-            size_t before = index;
-            try {
-                uint64_t type_addr = r_encode(tt_enc, 0);
-                // sanity: r_encode must advance index
-                if (index <= before) {
-                    std::cerr << "[AbiParser] warning: type table decode made "
-                                 "no progress; "
-                                 "aborting type table parsing\n";
-                    break;
-                }
-                type_table.push_back(type_addr);
-            } catch (const std::runtime_error& e) {
-                std::cerr
-                  << "[AbiParser] warning: type table appears truncated: "
-                  << e.what() << "\n";
+            const size_t before = index;
+            const uint64_t type_addr = r_encode(tt_enc, 0);
+            if (failed()) {
                 // stop reading types, but keep whatever we already parsed
+                warn(error->reason, before);
+                error.reset();
                 break;
             }
+            type_table.push_back(type_addr);
         }
     }
 
@@ -315,6 +687,42 @@ void LsdaParser::parse()
     build_scopes();
 }
 
+std::optional<CallSiteMatch> LsdaParser::lookup(uint64_t pc) const
+{
+    auto covers = [pc](const CallSite& cs) {
+        return cs.start <= pc && pc - cs.start < cs.length;
+    };
+    auto site = call_sites.end();
+    if (sorted_call_sites) {
+        site = std::ranges::upper_bound(call_sites, pc, {}, &CallSite::start);
+        if (site == call_sites.begin()) {
+            return std::nullopt;
+        }
+        --site;
+        if (!covers(*site)) {
+            return std::nullopt;
+        }
+    } else {
+        site = std::ranges::find_if(call_sites, covers);
+        if (site == call_sites.end()) {
+            return std::nullopt;
+        }
+    }
+    if (site->landing_pad == 0) {
+        return CallSiteMatch{ 0, {} };
+    }
+
+    // scopes are the call sites with a landing pad, in the same order
+    const auto scope
+      = sorted_call_sites
+          ? std::ranges::lower_bound(scopes, site->start, {}, &Scope::start)
+          : std::ranges::find(scopes, site->start, &Scope::start);
+    if (scope == scopes.end() || scope->start != site->start) {
+        return std::nullopt;
+    }
+    return CallSiteMatch{ scope->landing_pad, handlers(*scope) };
+}
+
 std::optional<uint64_t> LsdaParser::resolve_type(int64_t type_index) const
 {
     // Cleanup and filter entries have no concrete type address
@@ -330,6 +738,9 @@ std::optional<uint64_t> LsdaParser::resolve_type(int64_t type_index) const
     }
 
     const size_t pos = n - idx;  // 1 -> last, 2 -> second-to-last, etc.
+    if (std::ranges::binary_search(unresolved_types, pos)) {
+        return std::nullopt;
+    }
     return type_table[pos];
 }
 
@@ -346,7 +757,7 @@ void LsdaParser::parse_header(uint8_t& start_enc,
 
     tt_enc = read8();
     if (tt_enc != 0xFF) {
-        tt_off = read_uleb128(data, index);
+        tt_off = uleb();
     } else {
         tt_off = 0;
     }
@@ -356,17 +767,61 @@ void LsdaParser::parse_header(uint8_t& start_enc,
 void LsdaParser::parse_call_sites(uint8_t call_enc, uint64_t table_len)
 {
     size_t end = index + static_cast<size_t>(table_len);
+    // the encoding is fixed per LSDA, so pick the decoder once instead of
+    // per field. GCC uses uleb128, Clang udata4.
+    switch (call_enc) {
+        case 0x01:
+            parse_call_sites_as<0x01>(call_enc, end);
+            break;
+        case 0x03:
+            if (order == std::endian::big) {
+                parse_call_sites_as<0x03, std::endian::big>(call_enc, end);
+            } else {
+                parse_call_sites_as<0x03, std::endian::little>(call_enc, end);
+            }
+            break;
+        default:
+            parse_call_sites_as<0xFF>(call_enc, end);
+            break;
+    }
+    if (index != end) {
+        fail(LsdaError::BadCallSiteTable);
+    }
+}
+
+// reads one call-site field; Encoding 0xFF decodes call_enc at run time
+template<uint8_t Encoding, std::endian Order>
+uint64_t LsdaParser::read_call_site_field(uint8_t call_enc)
+{
+    if constexpr (Encoding == 0x01) {
+        return uleb();
+    } else if constexpr (Encoding == 0x03) {
+        // a single load, byte-swapped only when Order is not the host's
+        if (!check(4)) {
+            return 0;
+        }
+        const uint32_t value = elf_reader::load<uint32_t, Order>(
+          reinterpret_cast<const std::byte*>(data.data() + index));
+        index += 4;
+        return value;
+    } else {
+        return r_encode(call_enc, 0);
+    }
+}
+
+template<uint8_t Encoding, std::endian Order>
+void LsdaParser::parse_call_sites_as(uint8_t call_enc, size_t end)
+{
     while (index < end) {
+        const size_t record = index;
         CallSite cs{};
-        cs.start = r_encode(call_enc, 0);
-        cs.length = r_encode(call_enc, 0);
-        cs.landing_pad = r_encode(call_enc, 0);
-        cs.action = read_sleb128(data, index);
+        cs.start = read_call_site_field<Encoding, Order>(call_enc);
+        cs.length = read_call_site_field<Encoding, Order>(call_enc);
+        cs.landing_pad = read_call_site_field<Encoding, Order>(call_enc);
+        cs.action = sleb();
+        cs.size = static_cast<uint32_t>(index - record);
         call_sites.push_back(cs);
     }
-    if (index != end) {
-        throw std::runtime_error("call site parsing did not end at limit");
-    }
 }
 
 // parse action table end
@@ -375,9 +830,10 @@ void LsdaParser::parse_actions_tail(size_t table_start, size_t limit_end)
     while (index < limit_end) {
         Action a{};
         a.entry_offset = static_cast<int64_t>(index - table_start);
-        a.type = read_sleb128(data, index);
+        a.type = sleb();
         if (index > limit_end) {
-            throw std::runtime_error("action parsing went over limit");
+            fail(LsdaError::BadActionTable);
+            return;
         }
         if (index == limit_end) {
             a.next_field_offset = -1;
@@ -393,9 +849,10 @@ void LsdaParser::parse_actions_tail(size_t table_start, size_t limit_end)
           = static_cast<int64_t>(next_field_pos - table_start);
 
         // read next_offset (signed, can be negative)
-        a.next_offset = read_sleb128(data, index);
+        a.next_offset = sleb();
         if (index > limit_end) {
-            throw std::runtime_error("action parsing went over limit");
+            fail(LsdaError::BadActionTable);
+            return;
         }
 
         a.next_index = -1;
@@ -403,25 +860,17 @@ void LsdaParser::parse_actions_tail(size_t table_start, size_t limit_end)
     }
 
     // Second pass: resolve next_offset -> next_index
-    for (size_t i = 0; i < actions.size(); ++i) {
-        Action& a = actions[i];
-
+    index_actions();
+    for (auto& a : actions) {
         if (a.next_offset == 0) {
             a.next_index = -1;  // end of chain
             continue;
         }
 
-        const int64_t target_offset = a.entry_offset + a.next_offset;
-
-        int64_t found = -1;
-        for (size_t j = 0; j < actions.size(); ++j) {
-            if (actions[j].entry_offset == target_offset) {
-                found = static_cast<int64_t>(j);
-                break;
-            }
-        }
-
-        if (found < 0) {
+        // the displacement counts from the 'next' field itself
+        const int64_t target_offset = chain_target(a);
+        auto target = action_by_offset.find(target_offset);
+        if (target == action_by_offset.end()) {
             // truncate chain when target is outside known entries
             // techdebt: handle cross LSDA/shared-tail action chains when we
             // parse full .gcc_except_table sections instead of single LSDAs.
@@ -434,8 +883,202 @@ void LsdaParser::parse_actions_tail(size_t table_start, size_t limit_end)
             continue;
         }
 
-        a.next_index = found;
+        a.next_index = static_cast<int64_t>(target->second);
+    }
+}
+
+// parse the action records reachable from the call sites of one LSDA
+void LsdaParser::parse_action_chains(size_t table_start)
+{
+    std::vector<size_t> pending;
+    for (const auto& cs : call_sites) {
+        if (cs.action > 0) {
+            pending.push_back(table_start + static_cast<size_t>(cs.action) - 1);
+        }
+    }
+    std::ranges::sort(pending);
+    const auto repeated = std::ranges::unique(pending);
+    pending.erase(repeated.begin(), repeated.end());
+
+    std::set<size_t> seen;
+    while (!pending.empty() && !failed()) {
+        index = pending.back();
+        pending.pop_back();
+        if (!seen.insert(index).second) {
+            continue;
+        }
+        if (index >= data.size()) {
+            // the chain ends early; lsda_size() left the target out
+            warn(LsdaError::DanglingAction, std::min(index, data.size()));
+            continue;
+        }
+
+        Action a{};
+        a.entry_offset = static_cast<int64_t>(index - table_start);
+        a.type = sleb();
+        a.next_field_offset = static_cast<int64_t>(index - table_start);
+        a.next_offset = sleb();
+        a.next_index = -1;
+        if (a.next_offset != 0) {
+            // the displacement counts from the 'next' field itself
+            pending.push_back(table_start
+                              + static_cast<size_t>(chain_target(a)));
+        }
+        actions.push_back(a);
+    }
+    if (failed()) {
+        return;
+    }
+
+    std::ranges::sort(actions, {}, &Action::entry_offset);
+    index_actions();
+    for (auto& a : actions) {
+        if (a.next_offset == 0) {
+            continue;
+        }
+        auto next = action_by_offset.find(chain_target(a));
+        if (next != action_by_offset.end()) {
+            a.next_index = static_cast<int64_t>(next->second);
+        }
+    }
+}
+
+// the type table is indexed backwards from tt_base; entries are kept in
+// memory order so resolve_type() counts from the end
+void LsdaParser::parse_type_table(uint8_t tt_enc, size_t tt_base)
+{
+    int64_t count = 0;
+    for (const auto& a : actions) {
+        count = std::max(count, a.type);
+    }
+
+    size_t entry_size = 0;
+    switch (tt_enc & 0x0F) {
+        case 0x02:
+        case 0x0A:
+            entry_size = 2;
+            break;
+        case 0x03:
+        case 0x0B:
+            entry_size = 4;
+            break;
+        case 0x00:
+            entry_size = pointer_size;
+            break;
+        case 0x04:
+        case 0x0C:
+            entry_size = 8;
+            break;
+        default:
+            // type table entries must have fixed size
+            fail(LsdaError::UnsupportedEncoding);
+            return;
+    }
+    if (static_cast<size_t>(count) > tt_base / entry_size
+        || tt_base > data.size()) {
+        fail(LsdaError::BadTypeTable);
+        return;
+    }
+
+    type_table.reserve(static_cast<size_t>(count));
+    unresolved_types.clear();
+    index = tt_base - static_cast<size_t>(count) * entry_size;
+    while (index < tt_base) {
+        const size_t entry = index;
+        uint64_t type = r_encode(tt_enc, base_address + index);
+        // 0 is catch (...), not a slot
+        if ((tt_enc & 0x80) != 0 && type != 0 && pointer_reader != nullptr) {
+            auto typeinfo = (*pointer_reader)(type);
+            if (typeinfo.has_value()) {
+                type = *typeinfo;
+            } else {
+                unresolved_types.push_back(
+                  static_cast<uint32_t>(type_table.size()));
+                warn(LsdaError::UnresolvedType, entry);
+            }
+        }
+        type_table.push_back(type);
+    }
+}
+
+LsdaTable::LsdaTable(std::span<const std::byte> table,
+                     uint64_t table_address,
+                     std::vector<size_t> lsda_offsets,
+                     const PointerReader& read_pointer)
+  : offsets(std::move(lsda_offsets))
+{
+    std::ranges::sort(offsets);
+    const auto duplicates = std::ranges::unique(offsets);
+    offsets.erase(duplicates.begin(), duplicates.end());
+    parse_all(table, table_address, read_pointer);
+}
+
+LsdaTable::LsdaTable(std::span<const std::byte> table,
+                     uint64_t table_address,
+                     const PointerReader& read_pointer)
+  : offsets(scan_offsets(table))
+{
+    parse_all(table, table_address, read_pointer);
+}
+
+std::vector<size_t> LsdaTable::scan_offsets(std::span<const std::byte> table)
+{
+    const std::span<const uint8_t> bytes(
+      reinterpret_cast<const uint8_t*>(table.data()), table.size());
+    std::vector<size_t> found;
+    size_t offset = 0;
+    while (true) {
+        // GCC and Clang never encode LPStart, so an LSDA starts with 0xff
+        // and zero bytes in between are alignment padding
+        while (offset < bytes.size() && bytes[offset] == 0) {
+            ++offset;
+        }
+        if (offset >= bytes.size() || bytes[offset] != 0xFF) {
+            break;
+        }
+        auto size = LsdaParser::lsda_size(bytes.subspan(offset));
+        if (!size.has_value()) {
+            break;
+        }
+        found.push_back(offset);
+        offset += *size;
+    }
+    return found;
+}
+
+void LsdaTable::parse_all(std::span<const std::byte> table,
+                          uint64_t table_address,
+                          const PointerReader& read_pointer)
+{
+    // LSDAs are independent, and every task only writes its own slot
+    lsdas.resize(offsets.size());
+    std::vector<std::optional<LsdaDiagnostic>> errors(offsets.size());
+    safe::parallel_for(offsets.size(), [&](size_t i) {
+        auto decoded = LsdaParser::decode(
+          table, offsets[i], table_address, read_pointer);
+        if (decoded.has_value()) {
+            lsdas[i].emplace(std::move(*decoded));
+        } else {
+            errors[i] = decoded.error();
+        }
+    });
+    diagnostics.clear();
+    for (const auto& error : errors) {
+        if (error.has_value()) {
+            diagnostics.push_back(*error);
+        }
+    }
+    failures = diagnostics.size();
+}
+
+const LsdaParser* LsdaTable::find(size_t offset) const
+{
+    auto it = std::ranges::lower_bound(offsets, offset);
+    if (it == offsets.end() || *it != offset) {
+        return nullptr;
     }
+    const auto& lsda = lsdas[static_cast<size_t>(it - offsets.begin())];
+    return lsda.has_value() ? &*lsda : nullptr;
 }
 
 // printers
@@ -0,0 +1,132 @@
+/**
+ * @file archive.cpp
+ * @author SAFE Group
+ * @brief Static (ar) archive reader implementation file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "archive.hpp"
+
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+constexpr std::string_view archive_magic = "!<arch>\n";
+constexpr std::string_view thin_magic = "!<thin>\n";
+constexpr size_t header_size = 60;
+
+std::string_view as_chars(std::span<const std::byte> p_bytes)
+{
+    return { reinterpret_cast<const char*>(p_bytes.data()), p_bytes.size() };
+}
+
+// Header fields are space-padded ASCII
+std::string_view trim(std::string_view p_field)
+{
+    while (!p_field.empty() && p_field.back() == ' ') {
+        p_field.remove_suffix(1);
+    }
+    return p_field;
+}
+
+bool parse_decimal(std::string_view p_field, uint64_t& p_value)
+{
+    p_field = trim(p_field);
+    if (p_field.empty()) {
+        return false;
+    }
+    auto [end, ec] = std::from_chars(
+      p_field.data(), p_field.data() + p_field.size(), p_value);
+    return ec == std::errc{} && end == p_field.data() + p_field.size();
+}
+
+}  // namespace
+
+bool Archive::is_archive(std::span<const std::byte> p_image)
+{
+    return as_chars(p_image).starts_with(archive_magic);
+}
+
+std::expected<Archive, archive_error> Archive::parse(
+  std::span<const std::byte> p_image)
+{
+    const std::string_view image = as_chars(p_image);
+    if (image.starts_with(thin_magic)) {
+        return std::unexpected(archive_error::THIN_ARCHIVE);
+    }
+    if (!image.starts_with(archive_magic)) {
+        return std::unexpected(archive_error::NOT_AN_ARCHIVE);
+    }
+
+    Archive archive;
+    std::string_view long_names;
+    size_t offset = archive_magic.size();
+    while (offset < image.size()) {
+        if (image.size() - offset < header_size) {
+            return std::unexpected(archive_error::BAD_HEADER);
+        }
+        const std::string_view header = image.substr(offset, header_size);
+        uint64_t size = 0;
+        if (header.substr(58, 2) != "`\n"
+            || !parse_decimal(header.substr(48, 10), size)) {
+            return std::unexpected(archive_error::BAD_HEADER);
+        }
+
+        const size_t data_offset = offset + header_size;
+        if (size > image.size() - data_offset) {
+            return std::unexpected(archive_error::TRUNCATED);
+        }
+        std::span<const std::byte> data = p_image.subspan(data_offset, size);
+        // members are 2-byte aligned
+        offset = data_offset + size + (size & 1);
+
+        const std::string_view raw_name = trim(header.substr(0, 16));
+        if (raw_name == "/" || raw_name == "/SYM64/"
+            || raw_name == "__.SYMDEF" || raw_name == "__.SYMDEF SORTED") {
+            continue;  // symbol index
+        }
+        if (raw_name == "//") {
+            long_names = as_chars(data);
+            continue;
+        }
+
+        std::string name;
+        if (raw_name.starts_with("#1/")) {
+            // BSD: the name is stored in front of the data
+            uint64_t length = 0;
+            if (!parse_decimal(raw_name.substr(3), length)
+                || length > data.size()) {
+                return std::unexpected(archive_error::BAD_NAME);
+            }
+            std::string_view stored = as_chars(data.first(length));
+            name = stored.substr(0, stored.find('\0'));
+            data = data.subspan(length);
+        } else if (raw_name.size() > 1 && raw_name.front() == '/') {
+            // GNU: "/<offset>" into the "//" table, entries end in "/\n"
+            uint64_t name_offset = 0;
+            if (!parse_decimal(raw_name.substr(1), name_offset)
+                || name_offset >= long_names.size()) {
+                return std::unexpected(archive_error::BAD_NAME);
+            }
+            std::string_view entry = long_names.substr(name_offset);
+            entry = entry.substr(0, entry.find('\n'));
+            if (entry.ends_with('/')) {
+                entry.remove_suffix(1);
+            }
+            name = entry;
+        } else {
+            name = raw_name.ends_with('/')
+                     ? raw_name.substr(0, raw_name.size() - 1)
+                     : raw_name;
+        }
+
+        archive.m_members.push_back({ std::move(name), data });
+    }
+    return archive;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file arm_exidx.cpp
+ * @author SAFE Group
+ * @brief ARM EHABI .ARM.exidx / .ARM.extab parser implementation file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "arm_exidx.hpp"
+
+#include <algorithm>
+#include <ranges>
+
+namespace {
+
+constexpr uint32_t exidx_cantunwind = 1;
+constexpr uint32_t compact_model = 0x8000'0000;  // bit 31 of a data word
+constexpr size_t entry_size = 8;                 // function, data
+
+// A prel31 word holds a signed 31-bit offset from its own address
+uint64_t prel31(uint64_t p_place, uint32_t p_word)
+{
+    const auto offset = static_cast<int32_t>(p_word << 1) >> 1;
+    return (p_place + static_cast<uint64_t>(static_cast<int64_t>(offset)))
+           & 0xffff'ffff;
+}
+
+// Unwind instructions are packed most significant byte first
+void append_opcodes(std::vector<uint8_t>& p_opcodes,
+                    uint32_t p_word,
+                    int p_count)
+{
+    for (int i = p_count - 1; i >= 0; i--) {
+        p_opcodes.push_back(static_cast<uint8_t>(p_word >> (8 * i)));
+    }
+}
+
+}  // namespace
+
+std::expected<ArmExidx, arm_exidx_error> ArmExidx::parse(
+  section_view_s p_exidx,
+  std::optional<section_view_s> p_extab,
+  elf_reader::encoding_s p_encoding)
+{
+    if (p_exidx.data.size() % entry_size != 0) {
+        return std::unexpected(arm_exidx_error::TRUNCATED);
+    }
+    ArmExidx index;
+    index.m_exidx = p_exidx;
+    index.m_extab = p_extab.value_or(section_view_s{});
+    index.m_encoding = p_encoding;
+    index.m_count = p_exidx.data.size() / entry_size;
+
+    // find() trusts every function word, so check them once here
+    for (size_t i = 0; i < index.m_count; i++) {
+        if ((index.m_word(p_exidx.data, i * entry_size) & compact_model) != 0) {
+            return std::unexpected(arm_exidx_error::BAD_PREL31);
+        }
+    }
+    return index;
+}
+
+uint32_t ArmExidx::m_word(std::span<const std::byte> p_data,
+                          size_t p_offset) const
+{
+    const std::byte* data = p_data.data() + p_offset;
+    if (m_encoding.order == std::endian::little) {
+        return elf_reader::load<uint32_t, std::endian::little>(data);
+    }
+    return elf_reader::load<uint32_t, std::endian::big>(data);
+}
+
+uint64_t ArmExidx::m_function(size_t p_index) const
+{
+    const size_t offset = p_index * entry_size;
+    return prel31(m_exidx.header.sh_addr + offset,
+                  m_word(m_exidx.data, offset));
+}
+
+std::optional<exidx_entry_s> ArmExidx::find(uint64_t p_pc) const
+{
+    // first entry whose function starts after p_pc
+    auto indices = std::views::iota(size_t{ 0 }, m_count);
+    auto after = std::ranges::partition_point(
+      indices, [&](size_t p_index) { return m_function(p_index) <= p_pc; });
+    if (after == indices.begin()) {
+        return std::nullopt;
+    }
+    auto entry = entry_at(*after - 1);
+    if (!entry.has_value()) {
+        return std::nullopt;
+    }
+    return std::move(*entry);
+}
+
+std::expected<exidx_entry_s, arm_exidx_error> ArmExidx::entry_at(
+  size_t p_index) const
+{
+    if (p_index >= m_count) {
+        return std::unexpected(arm_exidx_error::TRUNCATED);
+    }
+    const size_t offset = p_index * entry_size;
+    const uint64_t place = m_exidx.header.sh_addr + offset;
+    const uint32_t data = m_word(m_exidx.data, offset + 4);
+
+    exidx_entry_s entry;
+    entry.offset = offset;
+    entry.pc_begin = m_function(p_index);
+    // the last function runs to the end of the 32-bit address space
+    entry.pc_end
+      = p_index + 1 < m_count ? m_function(p_index + 1) : uint64_t{ 1 } << 32;
+
+    if (data == exidx_cantunwind) {
+        entry.model = exidx_model::CANT_UNWIND;
+        return entry;
+    }
+    if ((data & compact_model) != 0) {
+        // only pr0 fits in the index entry itself
+        if ((data >> 24 & 0x0f) != 0) {
+            return std::unexpected(arm_exidx_error::UNSUPPORTED_PERSONALITY);
+        }
+        entry.model = exidx_model::INLINE;
+        append_opcodes(entry.opcodes, data, 3);
+        return entry;
+    }
+
+    entry.extab = prel31(place + 4, data);
+    if (auto decoded = m_decode_extab(entry); !decoded.has_value()) {
+        return std::unexpected(decoded.error());
+    }
+    return entry;
+}
+
+std::expected<void, arm_exidx_error> ArmExidx::m_decode_extab(
+  exidx_entry_s& p_entry) const
+{
+    const uint64_t base = m_extab.header.sh_addr;
+    if (m_extab.data.empty() || *p_entry.extab < base
+        || *p_entry.extab - base >= m_extab.data.size()) {
+        return std::unexpected(arm_exidx_error::BAD_EXTAB_POINTER);
+    }
+    size_t offset = *p_entry.extab - base;
+    auto next_word = [&]() -> std::optional<uint32_t> {
+        if (m_extab.data.size() - offset < 4) {
+            return std::nullopt;
+        }
+        const uint32_t word = m_word(m_extab.data, offset);
+        offset += 4;
+        return word;
+    };
+
+    auto first = next_word();
+    if (!first.has_value()) {
+        return std::unexpected(arm_exidx_error::TRUNCATED);
+    }
+    uint32_t words = 0;  // of unwind instructions after the first word
+    if ((*first & compact_model) != 0) {
+        p_entry.model = exidx_model::COMPACT;
+        p_entry.personality_index = *first >> 24 & 0x0f;
+        if (p_entry.personality_index == 0) {
+            append_opcodes(p_entry.opcodes, *first, 3);
+        } else if (p_entry.personality_index <= 2) {
+            words = *first >> 16 & 0xff;
+            append_opcodes(p_entry.opcodes, *first, 2);
+        } else {
+            return std::unexpected(arm_exidx_error::UNSUPPORTED_PERSONALITY);
+        }
+    } else {
+        // GCC's personality routines read the instructions as pr1 does,
+        // with the word count in the top byte
+        p_entry.model = exidx_model::GENERIC;
+        p_entry.personality = prel31(*p_entry.extab, *first);
+        auto second = next_word();
+        if (!second.has_value()) {
+            return std::unexpected(arm_exidx_error::TRUNCATED);
+        }
+        words = *second >> 24;
+        append_opcodes(p_entry.opcodes, *second, 3);
+    }
+
+    p_entry.opcodes.reserve(p_entry.opcodes.size() + 4 * words);
+    for (uint32_t i = 0; i < words; i++) {
+        auto word = next_word();
+        if (!word.has_value()) {
+            return std::unexpected(arm_exidx_error::TRUNCATED);
+        }
+        append_opcodes(p_entry.opcodes, *word, 4);
+    }
+    if (offset < m_extab.data.size()) {
+        p_entry.lsda = base + offset;
+    }
+    return {};
+}
+
+std::expected<std::vector<exidx_entry_s>, arm_exidx_error> ArmExidx::entries()
+  const
+{
+    std::vector<exidx_entry_s> result;
+    result.reserve(m_count);
+    for (size_t i = 0; i < m_count; i++) {
+        auto entry = entry_at(i);
+        if (!entry.has_value()) {
+            return std::unexpected(entry.error());
+        }
+        result.push_back(std::move(*entry));
+    }
+    return result;
+}
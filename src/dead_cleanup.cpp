@@ -0,0 +1,173 @@
+/**
+ * @file dead_cleanup.cpp
+ * @author SAFE Group
+ * @brief Cleanup landing pads that no exception can reach implementation
+ * file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "dead_cleanup.hpp"
+
+#include <algorithm>
+#include <format>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+#include "abi_parse.hpp"
+#include "demangle.hpp"
+#include "eh_frame.hpp"
+#include "eh_size.hpp"
+#include "throw_summary.hpp"
+
+namespace safe {
+
+namespace {
+
+bool cleanup_only(const LsdaParser& p_lsda, const Scope& p_scope)
+{
+    return std::ranges::all_of(p_lsda.handlers(p_scope),
+                               [](const ScopeHandler& p_handler) {
+                                   return p_handler.type
+                                          == HandlerType::Cleanup;
+                               });
+}
+
+}  // namespace
+
+cleanup_savings_s& cleanup_savings_s::operator+=(
+  const cleanup_savings_s& p_other) noexcept
+{
+    call_sites += p_other.call_sites;
+    landing_pads += p_other.landing_pads;
+    except_table += p_other.except_table;
+    return *this;
+}
+
+dead_cleanup_report_s find_dead_cleanups(const ElfParser& p_elf,
+                                         const SymbolTable& p_symbols)
+{
+    dead_cleanup_report_s report;
+    const ThrowSummary summary(p_elf, p_symbols);
+    report.supported = summary.supported();
+    auto eh_frame_section = p_elf.get_section_view(".eh_frame");
+    auto except_table = p_elf.get_section_view(".gcc_except_table");
+    if (!report.supported || !eh_frame_section.has_value()
+        || !except_table.has_value()) {
+        return report;
+    }
+    auto eh_frame
+      = EhFrame::parse(*eh_frame_section, std::nullopt, p_elf.get_encoding());
+    if (!eh_frame.has_value()) {
+        return report;
+    }
+    auto fdes = eh_frame->fdes();
+    if (!fdes.has_value()) {
+        return report;
+    }
+
+    const uint64_t table_address = except_table->header.sh_addr;
+    std::set<uint64_t> seen_lsdas;
+    std::map<std::string, size_t> callee_regions;
+    for (const fde_s& fde : *fdes) {
+        if (!fde.lsda.has_value() || *fde.lsda < table_address) {
+            continue;
+        }
+        auto lsda = LsdaParser::decode(except_table->data,
+                                       *fde.lsda - table_address,
+                                       LsdaContext{ table_address, {}, 8 });
+        if (!lsda.has_value()) {
+            report.undecodable++;
+            continue;
+        }
+
+        dead_cleanup_function_s function;
+        function.address = fde.pc_begin;
+        // scopes are the call sites with a landing pad, in table order
+        std::unordered_map<uint64_t, bool> pad_dead;
+        size_t scope = 0;
+        for (const CallSite& site : lsda->call_sites) {
+            if (site.landing_pad == 0) {
+                continue;
+            }
+            const Scope& region = lsda->get_scopes()[scope++];
+            const uint64_t pad = fde.pc_begin + site.landing_pad;
+            auto dead = pad_dead.try_emplace(pad, true).first;
+            if (!cleanup_only(*lsda, region)) {
+                dead->second = false;
+                continue;
+            }
+            function.cleanup_regions++;
+
+            const uint64_t start = fde.pc_begin + site.start;
+            const uint64_t end = start + site.length;
+            auto calls = summary.calls_returning_in(start, end);
+            const bool unreachable
+              = !calls.empty() && calls.back().return_address == end
+                && std::ranges::none_of(calls,
+                                        [&](const machine_call_s& p_call) {
+                                            return summary.may_throw(p_call);
+                                        });
+            if (!unreachable) {
+                dead->second = false;
+                continue;
+            }
+
+            dead_cleanup_s cleanup{ start, end, pad, {} };
+            for (const machine_call_s& call : calls) {
+                const std::string_view callee = summary.callee_name(call);
+                std::string name
+                  = demangle(callee).value_or(std::string(callee));
+                callee_regions[name]++;
+                cleanup.callees.push_back(std::move(name));
+            }
+            function.dead.push_back(std::move(cleanup));
+            function.savings.call_sites += site.size;
+        }
+        report.cleanup_regions += function.cleanup_regions;
+        if (function.dead.empty()) {
+            continue;
+        }
+        report.dead_regions += function.dead.size();
+
+        for (const landing_pad_s& pad :
+             landing_pads(*lsda, fde.pc_begin, fde.pc_end)) {
+            auto dead = pad_dead.find(pad.address);
+            if (dead != pad_dead.end() && dead->second) {
+                function.savings.landing_pads += pad.size;
+            }
+        }
+        const bool all_dead = std::ranges::all_of(
+          pad_dead, [](const auto& p_pad) { return p_pad.second; });
+        if (all_dead && seen_lsdas.insert(*fde.lsda).second) {
+            function.savings.except_table
+              = lsda->get_bytes().size() - function.savings.call_sites;
+        }
+
+        auto symbol = summary.functions().function_at(fde.pc_begin);
+        function.name = std::format("0x{:x}", fde.pc_begin);
+        if (symbol.has_value() && symbol->start == fde.pc_begin) {
+            const std::string_view mangled = p_symbols.name(symbol->symbol);
+            function.name = demangle(mangled).value_or(std::string(mangled));
+        }
+        report.savings += function.savings;
+        report.functions.push_back(std::move(function));
+    }
+
+    std::ranges::stable_sort(report.functions, [](const auto& p_a,
+                                                  const auto& p_b) {
+        return p_a.savings.total() > p_b.savings.total();
+    });
+    for (auto& [name, regions] : callee_regions) {
+        report.callees.push_back({ name, regions });
+    }
+    std::ranges::stable_sort(report.callees, std::ranges::greater{},
+                             &noexcept_candidate_s::regions);
+    return report;
+}
+
+}  // namespace safe
@@ -0,0 +1,34 @@
+/**
+ * @file demangle.cpp
+ * @author SAFE Group
+ * @brief Itanium C++ ABI symbol name demangling implementation file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "demangle.hpp"
+
+#include <cxxabi.h>
+
+#include <cstdlib>
+
+namespace safe {
+
+std::optional<std::string> demangle(std::string_view p_name)
+{
+    const std::string mangled(p_name);
+    int status = 0;
+    char* result
+      = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+    if (status != 0 || result == nullptr) {
+        return std::nullopt;
+    }
+    std::string name(result);
+    std::free(result);
+    return name;
+}
+
+}  // namespace safe
@@ -0,0 +1,261 @@
+/**
+ * @file dependency_graph.cpp
+ * @author SAFE Group
+ * @brief Shared-library dependency resolution implementation file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "dependency_graph.hpp"
+
+#include <sys/stat.h>
+
+#include <array>
+#include <fstream>
+#include <system_error>
+
+namespace safe {
+
+namespace {
+
+// Fields of the ELF identification the loader uses to reject a library
+struct elf_identity_s
+{
+    unsigned char elf_class;
+    unsigned char data;
+    uint16_t machine;
+
+    bool operator==(const elf_identity_s&) const = default;
+};
+
+// Reads just enough of p_path to tell whether it is an ELF file, and which
+std::optional<elf_identity_s> read_identity(const std::filesystem::path& p_path)
+{
+    std::ifstream file(p_path, std::ios::binary);
+    std::array<unsigned char, 20> header{};
+    if (!file.read(reinterpret_cast<char*>(header.data()), header.size())) {
+        return std::nullopt;
+    }
+    if (header[EI_MAG0] != ELFMAG0 || header[EI_MAG1] != ELFMAG1
+        || header[EI_MAG2] != ELFMAG2 || header[EI_MAG3] != ELFMAG3) {
+        return std::nullopt;
+    }
+
+    // e_machine sits at offset 18 in both classes, in the file's byte order
+    const uint16_t machine
+      = header[EI_DATA] == ELFDATA2MSB
+          ? static_cast<uint16_t>((header[18] << 8) | header[19])
+          : static_cast<uint16_t>(header[18] | (header[19] << 8));
+    return elf_identity_s{ header[EI_CLASS], header[EI_DATA], machine };
+}
+
+std::optional<elf_identity_s> identity_of(const ElfParser& p_elf)
+{
+    auto header = p_elf.get_elf_header();
+    if (!header.has_value()) {
+        return std::nullopt;
+    }
+    return elf_identity_s{ header->e_ident[EI_CLASS],
+                           header->e_ident[EI_DATA],
+                           header->e_machine };
+}
+
+// Replaces $ORIGIN / ${ORIGIN} in a DT_RUNPATH entry
+std::string expand_origin(std::string_view p_entry, std::string_view p_origin)
+{
+    std::string out;
+    while (!p_entry.empty()) {
+        size_t length = 0;
+        if (p_entry.starts_with("${ORIGIN}")) {
+            length = 9;
+        } else if (p_entry.starts_with("$ORIGIN")) {
+            length = 7;
+        }
+        if (length != 0) {
+            out += p_origin;
+            p_entry.remove_prefix(length);
+        } else {
+            out += p_entry.front();
+            p_entry.remove_prefix(1);
+        }
+    }
+    return out;
+}
+
+}  // namespace
+
+DependencyGraph::DependencyGraph(dependency_options_s p_options)
+  : m_options(std::move(p_options))
+{
+}
+
+std::filesystem::path DependencyGraph::m_in_sysroot(
+  const std::filesystem::path& p_path) const
+{
+    if (!p_path.is_absolute()) {
+        return p_path;
+    }
+    return (m_options.sysroot / p_path.relative_path()).lexically_normal();
+}
+
+std::filesystem::path DependencyGraph::m_follow_links(
+  std::filesystem::path p_path) const
+{
+    // Library files are usually versioned symlinks; absolute targets point
+    // into the target's filesystem, so keep them under the sysroot
+    std::error_code ec;
+    for (int hops = 0; hops < 16 && std::filesystem::is_symlink(p_path, ec);
+         hops++) {
+        std::filesystem::path target = std::filesystem::read_symlink(p_path, ec);
+        if (ec) {
+            break;
+        }
+        p_path = target.is_absolute()
+                   ? m_in_sysroot(target)
+                   : (p_path.parent_path() / target).lexically_normal();
+    }
+    return p_path;
+}
+
+std::optional<std::filesystem::path> DependencyGraph::resolve(
+  std::string_view p_needed,
+  const shared_object_s& p_from) const
+{
+    if (p_needed.empty()) {
+        return std::nullopt;
+    }
+
+    const std::filesystem::path origin = p_from.path.parent_path();
+    std::vector<std::filesystem::path> candidates;
+    if (p_needed.find('/') != std::string_view::npos) {
+        std::filesystem::path needed(p_needed);
+        candidates.push_back(needed.is_absolute() ? m_in_sysroot(needed)
+                                                  : origin / needed);
+    } else {
+        if (p_from.elf) {
+            for (std::string_view entry : p_from.elf->get_run_paths()) {
+                std::filesystem::path dir
+                  = expand_origin(entry, origin.native());
+                // $ORIGIN already lives under the sysroot
+                if (!entry.starts_with("$ORIGIN")
+                    && !entry.starts_with("${ORIGIN}")) {
+                    dir = m_in_sysroot(dir);
+                }
+                candidates.push_back(dir / p_needed);
+            }
+        }
+        for (const auto& dir : m_options.search_dirs) {
+            candidates.push_back(m_in_sysroot(dir) / p_needed);
+        }
+    }
+
+    std::optional<elf_identity_s> wanted;
+    if (p_from.elf) {
+        wanted = identity_of(*p_from.elf);
+    }
+
+    std::error_code ec;
+    for (auto& candidate : candidates) {
+        std::filesystem::path path = m_follow_links(candidate);
+        if (!std::filesystem::is_regular_file(path, ec)) {
+            continue;
+        }
+        auto identity = read_identity(path);
+        if (!identity.has_value()) {
+            continue;
+        }
+        if (wanted.has_value() && *identity != *wanted) {
+            continue;  // e.g. a 32-bit library in a multilib directory
+        }
+        return path;
+    }
+    return std::nullopt;
+}
+
+std::pair<size_t, bool> DependencyGraph::m_intern(
+  const std::filesystem::path& p_path)
+{
+    auto add = [this, &p_path] {
+        m_objects.emplace_back().path = p_path;
+        return std::pair<size_t, bool>{ m_objects.size() - 1, true };
+    };
+
+    struct stat info{};
+    if (::stat(p_path.c_str(), &info) != 0) {
+        // cannot identify the file, so treat every path as distinct
+        return add();
+    }
+
+    const std::pair<uint64_t, uint64_t> id{ info.st_dev, info.st_ino };
+    auto [it, added] = m_ids.try_emplace(id, m_objects.size());
+    if (added) {
+        return add();
+    }
+    return { it->second, false };
+}
+
+std::vector<size_t> DependencyGraph::load(
+  std::span<const std::filesystem::path> p_roots)
+{
+    std::vector<size_t> roots;
+    std::vector<size_t> level;
+    for (const auto& root : p_roots) {
+        std::error_code ec;
+        std::filesystem::path path = std::filesystem::absolute(root, ec);
+        if (ec || !std::filesystem::is_regular_file(path, ec)
+            || !read_identity(path).has_value()) {
+            continue;
+        }
+        auto [index, added] = m_intern(path.lexically_normal());
+        roots.push_back(index);
+        if (added) {
+            level.push_back(index);
+        }
+    }
+
+    while (!level.empty()) {
+        // Parse the new objects and resolve their DT_NEEDED entries in
+        // parallel; each worker only touches its own object
+        std::vector<std::vector<std::optional<std::filesystem::path>>> resolved(
+          level.size());
+        parallel_for(
+          level.size(),
+          [&](size_t i) {
+              shared_object_s& object = m_objects[level[i]];
+              object.elf = std::make_unique<ElfParser>(
+                object.path.native(),
+                elf_parser_options_s{ .mode = elf_load_mode::LAZY });
+              for (std::string_view name : object.elf->get_needed_libraries()) {
+                  object.needed.emplace_back(name);
+                  resolved[i].push_back(resolve(name, object));
+              }
+          },
+          m_options.max_threads);
+
+        // Deduplicate serially so every file joins the graph exactly once
+        std::vector<size_t> next;
+        for (size_t i = 0; i < level.size(); i++) {
+            const size_t object = level[i];
+            for (size_t n = 0; n < resolved[i].size(); n++) {
+                if (!resolved[i][n].has_value()) {
+                    m_objects[object].unresolved.push_back(
+                      m_objects[object].needed[n]);
+                    continue;
+                }
+                auto [index, added] = m_intern(*resolved[i][n]);
+                m_objects[object].dependencies.push_back(index);
+                if (added) {
+                    next.push_back(index);
+                }
+            }
+        }
+        level = std::move(next);
+    }
+
+    return roots;
+}
+
+}  // namespace safe
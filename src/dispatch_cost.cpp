@@ -0,0 +1,115 @@
+/**
+ * @file dispatch_cost.cpp
+ * @author SAFE Group
+ * @brief Per-function table lookup cost of exception dispatch
+ * implementation file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "dispatch_cost.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "abi_parse.hpp"
+
+namespace safe {
+
+dispatch_cost_report_s profile_dispatch_cost(
+  const EhFrame& p_eh_frame,
+  std::optional<section_view_s> p_except_table,
+  uint8_t p_pointer_size,
+  bool p_registered)
+{
+    dispatch_cost_report_s report;
+    if (p_eh_frame.has_search_table()) {
+        report.search = fde_search::HDR_TABLE;
+    } else if (p_registered) {
+        report.search = fde_search::REGISTERED;
+    }
+    auto fdes = p_eh_frame.fdes();
+    if (!fdes.has_value()) {
+        report.undecodable++;
+        return report;
+    }
+    report.fdes = fdes->size();
+    // halving the table until one entry is left
+    const auto binary_steps
+      = static_cast<size_t>(std::bit_width(fdes->size()));
+
+    LsdaContext context;
+    context.pointer_size = p_pointer_size;
+    context.order = p_eh_frame.encoding().order;
+    if (p_except_table.has_value()) {
+        context.table_address = p_except_table->header.sh_addr;
+    }
+
+    report.functions.reserve(fdes->size());
+    for (size_t position = 0; position < fdes->size(); position++) {
+        const fde_s& fde = (*fdes)[position];
+        dispatch_cost_s cost;
+        cost.pc_begin = fde.pc_begin;
+        cost.pc_end = fde.pc_end;
+        cost.fde_lookup
+          = report.search == fde_search::LINEAR ? position + 1 : binary_steps;
+        cost.worst_pc = fde.pc_end;
+
+        if (fde.lsda.has_value() && p_except_table.has_value()
+            && *fde.lsda >= context.table_address) {
+            auto lsda = LsdaParser::decode(p_except_table->data,
+                                           *fde.lsda - context.table_address,
+                                           context);
+            if (!lsda.has_value()) {
+                report.undecodable++;
+                continue;
+            }
+            const std::vector<CallSite>& sites = lsda->call_sites;
+            cost.call_sites = sites.size();
+            size_t total_records = 0;
+            size_t measured = 0;
+            for (const CallSite& target : sites) {
+                if (target.length == 0) {
+                    continue;
+                }
+                // the personality routine looks up the return address - 1
+                const uint64_t ip = target.start + target.length - 1;
+                size_t records = 0;
+                uint64_t bytes = 0;
+                for (const CallSite& site : sites) {
+                    records++;
+                    bytes += site.size;
+                    if (ip < site.start || ip < site.start + site.length) {
+                        break;
+                    }
+                }
+                total_records += records;
+                measured++;
+                if (records > cost.worst_records) {
+                    cost.worst_records = records;
+                    cost.worst_bytes = bytes;
+                    cost.worst_pc = fde.pc_begin + ip + 1;
+                }
+            }
+            if (measured != 0) {
+                cost.mean_records = static_cast<double>(total_records)
+                                    / static_cast<double>(measured);
+            }
+        }
+        report.functions.push_back(cost);
+    }
+
+    std::ranges::stable_sort(
+      report.functions, [](const auto& p_a, const auto& p_b) {
+          if (p_a.worst_steps() != p_b.worst_steps()) {
+              return p_a.worst_steps() > p_b.worst_steps();
+          }
+          return p_a.mean_records > p_b.mean_records;
+      });
+    return report;
+}
+
+}  // namespace safe
@@ -0,0 +1,693 @@
+/**
+ * @file eh_frame.cpp
+ * @author SAFE Group
+ * @brief .eh_frame / .eh_frame_hdr parser implementation file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "eh_frame.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace {
+
+// Reads DWARF EH data from a section. A read past the end yields 0 and
+// marks the cursor as failed, so a record is checked once after decoding.
+class cursor
+{
+  public:
+    cursor(std::span<const std::byte> p_data,
+           uint64_t p_address,
+           elf_reader::encoding_s p_encoding,
+           size_t p_offset = 0)
+      : m_data(p_data)
+      , m_address(p_address)
+      , m_encoding(p_encoding)
+      , m_offset(std::min(p_offset, p_data.size()))
+    {
+    }
+
+    template<class T>
+    T fixed()
+    {
+        if (m_data.size() - m_offset < sizeof(T)) {
+            return fail();
+        }
+        const std::byte* data = m_data.data() + m_offset;
+        m_offset += sizeof(T);
+        if (m_encoding.order == std::endian::little) {
+            return elf_reader::load<T, std::endian::little>(data);
+        }
+        return elf_reader::load<T, std::endian::big>(data);
+    }
+
+    uint64_t uleb()
+    {
+        uint64_t result = 0;
+        for (unsigned shift = 0; m_offset < m_data.size(); shift += 7) {
+            const auto byte = static_cast<uint8_t>(m_data[m_offset++]);
+            if (shift < 64) {
+                result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            }
+            if ((byte & 0x80) == 0) {
+                return result;
+            }
+        }
+        return fail();
+    }
+
+    int64_t sleb()
+    {
+        uint64_t result = 0;
+        for (unsigned shift = 0; m_offset < m_data.size();) {
+            const auto byte = static_cast<uint8_t>(m_data[m_offset++]);
+            if (shift < 64) {
+                result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            }
+            shift += 7;
+            if ((byte & 0x80) == 0) {
+                if (shift < 64 && (byte & 0x40) != 0) {
+                    result |= ~uint64_t{ 0 } << shift;
+                }
+                return static_cast<int64_t>(result);
+            }
+        }
+        return fail();
+    }
+
+    std::string_view string()
+    {
+        const auto* begin
+          = reinterpret_cast<const char*>(m_data.data() + m_offset);
+        const std::string_view rest(begin, m_data.size() - m_offset);
+        const size_t length = rest.find('\0');
+        if (length == std::string_view::npos) {
+            fail();
+            return {};
+        }
+        m_offset += length + 1;
+        return rest.substr(0, length);
+    }
+
+    // Decodes a DW_EH_PE encoded pointer. The indirection bit is not
+    // followed: the result is then the address of the pointer. datarel is
+    // relative to p_datarel_base, which is only known in .eh_frame_hdr.
+    std::optional<uint64_t> pointer(uint8_t p_encoding,
+                                    uint64_t p_datarel_base = 0)
+    {
+        const uint8_t application = p_encoding & 0x70;
+        if (application == dw_eh_pe::aligned) {
+            const uint64_t misalignment = address() % pointer_size();
+            if (misalignment != 0) {
+                skip(pointer_size() - misalignment);
+            }
+        }
+
+        const uint64_t field = address();
+        uint64_t value = 0;
+        switch (p_encoding & 0x0f) {
+            case dw_eh_pe::absptr:
+                value = pointer_size() == 8 ? fixed<uint64_t>()
+                                            : fixed<uint32_t>();
+                break;
+            case dw_eh_pe::uleb128:
+                value = uleb();
+                break;
+            case dw_eh_pe::udata2:
+                value = fixed<uint16_t>();
+                break;
+            case dw_eh_pe::udata4:
+                value = fixed<uint32_t>();
+                break;
+            case dw_eh_pe::udata8:
+                value = fixed<uint64_t>();
+                break;
+            case dw_eh_pe::sleb128:
+                value = static_cast<uint64_t>(sleb());
+                break;
+            case dw_eh_pe::sdata2:
+                value = static_cast<uint64_t>(
+                  static_cast<int16_t>(fixed<uint16_t>()));
+                break;
+            case dw_eh_pe::sdata4:
+                value = static_cast<uint64_t>(
+                  static_cast<int32_t>(fixed<uint32_t>()));
+                break;
+            case dw_eh_pe::sdata8:
+                value = fixed<uint64_t>();
+                break;
+            default:
+                return std::nullopt;
+        }
+
+        switch (application) {
+            case dw_eh_pe::absptr:
+            case dw_eh_pe::aligned:
+                break;
+            case dw_eh_pe::pcrel:
+                value += field;
+                break;
+            case dw_eh_pe::datarel:
+                if (p_datarel_base == 0) {
+                    return std::nullopt;
+                }
+                value += p_datarel_base;
+                break;
+            default:  // textrel and funcrel have no base here
+                return std::nullopt;
+        }
+        if (m_encoding.elf_class == ELFCLASS32) {
+            value &= 0xffff'ffff;
+        }
+        return value;
+    }
+
+    void skip(size_t p_bytes)
+    {
+        if (m_data.size() - m_offset < p_bytes) {
+            fail();
+            return;
+        }
+        m_offset += p_bytes;
+    }
+
+    void seek(size_t p_offset)
+    {
+        if (p_offset > m_data.size()) {
+            fail();
+            return;
+        }
+        m_offset = p_offset;
+    }
+
+    [[nodiscard]] size_t pointer_size() const
+    {
+        return m_encoding.elf_class == ELFCLASS32 ? 4 : 8;
+    }
+    [[nodiscard]] size_t offset() const
+    {
+        return m_offset;
+    }
+    [[nodiscard]] size_t remaining() const
+    {
+        return m_data.size() - m_offset;
+    }
+    [[nodiscard]] uint64_t address() const
+    {
+        return m_address + m_offset;
+    }
+    [[nodiscard]] bool failed() const
+    {
+        return m_failed;
+    }
+
+  private:
+    uint64_t fail()
+    {
+        m_failed = true;
+        m_offset = m_data.size();
+        return 0;
+    }
+
+    std::span<const std::byte> m_data;
+    uint64_t m_address;
+    elf_reader::encoding_s m_encoding;
+    size_t m_offset;
+    bool m_failed = false;
+};
+
+// Fixed size of one encoded pointer, or 0 for the LEB128 formats
+size_t encoded_size(uint8_t p_encoding, size_t p_pointer_size)
+{
+    switch (p_encoding & 0x0f) {
+        case dw_eh_pe::absptr:
+            return p_pointer_size;
+        case dw_eh_pe::udata2:
+        case dw_eh_pe::sdata2:
+            return 2;
+        case dw_eh_pe::udata4:
+        case dw_eh_pe::sdata4:
+            return 4;
+        case dw_eh_pe::udata8:
+        case dw_eh_pe::sdata8:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+// Decodes one CFA instruction and applies it to the current location.
+// Register rules are not tracked; only the operands are skipped. Returns
+// false for an opcode outside DWARF 4 and the GNU extensions.
+bool step_cfa(cursor& p_input, const cie_s& p_cie, uint64_t& p_location)
+{
+    const auto opcode = p_input.fixed<uint8_t>();
+    switch (opcode >> 6) {
+        case 1:  // DW_CFA_advance_loc
+            p_location += (opcode & 0x3f) * p_cie.code_alignment;
+            return true;
+        case 2:  // DW_CFA_offset
+            std::ignore = p_input.uleb();
+            return true;
+        case 3:  // DW_CFA_restore
+            return true;
+        default:
+            break;
+    }
+    switch (opcode) {
+        case 0x00:  // DW_CFA_nop
+        case 0x0a:  // DW_CFA_remember_state
+        case 0x0b:  // DW_CFA_restore_state
+        case 0x2d:  // DW_CFA_GNU_window_save, AArch64 negate_ra_state
+            return true;
+        case 0x01: {  // DW_CFA_set_loc
+            auto location = p_input.pointer(p_cie.fde_encoding);
+            if (!location.has_value()) {
+                return false;
+            }
+            p_location = *location;
+            return true;
+        }
+        case 0x02:  // DW_CFA_advance_loc1
+            p_location += p_input.fixed<uint8_t>() * p_cie.code_alignment;
+            return true;
+        case 0x03:  // DW_CFA_advance_loc2
+            p_location += p_input.fixed<uint16_t>() * p_cie.code_alignment;
+            return true;
+        case 0x04:  // DW_CFA_advance_loc4
+            p_location += p_input.fixed<uint32_t>() * p_cie.code_alignment;
+            return true;
+        case 0x06:  // DW_CFA_restore_extended
+        case 0x07:  // DW_CFA_undefined
+        case 0x08:  // DW_CFA_same_value
+        case 0x0d:  // DW_CFA_def_cfa_register
+        case 0x0e:  // DW_CFA_def_cfa_offset
+        case 0x2e:  // DW_CFA_GNU_args_size
+            std::ignore = p_input.uleb();
+            return true;
+        case 0x13:  // DW_CFA_def_cfa_offset_sf
+            std::ignore = p_input.sleb();
+            return true;
+        case 0x05:  // DW_CFA_offset_extended
+        case 0x09:  // DW_CFA_register
+        case 0x0c:  // DW_CFA_def_cfa
+        case 0x14:  // DW_CFA_val_offset
+        case 0x2f:  // DW_CFA_GNU_negative_offset_extended
+            std::ignore = p_input.uleb();
+            std::ignore = p_input.uleb();
+            return true;
+        case 0x11:  // DW_CFA_offset_extended_sf
+        case 0x12:  // DW_CFA_def_cfa_sf
+        case 0x15:  // DW_CFA_val_offset_sf
+            std::ignore = p_input.uleb();
+            std::ignore = p_input.sleb();
+            return true;
+        case 0x0f:  // DW_CFA_def_cfa_expression
+            p_input.skip(p_input.uleb());
+            return true;
+        case 0x10:  // DW_CFA_expression
+        case 0x16:  // DW_CFA_val_expression
+            std::ignore = p_input.uleb();
+            p_input.skip(p_input.uleb());
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Length and ID shared by CIEs and FDEs
+struct record_s
+{
+    size_t id_offset = 0;  // of the CIE ID / CIE pointer field
+    uint64_t id = 0;       // 0 for a CIE
+    size_t body = 0;       // first byte after the ID
+    size_t end = 0;        // one past the last byte of the record
+    bool terminator = false;
+};
+
+std::expected<record_s, eh_frame_error> read_record(
+  std::span<const std::byte> p_data,
+  elf_reader::encoding_s p_encoding,
+  size_t p_offset)
+{
+    cursor input(p_data, 0, p_encoding, p_offset);
+    record_s record;
+    uint64_t length = input.fixed<uint32_t>();
+    const bool is_64 = length == 0xffff'ffff;
+    if (is_64) {
+        length = input.fixed<uint64_t>();
+    }
+    if (input.failed() || length > input.remaining()) {
+        return std::unexpected(eh_frame_error::TRUNCATED);
+    }
+    record.end = input.offset() + length;
+    if (length == 0) {
+        record.terminator = true;
+        return record;
+    }
+
+    record.id_offset = input.offset();
+    record.id = is_64 ? input.fixed<uint64_t>() : input.fixed<uint32_t>();
+    if (input.failed() || input.offset() > record.end) {
+        return std::unexpected(eh_frame_error::TRUNCATED);
+    }
+    record.body = input.offset();
+    return record;
+}
+
+}  // namespace
+
+std::expected<EhFrame, eh_frame_error> EhFrame::parse(
+  section_view_s p_eh_frame,
+  std::optional<section_view_s> p_eh_frame_hdr,
+  elf_reader::encoding_s p_encoding)
+{
+    EhFrame frame;
+    frame.m_eh_frame = p_eh_frame;
+    frame.m_encoding = p_encoding;
+    if (p_eh_frame_hdr.has_value()
+        && frame.m_index_search_table(*p_eh_frame_hdr)) {
+        return frame;
+    }
+
+    auto fdes = frame.fdes();
+    if (!fdes.has_value()) {
+        return std::unexpected(fdes.error());
+    }
+    for (const auto& fde : *fdes) {
+        // the linker leaves empty FDEs behind for discarded functions
+        if (fde.pc_end > fde.pc_begin) {
+            frame.m_ranges.push_back({ fde.pc_begin, fde.pc_end, fde.offset });
+        }
+    }
+    std::ranges::sort(frame.m_ranges, {}, &range_s::pc_begin);
+    return frame;
+}
+
+bool EhFrame::m_index_search_table(section_view_s p_eh_frame_hdr)
+{
+    const uint64_t hdr_address = p_eh_frame_hdr.header.sh_addr;
+    cursor input(p_eh_frame_hdr.data, hdr_address, m_encoding);
+    const auto version = input.fixed<uint8_t>();
+    const auto eh_frame_ptr_encoding = input.fixed<uint8_t>();
+    const auto count_encoding = input.fixed<uint8_t>();
+    const auto table_encoding = input.fixed<uint8_t>();
+    if (input.failed() || version != 1
+        || count_encoding == dw_eh_pe::omit
+        || table_encoding == dw_eh_pe::omit) {
+        return false;
+    }
+
+    auto eh_frame_ptr = input.pointer(eh_frame_ptr_encoding, hdr_address);
+    auto count = input.pointer(count_encoding, hdr_address);
+    const size_t field_size
+      = encoded_size(table_encoding, input.pointer_size());
+    if (input.failed() || !eh_frame_ptr.has_value() || !count.has_value()
+        || *eh_frame_ptr != m_eh_frame.header.sh_addr || field_size == 0
+        || *count > input.remaining() / (2 * field_size)) {
+        return false;
+    }
+
+    m_eh_frame_hdr = p_eh_frame_hdr;
+    m_table_offset = input.offset();
+    m_table_encoding = table_encoding;
+    m_table_entry_size = 2 * field_size;
+    m_table_count = *count;
+    return true;
+}
+
+std::optional<fde_s> EhFrame::find(uint64_t p_pc) const
+{
+    std::optional<uint64_t> fde_offset;
+    if (has_search_table()) {
+        const uint64_t hdr_address = m_eh_frame_hdr.header.sh_addr;
+        auto field = [&](size_t p_entry, size_t p_field) {
+            cursor input(m_eh_frame_hdr.data,
+                         hdr_address,
+                         m_encoding,
+                         m_table_offset + p_entry * m_table_entry_size
+                           + p_field * m_table_entry_size / 2);
+            return input.pointer(m_table_encoding, hdr_address).value_or(0);
+        };
+
+        // last entry whose initial location is <= p_pc
+        size_t low = 0;
+        size_t high = m_table_count;
+        while (low < high) {
+            const size_t middle = low + (high - low) / 2;
+            if (field(middle, 0) <= p_pc) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        if (low == 0) {
+            return std::nullopt;
+        }
+        const uint64_t fde_address = field(low - 1, 1);
+        if (fde_address < m_eh_frame.header.sh_addr) {
+            return std::nullopt;
+        }
+        fde_offset = fde_address - m_eh_frame.header.sh_addr;
+    } else {
+        auto range = std::ranges::upper_bound(
+          m_ranges, p_pc, {}, &range_s::pc_begin);
+        if (range == m_ranges.begin()) {
+            return std::nullopt;
+        }
+        fde_offset = std::prev(range)->offset;
+    }
+
+    auto fde = fde_at(*fde_offset);
+    if (!fde.has_value() || p_pc < fde->pc_begin || p_pc >= fde->pc_end) {
+        return std::nullopt;
+    }
+    return *fde;
+}
+
+std::expected<cie_s, eh_frame_error> EhFrame::cie_at(uint64_t p_offset) const
+{
+    const auto data = m_eh_frame.data;
+    auto record = read_record(data, m_encoding, p_offset);
+    if (!record.has_value()) {
+        return std::unexpected(record.error());
+    }
+    if (record->terminator || record->id != 0) {
+        return std::unexpected(eh_frame_error::BAD_CIE_POINTER);
+    }
+
+    cursor input(data.first(record->end),
+                 m_eh_frame.header.sh_addr,
+                 m_encoding,
+                 record->body);
+    cie_s cie;
+    cie.offset = p_offset;
+    cie.size = record->end - p_offset;
+    cie.version = input.fixed<uint8_t>();
+    if (cie.version != 1 && cie.version != 3 && cie.version != 4) {
+        return std::unexpected(eh_frame_error::UNSUPPORTED_VERSION);
+    }
+    cie.augmentation = input.string();
+    std::string_view augmentation = cie.augmentation;
+    if (augmentation.starts_with("eh")) {
+        // pre-3.0 GCC stored the address of an exception table here
+        input.skip(input.pointer_size());
+        augmentation.remove_prefix(2);
+    }
+    if (!augmentation.empty() && !augmentation.starts_with('z')) {
+        return std::unexpected(eh_frame_error::UNSUPPORTED_AUGMENTATION);
+    }
+    if (cie.version == 4) {
+        input.skip(2);  // address_size and segment_size
+    }
+    cie.code_alignment = input.uleb();
+    cie.data_alignment = input.sleb();
+    cie.return_address
+      = cie.version == 1 ? input.fixed<uint8_t>() : input.uleb();
+
+    if (augmentation.starts_with('z')) {
+        const uint64_t length = input.uleb();
+        if (length > input.remaining()) {
+            return std::unexpected(eh_frame_error::TRUNCATED);
+        }
+        const size_t data_end = input.offset() + length;
+        for (char letter : augmentation.substr(1)) {
+            if (letter == 'L') {
+                cie.lsda_encoding = input.fixed<uint8_t>();
+            } else if (letter == 'R') {
+                cie.fde_encoding = input.fixed<uint8_t>();
+            } else if (letter == 'P') {
+                cie.personality_encoding = input.fixed<uint8_t>();
+                cie.personality = input.pointer(cie.personality_encoding);
+                if (!cie.personality.has_value()) {
+                    return std::unexpected(
+                      eh_frame_error::UNSUPPORTED_ENCODING);
+                }
+            } else if (letter == 'S') {
+                cie.signal_frame = true;
+            } else if (letter != 'B' && letter != 'G') {
+                break;  // the rest is skipped through the length
+            }
+        }
+        input.seek(data_end);
+    }
+    if (input.failed()) {
+        return std::unexpected(eh_frame_error::TRUNCATED);
+    }
+    cie.instructions
+      = data.subspan(input.offset(), record->end - input.offset());
+    return cie;
+}
+
+std::expected<fde_s, eh_frame_error> EhFrame::fde_at(uint64_t p_offset) const
+{
+    const auto data = m_eh_frame.data;
+    auto record = read_record(data, m_encoding, p_offset);
+    if (!record.has_value()) {
+        return std::unexpected(record.error());
+    }
+    // the CIE pointer counts back from its own field
+    if (record->terminator || record->id == 0
+        || record->id > record->id_offset) {
+        return std::unexpected(eh_frame_error::BAD_CIE_POINTER);
+    }
+
+    fde_s fde;
+    fde.offset = p_offset;
+    fde.size = record->end - p_offset;
+    fde.cie_offset = record->id_offset - record->id;
+    auto cie = cie_at(fde.cie_offset);
+    if (!cie.has_value()) {
+        return std::unexpected(cie.error());
+    }
+
+    cursor input(data.first(record->end),
+                 m_eh_frame.header.sh_addr,
+                 m_encoding,
+                 record->body);
+    auto pc_begin = input.pointer(cie->fde_encoding);
+    auto pc_range = input.pointer(cie->fde_encoding & 0x0f);
+    if (!pc_begin.has_value() || !pc_range.has_value()) {
+        return std::unexpected(eh_frame_error::UNSUPPORTED_ENCODING);
+    }
+    fde.pc_begin = *pc_begin;
+    fde.pc_end = *pc_begin + *pc_range;
+
+    if (cie->augmentation.find('z') != std::string_view::npos) {
+        const uint64_t length = input.uleb();
+        if (length > input.remaining()) {
+            return std::unexpected(eh_frame_error::TRUNCATED);
+        }
+        const size_t data_end = input.offset() + length;
+        if (cie->lsda_encoding != dw_eh_pe::omit) {
+            // a zero field means this function has no LSDA
+            const size_t field = input.offset();
+            const bool present = input.pointer(cie->lsda_encoding & 0x0f)
+                                   .value_or(0)
+                                 != 0;
+            input.seek(field);
+            auto lsda = input.pointer(cie->lsda_encoding);
+            if (!lsda.has_value()) {
+                return std::unexpected(eh_frame_error::UNSUPPORTED_ENCODING);
+            }
+            if (present) {
+                fde.lsda = *lsda;
+            }
+        }
+        input.seek(data_end);
+    }
+    if (input.failed()) {
+        return std::unexpected(eh_frame_error::TRUNCATED);
+    }
+    fde.instructions
+      = data.subspan(input.offset(), record->end - input.offset());
+    return fde;
+}
+
+std::expected<std::vector<size_t>, eh_frame_error>
+EhFrame::cfa_instruction_counts(const fde_s& p_fde,
+                                std::span<const uint64_t> p_pcs) const
+{
+    auto cie = cie_at(p_fde.cie_offset);
+    if (!cie.has_value()) {
+        return std::unexpected(cie.error());
+    }
+    const auto data = m_eh_frame.data;
+    auto program = [&](std::span<const std::byte> p_instructions) {
+        const auto offset
+          = static_cast<size_t>(p_instructions.data() - data.data());
+        return cursor(data.first(offset + p_instructions.size()),
+                      m_eh_frame.header.sh_addr,
+                      m_encoding,
+                      offset);
+    };
+
+    size_t executed = 0;
+    uint64_t location = p_fde.pc_begin;
+    cursor initial = program(cie->instructions);
+    while (initial.remaining() != 0) {
+        if (!step_cfa(initial, *cie, location)) {
+            return std::unexpected(eh_frame_error::UNSUPPORTED_INSTRUCTION);
+        }
+        executed++;
+    }
+    if (initial.failed()) {
+        return std::unexpected(eh_frame_error::TRUNCATED);
+    }
+
+    std::vector<size_t> counts(p_pcs.size());
+    size_t next = 0;
+    location = p_fde.pc_begin;
+    cursor input = program(p_fde.instructions);
+    while (true) {
+        // the unwinder stops once the location reaches the address
+        while (next < p_pcs.size() && p_pcs[next] <= location) {
+            counts[next++] = executed;
+        }
+        if (next == p_pcs.size() || input.remaining() == 0) {
+            break;
+        }
+        if (!step_cfa(input, *cie, location)) {
+            return std::unexpected(eh_frame_error::UNSUPPORTED_INSTRUCTION);
+        }
+        if (input.failed()) {
+            return std::unexpected(eh_frame_error::TRUNCATED);
+        }
+        executed++;
+    }
+    // past the last advance every instruction has run
+    std::fill(
+      counts.begin() + static_cast<ptrdiff_t>(next), counts.end(), executed);
+    return counts;
+}
+
+std::expected<std::vector<fde_s>, eh_frame_error> EhFrame::fdes() const
+{
+    std::vector<fde_s> fdes;
+    size_t offset = 0;
+    while (offset < m_eh_frame.data.size()) {
+        auto record = read_record(m_eh_frame.data, m_encoding, offset);
+        if (!record.has_value()) {
+            return std::unexpected(record.error());
+        }
+        if (!record->terminator && record->id != 0) {
+            auto fde = fde_at(offset);
+            if (!fde.has_value()) {
+                return std::unexpected(fde.error());
+            }
+            fdes.push_back(*fde);
+        }
+        offset = record->end;
+    }
+    return fdes;
+}
+
+size_t EhFrame::size() const noexcept
+{
+    return has_search_table() ? m_table_count : m_ranges.size();
+}
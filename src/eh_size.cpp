@@ -0,0 +1,383 @@
+/**
+ * @file eh_size.cpp
+ * @author SAFE Group
+ * @brief Per-function attribution of exception handling bytes
+ * implementation file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "eh_size.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <format>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "abi_parse.hpp"
+#include "arm_exidx.hpp"
+#include "demangle.hpp"
+#include "eh_frame.hpp"
+
+namespace safe {
+
+namespace {
+
+// Symbols of the unwinder (libgcc_eh), the personality routines and the
+// C++ ABI runtime that only exceptions pull into a static image
+constexpr std::array<std::string_view, 16> runtime_prefixes = {
+    "_Unwind_",
+    "__gxx_personality",
+    "__gcc_personality",
+    "__cxa_",
+    "__gnu_unwind",
+    "__gnu_Unwind",
+    "___Unwind_",
+    "__aeabi_unwind_cpp_pr",
+    "uw_",
+    "execute_cfa_program",
+    "execute_stack_op",
+    "__register_frame",
+    "__deregister_frame",
+    "_ZN10__cxxabiv1",
+    "_ZN9__gnu_cxx27__verbose_terminate_handler",
+    "d_print",
+};
+
+// An LSDA and the function whose call sites it lists
+struct lsda_ref_s
+{
+    uint64_t function;
+    uint64_t function_end;
+    std::span<const std::byte> table;
+    uint64_t table_address;
+    size_t offset;
+    bool except_table;  // false inside .ARM.extab
+};
+
+}  // namespace
+
+std::vector<landing_pad_s> landing_pads(const LsdaParser& p_lsda,
+                                        uint64_t p_function,
+                                        uint64_t p_function_end)
+{
+    std::vector<uint64_t> starts;
+    for (const CallSite& site : p_lsda.call_sites) {
+        const uint64_t pad = p_function + site.landing_pad;
+        if (site.landing_pad != 0 && pad < p_function_end) {
+            starts.push_back(pad);
+        }
+    }
+    std::ranges::sort(starts);
+    const auto repeated = std::ranges::unique(starts);
+    starts.erase(repeated.begin(), repeated.end());
+
+    std::vector<landing_pad_s> pads;
+    pads.reserve(starts.size());
+    for (size_t i = 0; i < starts.size(); i++) {
+        const uint64_t end
+          = i + 1 < starts.size() ? starts[i + 1] : p_function_end;
+        pads.push_back({ starts[i], end - starts[i] });
+    }
+    return pads;
+}
+
+eh_bytes_s& eh_bytes_s::operator+=(const eh_bytes_s& p_other) noexcept
+{
+    except_table += p_other.except_table;
+    eh_frame += p_other.eh_frame;
+    eh_frame_hdr += p_other.eh_frame_hdr;
+    arm_exidx += p_other.arm_exidx;
+    arm_extab += p_other.arm_extab;
+    landing_pads += p_other.landing_pads;
+    return *this;
+}
+
+eh_size_report_s attribute_eh_bytes(const ElfParser& p_elf,
+                                    const SymbolTable& p_symbols)
+{
+    eh_size_report_s report;
+    const elf_reader::encoding_s encoding = p_elf.get_encoding();
+    const uint8_t pointer_size = encoding.elf_class == ELFCLASS32 ? 4 : 8;
+    auto elf_header = p_elf.get_elf_header();
+    // Thumb function symbols have bit 0 set; unwind tables do not
+    const bool arm = elf_header.has_value() && elf_header->e_machine == EM_ARM;
+
+    std::unordered_map<uint64_t, size_t> function_symbols;
+    std::unordered_set<uint64_t> runtime_addresses;
+    for (size_t i = 0; i < p_symbols.size(); i++) {
+        if (ELF64_ST_TYPE(p_symbols.info(i)) != STT_FUNC
+            || p_symbols.shndx(i) == SHN_UNDEF) {
+            continue;
+        }
+        const uint64_t address
+          = arm ? p_symbols.value(i) & ~uint64_t{ 1 } : p_symbols.value(i);
+        function_symbols.try_emplace(address, i);
+
+        const std::string_view name = p_symbols.name(i);
+        const bool runtime = std::ranges::any_of(
+          runtime_prefixes,
+          [name](std::string_view p_prefix) {
+              return name.starts_with(p_prefix);
+          });
+        if (runtime && p_symbols.symbol_size(i) != 0
+            && runtime_addresses.insert(address).second) {
+            report.runtime.push_back(
+              { std::string(name), p_symbols.symbol_size(i) });
+        }
+    }
+
+    std::unordered_map<uint64_t, size_t> rows;
+    auto row = [&](uint64_t p_address) -> eh_bytes_s& {
+        auto [slot, inserted]
+          = rows.try_emplace(p_address, report.functions.size());
+        if (inserted) {
+            eh_function_bytes_s function;
+            function.address = p_address;
+            auto symbol = function_symbols.find(p_address);
+            function.name = std::format("0x{:x}", p_address);
+            if (symbol != function_symbols.end()) {
+                const std::string_view mangled = p_symbols.name(symbol->second);
+                function.name
+                  = demangle(mangled).value_or(std::string(mangled));
+            }
+            function.family = template_family(function.name);
+            report.functions.push_back(std::move(function));
+        }
+        return report.functions[slot->second].bytes;
+    };
+
+    std::vector<lsda_ref_s> lsdas;
+
+    // .eh_frame and its search table: one FDE and one entry per function
+    auto eh_frame_section = p_elf.get_section_view(".eh_frame");
+    auto hdr_section = p_elf.get_section_view(".eh_frame_hdr");
+    auto except_table = p_elf.get_section_view(".gcc_except_table");
+    if (eh_frame_section.has_value()) {
+        auto eh_frame = EhFrame::parse(
+          *eh_frame_section,
+          hdr_section.has_value() ? std::optional(*hdr_section) : std::nullopt,
+          encoding);
+        std::vector<fde_s> fdes;
+        if (eh_frame.has_value()) {
+            fdes = eh_frame->fdes().value_or(std::vector<fde_s>{});
+        }
+        const uint64_t table_address
+          = except_table.has_value() ? except_table->header.sh_addr : 0;
+        const size_t table_size
+          = except_table.has_value() ? except_table->data.size() : 0;
+        uint64_t frame_bytes = 0;
+        uint64_t hdr_bytes = 0;
+        for (const fde_s& fde : fdes) {
+            eh_bytes_s& bytes = row(fde.pc_begin);
+            bytes.eh_frame += fde.size;
+            frame_bytes += fde.size;
+            if (eh_frame->has_search_table()) {
+                bytes.eh_frame_hdr += eh_frame->search_table_entry_size();
+                hdr_bytes += eh_frame->search_table_entry_size();
+            }
+            if (fde.lsda.has_value() && *fde.lsda >= table_address
+                && *fde.lsda - table_address < table_size) {
+                lsdas.push_back({ fde.pc_begin,
+                                  fde.pc_end,
+                                  except_table->data,
+                                  table_address,
+                                  *fde.lsda - table_address,
+                                  true });
+            }
+        }
+        report.shared.eh_frame = eh_frame_section->data.size() - frame_bytes;
+        if (hdr_section.has_value()) {
+            report.shared.eh_frame_hdr
+              = hdr_section->data.size() - std::min<uint64_t>(
+                  hdr_bytes, hdr_section->data.size());
+        }
+    }
+
+    // .ARM.exidx: 8 bytes per entry; .ARM.extab: each entry runs to the next
+    auto exidx_section = p_elf.get_section_view(".ARM.exidx");
+    auto extab_section = p_elf.get_section_view(".ARM.extab");
+    if (exidx_section.has_value()) {
+        report.shared.arm_exidx = exidx_section->data.size();
+    }
+    if (extab_section.has_value()) {
+        report.shared.arm_extab = extab_section->data.size();
+    }
+    std::expected<ArmExidx, arm_exidx_error> exidx
+      = std::unexpected(arm_exidx_error::TRUNCATED);
+    if (exidx_section.has_value()) {
+        exidx = ArmExidx::parse(*exidx_section,
+                                extab_section.has_value()
+                                  ? std::optional(*extab_section)
+                                  : std::nullopt,
+                                encoding);
+    }
+    if (exidx.has_value()) {
+        std::vector<exidx_entry_s> entries;
+        std::vector<uint64_t> extab_starts;
+        for (size_t i = 0; i < exidx->size(); i++) {
+            auto entry = exidx->entry_at(i);
+            if (!entry.has_value()) {
+                continue;
+            }
+            row(entry->pc_begin).arm_exidx += 8;
+            report.shared.arm_exidx -= 8;
+            if (entry->extab.has_value()) {
+                extab_starts.push_back(*entry->extab);
+            }
+            entries.push_back(std::move(*entry));
+        }
+
+        std::ranges::sort(extab_starts);
+        const auto repeated = std::ranges::unique(extab_starts);
+        extab_starts.erase(repeated.begin(), repeated.end());
+        const section_view_s& extab = exidx->extab();
+        const uint64_t extab_end = extab.header.sh_addr + extab.data.size();
+        std::set<uint64_t> seen;
+        for (const exidx_entry_s& entry : entries) {
+            if (!entry.extab.has_value() || !seen.insert(*entry.extab).second) {
+                continue;
+            }
+            auto next = std::ranges::upper_bound(extab_starts, *entry.extab);
+            const uint64_t end = next != extab_starts.end() ? *next : extab_end;
+            row(entry.pc_begin).arm_extab += end - *entry.extab;
+            report.shared.arm_extab -= end - *entry.extab;
+            if (entry.model == exidx_model::GENERIC && entry.lsda.has_value()) {
+                lsdas.push_back({ entry.pc_begin,
+                                  entry.pc_end,
+                                  extab.data,
+                                  extab.header.sh_addr,
+                                  *entry.lsda - extab.header.sh_addr,
+                                  false });
+            }
+        }
+    }
+
+    // .gcc_except_table: each LSDA once, to the first function using it
+    if (except_table.has_value()) {
+        report.shared.except_table = except_table->data.size();
+    }
+    std::set<size_t> seen;
+    for (const lsda_ref_s& lsda : lsdas) {
+        auto decoded = LsdaParser::decode(
+          lsda.table,
+          lsda.offset,
+          LsdaContext{
+            lsda.table_address, {}, pointer_size, encoding.order });
+        if (!decoded.has_value()) {
+            continue;
+        }
+        eh_bytes_s& bytes = row(lsda.function);
+        for (const landing_pad_s& pad :
+             landing_pads(*decoded, lsda.function, lsda.function_end)) {
+            bytes.landing_pads += pad.size;
+        }
+        if (lsda.except_table && seen.insert(lsda.offset).second) {
+            bytes.except_table += decoded->get_bytes().size();
+            report.shared.except_table -= decoded->get_bytes().size();
+        }
+    }
+
+    std::ranges::sort(report.functions, [](const auto& p_a, const auto& p_b) {
+        if (p_a.bytes.total() != p_b.bytes.total()) {
+            return p_a.bytes.total() > p_b.bytes.total();
+        }
+        return p_a.address < p_b.address;
+    });
+    std::ranges::sort(report.runtime, std::ranges::greater{},
+                      &eh_runtime_bytes_s::size);
+    return report;
+}
+
+std::vector<eh_function_bytes_s> group_by_family(
+  const std::vector<eh_function_bytes_s>& p_functions)
+{
+    std::vector<eh_function_bytes_s> families;
+    std::unordered_map<std::string_view, size_t> index;
+    for (const auto& function : p_functions) {
+        auto [slot, inserted] = index.try_emplace(function.family,
+                                                  families.size());
+        if (inserted) {
+            eh_function_bytes_s family;
+            family.address = function.address;
+            family.name = function.family;
+            family.family = function.family;
+            families.push_back(std::move(family));
+        }
+        families[slot->second].bytes += function.bytes;
+    }
+    std::ranges::stable_sort(families, [](const auto& p_a, const auto& p_b) {
+        return p_a.bytes.total() > p_b.bytes.total();
+    });
+    return families;
+}
+
+std::string template_family(std::string_view p_demangled)
+{
+    constexpr std::string_view keyword = "operator";
+    constexpr std::string_view operator_chars = "<>=!+-*/%^&|~[]()";
+
+    std::string family;
+    family.reserve(p_demangled.size());
+    int depth = 0;
+    for (size_t i = 0; i < p_demangled.size(); i++) {
+        // operator<, operator<< and operator-> are not brackets
+        const bool word_start
+          = i == 0 || !(std::isalnum(static_cast<unsigned char>(
+                          p_demangled[i - 1]))
+                        || p_demangled[i - 1] == '_');
+        if (depth == 0 && word_start
+            && p_demangled.substr(i).starts_with(keyword)) {
+            family += keyword;
+            i += keyword.size();
+            while (i < p_demangled.size()
+                   && operator_chars.find(p_demangled[i])
+                        != std::string_view::npos) {
+                family += p_demangled[i++];
+            }
+            i--;
+            continue;
+        }
+        const char c = p_demangled[i];
+        if (c == '<') {
+            if (depth++ == 0) {
+                family += '<';
+            }
+        } else if (c == '>' && depth > 0) {
+            if (--depth == 0) {
+                family += '>';
+            }
+        } else if (depth == 0) {
+            family += c;
+        }
+    }
+
+    // drop the parameter list and what follows it: cv and ref qualifiers,
+    // " [clone .cold]"; a "::" after it means a local entity instead
+    const size_t close = family.rfind(')');
+    if (close == std::string::npos
+        || family.find(':', close) != std::string::npos) {
+        return family;
+    }
+    int parens = 0;
+    for (size_t i = close + 1; i-- > 0;) {
+        if (family[i] == ')') {
+            parens++;
+        } else if (family[i] == '(' && --parens == 0) {
+            if (i > 0) {
+                family.resize(i);
+            }
+            break;
+        }
+    }
+    return family;
+}
+
+}  // namespace safe
@@ -10,42 +10,159 @@
  **/
 
 #include "elf_parser.hpp"
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <format>
 #include <system_error>
 
-ElfParser::ElfParser(std::string_view p_file_name)
-  : m_file_name(p_file_name)
+namespace {
+// Note type of the GNU build ID (NT_GNU_BUILD_ID)
+constexpr uint32_t gnu_build_id_note = 3;
+
+// CRC-32 (IEEE 802.3, reflected) as stored in .gnu_debuglink
+uint32_t debuglink_crc(std::span<const std::byte> p_data)
 {
-    try {
-        if (elf_version(EV_CURRENT) == EV_NONE) {
-            throw std::runtime_error(
-              "ELF library initialization failed. Wrong ELF format version.");
+    static constexpr auto table = [] {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t i = 0; i < entries.size(); i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) != 0 ? 0xedb88320 ^ (crc >> 1) : crc >> 1;
+            }
+            entries[i] = crc;
         }
-    } catch (const std::runtime_error& e) {
-        std::println(stderr, "Error opening {}: {}", m_file_name, e.what());
-        exit(EXIT_FAILURE);
+        return entries;
+    }();
+
+    uint32_t crc = 0xffffffff;
+    for (std::byte value : p_data) {
+        crc = table[(crc ^ static_cast<uint32_t>(value)) & 0xff] ^ (crc >> 8);
     }
+    return ~crc;
+}
 
-    m_file = open(m_file_name.c_str(), O_RDONLY, 0);
-    try {
-        if (m_file < 0) {
-            throw std::system_error(
-              errno, std::generic_category(), "Open failed.");
+// The GNU build ID in the notes of one SHT_NOTE section, or an empty span
+std::span<const std::byte> note_build_id(elf_reader::encoding_s p_encoding,
+                                         std::span<const std::byte> p_notes,
+                                         uint64_t p_alignment)
+{
+    return elf_reader::visit(
+      p_encoding, [&](auto p_file) -> std::span<const std::byte> {
+          using nhdr_t = typename decltype(p_file)::nhdr;
+          // name and descriptor are padded to the section alignment
+          const size_t align = p_alignment == 8 ? 8 : 4;
+          auto padded = [align](size_t p_size) {
+              return (p_size + align - 1) / align * align;
+          };
+
+          size_t offset = 0;
+          while (p_notes.size() - offset >= nhdr_t::size) {
+              const nhdr_t note(p_notes.data() + offset);
+              const size_t name_offset = offset + nhdr_t::size;
+              const size_t desc_offset = name_offset + padded(note.n_namesz());
+              if (desc_offset > p_notes.size()
+                  || note.n_descsz() > p_notes.size() - desc_offset) {
+                  break;
+              }
+
+              const std::string_view name(
+                reinterpret_cast<const char*>(p_notes.data() + name_offset),
+                note.n_namesz());
+              if (note.n_type() == gnu_build_id_note
+                  && name == std::string_view("GNU", 4)) {
+                  return p_notes.subspan(desc_offset, note.n_descsz());
+              }
+              offset = desc_offset + padded(note.n_descsz());
+              if (offset > p_notes.size()) {
+                  break;
+              }
+          }
+          return {};
+      });
+}
+
+// What a debug file candidate offers, read from its section headers and
+// notes alone
+struct debug_candidate_s
+{
+    std::span<const std::byte> build_id;
+    bool has_symtab = false;
+};
+
+std::optional<debug_candidate_s> probe_debug_file(
+  std::span<const std::byte> p_image)
+{
+    auto encoding = elf_reader::identify(p_image);
+    if (!encoding.has_value()) {
+        return std::nullopt;
+    }
+    debug_candidate_s candidate;
+    elf_reader::visit(*encoding, [&](auto p_file) {
+        using file_t = decltype(p_file);
+        auto header = file_t::header(p_image);
+        if (!header.has_value()) {
+            return;
         }
-    } catch (const std::system_error& e) {
-        std::println(
-          stderr, "Error opening file: {}\n{}", m_file_name, e.what());
+        for (const auto& section : file_t::sections(p_image, *header)) {
+            if (section.sh_type() == SHT_SYMTAB) {
+                candidate.has_symtab = true;
+            } else if (section.sh_type() == SHT_NOTE
+                       && candidate.build_id.empty()) {
+                candidate.build_id = note_build_id(
+                  *encoding,
+                  elf_reader::slice(
+                    p_image, section.sh_offset(), section.sh_size()),
+                  section.sh_addralign());
+            }
+        }
+    });
+    return candidate;
+}
+}  // namespace
+
+ElfParser::ElfParser(std::string_view p_file_name,
+                     elf_parser_options_s p_options)
+  : m_file_name(p_file_name)
+  , m_options(p_options)
+{
+    auto mapping = MappedFile::open(
+      m_file_name, m_options.mode == elf_load_mode::LAZY);
+    if (!mapping.has_value()) {
+        std::println(stderr,
+                     "Error opening file: {}\n{}",
+                     m_file_name,
+                     mapping.error().what());
         exit(EXIT_FAILURE);
     }
+    m_mapping = std::move(*mapping);
+    m_image = m_mapping.bytes().data();
+    m_image_size = m_mapping.bytes().size();
+
+    m_initialize();
+}
+
+ElfParser::ElfParser(std::span<const std::byte> p_image,
+                     std::string_view p_name,
+                     elf_parser_options_s p_options)
+  : m_file_name(p_name)
+  , m_image(p_image.data())
+  , m_image_size(p_image.size())
+  , m_options(p_options)
+{
+    m_initialize();
+}
 
-    m_elf = elf_begin(m_file, ELF_C_READ, NULL);
+void ElfParser::m_initialize()
+{
     try {
-        if (m_elf == NULL) {
-            throw std::runtime_error("ELF_begin failed.");
-        }
-        if (elf_kind(m_elf) != ELF_K_ELF) {
+        auto encoding = elf_reader::identify({ m_image, m_image_size });
+        if (!encoding.has_value()) {
             throw std::runtime_error("Not a ELF object.");
         }
+        m_encoding = *encoding;
     } catch (const std::runtime_error& e) {
         std::println(stderr, "Error opening {}: {}", m_file_name, e.what());
         exit(EXIT_FAILURE);
@@ -53,31 +170,38 @@ ElfParser::ElfParser(std::string_view p_file_name)
 
     std::println("{} {}-bit ELF object\n",
                  m_file_name,
-                 m_elf_class == ELFCLASS32 ? 32 : 64);
+                 m_encoding.elf_class == ELFCLASS32 ? 32 : 64);
 
     m_load_elf_header();
     m_load_section_header();
-    m_load_program_header();
-    m_load_symbol_table();
-};
+    if (m_options.mode == elf_load_mode::EAGER) {
+        std::call_once(m_program_header_once,
+                       [this] { m_load_program_header(); });
+        std::call_once(m_symbol_records_once,
+                       [this] { m_load_symbol_records(); });
+    }
+}
 
 ElfParser::~ElfParser()
 {
-    elf_end(m_elf);
-    close(m_file);
     std::println("ELF file closed.");
 }
 
 void ElfParser::m_load_elf_header()
 {
-    if ((gelf_getehdr(m_elf, &m_elf_header)) == NULL) {
-        std::println(stderr,
-                     "Error (loadElfHeader):Elf header failed to load: {}.",
-                     elf_errmsg(-1));
-        m_elf_header_loaded = false;
-    } else {
+    elf_reader::visit(m_encoding, [this](auto p_file) {
+        using file_t = decltype(p_file);
+        auto header = file_t::header({ m_image, m_image_size });
+        if (!header.has_value()) {
+            std::println(stderr,
+                         "Error (loadElfHeader):Elf header failed to load: "
+                         "file is too small.");
+            m_elf_header_loaded = false;
+            return;
+        }
+        m_elf_header = header->to_gelf();
         m_elf_header_loaded = true;
-    }
+    });
 }
 
 void ElfParser::m_load_section_header()
@@ -85,124 +209,306 @@ void ElfParser::m_load_section_header()
     if (!m_elf_header_loaded) {
         std::println(stderr,
                      "Error (loadSectionHeader): Elf header was not previously "
-                     "loaded: {}.",
-                     elf_errmsg(-1));
-    }
-
-    section_s current_section;
-    char* section_name;
-    Elf_Scn* section = nullptr;
-    GElf_Shdr current_section_header;
-    while ((section = elf_nextscn(m_elf, section)) != NULL) {
-        if (gelf_getshdr(section, &current_section_header)
-            != &current_section_header) {
-            std::println(
-              stderr,
-              "Error (load_section_header): Unable to get section header: {}.",
-              elf_errmsg(-1));
-            continue;
+                     "loaded.");
+        return;
+    }
+
+    elf_reader::visit(m_encoding, [this](auto p_file) {
+        using file_t = decltype(p_file);
+        const std::span<const std::byte> image(m_image, m_image_size);
+        const auto header = *file_t::header(image);
+        const auto sections = file_t::sections(image, header);
+        if (sections.empty() && header.e_shoff() != 0) {
+            std::println(stderr,
+                         "Error (load_section_header): Section header table "
+                         "lies outside of the file.");
+            return;
         }
-        section_name = elf_strptr(
-          m_elf, m_elf_header.e_shstrndx, current_section_header.sh_name);
-        if (section_name == nullptr) {
-            std::println(
-              stderr,
-              "Error (load_section_header): Unable to get section name: {}.",
-              elf_errmsg(-1));
-            continue;
+
+        m_section_headers.reserve(sections.size());
+        for (auto section : sections) {
+            m_section_headers.push_back(section.to_gelf());
         }
+        m_section_data.resize(sections.size());
 
-        // m_section_header.emplace(section_name, current_section_header);
-        current_section.header = current_section_header;
+        std::span<const std::byte> names;
+        const size_t names_index = file_t::name_table_index(header, sections);
+        if (names_index < sections.size()) {
+            names = elf_reader::slice(image,
+                                      sections[names_index].sh_offset(),
+                                      sections[names_index].sh_size());
+        }
 
-        Elf_Data* section_data = elf_getdata(section, nullptr);
-        if (!section_data) {
-            std::println(
-              stderr,
-              "Error (load_section_header): Unable to get section {} data: {}.",
-              section_name,
-              elf_errmsg(-1));
-            continue;
+        for (size_t section_index = 1; section_index < sections.size();
+             section_index++) {
+            const GElf_Shdr& current_section_header
+              = m_section_headers[section_index];
+            if (current_section_header.sh_name >= names.size()) {
+                std::println(
+                  stderr,
+                  "Error (load_section_header): Unable to get section name "
+                  "of section {}.",
+                  section_index);
+                continue;
+            }
+            const char* name_start = reinterpret_cast<const char*>(
+              names.data() + current_section_header.sh_name);
+            const std::string_view section_name(
+              name_start,
+              strnlen(name_start,
+                      names.size() - current_section_header.sh_name));
+
+            section_view_s current_section{ current_section_header, {} };
+            if (current_section_header.sh_type != SHT_NOBITS) {
+                current_section.data
+                  = elf_reader::slice(image,
+                                      current_section_header.sh_offset,
+                                      current_section_header.sh_size);
+                if (current_section.data.empty()
+                    && current_section_header.sh_size != 0) {
+                    std::println(stderr,
+                                 "Error (load_section_header): Section {} "
+                                 "data lies outside of the file.",
+                                 section_name);
+                    continue;
+                }
+                m_section_data[section_index] = current_section.data;
+            }
+
+            m_sections.emplace(section_name, current_section);
         }
+    });
+}
 
-        std::vector<std::byte> current_section_data;
-        if (current_section_header.sh_type == SHT_NOBITS) {
-            current_section_data = {};
-        } else {
-            std::vector<std::byte> parsed_data(
-              reinterpret_cast<const std::byte*>(section_data->d_buf),
-              reinterpret_cast<const std::byte*>(section_data->d_buf)
-                + section_data->d_size);
-            current_section_data = parsed_data;
+void ElfParser::m_load_symbol_table() const
+{
+    const ElfParser* source = this;
+    if (!m_sections.contains(".symtab")) {
+        // stripped: only the symbol and string tables of the debug file
+        m_open_debug_file();
+        if (m_debug_file == nullptr) {
+            return;
         }
-        current_section.data = current_section_data;
+        source = m_debug_file.get();
+    }
 
-        m_sections.emplace(section_name, current_section);
+    auto symtab = source->m_sections.find(".symtab");
+    if (symtab == source->m_sections.end()) {
+        return;
     }
+
+    auto strtab = source->m_sections.find(".strtab");
+    if (strtab == source->m_sections.end()) {
+        return;
+    }
+
+    const GElf_Shdr& symtab_hdr = symtab->second.header;
+    m_compact_symbol_table = SymbolTable(symtab->second.data,
+                                         symtab_hdr.sh_entsize,
+                                         strtab->second.data,
+                                         source->m_encoding);
 }
 
-void ElfParser::m_load_symbol_table()
+void ElfParser::m_open_debug_file() const
 {
-    if (m_sections.find(".symtab") == m_sections.end()) {
+    namespace fs = std::filesystem;
+    const std::span<const std::byte> build_id = get_build_id();
+    const std::optional<debug_link_s> link = get_debug_link();
+
+    std::vector<fs::path> candidates;
+    if (build_id.size() >= 2) {
+        std::string hex;
+        for (std::byte value : build_id) {
+            hex += std::format("{:02x}", static_cast<uint8_t>(value));
+        }
+        for (const auto& directory : m_options.debug_directories) {
+            candidates.push_back(fs::path(directory) / ".build-id"
+                                 / hex.substr(0, 2)
+                                 / (hex.substr(2) + ".debug"));
+        }
+    }
+    if (link.has_value()) {
+        std::error_code error;
+        const fs::path binary_directory
+          = fs::absolute(m_file_name, error).parent_path();
+        candidates.push_back(binary_directory / link->file);
+        candidates.push_back(binary_directory / ".debug" / link->file);
+        for (const auto& directory : m_options.debug_directories) {
+            candidates.push_back(fs::path(directory)
+                                 / binary_directory.relative_path()
+                                 / link->file);
+        }
+    }
+
+    for (const auto& candidate : candidates) {
+        std::error_code error;
+        if (!fs::is_regular_file(candidate, error)
+            || fs::equivalent(candidate, m_file_name, error)) {
+            continue;
+        }
+        // random access: only the section headers, .symtab and .strtab are
+        // ever touched, never the .debug_* sections
+        auto mapping = MappedFile::open(candidate.string(), true);
+        if (!mapping.has_value()) {
+            continue;
+        }
+        // reject a candidate from its headers before decoding its tables
+        auto probe = probe_debug_file(mapping->bytes());
+        if (!probe.has_value() || !probe->has_symtab) {
+            continue;
+        }
+        const bool matches
+          = build_id.empty()
+              ? link.has_value()
+                  && (!m_options.verify_debuglink_crc
+                      || debuglink_crc(mapping->bytes()) == link->crc)
+              : std::ranges::equal(build_id, probe->build_id);
+        if (!matches) {
+            continue;
+        }
+        if (build_id.empty() && !m_options.verify_debuglink_crc) {
+            std::println(stderr,
+                         "Warning: {} matched by name only; its CRC-32 was "
+                         "not checked",
+                         candidate.string());
+        }
+        auto debug = std::make_unique<ElfParser>(
+          mapping->bytes(),
+          candidate.string(),
+          elf_parser_options_s{ .mode = elf_load_mode::LAZY });
+        m_debug_mapping = std::move(*mapping);
+        m_debug_file = std::move(debug);
         return;
     }
+}
 
-    if (m_sections.find(".strtab") == m_sections.end()) {
+void ElfParser::m_load_symbol_records() const
+{
+    std::call_once(m_symbol_table_once, [this] { m_load_symbol_table(); });
+
+    const SymbolTable& symbols = m_compact_symbol_table;
+    m_symbol_table.reserve(symbols.size());
+    for (size_t i = 0; i < symbols.size(); i++) {
+        m_symbol_table.emplace_back(symbols.to_symbol(i));
+    }
+}
+
+void ElfParser::m_load_dynamic_symbol_table() const
+{
+    size_t dynsym_index = 0;
+    for (size_t i = 1; i < m_section_headers.size(); i++) {
+        if (m_section_headers[i].sh_type == SHT_DYNSYM) {
+            dynsym_index = i;
+            break;
+        }
+    }
+    auto dynsym = m_section_at(dynsym_index);
+    if (!dynsym.has_value()) {
         return;
     }
 
-    const GElf_Shdr& symtab_hdr = m_sections[".symtab"].header;
-    const std::vector<std::byte>& symtab_data = m_sections[".symtab"].data;
-    const std::vector<std::byte>& strtab_data = m_sections[".strtab"].data;
-    size_t symtab_count = symtab_hdr.sh_size / symtab_hdr.sh_entsize;
+    auto dynstr = m_section_at(dynsym->header.sh_link);
+    if (!dynstr.has_value()) {
+        return;
+    }
 
-    for (size_t i = 0; i < symtab_count; i++) {
-        const GElf_Sym* sym = reinterpret_cast<const GElf_Sym*>(
-          symtab_data.data() + (i * symtab_hdr.sh_entsize));
+    // Prefer the .gnu.hash section linked to .dynsym, then SysV .hash
+    std::optional<ElfHashTable> hash;
+    const size_t bloom_word_size = m_encoding.elf_class == ELFCLASS32 ? 4 : 8;
+    for (uint32_t type : { SHT_GNU_HASH, SHT_HASH }) {
+        for (size_t i = 1; i < m_section_headers.size() && !hash; i++) {
+            const GElf_Shdr& header = m_section_headers[i];
+            if (header.sh_type != type || header.sh_link != dynsym_index) {
+                continue;
+            }
+            hash = type == SHT_GNU_HASH
+                     ? ElfHashTable::gnu(m_section_data[i],
+                                         bloom_word_size,
+                                         m_encoding.order)
+                     : ElfHashTable::sysv(m_section_data[i], m_encoding.order);
+        }
+    }
 
-        const char* name
-          = reinterpret_cast<const char*>(strtab_data.data() + sym->st_name);
+    m_dynamic_symbol_table = SymbolTable(dynsym->data,
+                                         dynsym->header.sh_entsize,
+                                         dynstr->data,
+                                         m_encoding,
+                                         hash);
+}
 
-        if (sym->st_name == 0) {
-            name = "";
+std::vector<std::string_view> ElfParser::m_dynamic_strings(int64_t p_tag) const
+{
+    std::vector<std::string_view> strings;
+    for (size_t i = 1; i < m_section_headers.size(); i++) {
+        if (m_section_headers[i].sh_type != SHT_DYNAMIC) {
+            continue;
+        }
+        auto dynstr = m_section_at(m_section_headers[i].sh_link);
+        if (!dynstr.has_value()) {
+            continue;
         }
 
-        symbol_s symbol = { name,
-                            static_cast<uint64_t>(sym->st_value),
-                            static_cast<uint64_t>(sym->st_size),
-                            sym->st_info,
-                            sym->st_other,
-                            sym->st_shndx };
-        m_symbol_table.emplace_back(symbol);
+        const char* chars = reinterpret_cast<const char*>(dynstr->data.data());
+        elf_reader::visit(m_encoding, [&](auto p_file) {
+            using file_t = decltype(p_file);
+            using dyn_t = typename file_t::dyn;
+            const size_t stride = std::max<size_t>(
+              m_section_headers[i].sh_entsize, dyn_t::size);
+            for (auto entry :
+                 elf_reader::record_span<dyn_t>(m_section_data[i], stride)) {
+                if (entry.d_tag() == DT_NULL) {
+                    break;
+                }
+                const uint64_t offset = entry.d_val();
+                if (entry.d_tag() != p_tag || offset >= dynstr->data.size()) {
+                    continue;
+                }
+                const size_t max_len = dynstr->data.size() - offset;
+                strings.emplace_back(chars + offset,
+                                     strnlen(chars + offset, max_len));
+            }
+        });
     }
+    return strings;
 }
 
-void ElfParser::m_load_program_header()
+std::optional<section_view_s> ElfParser::m_section_at(size_t p_index) const
+{
+    if (p_index == 0 || p_index >= m_section_headers.size()) {
+        return std::nullopt;
+    }
+    return section_view_s{ m_section_headers[p_index],
+                           m_section_data[p_index] };
+}
+
+void ElfParser::m_load_program_header() const
 {
     if (!m_elf_header_loaded) {
         std::println(
           stderr,
           "Error (Load_program_header): Elf header was not previously "
-          "loaded: {}.",
-          elf_errmsg(-1));
-    } else {
-        GElf_Phdr current_program_header;
-        for (int i = 0; i < m_elf_header.e_phnum; i++) {
-            if (gelf_getphdr(m_elf, i, &current_program_header)
-                != &current_program_header) {
-                std::println(
-                  stderr,
-                  "Error (Load_program_header): Unable to get program "
-                  "header: {}.",
-                  elf_errmsg(-1));
-                continue;
-            }
-            m_program_header.emplace_back(current_program_header);
-        }
+          "loaded.");
+        return;
     }
+
+    elf_reader::visit(m_encoding, [this](auto p_file) {
+        using file_t = decltype(p_file);
+        const std::span<const std::byte> image(m_image, m_image_size);
+        const auto segments = file_t::segments(image, *file_t::header(image));
+        if (segments.empty() && m_elf_header.e_phnum != 0) {
+            std::println(stderr,
+                         "Error (Load_program_header): Program header table "
+                         "lies outside of the file.");
+            return;
+        }
+        m_program_header.reserve(segments.size());
+        for (auto segment : segments) {
+            m_program_header.emplace_back(segment.to_gelf());
+        }
+    });
 }
 
-std::expected<GElf_Ehdr, elf_parser_error> ElfParser::get_elf_header()
+std::expected<GElf_Ehdr, elf_parser_error> ElfParser::get_elf_header() const
 {
     if (!m_elf_header_loaded) {
         return std::unexpected(elf_parser_error::UNLOADED_ELF_HEADER);
@@ -212,33 +518,179 @@ std::expected<GElf_Ehdr, elf_parser_error> ElfParser::get_elf_header()
 }
 
 std::expected<section_s, elf_parser_error> ElfParser::get_section(
-  std::string_view p_section)
+  std::string_view p_section) const
+{
+    auto view = get_section_view(p_section);
+    if (!view.has_value()) {
+        return std::unexpected(view.error());
+    }
+
+    return section_s{ view->header, { view->data.begin(), view->data.end() } };
+}
+
+std::expected<section_view_s, elf_parser_error> ElfParser::get_section_view(
+  std::string_view p_section) const
 {
     if (m_sections.empty()) {
         return std::unexpected(elf_parser_error::EMPTY_SECTION);
     }
 
-    if (!m_sections.contains(p_section)) {
+    auto section = m_sections.find(p_section);
+    if (section == m_sections.end()) {
+        return std::unexpected(elf_parser_error::SECTION_NOT_FOUND);
+    }
+
+    return section->second;
+}
+
+std::span<const std::byte> ElfParser::get_build_id() const
+{
+    for (size_t i = 1; i < m_section_headers.size(); i++) {
+        if (m_section_headers[i].sh_type != SHT_NOTE) {
+            continue;
+        }
+        auto build_id = note_build_id(
+          m_encoding, m_section_data[i], m_section_headers[i].sh_addralign);
+        if (!build_id.empty()) {
+            return build_id;
+        }
+    }
+    return {};
+}
+
+std::optional<debug_link_s> ElfParser::get_debug_link() const
+{
+    auto section = m_sections.find(".gnu_debuglink");
+    if (section == m_sections.end()) {
+        return std::nullopt;
+    }
+
+    // NUL-terminated name, padded to 4 bytes, then the CRC-32
+    const std::span<const std::byte> data = section->second.data;
+    const char* chars = reinterpret_cast<const char*>(data.data());
+    const size_t name_length = strnlen(chars, data.size());
+    const size_t crc_offset = (name_length + 1 + 3) / 4 * 4;
+    if (name_length == 0 || crc_offset + 4 > data.size()) {
+        return std::nullopt;
+    }
+
+    const uint32_t crc = elf_reader::visit(m_encoding, [&](auto p_file) {
+        constexpr std::endian order = decltype(p_file)::encoding.order;
+        return elf_reader::load<uint32_t, order>(data.data() + crc_offset);
+    });
+    return debug_link_s{ { chars, name_length }, crc };
+}
+
+std::optional<std::string> ElfParser::get_debug_file() const
+{
+    std::call_once(m_symbol_table_once, [this] { m_load_symbol_table(); });
+    if (m_debug_file == nullptr) {
+        return std::nullopt;
+    }
+    return m_debug_file->m_file_name;
+}
+
+std::expected<section_view_s, elf_parser_error> ElfParser::get_section_view(
+  size_t p_index) const
+{
+    auto section = m_section_at(p_index);
+    if (!section.has_value()) {
         return std::unexpected(elf_parser_error::SECTION_NOT_FOUND);
     }
+    return *section;
+}
 
-    return m_sections[p_section];
+std::span<const GElf_Shdr> ElfParser::get_section_headers() const
+{
+    return m_section_headers;
 }
 
-std::expected<std::span<GElf_Phdr>, elf_parser_error>
-ElfParser::get_program_header()
+std::expected<std::span<const GElf_Phdr>, elf_parser_error>
+ElfParser::get_program_header() const
 {
+    std::call_once(m_program_header_once, [this] { m_load_program_header(); });
     if (m_program_header.empty()) {
         return std::unexpected(elf_parser_error::EMPTY_PROGRAM);
     }
     return m_program_header;
 }
 
-std::expected<std::span<symbol_s>, elf_parser_error>
-ElfParser::get_symbol_table()
+std::expected<std::span<const symbol_s>, elf_parser_error>
+ElfParser::get_symbol_table() const
 {
+    std::call_once(m_symbol_records_once, [this] { m_load_symbol_records(); });
     if (m_symbol_table.empty()) {
         return std::unexpected(elf_parser_error::EMPTY_SYMBOL);
     }
     return m_symbol_table;
 }
+
+std::expected<const SymbolTable*, elf_parser_error>
+ElfParser::get_compact_symbol_table() const
+{
+    std::call_once(m_symbol_table_once, [this] { m_load_symbol_table(); });
+    if (m_compact_symbol_table.empty()) {
+        return std::unexpected(elf_parser_error::EMPTY_SYMBOL);
+    }
+    return &m_compact_symbol_table;
+}
+
+std::expected<symbol_s, elf_parser_error> ElfParser::find_symbol(
+  std::string_view p_name) const
+{
+    std::call_once(m_symbol_table_once, [this] { m_load_symbol_table(); });
+    const SymbolTable* table = &m_compact_symbol_table;
+    if (table->empty()) {
+        auto dynamic = get_dynamic_symbol_table();
+        if (!dynamic.has_value()) {
+            return std::unexpected(dynamic.error());
+        }
+        table = *dynamic;
+    }
+
+    auto index = table->find(p_name);
+    if (!index.has_value()) {
+        return std::unexpected(elf_parser_error::SYMBOL_NOT_FOUND);
+    }
+    return table->to_symbol(*index);
+}
+
+std::expected<const SymbolTable*, elf_parser_error>
+ElfParser::get_dynamic_symbol_table() const
+{
+    std::call_once(m_dynamic_symbol_table_once,
+                   [this] { m_load_dynamic_symbol_table(); });
+    if (m_dynamic_symbol_table.empty()) {
+        return std::unexpected(elf_parser_error::EMPTY_SYMBOL);
+    }
+    return &m_dynamic_symbol_table;
+}
+
+std::vector<std::string_view> ElfParser::get_needed_libraries() const
+{
+    return m_dynamic_strings(DT_NEEDED);
+}
+
+std::vector<std::string_view> ElfParser::get_run_paths() const
+{
+    std::vector<std::string_view> entries = m_dynamic_strings(DT_RUNPATH);
+    if (entries.empty()) {
+        entries = m_dynamic_strings(DT_RPATH);
+    }
+
+    std::vector<std::string_view> paths;
+    for (std::string_view entry : entries) {
+        while (!entry.empty()) {
+            const size_t colon = entry.find(':');
+            std::string_view path = entry.substr(0, colon);
+            if (!path.empty()) {
+                paths.push_back(path);
+            }
+            if (colon == std::string_view::npos) {
+                break;
+            }
+            entry.remove_prefix(colon + 1);
+        }
+    }
+    return paths;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file function_index.cpp
+ * @author SAFE Group
+ * @brief Address-ordered function interval index implementation file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "function_index.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// Address range of one SHF_ALLOC section
+struct section_range_s
+{
+    uint64_t start;
+    uint64_t end;
+};
+
+// Finds the end of the section that contains p_address, if any
+std::optional<uint64_t> containing_section_end(
+  std::span<const section_range_s> p_ranges,
+  uint64_t p_address)
+{
+    auto it = std::upper_bound(
+      p_ranges.begin(),
+      p_ranges.end(),
+      p_address,
+      [](uint64_t address, const section_range_s& range) {
+          return address < range.start;
+      });
+    if (it == p_ranges.begin()) {
+        return std::nullopt;
+    }
+    --it;
+    if (p_address >= it->end) {
+        return std::nullopt;
+    }
+    return it->end;
+}
+
+}  // namespace
+
+FunctionIndex::FunctionIndex(const SymbolTable& p_symbols,
+                             std::span<const GElf_Shdr> p_sections)
+{
+    std::vector<section_range_s> ranges;
+    for (const auto& section : p_sections) {
+        if ((section.sh_flags & SHF_ALLOC) == 0 || section.sh_size == 0) {
+            continue;
+        }
+        ranges.push_back({ section.sh_addr, section.sh_addr + section.sh_size });
+    }
+    std::sort(ranges.begin(),
+              ranges.end(),
+              [](const section_range_s& a, const section_range_s& b) {
+                  return a.start < b.start;
+              });
+
+    std::vector<uint32_t> functions = p_symbols.defined_of_type(STT_FUNC);
+    std::erase_if(functions, [&p_symbols](uint32_t index) {
+        return p_symbols.shndx(index) >= SHN_LORESERVE;
+    });
+
+    // Sort by address; among aliases put the sized, global symbol first
+    std::sort(functions.begin(),
+              functions.end(),
+              [&p_symbols](uint32_t a, uint32_t b) {
+                  if (p_symbols.value(a) != p_symbols.value(b)) {
+                      return p_symbols.value(a) < p_symbols.value(b);
+                  }
+                  if (p_symbols.symbol_size(a) != p_symbols.symbol_size(b)) {
+                      return p_symbols.symbol_size(a)
+                             > p_symbols.symbol_size(b);
+                  }
+                  const bool a_global
+                    = GELF_ST_BIND(p_symbols.info(a)) == STB_GLOBAL;
+                  const bool b_global
+                    = GELF_ST_BIND(p_symbols.info(b)) == STB_GLOBAL;
+                  if (a_global != b_global) {
+                      return a_global;
+                  }
+                  return a < b;
+              });
+
+    m_starts.reserve(functions.size());
+    m_extents.reserve(functions.size());
+    for (uint32_t index : functions) {
+        const uint64_t start = p_symbols.value(index);
+        if (!m_starts.empty() && m_starts.back() == start) {
+            continue;  // alias of the previous function
+        }
+        m_starts.push_back(start);
+        m_extents.push_back({ start,
+                              start + p_symbols.symbol_size(index),
+                              index,
+                              p_symbols.symbol_size(index) == 0 });
+    }
+
+    // Recover the extent of size-0 functions from their neighbours
+    for (size_t i = 0; i < m_extents.size(); i++) {
+        function_extent_s& extent = m_extents[i];
+        if (!extent.inferred) {
+            continue;
+        }
+
+        auto section_end = containing_section_end(ranges, extent.start);
+        uint64_t end = section_end.value_or(extent.start);
+        if (i + 1 < m_extents.size()) {
+            const uint64_t next = m_extents[i + 1].start;
+            end = section_end.has_value() ? std::min(end, next) : next;
+        }
+        extent.end = end;
+    }
+
+    m_max_ends.reserve(m_extents.size());
+    for (const function_extent_s& extent : m_extents) {
+        m_max_ends.push_back(
+          m_max_ends.empty() ? extent.end
+                             : std::max(m_max_ends.back(), extent.end));
+    }
+}
+
+std::optional<function_extent_s> FunctionIndex::function_at(
+  uint64_t p_address) const
+{
+    auto it = std::upper_bound(m_starts.begin(), m_starts.end(), p_address);
+    if (it == m_starts.begin()) {
+        return std::nullopt;
+    }
+    // walk back from the nearest preceding start to the innermost function
+    // still covering p_address; none is left once the running maximum end
+    // does not reach it
+    for (size_t i = static_cast<size_t>(it - m_starts.begin()); i-- > 0;) {
+        if (m_max_ends[i] <= p_address) {
+            break;
+        }
+        if (p_address < m_extents[i].end) {
+            return m_extents[i];
+        }
+    }
+    return std::nullopt;
+}
@@ -0,0 +1,284 @@
+/**
+ * @file loaded_image.cpp
+ * @author SAFE Group
+ * @brief Relocated view of a linked ELF image implementation file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "loaded_image.hpp"
+
+#include <algorithm>
+
+#include "elf_reader.hpp"
+
+namespace safe {
+
+namespace {
+
+constexpr uint16_t em_aarch64 = 183;
+
+// how a dynamic relocation computes the value of its slot
+enum class slot_kind : uint8_t
+{
+    ignored,   // not a pointer-sized data relocation
+    relative,  // base + addend, with the image at its link address
+    symbol,    // symbol + addend
+    unknown    // decided at run time, e.g. by an IFUNC resolver
+};
+
+// Dynamic relocation types from each psABI
+slot_kind classify(uint16_t p_machine, uint32_t p_type)
+{
+    switch (p_machine) {
+        case EM_X86_64:
+            switch (p_type) {
+                case 8:  // R_X86_64_RELATIVE
+                    return slot_kind::relative;
+                case 1:  // R_X86_64_64
+                case 6:  // R_X86_64_GLOB_DAT
+                case 7:  // R_X86_64_JUMP_SLOT
+                    return slot_kind::symbol;
+                case 37:  // R_X86_64_IRELATIVE
+                    return slot_kind::unknown;
+                default:
+                    return slot_kind::ignored;
+            }
+        case EM_386:
+            switch (p_type) {
+                case 8:  // R_386_RELATIVE
+                    return slot_kind::relative;
+                case 1:  // R_386_32
+                case 6:  // R_386_GLOB_DAT
+                case 7:  // R_386_JMP_SLOT
+                    return slot_kind::symbol;
+                case 42:  // R_386_IRELATIVE
+                    return slot_kind::unknown;
+                default:
+                    return slot_kind::ignored;
+            }
+        case EM_ARM:
+            switch (p_type) {
+                case 23:  // R_ARM_RELATIVE
+                    return slot_kind::relative;
+                case 2:   // R_ARM_ABS32
+                case 21:  // R_ARM_GLOB_DAT
+                case 22:  // R_ARM_JUMP_SLOT
+                    return slot_kind::symbol;
+                case 160:  // R_ARM_IRELATIVE
+                    return slot_kind::unknown;
+                default:
+                    return slot_kind::ignored;
+            }
+        case em_aarch64:
+            switch (p_type) {
+                case 1027:  // R_AARCH64_RELATIVE
+                    return slot_kind::relative;
+                case 257:   // R_AARCH64_ABS64
+                case 1025:  // R_AARCH64_GLOB_DAT
+                case 1026:  // R_AARCH64_JUMP_SLOT
+                    return slot_kind::symbol;
+                case 1032:  // R_AARCH64_IRELATIVE
+                    return slot_kind::unknown;
+                default:
+                    return slot_kind::ignored;
+            }
+        default:
+            return slot_kind::ignored;
+    }
+}
+
+}  // namespace
+
+LoadedImage::LoadedImage(const ElfParser& p_elf)
+  : m_encoding(p_elf.get_encoding())
+{
+    m_load_segments(p_elf);
+    m_load_relocations(p_elf);
+}
+
+void LoadedImage::m_load_segments(const ElfParser& p_elf)
+{
+    auto headers = p_elf.get_section_headers();
+    for (size_t i = 1; i < headers.size(); i++) {
+        const GElf_Shdr& header = headers[i];
+        if ((header.sh_flags & SHF_ALLOC) == 0 || header.sh_addr == 0) {
+            continue;
+        }
+        segment_s segment{ header.sh_addr, header.sh_size, {} };
+        if (header.sh_type != SHT_NOBITS) {
+            auto section = p_elf.get_section_view(i);
+            if (!section.has_value()) {
+                continue;
+            }
+            segment.data = section->data;
+        }
+        m_segments.push_back(segment);
+    }
+    std::ranges::sort(m_segments, {}, &segment_s::address);
+}
+
+void LoadedImage::m_load_relocations(const ElfParser& p_elf)
+{
+    auto elf_header = p_elf.get_elf_header();
+    if (!elf_header.has_value() || elf_header->e_type == ET_REL) {
+        return;
+    }
+    const uint16_t machine = elf_header->e_machine;
+    auto headers = p_elf.get_section_headers();
+
+    elf_reader::visit(m_encoding, [&](auto p_file) {
+        using file_t = decltype(p_file);
+        using sym_t = typename file_t::sym;
+
+        // the dynamic relocations are the allocated REL/RELA sections; their
+        // sh_link names the symbol table (.dynsym)
+        auto symbol_value = [&](const GElf_Shdr& p_relocations,
+                                uint32_t p_symbol) -> std::optional<uint64_t> {
+            if (p_symbol == 0) {
+                return 0;
+            }
+            auto symbols = p_elf.get_section_view(p_relocations.sh_link);
+            if (!symbols.has_value()) {
+                return std::nullopt;
+            }
+            const size_t stride
+              = std::max<size_t>(symbols->header.sh_entsize, sym_t::size);
+            elf_reader::record_span<sym_t> table(symbols->data, stride);
+            if (p_symbol >= table.size()) {
+                return std::nullopt;
+            }
+            const sym_t symbol = table[p_symbol];
+            if (symbol.st_shndx() == SHN_UNDEF) {
+                return std::nullopt;
+            }
+            return symbol.st_value();
+        };
+
+        auto add = [&](const GElf_Shdr& p_relocations,
+                       uint64_t p_offset,
+                       uint32_t p_symbol,
+                       uint32_t p_type,
+                       std::optional<int64_t> p_addend) {
+            const slot_kind kind = classify(machine, p_type);
+            if (kind == slot_kind::ignored) {
+                return;
+            }
+            // REL sections keep the addend in the slot itself
+            const uint64_t addend
+              = p_addend.has_value() ? static_cast<uint64_t>(*p_addend)
+                                     : m_stored_pointer(p_offset).value_or(0);
+            slot_s slot{ p_offset, std::nullopt };
+            if (kind == slot_kind::relative) {
+                slot.value = addend;
+            } else if (kind == slot_kind::symbol) {
+                auto symbol = symbol_value(p_relocations, p_symbol);
+                if (symbol.has_value()) {
+                    slot.value = *symbol + addend;
+                }
+            }
+            if (slot.value.has_value() && pointer_size() == 4) {
+                *slot.value &= 0xffff'ffff;
+            }
+            m_slots.push_back(slot);
+        };
+
+        for (size_t i = 1; i < headers.size(); i++) {
+            const GElf_Shdr& header = headers[i];
+            if ((header.sh_type != SHT_REL && header.sh_type != SHT_RELA)
+                || (header.sh_flags & SHF_ALLOC) == 0) {
+                continue;
+            }
+            auto section = p_elf.get_section_view(i);
+            if (!section.has_value()) {
+                continue;
+            }
+
+            if (header.sh_type == SHT_RELA) {
+                using rela_t = typename file_t::rela;
+                const size_t stride
+                  = std::max<size_t>(header.sh_entsize, rela_t::size);
+                for (auto reloc :
+                     elf_reader::record_span<rela_t>(section->data, stride)) {
+                    add(header,
+                        reloc.r_offset(),
+                        reloc.r_sym(),
+                        reloc.r_type(),
+                        reloc.r_addend());
+                }
+            } else {
+                using rel_t = typename file_t::rel;
+                const size_t stride
+                  = std::max<size_t>(header.sh_entsize, rel_t::size);
+                for (auto reloc :
+                     elf_reader::record_span<rel_t>(section->data, stride)) {
+                    add(header,
+                        reloc.r_offset(),
+                        reloc.r_sym(),
+                        reloc.r_type(),
+                        std::nullopt);
+                }
+            }
+        }
+    });
+
+    // the loader applies relocations in order, so the last one for a slot
+    // decides its value
+    std::ranges::stable_sort(m_slots, {}, &slot_s::address);
+    auto last = std::ranges::unique(
+      m_slots.rbegin(), m_slots.rend(), {}, &slot_s::address);
+    m_slots.erase(m_slots.begin(), last.begin().base());
+    m_unresolved_slots = static_cast<size_t>(std::ranges::count_if(
+      m_slots, [](const slot_s& p_slot) { return !p_slot.value; }));
+}
+
+std::optional<uint64_t> LoadedImage::m_stored_pointer(
+  uint64_t p_address) const
+{
+    auto after = std::ranges::upper_bound(
+      m_segments, p_address, {}, &segment_s::address);
+    if (after == m_segments.begin()) {
+        return std::nullopt;
+    }
+    const segment_s& segment = *std::prev(after);
+    const uint64_t offset = p_address - segment.address;
+    if (offset >= segment.size || segment.size - offset < pointer_size()) {
+        return std::nullopt;
+    }
+    if (offset > segment.data.size()
+        || segment.data.size() - offset < pointer_size()) {
+        return 0;  // .bss is zero-filled
+    }
+
+    const std::byte* data = segment.data.data() + offset;
+    return elf_reader::visit(m_encoding, [data](auto p_file) -> uint64_t {
+        using file_t = decltype(p_file);
+        constexpr std::endian order = file_t::encoding.order;
+        if constexpr (file_t::encoding.elf_class == ELFCLASS32) {
+            return elf_reader::load<uint32_t, order>(data);
+        } else {
+            return elf_reader::load<uint64_t, order>(data);
+        }
+    });
+}
+
+std::optional<uint64_t> LoadedImage::read_pointer(uint64_t p_address) const
+{
+    auto slot
+      = std::ranges::lower_bound(m_slots, p_address, {}, &slot_s::address);
+    std::optional<uint64_t> value;
+    if (slot != m_slots.end() && slot->address == p_address) {
+        value = slot->value;
+    } else {
+        value = m_stored_pointer(p_address);
+    }
+    if (value == uint64_t{ 0 }) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+}  // namespace safe
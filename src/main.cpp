@@ -8,19 +8,40 @@
  * @copyright Copyright (c) 2025
  *
  */
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <charconv>
 #include <expected>
 #include <filesystem>
+#include <format>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <print>
 #include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "abi_parse.hpp"
+#include "archive.hpp"
+#include "arm_exidx.hpp"
+#include "dependency_graph.hpp"
+#include "eh_frame.hpp"
+#include "dead_cleanup.hpp"
+#include "demangle.hpp"
+#include "dispatch_cost.hpp"
+#include "eh_size.hpp"
 #include "elf_parser.hpp"
+#include "loaded_image.hpp"
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+#include "relocatable.hpp"
+#include "unwind_cost.hpp"
 #include "validator.hpp"
 
 /**
@@ -31,18 +52,28 @@ enum class main_error : uint8_t
 {
     INVALID_ARG_AMOUNT,  //!< Wrong argument amount
     INVALID_FLAG,        //!< Wrong flag
-    FILE_NOT_FOUND       //!< File doe not exist
+    FILE_NOT_FOUND,      //!< File doe not exist
+    MISSING_FLAG_VALUE   //!< Flag that takes a value was last
 };
 
 /**
- * @brief holds the parsed arguements passed to the program. It can either be a
- * file_name and a flag or just the file name.
+ * @brief holds the parsed arguements passed to the program. The file name is
+ * required, the flags are optional.
  *
  */
 struct arg_value_s
 {
     std::string file_name;
     std::optional<std::string_view> flag;
+    std::optional<std::string> sysroot;  //!< Set by --sysroot <dir>
+    std::vector<std::string> debug_dirs;  //!< Set by --debug-dir <dir>
+    bool debuglink_crc = true;  //!< Cleared by --no-debuglink-crc
+    std::optional<size_t> max_memory;     //!< MiB, set by --max-memory <MiB>
+    bool unwind_cost = false;             //!< Set by --unwind-cost
+    bool eh_size = false;                 //!< Set by --eh-size
+    bool dead_cleanup = false;            //!< Set by --dead-cleanup
+    bool dispatch_cost = false;           //!< Set by --dispatch-cost
+    bool throw_sites = false;             //!< Set by --throw-sites
 };
 
 /**
@@ -50,84 +81,307 @@ struct arg_value_s
  * are valid or not. Returns arg_value_s if successfull or a main_error enum if
  * failed.
  *
+ * Usage: safe [-v] [--sysroot <dir>] [--debug-dir <dir>]...
+ *             [--no-debuglink-crc]
+ *             [--max-memory <MiB>] [--unwind-cost] [--eh-size]
+ *             [--dead-cleanup] [--dispatch-cost] [--throw-sites] <file>
+ *
+ * <file> may be an executable, a shared library, a relocatable object or a
+ * static library (ar archive).
+ *
  * @param argc
  * @param argv
  * @return std::expected<arg_value_s, main_error>
  */
 std::expected<arg_value_s, main_error> validate_args(int argc, char* argv[])
 {
-    if (argc == 3) {
-        std::string flag(argv[1]);
-        std::string file_name(argv[2]);
-        if (flag != "-v") {
+    arg_value_s args;
+    std::optional<std::string> file_name;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg(argv[i]);
+        if (arg == "-v") {
+            args.flag = arg;
+        } else if (arg == "--sysroot") {
+            if (i + 1 >= argc) {
+                std::print("Missing directory after --sysroot\n");
+                return std::unexpected(main_error::MISSING_FLAG_VALUE);
+            }
+            args.sysroot = argv[++i];
+            if (!std::filesystem::is_directory(*args.sysroot)) {
+                std::print("Sysroot not found.\nDirectory: {}\n",
+                           *args.sysroot);
+                return std::unexpected(main_error::FILE_NOT_FOUND);
+            }
+        } else if (arg == "--debug-dir") {
+            if (i + 1 >= argc) {
+                std::print("Missing directory after --debug-dir\n");
+                return std::unexpected(main_error::MISSING_FLAG_VALUE);
+            }
+            args.debug_dirs.emplace_back(argv[++i]);
+        } else if (arg == "--no-debuglink-crc") {
+            args.debuglink_crc = false;
+        } else if (arg == "--unwind-cost") {
+            args.unwind_cost = true;
+        } else if (arg == "--eh-size") {
+            args.eh_size = true;
+        } else if (arg == "--dead-cleanup") {
+            args.dead_cleanup = true;
+        } else if (arg == "--dispatch-cost") {
+            args.dispatch_cost = true;
+        } else if (arg == "--throw-sites") {
+            args.throw_sites = true;
+        } else if (arg == "--max-memory") {
+            if (i + 1 >= argc) {
+                std::print("Missing size after --max-memory\n");
+                return std::unexpected(main_error::MISSING_FLAG_VALUE);
+            }
+            std::string_view value(argv[++i]);
+            size_t mebibytes = 0;
+            auto [end, ec] = std::from_chars(
+              value.data(), value.data() + value.size(), mebibytes);
+            if (ec != std::errc{} || end != value.data() + value.size()
+                || mebibytes == 0) {
+                std::print("Invalid size for --max-memory: {}\n", value);
+                return std::unexpected(main_error::INVALID_FLAG);
+            }
+            args.max_memory = mebibytes;
+        } else if (arg.starts_with("-")) {
             std::print("Invalid Flag\n");
             return std::unexpected(main_error::INVALID_FLAG);
+        } else if (file_name.has_value()) {
+            std::print("Invalid argument amount\n");
+            return std::unexpected(main_error::INVALID_ARG_AMOUNT);
+        } else {
+            file_name = std::string(arg);
         }
-        if (!std::filesystem::exists(file_name)) {
-            std::print("File not found.\nFile: {}\n", file_name);
-            return std::unexpected(main_error::FILE_NOT_FOUND);
-        }
-        return arg_value_s{ file_name, flag };
-    } else if (argc == 2) {
-        std::string file_name(argv[1]);
-        if (!std::filesystem::exists(file_name)) {
-            std::print("File not found.\nFile: {}\n", file_name);
-            return std::unexpected(main_error::FILE_NOT_FOUND);
-        }
-        return arg_value_s{ file_name, std::nullopt };
-    } else {
+    }
+
+    if (!file_name.has_value()) {
         std::print("Invalid argument amount\n");
         return std::unexpected(main_error::INVALID_ARG_AMOUNT);
     }
+    if (!std::filesystem::exists(*file_name)) {
+        std::print("File not found.\nFile: {}\n", *file_name);
+        return std::unexpected(main_error::FILE_NOT_FOUND);
+    }
+    args.file_name = std::move(*file_name);
+    return args;
 }
 
-int main(int argc, char* argv[])
+/**
+ * @brief Picks the symbol table to analyze: .symtab when present, otherwise
+ * .dynsym, which stripped and dynamically linked binaries still carry.
+ *
+ * @param p_elf
+ * @return std::expected<const SymbolTable*, elf_parser_error>
+ */
+std::expected<const SymbolTable*, elf_parser_error> analysis_symbols(
+  const ElfParser& p_elf)
 {
-    auto args = validate_args(argc, argv);
-    if (!args.has_value()) {
-        return EXIT_FAILURE;
+    auto sym = p_elf.get_compact_symbol_table();
+    if (sym.has_value()) {
+        return sym;
     }
+    return p_elf.get_dynamic_symbol_table();
+}
 
-    ElfParser elf(args->file_name);
+/**
+ * @brief Functions that can throw in one object of the dependency graph.
+ */
+struct object_report_s
+{
+    std::vector<std::string> throwing_functions;  //!< Demangled names
+    bool analyzed = false;  //!< False if symbols or .text were missing
+};
 
-    auto sym = elf.get_symbol_table();
-    if (!sym.has_value()) {
-        std::print("Failed to get symbol table\n");
+/**
+ * @brief Analyzes p_file and every shared library it needs, resolved under
+ * p_sysroot. Objects are analyzed concurrently and reported in load order.
+ *
+ * @param p_file
+ * @param p_sysroot
+ * @return int exit code
+ */
+int analyze_dependencies(const std::string& p_file, const std::string& p_sysroot)
+{
+    safe::DependencyGraph graph({ .sysroot = p_sysroot });
+    const std::filesystem::path root(p_file);
+    if (graph.load(std::span(&root, 1)).empty()) {
+        std::print("Failed to load {}\n", p_file);
         return EXIT_FAILURE;
     }
 
-    auto text = elf.get_section(".text");
-    if (!text.has_value()) {
-        std::print("Failed to get .text section\n");
-        return EXIT_FAILURE;
-    }
+    auto reports = graph.analyze([](const safe::shared_object_s& p_object) {
+        object_report_s report;
+        auto sym = analysis_symbols(*p_object.elf);
+        auto text = p_object.elf->get_section_view(".text");
+        if (!sym.has_value() || !text.has_value()) {
+            return report;
+        }
 
-    safe::Validator val(sym.value(), text.value());
+        // The log files are shared, so concurrent Validators must not write
+        safe::validator_options_s options{ .write_logs = false };
+        if (auto header = p_object.elf->get_elf_header()) {
+            options.machine = header->e_machine;
+        }
+        safe::Validator val(*sym.value(), text.value(), options);
+        for (const auto& func : val.find_thrown_functions()) {
+            report.throwing_functions.push_back(
+              val.demangle(func.name.c_str()).value_or(func.name));
+        }
+        report.analyzed = true;
+        return report;
+    });
 
-    auto gcc_except_table = elf.get_section(".gcc_except_table");
-    if (!gcc_except_table.has_value()) {
-        std::print("Failed to get .gcc_except_table section\nReason: ");
-        if (gcc_except_table.error() == elf_parser_error::EMPTY_SECTION) {
-            std::print("Elf parser does not contain sections.\n");
+    auto objects = graph.objects();
+    for (size_t i = 0; i < objects.size(); i++) {
+        std::println("=======================================");
+        std::println("Object: {}", objects[i].path.string());
+        std::println("=======================================");
+        for (size_t dependency : objects[i].dependencies) {
+            std::println("  needs {}", objects[dependency].path.string());
+        }
+        for (const auto& name : objects[i].unresolved) {
+            std::println("  needs {} (not found)", name);
         }
-        if (gcc_except_table.error() == elf_parser_error::SECTION_NOT_FOUND) {
-            std::print("Section was not found.\n");
+        if (!reports[i].analyzed) {
+            std::println("  no symbol table or .text section");
+            continue;
         }
+        std::println("Function that can throw: ");
+        for (const auto& name : reports[i].throwing_functions) {
+            std::println("  {}", name);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Finds the throwing functions of one relocatable object.
+ *
+ * @param p_elf Parser over an ET_REL object.
+ * @param p_discarded_groups COMDAT groups another object already provides.
+ * @return object_report_s
+ */
+object_report_s analyze_relocatable(
+  const ElfParser& p_elf,
+  const std::unordered_set<std::string>& p_discarded_groups)
+{
+    object_report_s report;
+    safe::RelocatableObject object(p_elf, p_discarded_groups);
+    if (object.symbols().empty() || object.text().data.empty()) {
+        return report;
+    }
+
+    // The log files are shared, so concurrent Validators must not write
+    safe::validator_options_s options{ .write_logs = false };
+    if (auto header = p_elf.get_elf_header()) {
+        options.machine = header->e_machine;
+    }
+    safe::Validator val(object.symbols(), object.text(), options);
+    for (const auto& func : val.find_thrown_functions()) {
+        report.throwing_functions.push_back(
+          val.demangle(func.name.c_str()).value_or(func.name));
+    }
+    report.analyzed = true;
+    return report;
+}
+
+/**
+ * @brief Analyzes every relocatable member of a static library concurrently
+ * and prints one report per member followed by the merged list.
+ *
+ * COMDAT groups are kept in the first member that defines them, in archive
+ * order, the way the linker would pick them, so an inline function is
+ * reported once.
+ *
+ * @param p_file
+ * @param p_image Bytes of the archive.
+ * @return int exit code
+ */
+int analyze_archive(const std::string& p_file,
+                    std::span<const std::byte> p_image)
+{
+    auto archive = Archive::parse(p_image);
+    if (!archive.has_value()) {
+        std::print("Failed to read archive {}\n", p_file);
         return EXIT_FAILURE;
     }
 
-    LsdaParser lsda(gcc_except_table->data);
+    auto members = archive->members();
+    std::vector<std::unique_ptr<ElfParser>> objects(members.size());
+    std::vector<std::unordered_set<std::string>> discarded(members.size());
+    std::unordered_set<std::string> kept_groups;
+    for (size_t i = 0; i < members.size(); i++) {
+        if (!elf_reader::identify(members[i].data).has_value()) {
+            continue;
+        }
+        auto elf = std::make_unique<ElfParser>(
+          members[i].data, members[i].name,
+          elf_parser_options_s{ .mode = elf_load_mode::LAZY });
+        auto header = elf->get_elf_header();
+        if (!header.has_value() || header->e_type != ET_REL) {
+            continue;
+        }
+        for (auto& group : safe::RelocatableObject::comdat_groups(*elf)) {
+            if (!kept_groups.insert(group.signature).second) {
+                discarded[i].insert(std::move(group.signature));
+            }
+        }
+        objects[i] = std::move(elf);
+    }
 
-    // Load LSDA catch table into Validator
-    val.load_lsda(lsda);
+    std::vector<object_report_s> reports(members.size());
+    safe::parallel_for(members.size(), [&](size_t p_index) {
+        if (objects[p_index] != nullptr) {
+            reports[p_index]
+              = analyze_relocatable(*objects[p_index], discarded[p_index]);
+        }
+    });
 
+    std::vector<std::string> merged;
+    for (size_t i = 0; i < members.size(); i++) {
+        std::println("=======================================");
+        std::println("Member: {}", members[i].name);
+        std::println("=======================================");
+        if (!reports[i].analyzed) {
+            std::println("  not a relocatable object with symbols and code");
+            continue;
+        }
+        std::println("Function that can throw: ");
+        for (const auto& name : reports[i].throwing_functions) {
+            std::println("  {}", name);
+            merged.push_back(name);
+        }
+    }
+
+    std::ranges::sort(merged);
+    merged.erase(std::ranges::unique(merged).begin(), merged.end());
+    std::println("=======================================");
+    std::println("Function that can throw ({} members): ", members.size());
+    std::println("=======================================");
+    for (const auto& name : merged) {
+        std::println("  {}", name);
+    }
+    return 0;
+}
+
+/**
+ * @brief Prints the throwing functions and the catch sites that handle each
+ * thrown type, once the Validator has its LSDAs loaded.
+ *
+ * @param p_val Validator over the analyzed code.
+ * @return int exit code
+ */
+int print_exceptions(safe::Validator& p_val)
+{
     std::println("=======================================");
     std::println("Function that can throw: ");
     std::println("=======================================");
-    std::vector<symbol_s> callsite_function = val.find_thrown_functions();
+    std::vector<symbol_s> callsite_function = p_val.find_thrown_functions();
     for (const auto& func : callsite_function) {
         std::println("  {}",
-                     val.demangle(func.name.c_str()).value_or(func.name));
+                     p_val.demangle(func.name.c_str()).value_or(func.name));
     }
 
     std::println("=======================================");
@@ -137,7 +391,13 @@ int main(int argc, char* argv[])
     for (const auto& func : callsite_function) {
         std::println("Function: {}", func.name);
 
-        auto caught_throws = val.analyze_exceptions(func.name);
+        auto caught_throws = p_val.analyze_exceptions(func.name);
+        if (!caught_throws.has_value()
+            && caught_throws.error() == safe::CorrelateError::NoCatchRecords) {
+            std::println("\tNo catch site in this function");
+            std::println("---------------------------------------");
+            continue;
+        }
         if (!caught_throws.has_value()) {
             std::print("analyze_exceptions failed\n");
             return EXIT_FAILURE;
@@ -146,7 +406,7 @@ int main(int argc, char* argv[])
         for (auto& caught_throw : caught_throws.value()) {
             symbol_s caught_throw_obj = caught_throw.thrown;
             std::string caught_throw_name
-              = val.demangle(caught_throw_obj.name.c_str())
+              = p_val.demangle(caught_throw_obj.name.c_str())
                   .value_or(caught_throw_obj.name);
             std::println("\tThrows: {}", caught_throw_name);
             auto callsite_handlers = caught_throw.handlers;
@@ -160,4 +420,603 @@ int main(int argc, char* argv[])
     }
 
     return 0;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Prints the throwing functions and the catch sites that handle each
+ * thrown type.
+ *
+ * @param p_val Validator over the analyzed code.
+ * @param p_except_table The .gcc_except_table section.
+ * @param p_eh_frame Index of .eh_frame used to find the LSDA of each
+ * function. Without it the whole table is parsed as a single LSDA.
+ * @param p_image Relocated image, used to resolve indirect type table
+ * entries to typeinfo addresses. Only used with p_eh_frame.
+ * @return int exit code
+ */
+int report_exceptions(safe::Validator& p_val,
+                      section_view_s p_except_table,
+                      const EhFrame* p_eh_frame = nullptr,
+                      const safe::LoadedImage* p_image = nullptr)
+{
+    std::optional<LsdaParser> lsda;
+    std::optional<LsdaTable> lsdas;
+    if (p_eh_frame != nullptr) {
+        // every function is reported, so decode all LSDAs up front and on
+        // every core
+        std::vector<size_t> offsets;
+        const uint64_t table_address = p_except_table.header.sh_addr;
+        for (const auto& fde : p_eh_frame->fdes().value_or(std::vector<fde_s>{})) {
+            if (fde.lsda.has_value() && *fde.lsda >= table_address) {
+                offsets.push_back(*fde.lsda - table_address);
+            }
+        }
+        PointerReader read_pointer;
+        if (p_image != nullptr) {
+            read_pointer = [p_image](uint64_t p_address) {
+                return p_image->read_pointer(p_address);
+            };
+        }
+        lsdas.emplace(p_except_table.data,
+                      table_address,
+                      std::move(offsets),
+                      read_pointer);
+        p_val.load_eh_frame(
+          *p_eh_frame, p_except_table, &*lsdas, std::move(read_pointer));
+    } else {
+        // Load LSDA catch table into Validator
+        lsda.emplace(p_except_table.data);
+        p_val.load_lsda(*lsda);
+    }
+
+    return print_exceptions(p_val);
+}
+
+/**
+ * @brief Prints the throwing functions and catch sites of an ARM EHABI
+ * image, whose LSDAs follow the unwind instructions in .ARM.extab rather
+ * than living in a .gcc_except_table.
+ *
+ * @param p_val Validator over the analyzed code.
+ * @param p_exidx Index of .ARM.exidx used to find the LSDA of each function.
+ * @param p_image Relocated image, used to resolve indirect type table
+ * entries to typeinfo addresses.
+ * @return int exit code
+ */
+int report_arm_exceptions(safe::Validator& p_val,
+                          const ArmExidx& p_exidx,
+                          const safe::LoadedImage& p_image)
+{
+    p_val.load_arm_exidx(p_exidx, [&p_image](uint64_t p_address) {
+        return p_image.read_pointer(p_address);
+    });
+    return print_exceptions(p_val);
+}
+
+/**
+ * @brief Prints the worst-case number of CFA instructions interpreted for
+ * one unwind step through each function, costliest first.
+ *
+ * @param p_elf
+ * @param p_symbols Symbols naming the functions.
+ * @return int exit code
+ */
+int report_unwind_cost(const ElfParser& p_elf, const SymbolTable& p_symbols)
+{
+    auto section = p_elf.get_section_view(".eh_frame");
+    if (!section.has_value()) {
+        std::print("Failed to get .eh_frame section\n");
+        return EXIT_FAILURE;
+    }
+    auto hdr = p_elf.get_section_view(".eh_frame_hdr");
+    auto eh_frame = EhFrame::parse(
+      *section,
+      hdr.has_value() ? std::optional(*hdr) : std::nullopt,
+      p_elf.get_encoding());
+    if (!eh_frame.has_value()) {
+        std::print("Failed to parse .eh_frame section\n");
+        return EXIT_FAILURE;
+    }
+    auto except_table = p_elf.get_section_view(".gcc_except_table");
+    const uint8_t pointer_size
+      = p_elf.get_encoding().elf_class == ELFCLASS32 ? 4 : 8;
+    const auto report = safe::profile_unwind_cost(
+      *eh_frame,
+      except_table.has_value() ? std::optional(*except_table) : std::nullopt,
+      pointer_size);
+
+    std::unordered_map<uint64_t, std::string_view> names;
+    for (size_t i = 0; i < p_symbols.size(); i++) {
+        if (ELF64_ST_TYPE(p_symbols.info(i)) == STT_FUNC) {
+            names.try_emplace(p_symbols.value(i), p_symbols.name(i));
+        }
+    }
+
+    std::println("=======================================");
+    std::println("Unwind step cost (CFA instructions): ");
+    std::println("=======================================");
+    std::println("  {:>6} {:>4} {:>6}  function", "worst", "cie", "sites");
+    for (const auto& cost : report.functions) {
+        std::string name = std::format("0x{:x}", cost.pc_begin);
+        if (auto symbol = names.find(cost.pc_begin); symbol != names.end()) {
+            name = safe::demangle(symbol->second)
+                     .value_or(std::string(symbol->second));
+        }
+        std::println("  {:>6} {:>4} {:>6}  {}",
+                     cost.worst_instructions,
+                     cost.cie_instructions,
+                     cost.call_sites,
+                     name);
+    }
+    if (report.undecodable != 0) {
+        std::println("{} FDEs could not be decoded", report.undecodable);
+    }
+    return 0;
+}
+
+/**
+ * @brief Prints the FDE comparisons and call-site records each function
+ * costs the unwinder and the personality routine, costliest first.
+ *
+ * @param p_elf
+ * @param p_symbols Symbols naming the functions.
+ * @return int exit code
+ */
+int report_dispatch_cost(const ElfParser& p_elf, const SymbolTable& p_symbols)
+{
+    auto section = p_elf.get_section_view(".eh_frame");
+    if (!section.has_value()) {
+        std::print("Failed to get .eh_frame section\n");
+        return EXIT_FAILURE;
+    }
+    auto hdr = p_elf.get_section_view(".eh_frame_hdr");
+    auto eh_frame = EhFrame::parse(
+      *section,
+      hdr.has_value() ? std::optional(*hdr) : std::nullopt,
+      p_elf.get_encoding());
+    if (!eh_frame.has_value()) {
+        std::print("Failed to parse .eh_frame section\n");
+        return EXIT_FAILURE;
+    }
+    auto except_table = p_elf.get_section_view(".gcc_except_table");
+    const uint8_t pointer_size
+      = p_elf.get_encoding().elf_class == ELFCLASS32 ? 4 : 8;
+    auto registers = p_symbols.find("__register_frame_info");
+    const bool registered = registers.has_value()
+                            && p_symbols.shndx(*registers) != SHN_UNDEF;
+    const auto report = safe::profile_dispatch_cost(
+      *eh_frame,
+      except_table.has_value() ? std::optional(*except_table) : std::nullopt,
+      pointer_size,
+      registered);
+
+    std::unordered_map<uint64_t, std::string_view> names;
+    for (size_t i = 0; i < p_symbols.size(); i++) {
+        if (ELF64_ST_TYPE(p_symbols.info(i)) == STT_FUNC) {
+            names.try_emplace(p_symbols.value(i), p_symbols.name(i));
+        }
+    }
+
+    std::println("=======================================");
+    std::println("Exception dispatch cost per frame: ");
+    std::println("=======================================");
+    constexpr std::string_view searches[] = {
+        ".eh_frame_hdr binary search",
+        "binary search of the frames sorted on the first throw",
+        "linear .eh_frame walk",
+    };
+    std::println("FDE lookup: {} over {} FDEs",
+                 searches[static_cast<size_t>(report.search)],
+                 report.fdes);
+    std::println("  {:>6} {:>5} {:>7} {:>7} {:>6} {:>6}  function",
+                 "steps",
+                 "fde",
+                 "records",
+                 "mean",
+                 "bytes",
+                 "sites");
+    for (const auto& cost : report.functions) {
+        std::string name = std::format("0x{:x}", cost.pc_begin);
+        if (auto symbol = names.find(cost.pc_begin); symbol != names.end()) {
+            name = safe::demangle(symbol->second)
+                     .value_or(std::string(symbol->second));
+        }
+        std::println("  {:>6} {:>5} {:>7} {:>7.1f} {:>6} {:>6}  {}",
+                     cost.worst_steps(),
+                     cost.fde_lookup,
+                     cost.worst_records,
+                     cost.mean_records,
+                     cost.worst_bytes,
+                     cost.call_sites,
+                     name);
+    }
+    if (report.undecodable != 0) {
+        std::println("{} FDEs or LSDAs could not be decoded",
+                     report.undecodable);
+    }
+    return 0;
+}
+
+/**
+ * @brief Prints each call to __cxa_throw with the type it throws and the
+ * size of the exception object.
+ *
+ * @param p_report Throw sites of the image.
+ * @param p_symbols Symbols naming the functions.
+ * @return int exit code
+ */
+int report_throw_sites(const safe::throw_site_report_s& p_report,
+                       const SymbolTable& p_symbols)
+{
+    if (!p_report.supported) {
+        std::print("Throw site extraction only supports x86-64 code\n");
+        return EXIT_FAILURE;
+    }
+    auto demangled = [](std::string_view p_name) {
+        // without the version of symbols copied from a shared library
+        const std::string_view mangled = p_name.substr(0, p_name.find('@'));
+        return safe::demangle(mangled).value_or(std::string(mangled));
+    };
+    std::unordered_map<uint64_t, std::string_view> names;
+    for (size_t i = 0; i < p_symbols.size(); i++) {
+        if (ELF64_ST_TYPE(p_symbols.info(i)) == STT_FUNC) {
+            names.try_emplace(p_symbols.value(i), p_symbols.name(i));
+        }
+    }
+
+    std::println("=======================================");
+    std::println("Throw sites: ");
+    std::println("=======================================");
+    std::println("{} calls to __cxa_throw in {} functions, {} bytes decoded",
+                 p_report.sites.size(),
+                 p_report.functions,
+                 p_report.decoded_bytes);
+    std::println("  {:>10} {:>6}  {:<40} function", "call", "size", "type");
+    for (const auto& site : p_report.sites) {
+        std::string function = std::format("0x{:x}", site.function);
+        if (auto symbol = names.find(site.function); symbol != names.end()) {
+            function = demangled(symbol->second);
+        }
+        std::string type = "?";
+        if (site.resolved()) {
+            type = demangled(site.typeinfo_name);
+        } else if (site.typeinfo.has_value()) {
+            type = std::format("0x{:x}", *site.typeinfo);
+        }
+        std::string size = "?";
+        if (site.exception_size.has_value()) {
+            size = std::to_string(*site.exception_size);
+        }
+        std::println(
+          "  {:>#10x} {:>6}  {:<40} {}", site.call, size, type, function);
+    }
+    if (p_report.unresolved != 0) {
+        std::println("{} throw sites of unknown type", p_report.unresolved);
+    }
+    return 0;
+}
+
+/**
+ * @brief Prints the exception handling bytes of every function, then of
+ * every template family, as tab-separated tables sorted by total, followed
+ * by the shared bytes and the runtime routines exceptions link in.
+ *
+ * @param p_elf
+ * @param p_symbols Symbols naming the functions.
+ * @return int exit code
+ */
+int report_eh_size(const ElfParser& p_elf, const SymbolTable& p_symbols)
+{
+    const auto report = safe::attribute_eh_bytes(p_elf, p_symbols);
+    auto print_row = [](std::string_view p_name,
+                        const safe::eh_bytes_s& p_bytes) {
+        std::println("{}\t{}\t{}\t{}\t{}\t{}\t{}\t{}",
+                     p_bytes.total(),
+                     p_bytes.except_table,
+                     p_bytes.eh_frame,
+                     p_bytes.eh_frame_hdr,
+                     p_bytes.arm_exidx,
+                     p_bytes.arm_extab,
+                     p_bytes.landing_pads,
+                     p_name);
+    };
+    constexpr std::string_view columns
+      = "total\texcept_table\teh_frame\teh_frame_hdr\tarm_exidx\t"
+        "arm_extab\tlanding_pads";
+
+    std::println("# functions");
+    std::println("{}\tfunction\tfamily", columns);
+    for (const auto& function : report.functions) {
+        print_row(std::format("{}\t{}", function.name, function.family),
+                  function.bytes);
+    }
+    std::println("# families");
+    std::println("{}\tfamily", columns);
+    for (const auto& family : safe::group_by_family(report.functions)) {
+        print_row(family.family, family.bytes);
+    }
+    std::println("# shared");
+    std::println("{}\towner", columns);
+    print_row("CIEs, headers and padding", report.shared);
+    std::println("# runtime");
+    std::println("size\troutine");
+    for (const auto& routine : report.runtime) {
+        std::println("{}\t{}", routine.size, routine.name);
+    }
+    return 0;
+}
+
+/**
+ * @brief Prints the cleanup landing pads no exception can reach, per
+ * function as a tab-separated table sorted by the bytes they cost, followed
+ * by the callees that would have to be marked noexcept.
+ *
+ * @param p_elf
+ * @param p_symbols Symbols naming the functions.
+ * @return int exit code
+ */
+int report_dead_cleanup(const ElfParser& p_elf, const SymbolTable& p_symbols)
+{
+    const auto report = safe::find_dead_cleanups(p_elf, p_symbols);
+    if (!report.supported) {
+        std::print("Dead cleanup detection only supports x86-64 code\n");
+        return EXIT_FAILURE;
+    }
+    std::println("# {} of {} cleanup regions can never run, {} bytes",
+                 report.dead_regions,
+                 report.cleanup_regions,
+                 report.savings.total());
+    std::println("# functions");
+    std::println("total\tcall_sites\tlanding_pads\texcept_table\tregions\t"
+                 "function");
+    for (const auto& function : report.functions) {
+        std::println("{}\t{}\t{}\t{}\t{}/{}\t{}",
+                     function.savings.total(),
+                     function.savings.call_sites,
+                     function.savings.landing_pads,
+                     function.savings.except_table,
+                     function.dead.size(),
+                     function.cleanup_regions,
+                     function.name);
+    }
+    std::println("# regions");
+    std::println("start\tend\tlanding_pad\tcallees");
+    for (const auto& function : report.functions) {
+        for (const auto& region : function.dead) {
+            std::string callees;
+            for (const auto& callee : region.callees) {
+                callees += callees.empty() ? callee : ", " + callee;
+            }
+            std::println("0x{:x}\t0x{:x}\t0x{:x}\t{}",
+                         region.start,
+                         region.end,
+                         region.landing_pad,
+                         callees);
+        }
+    }
+    std::println("# noexcept candidates");
+    std::println("regions\tcallee");
+    for (const auto& callee : report.callees) {
+        std::println("{}\t{}", callee.regions, callee.name);
+    }
+    if (report.undecodable != 0) {
+        std::println("# {} LSDAs could not be decoded", report.undecodable);
+    }
+    return 0;
+}
+
+/**
+ * @brief Peak resident set of the process so far, in MiB.
+ */
+size_t peak_resident_mib()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<size_t>(usage.ru_maxrss) / 1024;
+}
+
+/**
+ * @brief Enforces --max-memory between two phases of the analysis: drops
+ * every mapped page consumed so far, then checks the peak resident set.
+ *
+ * @param p_elf Parser whose mappings are released.
+ * @param p_budget The --max-memory budget, in MiB.
+ * @param p_phase What was done last, for the message.
+ * @return bool false, once the message is printed, if the peak passed the
+ * budget.
+ */
+bool within_budget(const ElfParser& p_elf,
+                   size_t p_budget,
+                   std::string_view p_phase)
+{
+    p_elf.release_pages();
+    const size_t peak = peak_resident_mib();
+    if (peak <= p_budget) {
+        return true;
+    }
+    std::print("Memory budget of {} MiB exceeded after {}: {} MiB resident\n",
+               p_budget,
+               p_phase,
+               peak);
+    return false;
+}
+
+int main(int argc, char* argv[])
+{
+    auto args = validate_args(argc, argv);
+    if (!args.has_value()) {
+        return EXIT_FAILURE;
+    }
+
+    if (args->sysroot.has_value()) {
+        return analyze_dependencies(args->file_name, *args->sysroot);
+    }
+
+    auto mapping = MappedFile::open(args->file_name);
+    if (mapping.has_value() && Archive::is_archive(mapping->bytes())) {
+        return analyze_archive(args->file_name, mapping->bytes());
+    }
+
+    // Stripped binaries take their symbols from a separate debug file; the
+    // system debug tree is searched after the given directories
+    std::vector<std::string> debug_dirs = args->debug_dirs;
+    debug_dirs.emplace_back("/usr/lib/debug");
+
+    // Only .text, the symbol table and .gcc_except_table are needed here
+    ElfParser elf(args->file_name,
+                  { .mode = elf_load_mode::LAZY,
+                    .debug_directories = std::move(debug_dirs),
+                    .verify_debuglink_crc = args->debuglink_crc });
+
+    auto header = elf.get_elf_header();
+    if (header.has_value() && header->e_type == ET_REL) {
+        safe::RelocatableObject object(elf);
+        if (object.symbols().empty()) {
+            std::print("Failed to get symbol table\n");
+            return EXIT_FAILURE;
+        }
+        auto except_table = object.except_table();
+        if (except_table.data.empty()) {
+            std::print("Failed to get .gcc_except_table section\nReason: "
+                       "Section was not found.\n");
+            return EXIT_FAILURE;
+        }
+        safe::Validator val(object.symbols(),
+                            object.text(),
+                            { .machine = header->e_machine });
+        return report_exceptions(val, except_table);
+    }
+
+    auto sym = analysis_symbols(elf);
+    if (!sym.has_value()) {
+        std::print("Failed to get symbol table\n");
+        return EXIT_FAILURE;
+    }
+    if (args->max_memory.has_value()
+        && !within_budget(elf, *args->max_memory, "loading the symbols")) {
+        return EXIT_FAILURE;
+    }
+    if (args->eh_size) {
+        return report_eh_size(elf, *sym.value());
+    }
+    if (args->dead_cleanup) {
+        return report_dead_cleanup(elf, *sym.value());
+    }
+    if (args->unwind_cost) {
+        return report_unwind_cost(elf, *sym.value());
+    }
+    if (args->dispatch_cost) {
+        return report_dispatch_cost(elf, *sym.value());
+    }
+
+    auto text = elf.get_section_view(".text");
+    if (!text.has_value()) {
+        std::print("Failed to get .text section\n");
+        return EXIT_FAILURE;
+    }
+
+    // Streaming: scan .text in function-aligned windows and drop every
+    // window, and every table already decoded, from memory once consumed
+    safe::validator_options_s val_options;
+    if (header.has_value()) {
+        val_options.machine = header->e_machine;
+    }
+    val_options.order = elf.get_encoding().order;
+    if (args->max_memory.has_value()) {
+        // a quarter of the budget for .text, the rest for the tables
+        val_options.window_size
+          = std::max<size_t>(*args->max_memory * 1024 * 1024 / 4, 64 * 1024);
+        val_options.release = [&elf](std::span<const std::byte> p_bytes) {
+            elf.release_pages(p_bytes);
+        };
+    }
+    safe::Validator val(*sym.value(), text.value(), val_options);
+    // the typeinfo each __cxa_throw is passed, rather than every RTTI
+    // reference, which catch clauses, typeid and dynamic_cast make too
+    const auto throw_sites = safe::find_throw_sites(
+      elf,
+      *sym.value(),
+      { .window_size = val_options.window_size,
+        .release = val_options.release });
+    if (args->max_memory.has_value()
+        && !within_budget(elf, *args->max_memory, "finding throw sites")) {
+        return EXIT_FAILURE;
+    }
+    if (args->throw_sites) {
+        return report_throw_sites(throw_sites, *sym.value());
+    }
+    if (throw_sites.supported) {
+        val.load_throw_sites(throw_sites.sites);
+    }
+
+    // ARM EHABI images find each function's LSDA through .ARM.exidx and keep
+    // it in .ARM.extab, so they need no .gcc_except_table
+    std::optional<ArmExidx> arm_exidx;
+    if (header.has_value() && header->e_machine == EM_ARM) {
+        if (auto exidx = elf.get_section_view(".ARM.exidx"); exidx) {
+            auto extab = elf.get_section_view(".ARM.extab");
+            auto parsed = ArmExidx::parse(
+              *exidx,
+              extab.has_value() ? std::optional(*extab) : std::nullopt,
+              elf.get_encoding());
+            if (parsed.has_value()) {
+                arm_exidx = std::move(*parsed);
+            }
+        }
+    }
+
+    section_view_s except_table{};
+    std::optional<EhFrame> eh_frame;
+    if (!arm_exidx.has_value()) {
+        auto gcc_except_table = elf.get_section_view(".gcc_except_table");
+        if (!gcc_except_table.has_value()) {
+            std::print("Failed to get .gcc_except_table section\nReason: ");
+            if (gcc_except_table.error() == elf_parser_error::EMPTY_SECTION) {
+                std::print("Elf parser does not contain sections.\n");
+            }
+            if (gcc_except_table.error()
+                == elf_parser_error::SECTION_NOT_FOUND) {
+                std::print("Section was not found.\n");
+            }
+            return EXIT_FAILURE;
+        }
+        except_table = *gcc_except_table;
+
+        // .eh_frame gives every function its own LSDA; .eh_frame_hdr, when
+        // present, lets that lookup skip decoding the whole section
+        if (auto section = elf.get_section_view(".eh_frame"); section) {
+            auto hdr = elf.get_section_view(".eh_frame_hdr");
+            auto parsed = EhFrame::parse(
+              *section,
+              hdr.has_value() ? std::optional(*hdr) : std::nullopt,
+              elf.get_encoding());
+            if (parsed.has_value()) {
+                eh_frame = std::move(*parsed);
+            }
+        }
+    }
+    const EhFrame* eh_frame_index = eh_frame.has_value() ? &*eh_frame : nullptr;
+    // PIE type tables point at GOT slots the loader fills in
+    const safe::LoadedImage image(elf);
+    auto report = [&] {
+        if (arm_exidx.has_value()) {
+            return report_arm_exceptions(val, *arm_exidx, image);
+        }
+        return report_exceptions(val, except_table, eh_frame_index, &image);
+    };
+
+    if (!args->max_memory.has_value()) {
+        return report();
+    }
+
+    // the exception table is read back from the file, LSDA by LSDA
+    if (!within_budget(elf, *args->max_memory, "indexing the unwind tables")) {
+        return EXIT_FAILURE;
+    }
+    const int result = report();
+    std::println("Peak resident memory: {} MiB", peak_resident_mib());
+    if (!within_budget(elf, *args->max_memory, "the report")) {
+        return EXIT_FAILURE;
+    }
+    return result;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file mapped_file.cpp
+ * @author SAFE Group
+ * @brief Read-only memory mapping of a whole file implementation file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+std::expected<MappedFile, std::system_error> MappedFile::open(
+  std::string_view p_path,
+  bool p_random_access)
+{
+    MappedFile mapping;
+    const std::string path(p_path);
+    mapping.m_file = ::open(path.c_str(), O_RDONLY, 0);
+    if (mapping.m_file < 0) {
+        return std::unexpected(
+          std::system_error(errno, std::generic_category(), "Open failed."));
+    }
+
+    struct stat file_stat;
+    if (fstat(mapping.m_file, &file_stat) < 0) {
+        return std::unexpected(
+          std::system_error(errno, std::generic_category(), "Stat failed."));
+    }
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    if (size == 0) {
+        return std::unexpected(
+          std::system_error(EINVAL, std::generic_category(), "File is empty."));
+    }
+
+    // Records are read in place, so the mapping is never written
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, mapping.m_file, 0);
+    if (data == MAP_FAILED) {
+        return std::unexpected(
+          std::system_error(errno, std::generic_category(), "Mmap failed."));
+    }
+    mapping.m_data = static_cast<std::byte*>(data);
+    mapping.m_size = size;
+    if (p_random_access) {
+        madvise(data, size, MADV_RANDOM);
+    }
+    return mapping;
+}
+
+MappedFile::MappedFile(MappedFile&& p_other) noexcept
+  : m_file(std::exchange(p_other.m_file, -1))
+  , m_data(std::exchange(p_other.m_data, nullptr))
+  , m_size(std::exchange(p_other.m_size, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& p_other) noexcept
+{
+    if (this != &p_other) {
+        m_release();
+        m_file = std::exchange(p_other.m_file, -1);
+        m_data = std::exchange(p_other.m_data, nullptr);
+        m_size = std::exchange(p_other.m_size, 0);
+    }
+    return *this;
+}
+
+void MappedFile::release(std::span<const std::byte> p_bytes) const noexcept
+{
+    if (m_data == nullptr || p_bytes.empty()) {
+        return;
+    }
+    const auto page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto mapping_begin = reinterpret_cast<uintptr_t>(m_data);
+    const auto mapping_end = mapping_begin + m_size;
+    auto begin = std::max(reinterpret_cast<uintptr_t>(p_bytes.data()),
+                          mapping_begin);
+    auto end = std::min(reinterpret_cast<uintptr_t>(p_bytes.data())
+                          + p_bytes.size(),
+                        mapping_end);
+    // whole pages only: the neighbours may still be in use
+    begin = (begin + page - 1) / page * page;
+    end = end / page * page;
+    if (begin < end) {
+        madvise(reinterpret_cast<void*>(begin), end - begin, MADV_DONTNEED);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    m_release();
+}
+
+void MappedFile::m_release() noexcept
+{
+    if (m_data != nullptr) {
+        munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+    if (m_file >= 0) {
+        close(m_file);
+        m_file = -1;
+    }
+}
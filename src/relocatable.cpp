@@ -0,0 +1,524 @@
+/**
+ * @file relocatable.cpp
+ * @author SAFE Group
+ * @brief Relocatable (ET_REL) object loading implementation file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "relocatable.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include "elf_reader.hpp"
+
+namespace safe {
+
+namespace {
+
+// Relocation types from the x86-64 psABI
+namespace x86_64_reloc {
+constexpr uint32_t none = 0;
+constexpr uint32_t abs64 = 1;
+constexpr uint32_t pc32 = 2;
+constexpr uint32_t plt32 = 4;
+constexpr uint32_t gotpcrel = 9;
+constexpr uint32_t abs32 = 10;
+constexpr uint32_t abs32s = 11;
+constexpr uint32_t pc64 = 24;
+constexpr uint32_t gotpcrelx = 41;
+constexpr uint32_t rex_gotpcrelx = 42;
+}  // namespace x86_64_reloc
+
+// Relocation types from the ELF for the Arm Architecture ABI (AAELF32)
+namespace arm_reloc {
+constexpr uint32_t none = 0;
+constexpr uint32_t pc24 = 1;
+constexpr uint32_t abs32 = 2;
+constexpr uint32_t rel32 = 3;
+constexpr uint32_t thm_call = 10;
+constexpr uint32_t call = 28;
+constexpr uint32_t jump24 = 29;
+constexpr uint32_t thm_jump24 = 30;
+constexpr uint32_t target1 = 38;
+constexpr uint32_t target2 = 41;
+constexpr uint32_t prel31 = 42;
+}  // namespace arm_reloc
+
+constexpr uint64_t slot_size = 16;
+
+uint64_t align_up(uint64_t p_value, uint64_t p_align)
+{
+    if (p_align <= 1) {
+        return p_value;
+    }
+    return (p_value + p_align - 1) / p_align * p_align;
+}
+
+// Sign-extends the low p_bits bits of p_value
+int64_t sign_extend(uint64_t p_value, unsigned p_bits)
+{
+    const uint64_t sign = uint64_t{ 1 } << (p_bits - 1);
+    p_value &= (sign << 1) - 1;
+    return static_cast<int64_t>((p_value ^ sign) - sign);
+}
+
+uint32_t load_word(const std::byte* p_data, std::endian p_order)
+{
+    return p_order == std::endian::little
+             ? elf_reader::load<uint32_t, std::endian::little>(p_data)
+             : elf_reader::load<uint32_t, std::endian::big>(p_data);
+}
+
+// Name of the section described by p_header, or "" if it cannot be read
+std::string_view section_name(const ElfParser& p_elf, const GElf_Shdr& p_header)
+{
+    auto elf_header = p_elf.get_elf_header();
+    auto headers = p_elf.get_section_headers();
+    if (!elf_header.has_value() || headers.empty()) {
+        return {};
+    }
+    size_t names_index = elf_header->e_shstrndx;
+    if (names_index == SHN_XINDEX) {
+        names_index = headers[0].sh_link;
+    }
+    auto names = p_elf.get_section_view(names_index);
+    if (!names.has_value() || p_header.sh_name >= names->data.size()) {
+        return {};
+    }
+    const char* chars = reinterpret_cast<const char*>(names->data.data());
+    const size_t max_len = names->data.size() - p_header.sh_name;
+    return { chars + p_header.sh_name,
+             strnlen(chars + p_header.sh_name, max_len) };
+}
+
+bool is_except_table(std::string_view p_name)
+{
+    return p_name == ".gcc_except_table"
+           || p_name.starts_with(".gcc_except_table.");
+}
+
+template<std::endian Order>
+bool apply_x86_64(uint32_t p_type,
+                  std::byte* p_place,
+                  uint64_t p_room,
+                  uint64_t p_symbol,
+                  int64_t p_addend,
+                  uint64_t p_address)
+{
+    const uint64_t absolute = p_symbol + static_cast<uint64_t>(p_addend);
+    const uint64_t relative = absolute - p_address;
+    auto put32 = [&](uint64_t p_value) {
+        if (p_room < 4) {
+            return false;
+        }
+        elf_reader::store<uint32_t, Order>(p_place,
+                                           static_cast<uint32_t>(p_value));
+        return true;
+    };
+    auto put64 = [&](uint64_t p_value) {
+        if (p_room < 8) {
+            return false;
+        }
+        elf_reader::store<uint64_t, Order>(p_place, p_value);
+        return true;
+    };
+
+    switch (p_type) {
+        case x86_64_reloc::none:
+            return true;
+        case x86_64_reloc::abs64:
+            return put64(absolute);
+        case x86_64_reloc::pc64:
+            return put64(relative);
+        case x86_64_reloc::abs32:
+        case x86_64_reloc::abs32s:
+            return put32(absolute);
+        case x86_64_reloc::pc32:
+        case x86_64_reloc::plt32:
+        // resolved to the symbol itself, as GOT relaxation would
+        case x86_64_reloc::gotpcrel:
+        case x86_64_reloc::gotpcrelx:
+        case x86_64_reloc::rex_gotpcrelx:
+            return put32(relative);
+        default:
+            return false;
+    }
+}
+
+// REL sections keep the addend in the patched field, so p_addend is only
+// set for RELA sections
+template<std::endian Order>
+bool apply_arm(uint32_t p_type,
+               std::byte* p_place,
+               uint64_t p_room,
+               uint64_t p_symbol,
+               std::optional<int64_t> p_addend,
+               uint64_t p_address)
+{
+    if (p_type == arm_reloc::none) {
+        return true;
+    }
+    if (p_room < 4) {
+        return false;
+    }
+    const uint32_t word = elf_reader::load<uint32_t, Order>(p_place);
+    auto put = [&](uint64_t p_value) {
+        elf_reader::store<uint32_t, Order>(p_place,
+                                           static_cast<uint32_t>(p_value));
+        return true;
+    };
+
+    switch (p_type) {
+        case arm_reloc::abs32:
+        case arm_reloc::target1:
+        case arm_reloc::target2:
+            return put(p_symbol + p_addend.value_or(sign_extend(word, 32)));
+        case arm_reloc::rel32:
+            return put(p_symbol + p_addend.value_or(sign_extend(word, 32))
+                       - p_address);
+        case arm_reloc::prel31: {
+            const uint64_t value
+              = p_symbol + p_addend.value_or(sign_extend(word, 31)) - p_address;
+            return put((word & 0x80000000) | (value & 0x7fffffff));
+        }
+        case arm_reloc::pc24:
+        case arm_reloc::call:
+        case arm_reloc::jump24: {
+            const int64_t addend
+              = p_addend.value_or(sign_extend(word & 0xffffff, 24) * 4);
+            const uint64_t value = (p_symbol & ~uint64_t{ 1 }) + addend
+                                   - p_address;
+            return put((word & 0xff000000) | ((value >> 2) & 0xffffff));
+        }
+        case arm_reloc::thm_call:
+        case arm_reloc::thm_jump24: {
+            // Thumb-2 BL/B.W: S:I1:I2:imm10:imm11:0, with I = NOT(J XOR S)
+            const uint16_t upper = elf_reader::load<uint16_t, Order>(p_place);
+            const uint16_t lower
+              = elf_reader::load<uint16_t, Order>(p_place + 2);
+            const uint64_t sign = (upper >> 10) & 1;
+            const uint64_t i1 = ((lower >> 13) ^ sign ^ 1) & 1;
+            const uint64_t i2 = ((lower >> 11) ^ sign ^ 1) & 1;
+            const uint64_t offset = (sign << 24) | (i1 << 23) | (i2 << 22)
+                                    | (uint64_t{ upper & 0x3ffu } << 12)
+                                    | (uint64_t{ lower & 0x7ffu } << 1);
+            const int64_t addend = p_addend.value_or(sign_extend(offset, 25));
+            const uint64_t value = (p_symbol & ~uint64_t{ 1 }) + addend
+                                   - p_address;
+
+            const uint64_t new_sign = (value >> 24) & 1;
+            const uint64_t j1 = (((value >> 23) & 1) ^ new_sign ^ 1) & 1;
+            const uint64_t j2 = (((value >> 22) & 1) ^ new_sign ^ 1) & 1;
+            elf_reader::store<uint16_t, Order>(
+              p_place,
+              static_cast<uint16_t>((upper & 0xf800) | (new_sign << 10)
+                                    | ((value >> 12) & 0x3ff)));
+            elf_reader::store<uint16_t, Order>(
+              p_place + 2,
+              static_cast<uint16_t>((lower & 0xd000) | (j1 << 13) | (j2 << 11)
+                                    | ((value >> 1) & 0x7ff)));
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+std::vector<comdat_group_s> RelocatableObject::comdat_groups(
+  const ElfParser& p_elf)
+{
+    std::vector<comdat_group_s> groups;
+    auto headers = p_elf.get_section_headers();
+    auto symbols = p_elf.get_symbol_table();
+    const std::endian order = p_elf.get_encoding().order;
+    for (size_t i = 1; i < headers.size(); i++) {
+        if (headers[i].sh_type != SHT_GROUP) {
+            continue;
+        }
+        auto group = p_elf.get_section_view(i);
+        if (!group.has_value() || group->data.size() < 4) {
+            continue;
+        }
+        // flag word followed by the member section indices
+        const std::byte* words = group->data.data();
+        if ((load_word(words, order) & GRP_COMDAT) == 0) {
+            continue;
+        }
+
+        comdat_group_s comdat;
+        // sh_info is the signature symbol in the sh_link symbol table
+        if (symbols.has_value() && headers[i].sh_info < symbols->size()) {
+            comdat.signature = (*symbols)[headers[i].sh_info].name;
+        }
+        for (size_t offset = 4; offset + 4 <= group->data.size(); offset += 4) {
+            comdat.sections.push_back(load_word(words + offset, order));
+        }
+        groups.push_back(std::move(comdat));
+    }
+    return groups;
+}
+
+RelocatableObject::RelocatableObject(
+  const ElfParser& p_elf,
+  const std::unordered_set<std::string>& p_discarded_groups)
+{
+    std::vector<bool> discarded(p_elf.get_section_headers().size(), false);
+    if (!p_discarded_groups.empty()) {
+        for (const auto& group : comdat_groups(p_elf)) {
+            if (!p_discarded_groups.contains(group.signature)) {
+                continue;
+            }
+            for (uint32_t section : group.sections) {
+                if (section < discarded.size() && !discarded[section]) {
+                    discarded[section] = true;
+                    m_discarded_sections++;
+                }
+            }
+        }
+    }
+
+    m_layout(p_elf, discarded);
+    m_resolve_symbols(p_elf, discarded);
+    m_relocate(p_elf);
+}
+
+section_view_s RelocatableObject::text() const
+{
+    return m_view(base_address, m_text_end, SHF_ALLOC | SHF_EXECINSTR);
+}
+
+section_view_s RelocatableObject::except_table() const
+{
+    return m_view(m_except_begin, m_except_end, SHF_ALLOC);
+}
+
+std::optional<uint64_t> RelocatableObject::section_address(
+  size_t p_index) const
+{
+    if (p_index >= m_addresses.size()) {
+        return std::nullopt;
+    }
+    return m_addresses[p_index];
+}
+
+void RelocatableObject::m_layout(const ElfParser& p_elf,
+                                 const std::vector<bool>& p_discarded)
+{
+    auto headers = p_elf.get_section_headers();
+    m_addresses.assign(headers.size(), std::nullopt);
+
+    // 0: code, 1: exception tables, 2: other data, 3: SHT_NOBITS
+    std::vector<int> ranks(headers.size(), -1);
+    for (size_t i = 1; i < headers.size(); i++) {
+        const GElf_Shdr& header = headers[i];
+        if ((header.sh_flags & SHF_ALLOC) == 0 || p_discarded[i]) {
+            continue;
+        }
+        if (header.sh_type == SHT_NOBITS) {
+            ranks[i] = 3;
+        } else if ((header.sh_flags & SHF_EXECINSTR) != 0) {
+            ranks[i] = 0;
+        } else if (is_except_table(section_name(p_elf, header))) {
+            ranks[i] = 1;
+        } else {
+            ranks[i] = 2;
+        }
+    }
+
+    uint64_t address = base_address;
+    for (int rank = 0; rank <= 3; rank++) {
+        bool first = true;
+        for (size_t i = 1; i < headers.size(); i++) {
+            if (ranks[i] != rank) {
+                continue;
+            }
+            address = align_up(address, headers[i].sh_addralign);
+            if (rank == 1 && first) {
+                m_except_begin = address;
+            }
+            first = false;
+            m_addresses[i] = address;
+            address += headers[i].sh_size;
+        }
+        if (rank == 0) {
+            m_text_end = address;
+        } else if (rank == 1) {
+            if (first) {
+                m_except_begin = address;
+            }
+            m_except_end = address;
+        } else if (rank == 2) {
+            // SHT_NOBITS sections need addresses but no bytes
+            m_image.resize(address - base_address);
+        }
+    }
+    m_next_slot = align_up(address, slot_size);
+
+    for (size_t i = 1; i < headers.size(); i++) {
+        if (ranks[i] < 0 || ranks[i] == 3) {
+            continue;
+        }
+        auto section = p_elf.get_section_view(i);
+        if (!section.has_value()) {
+            continue;
+        }
+        const size_t size
+          = std::min<size_t>(section->data.size(), headers[i].sh_size);
+        std::memcpy(m_image.data() + (*m_addresses[i] - base_address),
+                    section->data.data(),
+                    size);
+    }
+}
+
+void RelocatableObject::m_resolve_symbols(const ElfParser& p_elf,
+                                          const std::vector<bool>& p_discarded)
+{
+    auto symbols = p_elf.get_symbol_table();
+    if (!symbols.has_value()) {
+        return;
+    }
+    auto headers = p_elf.get_section_headers();
+    m_symbols.reserve(symbols->size());
+    for (size_t i = 0; i < symbols->size(); i++) {
+        symbol_s symbol = (*symbols)[i];
+        const uint16_t shndx = symbol.shndx;
+        if (i == 0 || shndx == SHN_ABS) {
+            // null symbol and absolute values stay as they are
+        } else if (shndx < m_addresses.size() && m_addresses[shndx]) {
+            symbol.value += *m_addresses[shndx];
+        } else if (shndx == SHN_UNDEF || shndx == SHN_COMMON
+                   || shndx >= headers.size() || p_discarded[shndx]) {
+            std::string name = symbol.name;
+            if (GELF_ST_TYPE(symbol.info) == STT_SECTION
+                && shndx < headers.size()) {
+                name = section_name(p_elf, headers[shndx]);
+            }
+            symbol.value = name.empty() ? 0 : m_slot(name);
+            symbol.shndx = SHN_UNDEF;
+        }
+        // symbols in non-allocated sections keep section-relative values
+        m_symbols.push_back(std::move(symbol));
+    }
+}
+
+void RelocatableObject::m_relocate(const ElfParser& p_elf)
+{
+    auto headers = p_elf.get_section_headers();
+    auto elf_header = p_elf.get_elf_header();
+    if (!elf_header.has_value()) {
+        return;
+    }
+    const uint16_t machine = elf_header->e_machine;
+
+    elf_reader::visit(p_elf.get_encoding(), [&](auto p_file) {
+        using file_t = decltype(p_file);
+        constexpr std::endian order = file_t::encoding.order;
+
+        auto apply = [&](uint64_t p_target,
+                         uint64_t p_offset,
+                         uint32_t p_symbol,
+                         uint32_t p_type,
+                         std::optional<int64_t> p_addend) {
+            const uint64_t section_size = headers[p_target].sh_size;
+            const uint64_t symbol
+              = p_symbol < m_symbols.size() ? m_symbols[p_symbol].value : 0;
+            bool applied = false;
+            if (p_offset < section_size) {
+                const uint64_t address = *m_addresses[p_target] + p_offset;
+                std::byte* place = m_image.data() + (address - base_address);
+                const uint64_t room = section_size - p_offset;
+                if (machine == EM_X86_64) {
+                    applied = apply_x86_64<order>(p_type,
+                                                  place,
+                                                  room,
+                                                  symbol,
+                                                  p_addend.value_or(0),
+                                                  address);
+                } else if (machine == EM_ARM) {
+                    applied = apply_arm<order>(
+                      p_type, place, room, symbol, p_addend, address);
+                }
+            }
+            if (!applied) {
+                m_unsupported_relocations++;
+            }
+        };
+
+        for (size_t i = 1; i < headers.size(); i++) {
+            const GElf_Shdr& header = headers[i];
+            if (header.sh_type != SHT_REL && header.sh_type != SHT_RELA) {
+                continue;
+            }
+            // relocations of discarded or non-allocated sections do not
+            // affect the analysis
+            const uint64_t target = header.sh_info;
+            if (target >= m_addresses.size() || !m_addresses[target]
+                || headers[target].sh_type == SHT_NOBITS) {
+                continue;
+            }
+            auto section = p_elf.get_section_view(i);
+            if (!section.has_value()) {
+                continue;
+            }
+
+            if (header.sh_type == SHT_RELA) {
+                using rela_t = typename file_t::rela;
+                const size_t stride
+                  = std::max<size_t>(header.sh_entsize, rela_t::size);
+                for (auto reloc :
+                     elf_reader::record_span<rela_t>(section->data, stride)) {
+                    apply(target,
+                          reloc.r_offset(),
+                          reloc.r_sym(),
+                          reloc.r_type(),
+                          reloc.r_addend());
+                }
+            } else {
+                using rel_t = typename file_t::rel;
+                const size_t stride
+                  = std::max<size_t>(header.sh_entsize, rel_t::size);
+                for (auto reloc :
+                     elf_reader::record_span<rel_t>(section->data, stride)) {
+                    apply(target,
+                          reloc.r_offset(),
+                          reloc.r_sym(),
+                          reloc.r_type(),
+                          std::nullopt);
+                }
+            }
+        }
+    });
+}
+
+uint64_t RelocatableObject::m_slot(const std::string& p_name)
+{
+    auto [slot, inserted] = m_slots.try_emplace(p_name, m_next_slot);
+    if (inserted) {
+        m_next_slot += slot_size;
+    }
+    return slot->second;
+}
+
+section_view_s RelocatableObject::m_view(uint64_t p_begin,
+                                         uint64_t p_end,
+                                         uint64_t p_flags) const
+{
+    GElf_Shdr header{};
+    header.sh_type = SHT_PROGBITS;
+    header.sh_flags = p_flags;
+    header.sh_addr = p_begin;
+    header.sh_size = p_end - p_begin;
+    return { header,
+             std::span(m_image).subspan(p_begin - base_address,
+                                        p_end - p_begin) };
+}
+
+}  // namespace safe
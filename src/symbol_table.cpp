@@ -0,0 +1,321 @@
+/**
+ * @file symbol_table.cpp
+ * @author SAFE Group
+ * @brief Compact structure-of-arrays ELF symbol table implementation file
+ * @version 0.1
+ * @date 2026-10-16
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "symbol_table.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <gelf.h>
+
+#include "elf_parser.hpp"
+
+std::optional<ElfHashTable> ElfHashTable::gnu(
+  std::span<const std::byte> p_section,
+  size_t p_bloom_word_size,
+  std::endian p_order)
+{
+    ElfHashTable table;
+    table.m_section = p_section;
+    table.m_is_gnu = true;
+    table.m_swap = p_order != std::endian::native;
+    table.m_bloom_word_size = p_bloom_word_size;
+    if (p_section.size() < 16
+        || (p_bloom_word_size != 4 && p_bloom_word_size != 8)) {
+        return std::nullopt;
+    }
+
+    table.m_bucket_count = table.m_word(0);
+    table.m_symbol_offset = table.m_word(4);
+    table.m_bloom_size = table.m_word(8);
+    table.m_bloom_shift = table.m_word(12);
+    table.m_buckets_offset
+      = 16 + static_cast<size_t>(table.m_bloom_size) * p_bloom_word_size;
+    table.m_chain_offset
+      = table.m_buckets_offset + static_cast<size_t>(table.m_bucket_count) * 4;
+
+    if (table.m_bucket_count == 0 || table.m_bloom_size == 0
+        || table.m_chain_offset > p_section.size()) {
+        return std::nullopt;
+    }
+    return table;
+}
+
+std::optional<ElfHashTable> ElfHashTable::sysv(
+  std::span<const std::byte> p_section,
+  std::endian p_order)
+{
+    ElfHashTable table;
+    table.m_section = p_section;
+    table.m_swap = p_order != std::endian::native;
+    if (p_section.size() < 8) {
+        return std::nullopt;
+    }
+
+    table.m_bucket_count = table.m_word(0);
+    table.m_chain_count = table.m_word(4);
+    table.m_buckets_offset = 8;
+    table.m_chain_offset
+      = table.m_buckets_offset + static_cast<size_t>(table.m_bucket_count) * 4;
+
+    const size_t end
+      = table.m_chain_offset + static_cast<size_t>(table.m_chain_count) * 4;
+    if (table.m_bucket_count == 0 || end > p_section.size()) {
+        return std::nullopt;
+    }
+    return table;
+}
+
+uint32_t ElfHashTable::m_word(size_t p_offset) const
+{
+    uint32_t word;
+    std::memcpy(&word, m_section.data() + p_offset, sizeof(word));
+    return m_swap ? std::byteswap(word) : word;
+}
+
+uint64_t ElfHashTable::m_bloom_word(size_t p_index) const
+{
+    const std::byte* word = m_section.data() + 16 + p_index * m_bloom_word_size;
+    if (m_bloom_word_size == 4) {
+        uint32_t value;
+        std::memcpy(&value, word, sizeof(value));
+        return m_swap ? std::byteswap(value) : value;
+    }
+    uint64_t value;
+    std::memcpy(&value, word, sizeof(value));
+    return m_swap ? std::byteswap(value) : value;
+}
+
+uint32_t ElfHashTable::gnu_hash(std::string_view p_name)
+{
+    uint32_t h = 5381;
+    for (char c : p_name) {
+        h = (h << 5) + h + static_cast<unsigned char>(c);
+    }
+    return h;
+}
+
+uint32_t ElfHashTable::sysv_hash(std::string_view p_name)
+{
+    uint32_t h = 0;
+    for (char c : p_name) {
+        h = (h << 4) + static_cast<unsigned char>(c);
+        const uint32_t g = h & 0xf0000000;
+        if (g != 0) {
+            h ^= g >> 24;
+        }
+        h &= ~g;
+    }
+    return h;
+}
+
+std::optional<uint32_t> ElfHashTable::find(
+  std::string_view p_name,
+  std::span<const std::string_view> p_names) const
+{
+    if (!m_is_gnu) {
+        const uint32_t h = sysv_hash(p_name);
+        uint32_t index = m_word(m_buckets_offset + (h % m_bucket_count) * 4);
+        // a well-formed chain visits each entry at most once
+        for (uint32_t steps = 0; index != 0 && steps < m_chain_count;
+             steps++) {
+            if (index >= m_chain_count || index >= p_names.size()) {
+                return std::nullopt;
+            }
+            if (p_names[index] == p_name) {
+                return index;
+            }
+            index = m_word(m_chain_offset + static_cast<size_t>(index) * 4);
+        }
+        return std::nullopt;
+    }
+
+    const uint32_t h = gnu_hash(p_name);
+    const uint32_t bits = static_cast<uint32_t>(m_bloom_word_size * 8);
+    const uint64_t word = m_bloom_word((h / bits) % m_bloom_size);
+    const uint64_t mask = (uint64_t{ 1 } << (h % bits))
+                          | (uint64_t{ 1 } << ((h >> m_bloom_shift) % bits));
+    if ((word & mask) != mask) {
+        return std::nullopt;
+    }
+
+    uint32_t index = m_word(m_buckets_offset + (h % m_bucket_count) * 4);
+    if (index < m_symbol_offset) {
+        return std::nullopt;
+    }
+    for (; index < p_names.size(); index++) {
+        const size_t chain_pos
+          = m_chain_offset + static_cast<size_t>(index - m_symbol_offset) * 4;
+        if (chain_pos + 4 > m_section.size()) {
+            return std::nullopt;
+        }
+        const uint32_t chain_hash = m_word(chain_pos);
+        if ((h | 1) == (chain_hash | 1) && p_names[index] == p_name) {
+            return index;
+        }
+        if ((chain_hash & 1) != 0) {
+            break;  // end of this bucket's chain
+        }
+    }
+    return std::nullopt;
+}
+
+SymbolTable::SymbolTable(std::span<const std::byte> p_symtab,
+                         size_t p_entsize,
+                         std::span<const std::byte> p_strtab,
+                         elf_reader::encoding_s p_encoding,
+                         std::optional<ElfHashTable> p_hash)
+  : m_hash(p_hash)
+{
+    elf_reader::visit(p_encoding, [&](auto p_file) {
+        using sym_t = typename decltype(p_file)::sym;
+        const elf_reader::record_span<sym_t> symbols(p_symtab, p_entsize);
+        m_reserve(symbols.size());
+
+        const char* strings = reinterpret_cast<const char*>(p_strtab.data());
+        for (auto sym : symbols) {
+            const uint32_t name_offset = sym.st_name();
+            std::string_view name;
+            if (name_offset != 0 && name_offset < p_strtab.size()) {
+                const size_t max_len = p_strtab.size() - name_offset;
+                name = { strings + name_offset,
+                         strnlen(strings + name_offset, max_len) };
+            }
+
+            m_names.push_back(name);
+            m_values.push_back(sym.st_value());
+            m_sizes.push_back(sym.st_size());
+            m_infos.push_back(sym.st_info());
+            m_others.push_back(sym.st_other());
+            m_shndx.push_back(sym.st_shndx());
+        }
+    });
+
+    if (!m_hash.has_value()) {
+        m_build_name_index();
+    }
+}
+
+SymbolTable::SymbolTable(std::span<const symbol_s> p_symbols)
+{
+    m_reserve(p_symbols.size());
+    for (const auto& sym : p_symbols) {
+        m_names.push_back(sym.name);
+        m_values.push_back(sym.value);
+        m_sizes.push_back(sym.size);
+        m_infos.push_back(sym.info);
+        m_others.push_back(sym.other);
+        m_shndx.push_back(sym.shndx);
+    }
+    m_build_name_index();
+}
+
+void SymbolTable::m_reserve(size_t p_count)
+{
+    m_names.reserve(p_count);
+    m_values.reserve(p_count);
+    m_sizes.reserve(p_count);
+    m_infos.reserve(p_count);
+    m_others.reserve(p_count);
+    m_shndx.reserve(p_count);
+}
+
+void SymbolTable::m_build_name_index()
+{
+    if (m_names.empty()) {
+        return;
+    }
+
+    // Keep the load factor at or below 1/2 so probe sequences stay short
+    const size_t slot_count
+      = std::bit_ceil(std::max<size_t>(16, m_names.size() * 2));
+    m_slot_shift = 64 - static_cast<unsigned>(std::countr_zero(slot_count));
+    m_name_slots.assign(slot_count, name_slot_s{ 0, 0 });
+
+    const size_t mask = slot_count - 1;
+    for (size_t i = 0; i < m_names.size(); i++) {
+        std::string_view name = m_names[i];
+        if (name.empty()) {
+            continue;
+        }
+        const uint32_t h = ElfHashTable::gnu_hash(name);
+        size_t slot = (h * 0x9E3779B97F4A7C15ULL) >> m_slot_shift;
+        while (true) {
+            name_slot_s& entry = m_name_slots[slot];
+            if (entry.index_plus_one == 0) {
+                entry = { h, static_cast<uint32_t>(i + 1) };
+                break;
+            }
+            if (entry.hash == h && m_names[entry.index_plus_one - 1] == name) {
+                break;  // keep the first symbol with this name
+            }
+            slot = (slot + 1) & mask;
+        }
+    }
+}
+
+std::optional<uint32_t> SymbolTable::find(std::string_view p_name) const
+{
+    if (m_hash.has_value()) {
+        return m_hash->find(p_name, m_names);
+    }
+    if (m_name_slots.empty() || p_name.empty()) {
+        return std::nullopt;
+    }
+
+    const size_t mask = m_name_slots.size() - 1;
+    const uint32_t h = ElfHashTable::gnu_hash(p_name);
+    size_t slot = (h * 0x9E3779B97F4A7C15ULL) >> m_slot_shift;
+    while (true) {
+        const name_slot_s& entry = m_name_slots[slot];
+        if (entry.index_plus_one == 0) {
+            return std::nullopt;
+        }
+        if (entry.hash == h && m_names[entry.index_plus_one - 1] == p_name) {
+            return entry.index_plus_one - 1;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+symbol_s SymbolTable::to_symbol(size_t p_index) const
+{
+    return symbol_s{ std::string(m_names[p_index]),
+                     m_values[p_index],
+                     m_sizes[p_index],
+                     m_infos[p_index],
+                     m_others[p_index],
+                     m_shndx[p_index] };
+}
+
+std::vector<uint32_t> SymbolTable::defined_of_type(unsigned char p_type) const
+{
+    std::vector<uint32_t> out;
+    const size_t count = m_infos.size();
+    for (size_t i = 0; i < count; i++) {
+        if (GELF_ST_TYPE(m_infos[i]) == p_type && m_shndx[i] != SHN_UNDEF) {
+            out.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return out;
+}
+
+std::vector<uint32_t> SymbolTable::with_prefix(std::string_view p_prefix) const
+{
+    std::vector<uint32_t> out;
+    for (size_t i = 0; i < m_names.size(); i++) {
+        if (m_names[i].starts_with(p_prefix)) {
+            out.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return out;
+}
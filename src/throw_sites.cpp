@@ -0,0 +1,506 @@
+/**
+ * @file throw_sites.cpp
+ * @author SAFE Group
+ * @brief Typeinfo and exception size of each __cxa_throw call
+ * implementation file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "throw_sites.hpp"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "function_index.hpp"
+#include "throw_summary.hpp"
+#include "x86_decoder.hpp"
+
+namespace safe {
+
+namespace {
+
+constexpr std::string_view cxa_throw = "__cxa_throw";
+constexpr std::string_view cxa_allocate_exception = "__cxa_allocate_exception";
+
+constexpr uint8_t rax = 0;
+constexpr uint8_t rdx = 2;
+constexpr uint8_t rsi = 6;
+constexpr uint8_t rdi = 7;
+
+// registers a call may change, as the System V ABI allows
+constexpr uint16_t caller_saved = 1U << 0 | 1U << 1 | 1U << 2 | 1U << 6
+                                  | 1U << 7 | 1U << 8 | 1U << 9 | 1U << 10
+                                  | 1U << 11;
+
+enum class value_kind : uint8_t
+{
+    copy,       // another register, whose definition comes earlier
+    address,    // lea of a RIP-relative operand
+    load,       // load from a RIP-relative operand, i.e. a GOT slot
+    immediate,  // mov of a constant
+    unknown     // anything else
+};
+
+struct definition_s
+{
+    value_kind kind = value_kind::unknown;
+    uint64_t value = 0;  // register, address or constant
+};
+
+bool legacy(const x86_instruction_s& p_instruction, uint8_t p_map)
+{
+    return !p_instruction.vector && p_instruction.map == p_map;
+}
+
+bool is_call(const x86_instruction_s& p_instruction)
+{
+    if (!legacy(p_instruction, 0)) {
+        return false;
+    }
+    const uint8_t group = p_instruction.reg & 7;
+    return p_instruction.opcode == 0xe8
+           || (p_instruction.opcode == 0xff && (group == 2 || group == 3));
+}
+
+// the callee a call reaches through its target or GOT slot
+std::optional<uint64_t> call_target(const x86_instruction_s& p_instruction)
+{
+    if (!is_call(p_instruction)) {
+        return std::nullopt;
+    }
+    if (p_instruction.opcode == 0xe8) {
+        return p_instruction.branch_target;
+    }
+    return p_instruction.rip_target;
+}
+
+// whether the next instruction can only be reached by a branch
+bool ends_block(const x86_instruction_s& p_instruction)
+{
+    if (legacy(p_instruction, 1)) {
+        return p_instruction.opcode == 0x0b;  // ud2
+    }
+    if (!legacy(p_instruction, 0)) {
+        return false;
+    }
+    const uint8_t group = p_instruction.reg & 7;
+    switch (p_instruction.opcode) {
+        case 0xc2:
+        case 0xc3:
+        case 0xe9:
+        case 0xeb:
+            return true;
+        case 0xff:
+            return group == 4 || group == 5;
+        default:
+            return false;
+    }
+}
+
+// How p_instruction defines p_register; nullopt if it leaves it alone.
+// Instructions the slice does not follow are assumed to write every register
+// they name, and those with implicit operands every register.
+std::optional<definition_s> definition(const x86_instruction_s& p_instruction,
+                                       uint8_t p_register)
+{
+    const definition_s unknown{};
+    const bool names = p_instruction.reg == p_register
+                       || p_instruction.rm_register == p_register;
+    if (p_instruction.vector) {
+        // VEX encoded GPR instructions write ModRM.reg or ModRM.rm; mulx
+        // writes vvvv as well
+        const bool mulx
+          = p_instruction.map == 2 && p_instruction.opcode == 0xf6;
+        return names || mulx ? std::optional(unknown) : std::nullopt;
+    }
+    const uint8_t opcode = p_instruction.opcode;
+    const uint8_t group = p_instruction.reg & 7;
+    if (is_call(p_instruction)) {
+        return (caller_saved >> p_register & 1) != 0 ? std::optional(unknown)
+                                                     : std::nullopt;
+    }
+
+    if (p_instruction.map == 1) {
+        if ((opcode >= 0x80 && opcode <= 0x8f) || opcode == 0x0b
+            || opcode == 0x1e || opcode == 0x1f) {
+            return std::nullopt;  // jcc, ud2, endbr64, nop
+        }
+        if (!p_instruction.modrm.has_value()
+            || ((opcode == 0xb0 || opcode == 0xb1 || opcode == 0xc7)
+                && (p_register == rax || p_register == rdx))) {
+            return unknown;  // cpuid, rdtsc, syscall, cmpxchg...
+        }
+        return names ? std::optional(unknown) : std::nullopt;
+    }
+    if (p_instruction.map != 0) {
+        return names ? std::optional(unknown) : std::nullopt;
+    }
+
+    switch (opcode) {
+        case 0x8d:  // lea
+            if (p_instruction.reg != p_register) {
+                return std::nullopt;
+            }
+            if (p_instruction.rip_target.has_value()) {
+                return definition_s{ value_kind::address,
+                                     *p_instruction.rip_target };
+            }
+            return unknown;
+        case 0x89:  // mov r/m, r
+            if (p_instruction.rm_register != p_register) {
+                return std::nullopt;
+            }
+            return definition_s{ value_kind::copy, p_instruction.reg };
+        case 0x8b:  // mov r, r/m
+            if (p_instruction.reg != p_register) {
+                return std::nullopt;
+            }
+            if (p_instruction.rm_register.has_value()) {
+                return definition_s{ value_kind::copy,
+                                     *p_instruction.rm_register };
+            }
+            if (p_instruction.rip_target.has_value()) {
+                return definition_s{ value_kind::load,
+                                     *p_instruction.rip_target };
+            }
+            return unknown;
+        case 0xc7:  // mov r/m, imm32
+            if (p_instruction.rm_register != p_register) {
+                return std::nullopt;
+            }
+            if (group == 0 && p_instruction.immediate.has_value()) {
+                const int64_t value = *p_instruction.immediate;
+                return definition_s{
+                    value_kind::immediate,
+                    p_instruction.rex_w ? static_cast<uint64_t>(value)
+                                        : static_cast<uint32_t>(value)
+                };
+            }
+            return unknown;
+        case 0x31:  // xor r/m, r
+        case 0x33:  // xor r, r/m
+            if (!names) {
+                return std::nullopt;
+            }
+            if (p_instruction.reg == p_instruction.rm_register) {
+                return definition_s{ value_kind::immediate, 0 };
+            }
+            return unknown;
+        case 0x88:  // mov of a byte
+        case 0xc6:
+            return p_instruction.rm_register == p_register
+                     ? std::optional(unknown)
+                     : std::nullopt;
+        case 0x38:  // cmp
+        case 0x39:
+        case 0x3a:
+        case 0x3b:
+        case 0x84:  // test
+        case 0x85:
+        case 0x3c:
+        case 0x3d:
+        case 0xa8:
+        case 0xa9:
+        case 0xc3:
+        case 0xcc:
+        case 0xe9:
+        case 0xeb:
+            return std::nullopt;
+        case 0x90:  // nop; with REX.B, xchg %r8,%rax
+            return p_instruction.reg == 0
+                       || (p_register != rax
+                           && p_register != p_instruction.reg)
+                     ? std::nullopt
+                     : std::optional(unknown);
+        case 0x98:  // cltq
+            return p_register == rax ? std::optional(unknown) : std::nullopt;
+        case 0x99:  // cqto
+            return p_register == rdx ? std::optional(unknown) : std::nullopt;
+        default:
+            break;
+    }
+    if (opcode >= 0x70 && opcode <= 0x7f) {
+        return std::nullopt;  // jcc
+    }
+    if (opcode >= 0x50 && opcode <= 0x57) {
+        return std::nullopt;  // push
+    }
+    if (opcode >= 0x58 && opcode <= 0x5f) {
+        return p_instruction.reg == p_register ? std::optional(unknown)
+                                               : std::nullopt;  // pop
+    }
+    if (opcode >= 0xb8 && opcode <= 0xbf) {  // mov r, imm
+        if (p_instruction.reg != p_register) {
+            return std::nullopt;
+        }
+        const int64_t value = p_instruction.immediate.value_or(0);
+        return definition_s{ value_kind::immediate,
+                             p_instruction.rex_w
+                               ? static_cast<uint64_t>(value)
+                               : static_cast<uint32_t>(value) };
+    }
+    if (opcode >= 0x80 && opcode <= 0x83) {
+        // group 1; cmp (/7) writes nothing
+        return group != 7 && p_instruction.rm_register == p_register
+                 ? std::optional(unknown)
+                 : std::nullopt;
+    }
+    if (opcode == 0xf6 || opcode == 0xf7) {
+        // group 3: test writes nothing, mul and div rax and rdx
+        if (group >= 4 && (p_register == rax || p_register == rdx)) {
+            return unknown;
+        }
+        return group >= 2 && p_instruction.rm_register == p_register
+                 ? std::optional(unknown)
+                 : std::nullopt;
+    }
+    if (!p_instruction.modrm.has_value()) {
+        return unknown;  // string instructions, xchg, pushf, leave...
+    }
+    return names ? std::optional(unknown) : std::nullopt;
+}
+
+// Follows p_register backward from before p_instructions[p_index] to the
+// start of its basic block.
+std::optional<definition_s> slice(
+  std::span<const x86_instruction_s> p_instructions,
+  std::span<const size_t> p_block_start,
+  size_t p_index,
+  uint8_t p_register)
+{
+    for (size_t k = p_index; k-- > p_block_start[p_index];) {
+        auto defined = definition(p_instructions[k], p_register);
+        if (!defined.has_value()) {
+            continue;
+        }
+        if (defined->kind != value_kind::copy) {
+            return defined;
+        }
+        p_register = static_cast<uint8_t>(defined->value);
+    }
+    return std::nullopt;
+}
+
+struct code_section_s
+{
+    uint64_t address;
+    std::span<const std::byte> data;
+};
+
+// End of the window of p_code that starts at p_begin: p_size bytes on, moved
+// back to the start of the function straddling the cut, or past its end if
+// that function began before the window
+size_t window_end(const FunctionIndex& p_functions,
+                  const code_section_s& p_code,
+                  size_t p_begin,
+                  size_t p_size)
+{
+    const size_t size = p_code.data.size();
+    if (p_size == 0 || size - p_begin <= p_size) {
+        return size;
+    }
+    size_t end = p_begin + p_size;
+    auto function = p_functions.function_at(p_code.address + end);
+    if (function.has_value() && function->start < p_code.address + end) {
+        if (function->start > p_code.address + p_begin) {
+            end = function->start - p_code.address;
+        } else {
+            end = std::min<uint64_t>(function->end - p_code.address, size);
+        }
+    }
+    return end;
+}
+
+}  // namespace
+
+throw_site_report_s find_throw_sites(const ElfParser& p_elf,
+                                     const SymbolTable& p_symbols,
+                                     const throw_site_options_s& p_options)
+{
+    throw_site_report_s report;
+    auto elf_header = p_elf.get_elf_header();
+    report.supported
+      = elf_header.has_value() && elf_header->e_machine == EM_X86_64;
+    if (!report.supported) {
+        return report;
+    }
+
+    // __cxa_throw and __cxa_allocate_exception: their definition, PLT
+    // entries and GOT slots
+    const external_targets_s external = load_external_targets(p_elf);
+    std::unordered_set<uint64_t> throws;
+    std::unordered_set<uint64_t> allocations;
+    auto add_targets = [&](std::string_view p_name,
+                           std::unordered_set<uint64_t>& p_targets) {
+        auto index = p_symbols.find(p_name);
+        if (index.has_value()
+            && p_symbols.shndx(*index) != SHN_UNDEF
+            && p_symbols.value(*index) != 0) {
+            p_targets.insert(p_symbols.value(*index));
+        }
+        for (const auto& [address, name] : external.names) {
+            if (name == p_name) {
+                p_targets.insert(address);
+            }
+        }
+    };
+    add_targets(cxa_throw, throws);
+    add_targets(cxa_allocate_exception, allocations);
+    if (throws.empty()) {
+        return report;
+    }
+
+    // typeinfo objects by address
+    std::unordered_map<uint64_t, std::string_view> typeinfo;
+    for (uint32_t i : p_symbols.with_prefix("_ZTI")) {
+        if (p_symbols.shndx(i) != SHN_UNDEF
+            && p_symbols.value(i) != 0) {
+            typeinfo.try_emplace(p_symbols.value(i), p_symbols.name(i));
+        }
+    }
+
+    auto headers = p_elf.get_section_headers();
+    const FunctionIndex functions(p_symbols, headers);
+    auto decode = [&](const code_section_s& p_code,
+                      const function_extent_s& p_extent) {
+        const uint64_t start = p_extent.start;
+        const size_t offset = start - p_code.address;
+        const size_t size = std::min<uint64_t>(p_extent.end - start,
+                                               p_code.data.size() - offset);
+        const std::vector<x86_instruction_s> instructions
+          = sweep_x86_64(p_code.data.subspan(offset, size), start);
+        report.functions++;
+        report.decoded_bytes += size;
+
+        // a block starts at each branch target and after each jmp or ret
+        std::unordered_set<uint64_t> targets;
+        for (const x86_instruction_s& instruction : instructions) {
+            if (instruction.branch_target.has_value()) {
+                targets.insert(*instruction.branch_target);
+            }
+        }
+        std::vector<size_t> block_start(instructions.size());
+        for (size_t k = 1; k < instructions.size(); k++) {
+            const auto previous = call_target(instructions[k - 1]);
+            const bool boundary
+              = targets.contains(instructions[k].address)
+                || ends_block(instructions[k - 1])
+                || (previous.has_value() && throws.contains(*previous));
+            block_start[k] = boundary ? k : block_start[k - 1];
+        }
+
+        std::optional<size_t> allocation;
+        for (size_t k = 0; k < instructions.size(); k++) {
+            auto callee = call_target(instructions[k]);
+            if (!callee.has_value()) {
+                continue;
+            }
+            if (allocations.contains(*callee)) {
+                allocation = k;
+                continue;
+            }
+            if (!throws.contains(*callee)) {
+                continue;
+            }
+
+            throw_site_s site;
+            site.function = start;
+            site.call = instructions[k].address;
+            auto thrown = slice(instructions, block_start, k, rsi);
+            if (thrown.has_value()) {
+                if (thrown->kind == value_kind::address
+                    || thrown->kind == value_kind::immediate) {
+                    site.typeinfo = thrown->value;
+                    auto name = typeinfo.find(thrown->value);
+                    if (name != typeinfo.end()) {
+                        site.typeinfo_name = name->second;
+                    }
+                } else if (thrown->kind == value_kind::load) {
+                    auto name = external.names.find(thrown->value);
+                    if (name != external.names.end()
+                        && name->second.starts_with("_ZTI")) {
+                        site.typeinfo_name = name->second;
+                    }
+                }
+            }
+            if (allocation.has_value()) {
+                auto size_argument
+                  = slice(instructions, block_start, *allocation, rdi);
+                if (size_argument.has_value()
+                    && size_argument->kind == value_kind::immediate) {
+                    site.exception_size = size_argument->value;
+                }
+            }
+            allocation.reset();
+            if (!site.resolved()) {
+                report.unresolved++;
+            }
+            report.sites.push_back(site);
+        }
+    };
+
+    // functions with a call rel32 or call *slot(%rip) reaching __cxa_throw,
+    // decoded as soon as the window of code holding them has been scanned
+    for (size_t s = 1; s < headers.size(); s++) {
+        const GElf_Shdr& header = headers[s];
+        if (header.sh_type != SHT_PROGBITS
+            || (header.sh_flags & SHF_EXECINSTR) == 0
+            || external.in_plt(header.sh_addr)) {
+            continue;
+        }
+        auto section = p_elf.get_section_view(s);
+        if (!section.has_value()) {
+            continue;
+        }
+        const code_section_s code{ header.sh_addr, section->data };
+        const std::span<const std::byte> data = code.data;
+        size_t begin = 0;
+        while (begin < data.size()) {
+            const size_t end
+              = window_end(functions, code, begin, p_options.window_size);
+            std::map<uint64_t, function_extent_s> throwing;
+            for (size_t i = begin; i < end && i + 5 <= data.size(); i++) {
+                const uint64_t here = header.sh_addr + i;
+                uint64_t target = 0;
+                if (data[i] == std::byte{ 0xe8 }) {
+                    target = here + 5
+                             + static_cast<int64_t>(read_rel32(&data[i + 1]));
+                } else if (data[i] == std::byte{ 0xff }
+                           && i + 6 <= data.size()
+                           && data[i + 1] == std::byte{ 0x15 }) {
+                    target = here + 6
+                             + static_cast<int64_t>(read_rel32(&data[i + 2]));
+                } else {
+                    continue;
+                }
+                if (!throws.contains(target)) {
+                    continue;
+                }
+                auto function = functions.function_at(here);
+                if (function.has_value()) {
+                    throwing.try_emplace(function->start, *function);
+                }
+            }
+            for (const auto& [start, extent] : throwing) {
+                if (start >= code.address) {
+                    decode(code, extent);
+                }
+            }
+            if (p_options.release) {
+                p_options.release(data.subspan(begin, end - begin));
+            }
+            begin = end;
+        }
+    }
+    // sections need not be in address order
+    std::ranges::stable_sort(report.sites, {}, &throw_site_s::function);
+    return report;
+}
+
+}  // namespace safe
@@ -0,0 +1,427 @@
+/**
+ * @file throw_summary.cpp
+ * @author SAFE Group
+ * @brief Call graph and may-throw summary of a linked image implementation
+ * file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "throw_summary.hpp"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+
+#include "abi_parse.hpp"
+#include "eh_frame.hpp"
+#include "elf_reader.hpp"
+
+namespace safe {
+
+namespace {
+
+// sections holding PLT entries, which jump through a GOT slot
+constexpr std::array<std::string_view, 3> plt_sections = { ".plt",
+                                                           ".plt.sec",
+                                                           ".plt.got" };
+
+// routines that raise an exception
+constexpr std::array<std::string_view, 5> raising = {
+    "__cxa_throw",
+    "__cxa_rethrow",
+    "_Unwind_RaiseException",
+    "_Unwind_Resume_or_Rethrow",
+    "_Unwind_ForcedUnwind",
+};
+
+// C routines that run user code, which may throw through them
+constexpr std::array<std::string_view, 4> callbacks = {
+    "qsort",
+    "bsearch",
+    "pthread_once",
+    "__libc_start_main",
+};
+
+// continues the exception of the landing pad it is called from
+constexpr std::string_view resume = "_Unwind_Resume";
+
+bool external_may_throw(std::string_view p_name)
+{
+    return p_name.starts_with("_Z") || std::ranges::find(raising, p_name)
+                                         != raising.end()
+           || std::ranges::find(callbacks, p_name) != callbacks.end();
+}
+
+}  // namespace
+
+external_targets_s load_external_targets(const ElfParser& p_elf)
+{
+    external_targets_s targets;
+    auto dynamic = p_elf.get_dynamic_symbol_table();
+    if (!dynamic.has_value()) {
+        return targets;
+    }
+    const SymbolTable& dynsym = **dynamic;
+    auto headers = p_elf.get_section_headers();
+
+    // GOT slots, from the relocations that fill them with a symbol's address
+    std::unordered_map<uint64_t, std::string_view> slots;
+    elf_reader::visit(p_elf.get_encoding(), [&](auto p_file) {
+        using rela_t = typename decltype(p_file)::rela;
+        for (size_t i = 1; i < headers.size(); i++) {
+            const GElf_Shdr& header = headers[i];
+            if (header.sh_type != SHT_RELA
+                || (header.sh_flags & SHF_ALLOC) == 0) {
+                continue;
+            }
+            auto section = p_elf.get_section_view(i);
+            if (!section.has_value()) {
+                continue;
+            }
+            const size_t stride
+              = std::max<size_t>(header.sh_entsize, rela_t::size);
+            for (auto reloc :
+                 elf_reader::record_span<rela_t>(section->data, stride)) {
+                const uint32_t type = reloc.r_type();
+                // R_X86_64_GLOB_DAT and R_X86_64_JUMP_SLOT
+                if ((type == 6 || type == 7) && reloc.r_sym() < dynsym.size()
+                    && !dynsym.name(reloc.r_sym()).empty()) {
+                    slots.emplace(reloc.r_offset(), dynsym.name(reloc.r_sym()));
+                }
+            }
+        }
+    });
+    targets.names = slots;
+
+    // each PLT entry jumps through its slot: jmp *slot(%rip), ff 25 rel32,
+    // after an optional endbr64 or bnd prefix
+    for (std::string_view name : plt_sections) {
+        auto plt = p_elf.get_section_view(name);
+        if (!plt.has_value()) {
+            continue;
+        }
+        const uint64_t address = plt->header.sh_addr;
+        const std::span<const std::byte> data = plt->data;
+        targets.plt.emplace_back(address, address + data.size());
+        const uint64_t entry_size
+          = plt->header.sh_entsize != 0 ? plt->header.sh_entsize : 16;
+        for (size_t i = 0; i + 6 <= data.size(); i++) {
+            if (data[i] != std::byte{ 0xff }
+                || data[i + 1] != std::byte{ 0x25 }) {
+                continue;
+            }
+            const uint64_t slot
+              = address + i + 6
+                + static_cast<int64_t>(read_rel32(&data[i + 2]));
+            auto symbol = slots.find(slot);
+            if (symbol != slots.end()) {
+                targets.names.try_emplace(address + i - i % entry_size,
+                                          symbol->second);
+            }
+        }
+    }
+    return targets;
+}
+
+bool external_targets_s::in_plt(uint64_t p_address) const
+{
+    return std::ranges::any_of(plt, [p_address](const auto& p_section) {
+        return p_section.first <= p_address && p_address < p_section.second;
+    });
+}
+
+ThrowSummary::ThrowSummary(const ElfParser& p_elf,
+                           const SymbolTable& p_symbols)
+  : m_symbols(&p_symbols)
+  , m_functions(p_symbols, p_elf.get_section_headers())
+{
+    auto elf_header = p_elf.get_elf_header();
+    m_supported = elf_header.has_value() && elf_header->e_machine == EM_X86_64;
+    m_may_throw.assign(m_functions.size(), true);
+    if (!m_supported) {
+        return;
+    }
+
+    m_external = load_external_targets(p_elf);
+    m_scan_code(p_elf);
+    std::vector<unwind_info_s> info(m_functions.size());
+    m_load_unwind_info(p_elf, info);
+    m_propagate(info);
+}
+
+void ThrowSummary::m_scan_code(const ElfParser& p_elf)
+{
+    auto headers = p_elf.get_section_headers();
+    const std::span<const function_extent_s> functions
+      = m_functions.functions();
+    for (size_t s = 1; s < headers.size(); s++) {
+        const GElf_Shdr& header = headers[s];
+        if (header.sh_type != SHT_PROGBITS
+            || (header.sh_flags & SHF_EXECINSTR) == 0
+            || m_external.in_plt(header.sh_addr)) {
+            continue;
+        }
+        auto section = p_elf.get_section_view(s);
+        if (!section.has_value()) {
+            continue;
+        }
+        const uint64_t address = header.sh_addr;
+        const std::span<const std::byte> data = section->data;
+        const uint64_t end = address + data.size();
+
+        // decode each function of the section from its first byte
+        auto function = std::ranges::lower_bound(
+          functions, address, {}, &function_extent_s::start);
+        for (; function != functions.end() && function->start < end;
+             function++) {
+            const uint64_t stop = std::min(function->end, end);
+            for (const x86_instruction_s& instruction :
+                 sweep_x86_64(data.subspan(function->start - address,
+                                           stop - function->start),
+                              function->start)) {
+                m_record_transfer(*function, instruction);
+            }
+        }
+    }
+    std::ranges::sort(m_calls, {}, &machine_call_s::return_address);
+}
+
+void ThrowSummary::m_record_transfer(const function_extent_s& p_function,
+                                     const x86_instruction_s& p_instruction)
+{
+    if (p_instruction.vector) {
+        return;
+    }
+    const uint64_t here = p_instruction.address;
+    const uint64_t next = here + p_instruction.length;
+
+    if (p_instruction.map == 0 && p_instruction.opcode == 0xff) {
+        // call (/2, /3) or jmp (/4, /5) through a register or memory
+        const uint8_t group = p_instruction.reg & 7;
+        if (group < 2 || group > 5) {
+            return;
+        }
+        machine_call_s call{ here, next, std::nullopt, group >= 4 };
+        // call *slot(%rip) and jmp *slot(%rip), as -fno-plt emits
+        if (p_instruction.rip_target.has_value()
+            && m_external.names.contains(*p_instruction.rip_target)) {
+            call.target = *p_instruction.rip_target;
+        }
+        m_calls.push_back(call);
+        return;
+    }
+    if (!p_instruction.branch_target.has_value()) {
+        return;
+    }
+    const uint64_t target = *p_instruction.branch_target;
+
+    if (p_instruction.map == 0 && p_instruction.opcode == 0xe8) {
+        // a callee that is no known function start, e.g. an unsymbolized
+        // local function, may throw anything
+        machine_call_s call{ here, next, std::nullopt, false };
+        if (m_external.in_plt(target)
+            || m_function_starting_at(target).has_value()) {
+            call.target = target;
+        }
+        m_calls.push_back(call);
+        return;
+    }
+
+    // jmp and jcc leaving the function, e.g. to its .cold part, continue
+    // in the function they land in
+    if (target >= p_function.start && target < p_function.end) {
+        return;
+    }
+    std::optional<uint64_t> callee;
+    if (m_external.in_plt(target)) {
+        callee = target;
+    } else if (auto landing = m_function_containing(target)) {
+        callee = m_functions.functions()[*landing].start;
+    }
+    m_calls.push_back({ here, next, callee, true });
+}
+
+void ThrowSummary::m_load_unwind_info(const ElfParser& p_elf,
+                                      std::vector<unwind_info_s>& p_info) const
+{
+    auto section = p_elf.get_section_view(".eh_frame");
+    if (!section.has_value()) {
+        return;
+    }
+    auto eh_frame
+      = EhFrame::parse(*section, std::nullopt, p_elf.get_encoding());
+    if (!eh_frame.has_value()) {
+        return;
+    }
+    auto fdes = eh_frame->fdes();
+    if (!fdes.has_value()) {
+        return;
+    }
+
+    for (unwind_info_s& info : p_info) {
+        info.has_fde = false;
+    }
+    auto except_table = p_elf.get_section_view(".gcc_except_table");
+    for (const fde_s& fde : *fdes) {
+        auto function = m_function_containing(fde.pc_begin);
+        if (!function.has_value()) {
+            continue;
+        }
+        unwind_info_s& info = p_info[*function];
+        info.has_fde = true;
+        if (!fde.lsda.has_value() || !except_table.has_value()
+            || *fde.lsda < except_table->header.sh_addr) {
+            continue;
+        }
+        auto lsda = LsdaParser::decode(
+          except_table->data,
+          *fde.lsda - except_table->header.sh_addr,
+          LsdaContext{ except_table->header.sh_addr, {}, 8 });
+        if (!lsda.has_value()) {
+            continue;  // as if every call let exceptions through
+        }
+        info.has_lsda = true;
+        for (const CallSite& site : lsda->call_sites) {
+            info.call_sites.emplace_back(fde.pc_begin + site.start,
+                                         fde.pc_begin + site.start
+                                           + site.length);
+        }
+        std::ranges::sort(info.call_sites);
+    }
+}
+
+void ThrowSummary::m_propagate(const std::vector<unwind_info_s>& p_info)
+{
+    const std::span<const function_extent_s> functions
+      = m_functions.functions();
+    m_may_throw.assign(functions.size(), false);
+    std::vector<std::vector<size_t>> callers(functions.size());
+    std::deque<size_t> pending;
+    auto mark = [&](size_t p_function) {
+        if (!m_may_throw[p_function]) {
+            m_may_throw[p_function] = true;
+            pending.push_back(p_function);
+        }
+    };
+
+    for (size_t f = 0; f < functions.size(); f++) {
+        if (std::ranges::find(raising, m_symbols->name(functions[f].symbol))
+            != raising.end()) {
+            mark(f);
+        }
+    }
+
+    for (const machine_call_s& call : m_calls) {
+        auto caller = m_function_containing(call.address);
+        if (!caller.has_value()) {
+            continue;
+        }
+        const unwind_info_s& info = p_info[*caller];
+        // the unwinder looks up the byte before the return address
+        const uint64_t pc = call.return_address - 1;
+        auto site = std::ranges::upper_bound(
+          info.call_sites, pc, {}, [](const auto& p_site) {
+              return p_site.first;
+          });
+        const bool covered
+          = site != info.call_sites.begin() && pc < std::prev(site)->second;
+        // a tail call leaves no frame of the caller to stop the exception
+        if (!call.tail && (!info.has_fde || (info.has_lsda && !covered))) {
+            continue;
+        }
+        if (!call.target.has_value()) {
+            mark(*caller);
+            continue;
+        }
+        auto callee = m_function_starting_at(*call.target);
+        if (callee.has_value()) {
+            if (m_symbols->name(functions[*callee].symbol) != resume) {
+                callers[*callee].push_back(*caller);
+            }
+            continue;
+        }
+        auto name = m_external.names.find(*call.target);
+        if (name == m_external.names.end()
+            || (name->second != resume && external_may_throw(name->second))) {
+            mark(*caller);
+        }
+    }
+
+    while (!pending.empty()) {
+        const size_t callee = pending.front();
+        pending.pop_front();
+        for (size_t caller : callers[callee]) {
+            mark(caller);
+        }
+    }
+}
+
+bool ThrowSummary::may_throw(uint64_t p_function) const
+{
+    auto function = m_function_starting_at(p_function);
+    if (function.has_value()) {
+        return m_may_throw[*function];
+    }
+    auto name = m_external.names.find(p_function);
+    return name == m_external.names.end() || external_may_throw(name->second);
+}
+
+bool ThrowSummary::may_throw(const machine_call_s& p_call) const
+{
+    return !m_supported || !p_call.target.has_value()
+           || may_throw(*p_call.target);
+}
+
+std::span<const machine_call_s> ThrowSummary::calls_returning_in(
+  uint64_t p_begin,
+  uint64_t p_end) const
+{
+    auto first = std::ranges::upper_bound(
+      m_calls, p_begin, {}, &machine_call_s::return_address);
+    auto last = std::ranges::upper_bound(
+      first, m_calls.end(), p_end, {}, &machine_call_s::return_address);
+    return { first, last };
+}
+
+std::string_view ThrowSummary::callee_name(const machine_call_s& p_call) const
+{
+    if (!p_call.target.has_value()) {
+        return {};
+    }
+    auto function = m_function_starting_at(*p_call.target);
+    if (function.has_value()) {
+        return m_symbols->name(m_functions.functions()[*function].symbol);
+    }
+    auto name = m_external.names.find(*p_call.target);
+    return name != m_external.names.end() ? name->second : std::string_view{};
+}
+
+std::optional<size_t> ThrowSummary::m_function_starting_at(
+  uint64_t p_address) const
+{
+    auto function = m_function_containing(p_address);
+    if (!function.has_value()
+        || m_functions.functions()[*function].start != p_address) {
+        return std::nullopt;
+    }
+    return function;
+}
+
+std::optional<size_t> ThrowSummary::m_function_containing(
+  uint64_t p_address) const
+{
+    const std::span<const function_extent_s> functions
+      = m_functions.functions();
+    auto after = std::ranges::upper_bound(
+      functions, p_address, {}, &function_extent_s::start);
+    if (after == functions.begin() || p_address >= std::prev(after)->end) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(std::prev(after) - functions.begin());
+}
+
+}  // namespace safe
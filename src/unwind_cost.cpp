@@ -0,0 +1,88 @@
+/**
+ * @file unwind_cost.cpp
+ * @author SAFE Group
+ * @brief Per-function CFA interpretation cost of an unwind step
+ * implementation file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "unwind_cost.hpp"
+
+#include <algorithm>
+
+#include "abi_parse.hpp"
+
+namespace safe {
+
+unwind_cost_report_s profile_unwind_cost(
+  const EhFrame& p_eh_frame,
+  std::optional<section_view_s> p_except_table,
+  uint8_t p_pointer_size)
+{
+    unwind_cost_report_s report;
+    auto fdes = p_eh_frame.fdes();
+    if (!fdes.has_value()) {
+        return report;
+    }
+
+    LsdaContext context;
+    context.pointer_size = p_pointer_size;
+    context.order = p_eh_frame.encoding().order;
+    if (p_except_table.has_value()) {
+        context.table_address = p_except_table->header.sh_addr;
+    }
+
+    report.functions.reserve(fdes->size());
+    std::vector<uint64_t> pcs;
+    for (const fde_s& fde : *fdes) {
+        // pc_begin gives the CIE's share on its own
+        pcs.assign({ fde.pc_begin });
+        size_t call_sites = 0;
+        if (fde.lsda.has_value() && p_except_table.has_value()
+            && *fde.lsda >= context.table_address) {
+            auto lsda = LsdaParser::decode(p_except_table->data,
+                                           *fde.lsda - context.table_address,
+                                           context);
+            if (!lsda.has_value()) {
+                report.undecodable++;
+                continue;
+            }
+            for (const CallSite& site : lsda->call_sites) {
+                pcs.push_back(std::min(
+                  fde.pc_begin + site.start + site.length, fde.pc_end));
+            }
+            call_sites = lsda->call_sites.size();
+        }
+        if (call_sites == 0) {
+            pcs.push_back(fde.pc_end);
+        }
+        std::ranges::sort(pcs);
+
+        auto counts = p_eh_frame.cfa_instruction_counts(fde, pcs);
+        if (!counts.has_value()) {
+            report.undecodable++;
+            continue;
+        }
+        // counts never decrease with the address
+        unwind_cost_s cost;
+        cost.pc_begin = fde.pc_begin;
+        cost.pc_end = fde.pc_end;
+        cost.cie_instructions = counts->front();
+        cost.worst_instructions = counts->back();
+        const auto worst = std::ranges::lower_bound(*counts, counts->back());
+        cost.worst_pc = pcs[static_cast<size_t>(worst - counts->begin())];
+        cost.call_sites = call_sites;
+        report.functions.push_back(cost);
+    }
+
+    std::ranges::stable_sort(report.functions,
+                             std::ranges::greater{},
+                             &unwind_cost_s::worst_instructions);
+    return report;
+}
+
+}  // namespace safe
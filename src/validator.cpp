@@ -2,36 +2,117 @@
 
 namespace safe {
 
+void Validator::initialize()
+{
+    if (m_options.write_logs) {
+        std::filesystem::create_directories("../logs");
+    }
+    std::ofstream out = open_log("function_binary.txt");
+    out.close();
+    m_functions = FunctionIndex(*m_sym, std::span(&m_text.header, 1));
+    collect_rtti_sym();
+}
+
+std::ofstream Validator::open_log(std::string_view file_name,
+                                  std::ios::openmode mode) const
+{
+    // a stream that was never opened discards everything written to it
+    std::ofstream out;
+    if (m_options.write_logs) {
+        out.open(std::filesystem::path("../logs") / file_name, mode);
+    }
+    return out;
+}
+
 std::optional<std::vector<symbol_s>> Validator::find_typeinfo(
   std::string_view func_name)
 {
-    auto func_sym_opt = get_symbol(func_name);
-    if (!func_sym_opt.has_value()) {
+    auto func_index = find_symbol_index(func_name);
+    if (!func_index.has_value()) {
         return std::nullopt;
     }
+    return find_typeinfo_at(*func_index);
+}
 
-    symbol_s func_sym = *func_sym_opt;
-    uint64_t func_addr = func_sym.value;
-    GElf_Shdr text_hdr = m_text.header;
-    uint64_t text_addr = text_hdr.sh_addr;
-    uint64_t offset = func_addr - text_addr;
+std::optional<std::vector<symbol_s>> Validator::find_typeinfo_at(
+  std::size_t sym_index)
+{
+    std::string_view func_name = m_sym->name(sym_index);
+    uint64_t func_addr = m_sym->value(sym_index);
 
-    if (offset >= m_text.data.size()) {
+    auto bytes = function_bytes(sym_index);
+    if (!bytes.has_value()) {
         std::println("Error: function address out of .text bounds");
         return std::nullopt;
     }
-
+    const auto [offset, func_size] = *bytes;
     const std::byte* func_start = m_text.data.data() + offset;
-    size_t func_size = func_sym.size;
 
     std::vector<symbol_s> thrown_obj;
 
-    std::ofstream out("../logs/function_binary.txt", std::ios::app);
+    std::ofstream out = open_log("function_binary.txt", std::ios::app);
     out << std::format("===========================\n");
     out << std::format("Function: {}\n",
                        demangle(func_name.data()).value_or(func_name.data()));
     out << std::format("===========================\n");
 
+    if (m_throw_sites.has_value()) {
+        auto sites = std::ranges::equal_range(
+          *m_throw_sites, func_addr, {}, &throw_site_s::function);
+        if (std::ranges::all_of(sites, &throw_site_s::resolved)) {
+            for (const throw_site_s& site : sites) {
+                out << std::format("Throw site: 0x{:x} | Typeinfo: {}\n",
+                                   site.call,
+                                   site.typeinfo_name);
+                auto rtti = m_sym->find(site.typeinfo_name);
+                if (rtti.has_value()) {
+                    add_thrown(*rtti, thrown_obj, out);
+                } else if (site.typeinfo.has_value()) {
+                    probe_typeinfo(*site.typeinfo, thrown_obj, out);
+                }
+            }
+            out.close();
+            return thrown_obj;
+        }
+    }
+
+    if (m_options.machine == EM_X86_64) {
+        for (const x86_reference_s& reference : x86_references(
+               std::span(func_start, func_size), func_addr)) {
+            constexpr std::array<std::string_view, 4> kinds
+              = { "lea", "mem", "call", "jmp" };
+            out << std::format(
+              "Offset: {:4} | {:4} | Target: 0x{:x}\n",
+              reference.instruction - func_addr,
+              kinds[static_cast<std::size_t>(reference.kind)],
+              reference.target);
+            probe_typeinfo(reference.target, thrown_obj, out);
+        }
+        out.close();
+        return thrown_obj;
+    }
+
+    if (m_options.machine == EM_ARM) {
+        // literal pools sit between and after the function's instructions,
+        // word aligned, and hold absolute addresses
+        const uint64_t code_addr = func_addr & ~uint64_t{ 1 };
+        const uint64_t pool_begin = (code_addr + 3) & ~uint64_t{ 3 };
+        for (uint64_t addr = pool_begin; addr + 4 <= code_addr + func_size;
+             addr += 4) {
+            const std::byte* word = func_start + (addr - code_addr);
+            const uint32_t target
+              = m_options.order == std::endian::big
+                  ? elf_reader::load<uint32_t, std::endian::big>(word)
+                  : elf_reader::load<uint32_t, std::endian::little>(word);
+            out << std::format("Offset: {:4} | Word: 0x{:08x}\n",
+                               addr - code_addr,
+                               target);
+            probe_typeinfo(target, thrown_obj, out);
+        }
+        out.close();
+        return thrown_obj;
+    }
+
     // safer than (func_size - 8)
     for (size_t i = 0; i + 4 <= func_size; ++i) {
         uint64_t current_addr = func_addr + i;
@@ -46,36 +127,57 @@ std::optional<std::vector<symbol_s>> Validator::find_typeinfo(
                            static_cast<uint8_t>(func_start[i + 2]),
                            static_cast<uint8_t>(func_start[i + 3]),
                            target_addr);
-
-        if (rtti_sym.contains(target_addr)) {
-            std::string demangled
-              = demangle(rtti_sym[target_addr].name.data())
-                  .value_or(rtti_sym[target_addr].name.data());
-            out << std::format(
-              "^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^"
-              "^^^^^ Throw Found: {}\n",
-              demangled);
-            thrown_obj.emplace_back(rtti_sym[target_addr]);
-        }
+        probe_typeinfo(target_addr, thrown_obj, out);
     }
     out.close();
     return thrown_obj;
 }
 
+void Validator::probe_typeinfo(std::uint64_t target_addr,
+                               std::vector<symbol_s>& thrown,
+                               std::ofstream& out)
+{
+    auto rtti = rtti_sym.find(target_addr);
+    if (rtti != rtti_sym.end()) {
+        add_thrown(rtti->second, thrown, out);
+    }
+}
+
+void Validator::add_thrown(std::uint32_t rtti_index,
+                           std::vector<symbol_s>& thrown,
+                           std::ofstream& out)
+{
+    std::string_view rtti_name = m_sym->name(rtti_index);
+    std::string demangled = demangle(rtti_name.data())
+                              .value_or(std::string(rtti_name));
+    out << std::format(
+      "^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^"
+      "^^^^^ Throw Found: {}\n",
+      demangled);
+    thrown.emplace_back(m_sym->to_symbol(rtti_index));
+}
+
 void Validator::collect_rtti_sym()
 {
-    std::ofstream out("../logs/RTTI_typeinfo.txt");
+    std::ofstream out = open_log("RTTI_typeinfo.txt");
     out << std::format("===================================\n");
     out << std::format("RTTI Address | Demangled Throw Name\n");
     out << std::format("===================================\n");
-    for (auto& sym : m_sym) {
-        auto demangle_sym = demangle(sym.name.c_str());
+    // "typeinfo for" and "typeinfo name for" only demangle from _ZTI and
+    // _ZTS, so skip demangling every other symbol
+    for (std::uint32_t i : m_sym->with_prefix("_ZT")) {
+        std::string_view name = m_sym->name(i);
+        if (!name.starts_with("_ZTI") && !name.starts_with("_ZTS")) {
+            continue;
+        }
+        auto demangle_sym = demangle(name.data());
         if (!demangle_sym) {
             continue;
         }
         if (demangle_sym->starts_with("typeinfo")) {
-            out << std::format("   {}   | {}\n", sym.value, demangle_sym.value());
-            rtti_sym.emplace(sym.value, sym);
+            out << std::format(
+              "   {}   | {}\n", m_sym->value(i), demangle_sym.value());
+            rtti_sym.emplace(m_sym->value(i), i);
         }
     }
     out.close();
@@ -83,25 +185,22 @@ void Validator::collect_rtti_sym()
 
 std::optional<symbol_s> Validator::get_symbol(std::string_view name)
 {
-    for (const auto& s : m_sym) {
-        if (s.name == name) {
-            return s;
-        }
+    auto index = find_symbol_index(name);
+    if (!index.has_value()) {
+        return std::nullopt;
     }
-    return std::nullopt;
+    return m_sym->to_symbol(*index);
 }
 
-std::optional<std::string> Validator::demangle(const char* mangled)
+std::optional<std::size_t> Validator::find_symbol_index(
+  std::string_view name) const
 {
-    int status = 0;
-    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    return m_sym->find(name);
+}
 
-    if (status == 0 && demangled) {
-        std::string result(demangled);
-        std::free(demangled);
-        return result;
-    }
-    return std::nullopt;
+std::optional<std::string> Validator::demangle(const char* mangled)
+{
+    return safe::demangle(mangled);
 }
 
 void Validator::load_lsda(const LsdaParser& lsda)
@@ -112,28 +211,140 @@ void Validator::load_lsda(const LsdaParser& lsda)
 
     const auto& scopes = lsda.get_scopes();
     std::println("[Validator] load_lsda: scopes = {}", scopes.size());
-    std::size_t idx = 0;
+    append_records(lsda, m_records);
+    std::println("[Validator] load_lsda: records = {}", m_records.size());
+}
 
-    for (const auto& scope : scopes) {
+void Validator::append_records(const LsdaParser& lsda,
+                               std::vector<CatchRecord>& records)
+{
+    std::size_t idx = 0;
+    for (const auto& scope : lsda.get_scopes()) {
         std::string scope_label = "scope[" + std::to_string(idx) + ']';
-        for (const auto& h : scope.handlers) {
+        for (const auto& h : lsda.handlers(scope)) {
             CatchRecord rec{};
             rec.scope_id    = scope_label;
             rec.kind        = h.type;
             rec.range_begin = scope.start;
             rec.range_end   = scope.end;
-            rec.landing_pad = h.landing_pad;
+            rec.landing_pad = scope.landing_pad;
             rec.type_index  = h.type_index;
-            m_records.push_back(std::move(rec));
+            records.push_back(std::move(rec));
         }
         ++idx;
     }
-    std::println("[Validator] load_lsda: records = {}", m_records.size());
+}
+
+void Validator::load_throw_sites(std::span<const throw_site_s> throw_sites)
+{
+    m_throw_sites = throw_sites;
+}
+
+void Validator::load_eh_frame(const EhFrame& eh_frame,
+                              section_view_s except_table,
+                              const LsdaTable* lsdas,
+                              PointerReader read_pointer)
+{
+    m_eh_frame = &eh_frame;
+    m_arm_exidx = nullptr;
+    m_except_table = except_table;
+    m_lsdas = lsdas;
+    m_read_pointer = std::move(read_pointer);
+    m_function_lsda.clear();
+    std::println("[Validator] load_eh_frame: fdes = {}{}",
+                 eh_frame.size(),
+                 eh_frame.has_search_table() ? " (.eh_frame_hdr)" : "");
+    if (lsdas != nullptr) {
+        std::println("[Validator] load_eh_frame: lsdas = {}, failed = {}",
+                     lsdas->size(),
+                     lsdas->get_failures());
+    }
+}
+
+void Validator::load_arm_exidx(const ArmExidx& exidx,
+                               PointerReader read_pointer)
+{
+    m_arm_exidx = &exidx;
+    m_eh_frame = nullptr;
+    m_lsdas = nullptr;
+    m_read_pointer = std::move(read_pointer);
+    m_function_lsda.clear();
+    std::println("[Validator] load_arm_exidx: entries = {}", exidx.size());
+}
+
+std::optional<std::pair<std::uint64_t, LsdaContext>>
+Validator::lsda_location(std::uint64_t func_addr) const
+{
+    if (m_arm_exidx != nullptr) {
+        // Thumb function symbols have bit 0 set; the index does not
+        auto entry = m_arm_exidx->find(func_addr & ~std::uint64_t{ 1 });
+        if (!entry.has_value() || entry->model != exidx_model::GENERIC
+            || !entry->lsda.has_value()) {
+            return std::nullopt;
+        }
+        const section_view_s& extab = m_arm_exidx->extab();
+        return std::pair(*entry->lsda,
+                         LsdaContext{ extab.header.sh_addr,
+                                      m_read_pointer,
+                                      4,
+                                      m_arm_exidx->encoding().order });
+    }
+    auto fde = m_eh_frame->find(func_addr);
+    if (!fde.has_value() || !fde->lsda.has_value()) {
+        return std::nullopt;
+    }
+    return std::pair(*fde->lsda,
+                     LsdaContext{ m_except_table.header.sh_addr,
+                                  m_read_pointer });
+}
+
+const Validator::function_lsda_s* Validator::lsda_for(
+  std::uint64_t func_addr) const
+{
+    auto location = lsda_location(func_addr);
+    if (!location.has_value()) {
+        return nullptr;
+    }
+    const auto& [lsda_addr, context] = *location;
+    const std::span<const std::byte> table = m_arm_exidx != nullptr
+                                               ? m_arm_exidx->extab().data
+                                               : m_except_table.data;
+    const std::uint64_t table_addr = context.table_address;
+    if (lsda_addr < table_addr || lsda_addr - table_addr >= table.size()) {
+        return nullptr;
+    }
+
+    // functions sharing an LSDA (e.g. split hot/cold parts) parse it once
+    auto [entry, inserted] = m_function_lsda.try_emplace(lsda_addr);
+    if (!inserted) {
+        return entry->second.get();
+    }
+    const std::size_t lsda_offset = lsda_addr - table_addr;
+    auto parsed = std::make_unique<function_lsda_s>(
+      function_lsda_s{ std::nullopt, nullptr, {} });
+    if (m_lsdas != nullptr) {
+        parsed->lsda = m_lsdas->find(lsda_offset);
+    }
+    if (parsed->lsda == nullptr) {
+        auto decoded = LsdaParser::decode(table, lsda_offset, context);
+        if (!decoded.has_value()) {
+            std::println("[Validator] LSDA at 0x{:x}: {} at offset 0x{:x}",
+                         lsda_addr,
+                         to_string(decoded.error().reason),
+                         decoded.error().offset);
+            return nullptr;
+        }
+        parsed->lsda = &parsed->owned.emplace(std::move(*decoded));
+    }
+    append_records(*parsed->lsda, parsed->records);
+    entry->second = std::move(parsed);
+    return entry->second.get();
 }
 
 Validator::Result Validator::analyze_exceptions(std::string_view func_name) const
 {
-    if (m_lsda == nullptr) {
+    if (m_lsda == nullptr && m_eh_frame == nullptr
+        && m_arm_exidx == nullptr) {
         return std::unexpected(CorrelateError::NoLsdaLoaded);
     }
 
@@ -148,7 +359,25 @@ Validator::Result Validator::analyze_exceptions(std::string_view func_name) cons
         return std::unexpected(CorrelateError::NoThrownTypes);
     }
 
-    if (m_records.empty()) {
+    if (m_eh_frame == nullptr && m_arm_exidx == nullptr) {
+        return match_handlers(thrown_vec, m_records, *m_lsda);
+    }
+
+    // only the call-site table of this function's own LSDA is consulted
+    auto func_index = find_symbol_index(func_name);
+    const function_lsda_s* lsda = lsda_for(m_sym->value(*func_index));
+    if (lsda == nullptr) {
+        return std::unexpected(CorrelateError::NoCatchRecords);
+    }
+    return match_handlers(thrown_vec, lsda->records, *lsda->lsda);
+}
+
+Validator::Result Validator::match_handlers(
+  const std::vector<symbol_s>& thrown_vec,
+  const std::vector<CatchRecord>& records,
+  const LsdaParser& lsda) const
+{
+    if (records.empty()) {
         return std::unexpected(CorrelateError::NoCatchRecords);
     }
 
@@ -159,7 +388,7 @@ Validator::Result Validator::analyze_exceptions(std::string_view func_name) cons
         ThrowCatchMatch rel{ t, {} };
         const std::uint64_t thrown_addr = t.value;
 
-        for (const auto& rec : m_records) {
+        for (const auto& rec : records) {
             if (rec.type_index == 0) {
                 rel.handlers.push_back(&rec);
                 continue;
@@ -171,7 +400,7 @@ Validator::Result Validator::analyze_exceptions(std::string_view func_name) cons
                 continue;
             }
 
-            auto handler_addr_opt = m_lsda->resolve_type(rec.type_index);
+            auto handler_addr_opt = lsda.resolve_type(rec.type_index);
             if (!handler_addr_opt.has_value()) {
                 continue; 
             }
@@ -204,25 +433,97 @@ bool Validator::check_thrown_functions(std::string_view func_name)
     return thrown_opt.has_value() && !thrown_opt->empty();
 }
 
+std::optional<std::pair<std::size_t, std::size_t>> Validator::function_bytes(
+  std::size_t sym_index) const
+{
+    const uint64_t sym_addr = m_sym->value(sym_index);
+    uint64_t func_addr = sym_addr;
+    if (m_options.machine == EM_ARM) {
+        // bit 0 of a Thumb function's address selects the instruction set
+        func_addr &= ~uint64_t{ 1 };
+    }
+    uint64_t offset = func_addr - m_text.header.sh_addr;
+    if (offset >= m_text.data.size()) {
+        return std::nullopt;
+    }
+
+    size_t func_size = m_sym->symbol_size(sym_index);
+    if (func_size == 0) {
+        // st_size is 0 for many assembly / compiler-generated functions
+        auto extent = m_functions.function_at(sym_addr);
+        if (extent.has_value() && extent->start == sym_addr) {
+            func_size = extent->end - extent->start;
+        }
+    }
+    func_size = std::min<size_t>(func_size, m_text.data.size() - offset);
+    return std::pair{ static_cast<size_t>(offset), func_size };
+}
+
 std::vector<symbol_s> Validator::find_thrown_functions()
 {
+    if (m_options.window_size != 0) {
+        return find_thrown_functions_windowed();
+    }
+
     std::vector<symbol_s> out;
 
-    for (const auto& s : m_sym) {
-        // Only consider real functions
-        if (GELF_ST_TYPE(s.info) != STT_FUNC) {
-            continue;
+    // Only consider real functions, skipping undefined / external stubs
+    for (std::uint32_t i : m_sym->defined_of_type(STT_FUNC)) {
+        auto thrown_opt = find_typeinfo_at(i);
+        if (thrown_opt.has_value() && !thrown_opt->empty()) {
+            out.push_back(m_sym->to_symbol(i));
         }
-        // skip undefined / external stubs if you want
-        if (s.shndx == SHN_UNDEF) {
-            continue;
+    }
+
+    return out;
+}
+
+std::vector<symbol_s> Validator::find_thrown_functions_windowed()
+{
+    // Visit the functions in address order so every window of .text is
+    // read once and can be released right after; report them in symbol
+    // table order like find_thrown_functions()
+    std::vector<std::uint32_t> functions = m_sym->defined_of_type(STT_FUNC);
+    std::ranges::stable_sort(functions, {}, [this](std::uint32_t i) {
+        return m_sym->value(i);
+    });
+
+    std::vector<std::uint32_t> throwing;
+    size_t next = 0;
+    while (next < functions.size()) {
+        size_t window_begin = m_text.data.size();
+        size_t window_end = 0;
+        for (; next < functions.size(); next++) {
+            const std::uint32_t i = functions[next];
+            auto bytes = function_bytes(i);
+            if (bytes.has_value()) {
+                const size_t end = bytes->first + bytes->second;
+                // a function that would overflow the window starts the next
+                if (window_begin < window_end && end > window_end
+                    && end - window_begin > m_options.window_size) {
+                    break;
+                }
+                window_begin = std::min(window_begin, bytes->first);
+                window_end = std::max(window_end, end);
+            }
+            auto thrown_opt = find_typeinfo_at(i);
+            if (thrown_opt.has_value() && !thrown_opt->empty()) {
+                throwing.push_back(i);
+            }
         }
 
-        if (check_thrown_functions(s.name)) {
-            out.push_back(s);
+        if (m_options.release && window_begin < window_end) {
+            m_options.release(
+              m_text.data.subspan(window_begin, window_end - window_begin));
         }
     }
 
+    std::ranges::sort(throwing);
+    std::vector<symbol_s> out;
+    out.reserve(throwing.size());
+    for (std::uint32_t i : throwing) {
+        out.push_back(m_sym->to_symbol(i));
+    }
     return out;
 }
 
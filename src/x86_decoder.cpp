@@ -0,0 +1,544 @@
+/**
+ * @file x86_decoder.cpp
+ * @author SAFE Group
+ * @brief x86-64 instruction length decoder implementation file
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ **/
+
+#include "x86_decoder.hpp"
+
+namespace safe {
+
+namespace {
+
+constexpr size_t max_length = 15;
+
+// immediate operand of a one-byte or 0F opcode
+enum class immediate : uint8_t
+{
+    none,
+    byte,    // ib, or rel8
+    word,    // iw
+    sized,   // iz: 2 bytes with 0x66, 4 otherwise
+    full,    // iv: mov r64, imm64 with REX.W
+    offset,  // moffs: an 8-byte address, 4 with 0x67
+    enter,   // iw, ib
+    group3,  // test in group 3: ib or iz when ModRM.reg < 2
+    dword    // rel32, whatever the operand size
+};
+
+struct opcode_info_s
+{
+    bool valid = true;
+    bool modrm = false;
+    immediate operand = immediate::none;
+};
+
+opcode_info_s one_byte(uint8_t p_opcode)
+{
+    // ALU: op r/m,r  op r,r/m  op al,ib  op eax,iz
+    if (p_opcode < 0x40) {
+        switch (p_opcode) {
+            case 0x06:
+            case 0x07:
+            case 0x0e:
+            case 0x16:
+            case 0x17:
+            case 0x1e:
+            case 0x1f:
+            case 0x27:
+            case 0x2f:
+            case 0x37:
+            case 0x3f:
+                return { false };
+            default:
+                break;
+        }
+        switch (p_opcode & 7) {
+            case 4:
+                return { true, false, immediate::byte };
+            case 5:
+                return { true, false, immediate::sized };
+            default:
+                return { true, true };
+        }
+    }
+    if (p_opcode >= 0x50 && p_opcode <= 0x5f) {
+        return { true };  // push, pop
+    }
+    if (p_opcode >= 0x70 && p_opcode <= 0x7f) {
+        return { true, false, immediate::byte };  // jcc rel8
+    }
+    if (p_opcode >= 0x84 && p_opcode <= 0x8f) {
+        return { true, true };  // test, xchg, mov, lea, pop r/m
+    }
+    if (p_opcode >= 0x90 && p_opcode <= 0x9f) {
+        return { p_opcode != 0x9a };  // xchg, cbw, pushf...
+    }
+    if (p_opcode >= 0xa0 && p_opcode <= 0xa3) {
+        return { true, false, immediate::offset };
+    }
+    if (p_opcode >= 0xa4 && p_opcode <= 0xaf) {
+        return { true, false, p_opcode == 0xa8   ? immediate::byte
+                              : p_opcode == 0xa9 ? immediate::sized
+                                                 : immediate::none };
+    }
+    if (p_opcode >= 0xb0 && p_opcode <= 0xb7) {
+        return { true, false, immediate::byte };
+    }
+    if (p_opcode >= 0xb8 && p_opcode <= 0xbf) {
+        return { true, false, immediate::full };
+    }
+    if (p_opcode >= 0xd8 && p_opcode <= 0xdf) {
+        return { true, true };  // x87
+    }
+    if (p_opcode >= 0xe0 && p_opcode <= 0xe7) {
+        return { true, false, immediate::byte };  // loop, jrcxz, in, out
+    }
+    switch (p_opcode) {
+        case 0x63:
+        case 0xd0:
+        case 0xd1:
+        case 0xd2:
+        case 0xd3:
+        case 0xfe:
+        case 0xff:
+            return { true, true };
+        case 0x68:
+            return { true, false, immediate::sized };
+        case 0x69:
+        case 0x81:
+        case 0xc7:
+            return { true, true, immediate::sized };
+        case 0x6a:
+        case 0xcd:
+        case 0xeb:
+            return { true, false, immediate::byte };
+        case 0x6b:
+        case 0x80:
+        case 0x83:
+        case 0xc0:
+        case 0xc1:
+        case 0xc6:
+            return { true, true, immediate::byte };
+        case 0x6c:
+        case 0x6d:
+        case 0x6e:
+        case 0x6f:
+        case 0xc3:
+        case 0xc9:
+        case 0xcb:
+        case 0xcc:
+        case 0xcf:
+        case 0xd7:
+        case 0xec:
+        case 0xed:
+        case 0xee:
+        case 0xef:
+        case 0xf1:
+        case 0xf4:
+        case 0xf5:
+        case 0xf8:
+        case 0xf9:
+        case 0xfa:
+        case 0xfb:
+        case 0xfc:
+        case 0xfd:
+            return { true };
+        case 0xc2:
+        case 0xca:
+            return { true, false, immediate::word };
+        case 0xc8:
+            return { true, false, immediate::enter };
+        case 0xe8:
+        case 0xe9:
+            return { true, false, immediate::dword };
+        case 0xf6:
+        case 0xf7:
+            return { true, true, immediate::group3 };
+        default:
+            return { false };  // invalid in 64-bit mode
+    }
+}
+
+opcode_info_s two_byte(uint8_t p_opcode)
+{
+    if (p_opcode >= 0x80 && p_opcode <= 0x8f) {
+        return { true, false, immediate::dword };  // jcc rel32
+    }
+    if (p_opcode >= 0xc8 && p_opcode <= 0xcf) {
+        return { true };  // bswap
+    }
+    switch (p_opcode) {
+        case 0x05:
+        case 0x06:
+        case 0x07:
+        case 0x08:
+        case 0x09:
+        case 0x0b:
+        case 0x0e:
+        case 0x30:
+        case 0x31:
+        case 0x32:
+        case 0x33:
+        case 0x34:
+        case 0x35:
+        case 0x37:
+        case 0x77:
+        case 0xa0:
+        case 0xa1:
+        case 0xa2:
+        case 0xa8:
+        case 0xa9:
+        case 0xaa:
+            return { true };
+        case 0x04:
+        case 0x0a:
+        case 0x0c:
+        case 0x24:
+        case 0x25:
+        case 0x26:
+        case 0x27:
+        case 0x36:
+        case 0x39:
+        case 0x3b:
+        case 0x3c:
+        case 0x3d:
+        case 0x3e:
+        case 0x3f:
+            return { false };
+        case 0x0f:  // 3DNow!, the opcode follows as an immediate
+        case 0x70:
+        case 0x71:
+        case 0x72:
+        case 0x73:
+        case 0xa4:
+        case 0xac:
+        case 0xba:
+        case 0xc2:
+        case 0xc4:
+        case 0xc5:
+        case 0xc6:
+            return { true, true, immediate::byte };
+        default:
+            return { true, true };
+    }
+}
+
+// VEX and EVEX opcodes of the 0F map that take an imm8
+bool vector_map1_immediate(uint8_t p_opcode)
+{
+    return (p_opcode >= 0x70 && p_opcode <= 0x73) || p_opcode == 0xc2
+           || p_opcode == 0xc4 || p_opcode == 0xc5 || p_opcode == 0xc6;
+}
+
+}  // namespace
+
+std::optional<x86_instruction_s> decode_x86_64(
+  std::span<const std::byte> p_code,
+  uint64_t p_address)
+{
+    const size_t limit = std::min(p_code.size(), max_length);
+    size_t index = 0;
+    auto next = [&]() -> std::optional<uint8_t> {
+        if (index >= limit) {
+            return std::nullopt;
+        }
+        return std::to_integer<uint8_t>(p_code[index++]);
+    };
+
+    x86_instruction_s instruction;
+    instruction.address = p_address;
+    bool address_size_32 = false;
+    uint8_t rex = 0;
+    std::optional<uint8_t> byte = next();
+
+    // legacy prefixes; a REX prefix only counts right before the opcode
+    while (byte.has_value()) {
+        const uint8_t value = *byte;
+        if (value == 0x66) {
+            instruction.operand_size_16 = true;
+        } else if (value == 0x67) {
+            address_size_32 = true;
+        } else if (value != 0xf0 && value != 0xf2 && value != 0xf3
+                   && value != 0x2e && value != 0x36 && value != 0x3e
+                   && value != 0x26 && value != 0x64 && value != 0x65
+                   && (value & 0xf0) != 0x40) {
+            break;
+        }
+        rex = (value & 0xf0) == 0x40 ? value : 0;
+        byte = next();
+    }
+    if (!byte.has_value()) {
+        return std::nullopt;
+    }
+
+    bool rex_r = (rex & 4) != 0;
+    bool rex_b = (rex & 1) != 0;
+    instruction.rex_w = (rex & 8) != 0;
+    opcode_info_s info;
+    const uint8_t first = *byte;
+
+    if (first == 0xc4 || first == 0xc5 || first == 0x62
+        || (first == 0x8f && index < limit
+            && (std::to_integer<uint8_t>(p_code[index]) & 0x1f) >= 8)) {
+        // VEX, EVEX and XOP carry the map and the REX bits themselves
+        auto p0 = next();
+        if (!p0.has_value()) {
+            return std::nullopt;
+        }
+        instruction.vector = true;
+        rex_r = (*p0 & 0x80) == 0;
+        if (first == 0xc5) {
+            instruction.map = 1;
+            rex_b = false;
+        } else {
+            auto p1 = next();
+            if (!p1.has_value()) {
+                return std::nullopt;
+            }
+            rex_b = (*p0 & 0x20) == 0;
+            instruction.rex_w = (*p1 & 0x80) != 0;
+            if (first == 0x62) {
+                if (!next().has_value()) {
+                    return std::nullopt;
+                }
+                instruction.map = *p0 & 7;
+            } else {
+                instruction.map = *p0 & 0x1f;
+            }
+        }
+        auto opcode = next();
+        if (!opcode.has_value()) {
+            return std::nullopt;
+        }
+        instruction.opcode = *opcode;
+        // everything but vzeroupper and vzeroall has a ModRM byte
+        info.modrm = first == 0x62 || first == 0x8f || instruction.map != 1
+                     || instruction.opcode != 0x77;
+        if (first == 0x8f) {
+            // XOP map 8 takes an imm8, map 0xA an imm32
+            if (instruction.map == 8) {
+                info.operand = immediate::byte;
+            } else if (instruction.map == 0xa) {
+                info.operand = immediate::dword;
+            } else if (instruction.map != 9) {
+                return std::nullopt;
+            }
+        } else if (instruction.map == 3
+                   || (instruction.map == 1
+                       && vector_map1_immediate(instruction.opcode))) {
+            info.operand = immediate::byte;
+        } else if (instruction.map == 0 || instruction.map > 7
+                   || (first != 0x62 && instruction.map > 3)) {
+            return std::nullopt;
+        }
+    } else if (first == 0x0f) {
+        auto second = next();
+        if (!second.has_value()) {
+            return std::nullopt;
+        }
+        if (*second == 0x38 || *second == 0x3a) {
+            instruction.map = *second == 0x38 ? 2 : 3;
+            auto opcode = next();
+            if (!opcode.has_value()) {
+                return std::nullopt;
+            }
+            instruction.opcode = *opcode;
+            info.modrm = true;
+            info.operand
+              = instruction.map == 3 ? immediate::byte : immediate::none;
+        } else {
+            instruction.map = 1;
+            instruction.opcode = *second;
+            info = two_byte(*second);
+        }
+    } else {
+        instruction.opcode = first;
+        info = one_byte(first);
+    }
+    if (!info.valid) {
+        return std::nullopt;
+    }
+
+    // registers encoded in the opcode
+    const uint8_t opcode = instruction.opcode;
+    if (instruction.map == 0 && !instruction.vector
+        && ((opcode >= 0x50 && opcode <= 0x5f)
+            || (opcode >= 0x90 && opcode <= 0x97)
+            || (opcode >= 0xb0 && opcode <= 0xbf))) {
+        instruction.reg = static_cast<uint8_t>((opcode & 7) | (rex_b ? 8 : 0));
+    } else if (instruction.map == 1 && !instruction.vector && opcode >= 0xc8
+               && opcode <= 0xcf) {
+        instruction.reg = static_cast<uint8_t>((opcode & 7) | (rex_b ? 8 : 0));
+    }
+
+    // ModRM, SIB and displacement
+    std::optional<size_t> rip_displacement;
+    if (info.modrm) {
+        auto modrm = next();
+        if (!modrm.has_value()) {
+            return std::nullopt;
+        }
+        instruction.modrm = *modrm;
+        const uint8_t mod = *modrm >> 6;
+        const uint8_t rm = *modrm & 7;
+        instruction.reg
+          = static_cast<uint8_t>(((*modrm >> 3) & 7) | (rex_r ? 8 : 0));
+        size_t displacement = 0;
+        if (mod == 3) {
+            instruction.rm_register
+              = static_cast<uint8_t>(rm | (rex_b ? 8 : 0));
+        } else {
+            if (rm == 4) {
+                auto sib = next();
+                if (!sib.has_value()) {
+                    return std::nullopt;
+                }
+                if (mod == 0 && (*sib & 7) == 5) {
+                    displacement = 4;
+                }
+            } else if (mod == 0 && rm == 5) {
+                displacement = 4;
+                rip_displacement = index;
+            }
+            if (mod == 1) {
+                displacement = 1;
+            } else if (mod == 2) {
+                displacement = 4;
+            }
+        }
+        if (index + displacement > limit) {
+            return std::nullopt;
+        }
+        index += displacement;
+    }
+
+    // immediate
+    size_t immediate_size = 0;
+    const size_t sized = instruction.operand_size_16 ? 2 : 4;
+    switch (info.operand) {
+        case immediate::none:
+            break;
+        case immediate::byte:
+            immediate_size = 1;
+            break;
+        case immediate::word:
+            immediate_size = 2;
+            break;
+        case immediate::sized:
+            immediate_size = sized;
+            break;
+        case immediate::full:
+            immediate_size = instruction.rex_w ? 8 : sized;
+            break;
+        case immediate::offset:
+            immediate_size = address_size_32 ? 4 : 8;
+            break;
+        case immediate::enter:
+            immediate_size = 3;
+            break;
+        case immediate::group3:
+            if ((instruction.reg & 7) < 2) {
+                immediate_size = opcode == 0xf6 ? 1 : sized;
+            }
+            break;
+        case immediate::dword:
+            immediate_size = 4;
+            break;
+    }
+    if (index + immediate_size > limit) {
+        return std::nullopt;
+    }
+    if (immediate_size != 0 && info.operand != immediate::offset
+        && info.operand != immediate::enter) {
+        uint64_t value = 0;
+        for (size_t i = immediate_size; i-- > 0;) {
+            value = value << 8 | std::to_integer<uint8_t>(p_code[index + i]);
+        }
+        // sign extend from the immediate's width
+        const unsigned shift = 64 - static_cast<unsigned>(immediate_size) * 8;
+        instruction.immediate
+          = shift == 0 ? static_cast<int64_t>(value)
+                       : static_cast<int64_t>(value << shift) >> shift;
+    }
+    index += immediate_size;
+
+    instruction.length = static_cast<uint8_t>(index);
+    const uint64_t end = p_address + index;
+    if (rip_displacement.has_value()) {
+        uint32_t displacement = 0;
+        for (size_t i = 4; i-- > 0;) {
+            displacement = displacement << 8
+                           | std::to_integer<uint8_t>(
+                             p_code[*rip_displacement + i]);
+        }
+        instruction.rip_target
+          = end + static_cast<int64_t>(static_cast<int32_t>(displacement));
+    }
+
+    // relative branches: their immediate is the offset from the next one
+    const bool rel8 = instruction.map == 0 && !instruction.vector
+                      && ((opcode >= 0x70 && opcode <= 0x7f) || opcode == 0xeb
+                          || (opcode >= 0xe0 && opcode <= 0xe3));
+    const bool rel32 = !instruction.vector
+                       && ((instruction.map == 0
+                            && (opcode == 0xe8 || opcode == 0xe9))
+                           || (instruction.map == 1 && opcode >= 0x80
+                               && opcode <= 0x8f));
+    if ((rel8 || rel32) && instruction.immediate.has_value()) {
+        instruction.branch_target = end + *instruction.immediate;
+        instruction.immediate.reset();
+    }
+    return instruction;
+}
+
+std::vector<x86_instruction_s> sweep_x86_64(std::span<const std::byte> p_code,
+                                            uint64_t p_address)
+{
+    std::vector<x86_instruction_s> instructions;
+    size_t offset = 0;
+    while (offset < p_code.size()) {
+        auto instruction
+          = decode_x86_64(p_code.subspan(offset), p_address + offset);
+        if (!instruction.has_value()) {
+            offset++;
+            continue;
+        }
+        offset += instruction->length;
+        instructions.push_back(*instruction);
+    }
+    return instructions;
+}
+
+std::vector<x86_reference_s> x86_references(std::span<const std::byte> p_code,
+                                            uint64_t p_address)
+{
+    std::vector<x86_reference_s> references;
+    for (const x86_instruction_s& instruction :
+         sweep_x86_64(p_code, p_address)) {
+        const bool one_byte_map = instruction.map == 0 && !instruction.vector;
+        if (instruction.rip_target.has_value()) {
+            const bool lea = one_byte_map && instruction.opcode == 0x8d;
+            references.push_back({ instruction.address,
+                                   *instruction.rip_target,
+                                   lea ? x86_reference_kind::ADDRESS
+                                       : x86_reference_kind::MEMORY });
+        } else if (one_byte_map && instruction.branch_target.has_value()
+                   && (instruction.opcode == 0xe8
+                       || instruction.opcode == 0xe9)) {
+            references.push_back({ instruction.address,
+                                   *instruction.branch_target,
+                                   instruction.opcode == 0xe8
+                                     ? x86_reference_kind::CALL
+                                     : x86_reference_kind::JUMP });
+        }
+    }
+    return references;
+}
+
+}  // namespace safe
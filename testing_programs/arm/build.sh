@@ -0,0 +1,15 @@
+#!/bin/sh
+# Rebuilds firmware.elf, a Cortex-M0 image unwound through .ARM.exidx and
+# .ARM.extab, with LLVM's code generator and linker. The result is checked
+# in so the tests need no ARM toolchain.
+#   LLC, LLVM_MC: llc and llvm-mc with the ARM target (LLVM 14 or later)
+#   LLD:          ld.lld, or rust-lld -flavor gnu
+set -e
+LLC=${LLC:-llc}
+LLVM_MC=${LLVM_MC:-llvm-mc}
+LLD=${LLD:-ld.lld}
+$LLC -O1 -filetype=obj firmware.ll -o firmware.o
+$LLVM_MC -triple=thumbv6m-none-eabi -filetype=obj runtime.s -o runtime.o
+# TARGET2 is absolute on bare metal, as arm-none-eabi-ld resolves it
+$LLD --target2=abs -n -T firmware.ld firmware.o runtime.o -o firmware.elf
+rm firmware.o runtime.o
@@ -0,0 +1,32 @@
+// Cortex-M firmware the checked-in firmware.elf is built from, through the
+// equivalent firmware.ll (see build.sh)
+
+struct sensor_error
+{
+    int code;
+};
+
+[[gnu::noinline]] int read_sensor(int channel)
+{
+    if (channel > 3) {
+        throw sensor_error{ channel };
+    }
+    return channel * 10;
+}
+
+int poll(int channel)
+{
+    try {
+        if (channel < 0) {
+            throw sensor_error{ channel };
+        }
+        return read_sensor(channel);
+    } catch (const sensor_error& error) {
+        return -error.code;
+    }
+}
+
+int main()
+{
+    return poll(5);
+}
@@ -0,0 +1,86 @@
+; firmware.cpp as clang++ --target=thumbv6m-none-eabi -O1 lowers it
+target datalayout = "e-m:e-p:32:32-Fi8-i64:64-v128:64:128-a:0:32-n32-S64"
+target triple = "thumbv6m-none-unknown-eabi"
+
+@_ZTVN10__cxxabiv117__class_type_infoE = external global i8*
+@_ZTS12sensor_error = linkonce_odr constant [15 x i8] c"12sensor_error\00"
+@_ZTI12sensor_error = linkonce_odr constant { i8*, i8* } {
+  i8* bitcast (i8** getelementptr inbounds (i8*, i8** @_ZTVN10__cxxabiv117__class_type_infoE, i32 2) to i8*),
+  i8* getelementptr inbounds ([15 x i8], [15 x i8]* @_ZTS12sensor_error, i32 0, i32 0) }
+
+declare i8* @__cxa_allocate_exception(i32)
+declare void @__cxa_throw(i8*, i8*, i8*)
+declare i8* @__cxa_begin_catch(i8*)
+declare void @__cxa_end_catch()
+declare i32 @__gxx_personality_v0(...)
+declare i32 @llvm.eh.typeid.for(i8*)
+
+define i32 @_Z11read_sensori(i32 %channel) noinline uwtable {
+entry:
+  %cmp = icmp sgt i32 %channel, 3
+  br i1 %cmp, label %throw, label %ok
+
+throw:
+  %exception = call i8* @__cxa_allocate_exception(i32 4)
+  %object = bitcast i8* %exception to i32*
+  store i32 %channel, i32* %object
+  call void @__cxa_throw(i8* %exception,
+                         i8* bitcast ({ i8*, i8* }* @_ZTI12sensor_error to i8*),
+                         i8* null) noreturn
+  unreachable
+
+ok:
+  %value = mul i32 %channel, 10
+  ret i32 %value
+}
+
+define i32 @_Z4polli(i32 %channel) uwtable personality i8* bitcast (i32 (...)* @__gxx_personality_v0 to i8*) {
+entry:
+  %negative = icmp slt i32 %channel, 0
+  br i1 %negative, label %throw, label %read
+
+throw:
+  %thrown = call i8* @__cxa_allocate_exception(i32 4)
+  %object = bitcast i8* %thrown to i32*
+  store i32 %channel, i32* %object
+  invoke void @__cxa_throw(i8* %thrown,
+                           i8* bitcast ({ i8*, i8* }* @_ZTI12sensor_error to i8*),
+                           i8* null) noreturn
+          to label %unreachable unwind label %pad
+
+unreachable:
+  unreachable
+
+read:
+  %value = invoke i32 @_Z11read_sensori(i32 %channel)
+          to label %done unwind label %pad
+
+done:
+  ret i32 %value
+
+pad:
+  %landing = landingpad { i8*, i32 }
+          catch i8* bitcast ({ i8*, i8* }* @_ZTI12sensor_error to i8*)
+  %selector = extractvalue { i8*, i32 } %landing, 1
+  %type = call i32 @llvm.eh.typeid.for(i8* bitcast ({ i8*, i8* }* @_ZTI12sensor_error to i8*))
+  %matches = icmp eq i32 %selector, %type
+  br i1 %matches, label %handler, label %unwind
+
+handler:
+  %exception = extractvalue { i8*, i32 } %landing, 0
+  %caught = call i8* @__cxa_begin_catch(i8* %exception)
+  %error = bitcast i8* %caught to i32*
+  %code = load i32, i32* %error
+  %negated = sub i32 0, %code
+  call void @__cxa_end_catch()
+  ret i32 %negated
+
+unwind:
+  resume { i8*, i32 } %landing
+}
+
+define i32 @main() uwtable {
+entry:
+  %value = call i32 @_Z4polli(i32 5)
+  ret i32 %value
+}
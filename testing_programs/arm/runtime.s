@@ -0,0 +1,43 @@
+@ Vector table, reset handler and the C++ runtime entry points firmware.ll
+@ calls, stubbed: only their symbols matter to the analysis
+    .syntax unified
+    .cpu cortex-m0
+    .thumb
+
+    .section .isr_vector, "a", %progbits
+    .word _stack_top
+    .word Reset_Handler
+
+    .text
+    .macro stub name
+    .globl \name
+    .type \name, %function
+    .thumb_func
+\name:
+    bx lr
+    .size \name, . - \name
+    .endm
+
+    .globl Reset_Handler
+    .type Reset_Handler, %function
+    .thumb_func
+Reset_Handler:
+    bl main
+    b .
+    .size Reset_Handler, . - Reset_Handler
+
+    stub __cxa_allocate_exception
+    stub __cxa_throw
+    stub __cxa_begin_catch
+    stub __cxa_end_catch
+    stub _Unwind_Resume
+    stub __gxx_personality_v0
+    stub __aeabi_unwind_cpp_pr0
+
+    .section .rodata
+    .globl _ZTVN10__cxxabiv117__class_type_infoE
+    .type _ZTVN10__cxxabiv117__class_type_infoE, %object
+    .p2align 2
+_ZTVN10__cxxabiv117__class_type_infoE:
+    .space 16
+    .size _ZTVN10__cxxabiv117__class_type_infoE, 16
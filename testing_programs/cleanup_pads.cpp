@@ -0,0 +1,43 @@
+#include <cstdio>
+
+struct guard
+{
+    ~guard()
+    {
+        std::puts("released");
+    }
+};
+
+// defined in C, in cleanup_scale.c
+extern "C" int scale(int value);
+
+void may_fail(int value)
+{
+    if (value < 0) {
+        throw value;
+    }
+}
+
+int only_c_calls(int value)
+{
+    guard held;
+    std::puts("scaling");
+    return scale(value);
+}
+
+int mixed_calls(int value)
+{
+    guard held;
+    const int scaled = scale(value);
+    may_fail(scaled);
+    return scaled;
+}
+
+int main(int argc, char**)
+{
+    try {
+        return only_c_calls(argc) + mixed_calls(argc - 2);
+    } catch (int code) {
+        return code;
+    }
+}
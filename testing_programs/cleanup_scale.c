@@ -0,0 +1,4 @@
+int scale(int value)
+{
+    return value * 3;
+}
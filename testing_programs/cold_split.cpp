@@ -0,0 +1,34 @@
+#include <cstdio>
+#include <stdexcept>
+
+struct guard
+{
+    ~guard()
+    {
+        std::puts("bye");
+    }
+};
+
+// at -O2 the throw moves to check(int) [clone .cold], reached by a jcc
+[[gnu::noinline]] int check(int value)
+{
+    if (__builtin_expect(value < 0, 0)) {
+        throw std::runtime_error("neg");
+    }
+    return value * 3;
+}
+
+[[gnu::noinline]] int user(int value)
+{
+    guard held;
+    return check(value) + 1;
+}
+
+int main(int argc, char**)
+{
+    try {
+        return user(argc - 2);
+    } catch (const std::exception&) {
+        return 1;
+    }
+}
@@ -0,0 +1,6 @@
+#include "demo_inline.h"
+
+int ratio(int a, int b)
+{
+    return checked_divide(a, b);
+}
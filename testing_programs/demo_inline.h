@@ -0,0 +1,10 @@
+#pragma once
+#include <stdexcept>
+
+inline int checked_divide(int a, int b)
+{
+    if (b == 0) {
+        throw std::domain_error("division by zero");
+    }
+    return a / b;
+}
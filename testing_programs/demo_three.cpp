@@ -0,0 +1,6 @@
+#include "demo_inline.h"
+
+int half(int a)
+{
+    return checked_divide(a, 2);
+}
@@ -1,6 +1,23 @@
 mkdir build/
 g++ -o build/demo_class -fdump-ipa-whole-program -flto -O0 demo_class.cpp
 g++ -static simple.cpp -o build/simple 
+g++ -fPIE -pie pie_catch.cpp -o build/pie_catch
+g++ -fPIE -pie cleanup_pads.cpp -x c cleanup_scale.c -o build/cleanup_pads
+objcopy --strip-symbol=_Z8may_faili build/cleanup_pads build/cleanup_pads_nosym
+g++ -O2 -fPIE -pie cold_split.cpp -o build/cold_split
+g++ -shared -fPIC -Wl,--hash-style=both demo_two.cpp -o build/libdemo_two.so
+strip --strip-all build/libdemo_two.so -o build/libdemo_two_stripped.so
+g++ demo_class.cpp -Lbuild -ldemo_two -Wl,-rpath,'$ORIGIN' -o build/demo_dynamic
+g++ -c demo_class.cpp -o build/demo_class.o
+g++ -c demo_three.cpp -o build/demo_three.o
+g++ -c demo_four.cpp -o build/demo_four.o
+ar rcs build/libdemo.a build/demo_class.o build/demo_three.o build/demo_four.o
+g++ -g -Wl,--build-id demo_class.cpp demo_two.cpp -o build/demo_debug_full
+objcopy --only-keep-debug build/demo_debug_full build/demo_stripped.debug
+objcopy --strip-all --add-gnu-debuglink=build/demo_stripped.debug build/demo_debug_full build/demo_stripped
+g++ -g -Wl,--build-id=none demo_class.cpp demo_two.cpp -o build/demo_no_id_full
+objcopy --only-keep-debug build/demo_no_id_full build/demo_no_id.debug
+objcopy --strip-all --add-gnu-debuglink=build/demo_no_id.debug build/demo_no_id_full build/demo_no_id
 cd build/
 mv demo_class.wpa.*.whole-program multi_tu.whole-program
 echo Built example program with multiple TUs.
\ No newline at end of file
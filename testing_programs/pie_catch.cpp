@@ -0,0 +1,28 @@
+#include <stdexcept>
+
+struct parse_error
+{
+    int code;
+};
+
+void check(int value)
+{
+    if (value < 0) {
+        throw parse_error{ value };
+    }
+    if (value == 0) {
+        throw std::runtime_error("zero");
+    }
+}
+
+int main(int argc, char**)
+{
+    try {
+        check(argc - 2);
+    } catch (const parse_error& error) {
+        return error.code;
+    } catch (const std::exception&) {
+        return 1;
+    }
+    return 0;
+}
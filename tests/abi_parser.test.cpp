@@ -1,8 +1,11 @@
 #include "abi_parse.hpp"
+#include "eh_frame.hpp"
 #include "elf_parser.hpp"
 
 #include <boost/ut.hpp>
 
+#include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
@@ -55,4 +58,269 @@ boost::ut::suite<"Abi_Parser_Test"> abi_parser_test = [] {
             expect(false) << "exception thrown while parsing LSDA";
         }
     };
+
+    "whole_table_lsdas"_test = [] {
+        ElfParser elf("../../testing_programs/build/simple");
+        auto table = elf.get_section_view(".gcc_except_table");
+        auto eh_frame_section = elf.get_section_view(".eh_frame");
+        expect(table.has_value() && eh_frame_section.has_value());
+        if (!table.has_value() || !eh_frame_section.has_value()) {
+            return;
+        }
+        auto eh_frame = EhFrame::parse(
+          *eh_frame_section, std::nullopt, elf.get_encoding());
+        auto fdes = eh_frame.value().fdes().value();
+
+        // the LSDAs .eh_frame points to are exactly the ones the walk finds
+        const uint64_t address = table->header.sh_addr;
+        std::vector<size_t> referenced;
+        for (const auto& fde : fdes) {
+            if (fde.lsda.has_value()) {
+                referenced.push_back(*fde.lsda - address);
+            }
+        }
+        std::ranges::sort(referenced);
+        const auto duplicates = std::ranges::unique(referenced);
+        referenced.erase(duplicates.begin(), duplicates.end());
+        const auto scanned = LsdaTable::scan_offsets(table->data);
+        expect(scanned.size() > 1_u) << "expect more than the first LSDA";
+        expect(scanned == referenced) << "walk found " << scanned.size()
+                                      << ", .eh_frame has "
+                                      << referenced.size();
+
+        LsdaTable lsdas(table->data, address);
+        expect(lsdas.size() == scanned.size());
+        expect(lsdas.get_failures() == 0_u);
+        expect(lsdas.find(1) == nullptr) << "not the start of an LSDA";
+        for (size_t offset : scanned) {
+            const LsdaParser* parsed = lsdas.find(offset);
+            expect(parsed != nullptr) << "no LSDA at " << offset;
+            if (parsed == nullptr) {
+                continue;
+            }
+            // decoded in place, straight from the mapped section
+            expect(static_cast<const void*>(parsed->get_bytes().data())
+                   == static_cast<const void*>(table->data.data() + offset));
+
+            // the parallel parse matches a parse of that LSDA alone
+            LsdaParser alone(table->data, offset, address);
+            expect(parsed->get_call_sites().size()
+                   == alone.get_call_sites().size());
+            expect(parsed->type_table == alone.type_table);
+        }
+    };
+
+    "shared_handler_chains"_test = [] {
+        ElfParser elf("../../testing_programs/build/simple");
+        auto table = elf.get_section_view(".gcc_except_table");
+        expect(table.has_value()) << "missing .gcc_except_table";
+        if (!table.has_value()) {
+            return;
+        }
+
+        LsdaTable lsdas(table->data, table->header.sh_addr);
+        size_t shared = 0;
+        for (size_t offset : lsdas.get_offsets()) {
+            const LsdaParser* lsda = lsdas.find(offset);
+            if (lsda == nullptr) {
+                continue;
+            }
+            // scopes are the call sites with a landing pad, in order
+            std::vector<int64_t> scope_actions;
+            for (const auto& cs : lsda->get_call_sites()) {
+                if (cs.landing_pad != 0) {
+                    scope_actions.push_back(std::max<int64_t>(cs.action, 0));
+                }
+            }
+            const auto& scopes = lsda->get_scopes();
+            expect(scopes.size() == scope_actions.size());
+            if (scopes.size() != scope_actions.size()) {
+                continue;
+            }
+
+            std::vector<int64_t> distinct = scope_actions;
+            std::ranges::sort(distinct);
+            const auto duplicates = std::ranges::unique(distinct);
+            distinct.erase(duplicates.begin(), duplicates.end());
+            expect(lsda->get_handler_chains().size() == distinct.size())
+              << "one chain per distinct action";
+            shared += scopes.size() - distinct.size();
+
+            for (size_t i = 0; i < scopes.size(); ++i) {
+                expect(!lsda->handlers(scopes[i]).empty());
+                for (size_t j = 0; j < i; ++j) {
+                    expect((scope_actions[i] == scope_actions[j])
+                           == (scopes[i].chain == scopes[j].chain));
+                }
+            }
+        }
+        expect(shared > 0_u) << "expect call sites to share chains";
+    };
+
+    "pc_lookup"_test = [] {
+        ElfParser elf("../../testing_programs/build/simple");
+        auto table = elf.get_section_view(".gcc_except_table");
+        expect(table.has_value()) << "missing .gcc_except_table";
+        if (!table.has_value()) {
+            return;
+        }
+
+        LsdaTable lsdas(table->data, table->header.sh_addr);
+        size_t checked = 0;
+        for (size_t offset : lsdas.get_offsets()) {
+            const LsdaParser* lsda = lsdas.find(offset);
+            if (lsda == nullptr) {
+                continue;
+            }
+            const auto& call_sites = lsda->get_call_sites();
+            size_t scope = 0;
+            for (const auto& cs : call_sites) {
+                const size_t this_scope = scope;
+                if (cs.landing_pad != 0) {
+                    ++scope;
+                }
+                if (cs.length == 0) {
+                    continue;
+                }
+                for (uint64_t pc : { cs.start, cs.start + cs.length - 1 }) {
+                    auto match = lsda->lookup(pc);
+                    expect(match.has_value()) << "no call site at " << pc;
+                    if (!match.has_value()) {
+                        continue;
+                    }
+                    expect(match->landing_pad == cs.landing_pad);
+                    if (cs.landing_pad == 0) {
+                        expect(match->handlers.empty());
+                        continue;
+                    }
+                    // the same handlers the scope holds, not a copy
+                    const auto expected
+                      = lsda->handlers(lsda->get_scopes()[this_scope]);
+                    expect(match->handlers.data() == expected.data()
+                           && match->handlers.size() == expected.size());
+                    ++checked;
+                }
+            }
+            if (call_sites.empty()) {
+                continue;
+            }
+            const auto& last = call_sites.back();
+            expect(!lsda->lookup(last.start + last.length).has_value())
+              << "past the last call site";
+        }
+        expect(checked > 0_u);
+    };
+
+    "malformed_lsdas_are_reported"_test = [] {
+        auto bytes_of = [](std::vector<uint8_t> values) {
+            std::vector<std::byte> bytes;
+            for (uint8_t value : values) {
+                bytes.push_back(static_cast<std::byte>(value));
+            }
+            return bytes;
+        };
+        auto has = [](const std::vector<LsdaDiagnostic>& diagnostics,
+                      LsdaError reason) {
+            return std::ranges::find(
+                     diagnostics, reason, &LsdaDiagnostic::reason)
+                   != diagnostics.end();
+        };
+
+        // one call site whose action record is its own successor
+        const auto cyclic = bytes_of(
+          { 0xff, 0xff, 0x01, 0x04, 0x00, 0x10, 0x20, 0x01, 0x00, 0x7f });
+        auto looped = LsdaParser::decode(cyclic, 0, 0);
+        expect(looped.has_value()) << "a cycle only truncates the chain";
+        if (looped.has_value()) {
+            expect(looped->get_scopes().size() == 1_u);
+            expect(looped->call_sites.at(0).size == 4_u);
+            expect(looped->handlers(looped->get_scopes()[0]).size() == 1_u);
+            expect(has(looped->get_diagnostics(), LsdaError::ActionCycle));
+        }
+
+        // action 5 points past the end of the action table
+        const auto dangling = bytes_of(
+          { 0xff, 0xff, 0x01, 0x04, 0x00, 0x10, 0x20, 0x05, 0x00, 0x00 });
+        auto cleanup = LsdaParser::decode(dangling, 0, 0);
+        expect(cleanup.has_value());
+        if (cleanup.has_value()) {
+            const auto& handlers
+              = cleanup->handlers(cleanup->get_scopes().at(0));
+            expect(handlers.size() == 1_u
+                   && handlers[0].type == HandlerType::Cleanup);
+            expect(has(cleanup->get_diagnostics(), LsdaError::DanglingAction));
+        }
+
+        // a call site table length wider than 64 bits
+        std::vector<uint8_t> overlong{ 0xff, 0xff, 0x01 };
+        overlong.insert(overlong.end(), 10, 0x80);
+        overlong.push_back(0x01);
+        auto wide = LsdaParser::decode(bytes_of(overlong), 0, 0);
+        expect(!wide.has_value() && wide.error().offset == 3_u
+               && wide.error().reason == LsdaError::BadLeb128);
+        expect(!LsdaParser::decode(dangling, dangling.size(), 0).has_value());
+
+        // every truncation of a real table fails softly, at a known offset
+        ElfParser elf("../../testing_programs/build/simple");
+        auto table = elf.get_section_view(".gcc_except_table");
+        expect(table.has_value()) << "missing .gcc_except_table";
+        if (!table.has_value()) {
+            return;
+        }
+        const auto offsets = LsdaTable::scan_offsets(table->data);
+        expect(offsets.size() > 1_u);
+        if (offsets.size() < 2) {
+            return;
+        }
+        const size_t first_size = offsets[1];
+        for (size_t size = 1; size < first_size; ++size) {
+            auto cut = table->data.first(size);
+            auto decoded = LsdaParser::decode(cut, 0, 0);
+            if (!decoded.has_value()) {
+                expect(decoded.error().offset <= size) << size;
+            }
+            LsdaTable lsdas(cut, 0, std::vector<size_t>{ 0 });
+            expect(lsdas.get_failures() == lsdas.get_diagnostics().size());
+        }
+    };
+
+    "udata4_call_sites_in_either_byte_order"_test = [] {
+        // one call site: start 0x10203, length 0x40, landing pad 0x1000
+        const std::vector<uint32_t> fields = { 0x10203, 0x40, 0x1000 };
+        for (auto order : { std::endian::little, std::endian::big }) {
+            std::vector<std::byte> lsda;
+            for (uint8_t value : { 0xff, 0xff, 0x03, 0x0d }) {
+                lsda.push_back(static_cast<std::byte>(value));
+            }
+            for (uint32_t field : fields) {
+                for (int i = 0; i < 4; ++i) {
+                    const int shift
+                      = (order == std::endian::little ? i : 3 - i) * 8;
+                    lsda.push_back(static_cast<std::byte>(field >> shift));
+                }
+            }
+            lsda.push_back(std::byte{ 0x00 });  // no action
+
+            LsdaContext context;
+            context.order = order;
+            auto specialized = LsdaParser::decode(lsda, 0, context);
+            // sdata4 reads the same bytes through r_encode
+            lsda[2] = std::byte{ 0x0b };
+            auto generic = LsdaParser::decode(lsda, 0, context);
+            expect(specialized.has_value() && generic.has_value());
+            if (!specialized.has_value() || !generic.has_value()) {
+                continue;
+            }
+            for (const auto* parsed : { &*specialized, &*generic }) {
+                expect(parsed->call_sites.size() == 1_u);
+                if (parsed->call_sites.size() != 1) {
+                    continue;
+                }
+                const CallSite& site = parsed->call_sites[0];
+                expect(site.start == fields[0] && site.length == fields[1]
+                       && site.landing_pad == fields[2]);
+                expect(site.size == 13_u);
+            }
+        }
+    };
 };
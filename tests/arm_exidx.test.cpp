@@ -0,0 +1,491 @@
+#include <gelf.h>
+
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "abi_parse.hpp"
+#include "arm_exidx.hpp"
+#include "eh_size.hpp"
+#include "elf_parser.hpp"
+#include "symbol_table.hpp"
+#include "validator.hpp"
+
+namespace {
+constexpr uint64_t text_address = 0x8000;
+constexpr uint64_t exidx_address = 0x9000;
+constexpr uint64_t extab_address = 0x9100;
+constexpr uint64_t personality_address = 0x8100;  // __gxx_personality_v0
+constexpr uint64_t typeinfo_address = 0xa000;
+
+void put(std::vector<std::byte>& p_out,
+         size_t p_offset,
+         uint64_t p_value,
+         size_t p_width,
+         std::endian p_order)
+{
+    if (p_out.size() < p_offset + p_width) {
+        p_out.resize(p_offset + p_width);
+    }
+    for (size_t i = 0; i < p_width; i++) {
+        const size_t shift = p_order == std::endian::little
+                               ? i * 8
+                               : (p_width - 1 - i) * 8;
+        p_out[p_offset + i] = static_cast<std::byte>((p_value >> shift) & 0xff);
+    }
+}
+
+uint32_t prel31(uint64_t p_place, uint64_t p_target)
+{
+    return static_cast<uint32_t>(p_target - p_place) & 0x7fff'ffff;
+}
+
+struct section_s
+{
+    std::string name;
+    uint32_t type;
+    uint32_t flags;
+    uint64_t address;
+    std::vector<std::byte> data;
+};
+
+// An ELF32 ARM executable holding p_sections and .shstrtab
+std::vector<std::byte> make_elf(std::endian p_order,
+                                std::vector<section_s> p_sections)
+{
+    std::string shstrtab(1, '\0');
+    std::vector<uint32_t> names;
+    for (const auto& section : p_sections) {
+        names.push_back(static_cast<uint32_t>(shstrtab.size()));
+        shstrtab += section.name;
+        shstrtab += '\0';
+    }
+    const auto shstrtab_name = static_cast<uint32_t>(shstrtab.size());
+    shstrtab += ".shstrtab";
+    shstrtab += '\0';
+
+    std::vector<std::byte> out(52);
+    std::vector<uint32_t> offsets;
+    for (const auto& section : p_sections) {
+        out.resize((out.size() + 3) & ~size_t{ 3 });
+        offsets.push_back(static_cast<uint32_t>(out.size()));
+        out.insert(out.end(), section.data.begin(), section.data.end());
+    }
+    const auto shstrtab_offset = static_cast<uint32_t>(out.size());
+    for (char c : shstrtab) {
+        out.push_back(static_cast<std::byte>(c));
+    }
+    out.resize((out.size() + 3) & ~size_t{ 3 });
+    const size_t shdr_offset = out.size();
+    const size_t shnum = p_sections.size() + 2;
+    out.resize(shdr_offset + shnum * 40);
+
+    auto u16 = [&](size_t offset, uint64_t value) {
+        put(out, offset, value, 2, p_order);
+    };
+    auto u32 = [&](size_t offset, uint64_t value) {
+        put(out, offset, value, 4, p_order);
+    };
+    out[0] = std::byte{ 0x7f };
+    out[1] = std::byte{ 'E' };
+    out[2] = std::byte{ 'L' };
+    out[3] = std::byte{ 'F' };
+    out[EI_CLASS] = std::byte{ ELFCLASS32 };
+    out[EI_DATA] = p_order == std::endian::little ? std::byte{ ELFDATA2LSB }
+                                                  : std::byte{ ELFDATA2MSB };
+    out[EI_VERSION] = std::byte{ EV_CURRENT };
+    u16(16, ET_EXEC);
+    u16(18, EM_ARM);
+    u32(20, EV_CURRENT);
+    u32(24, text_address);  // e_entry
+    u32(32, shdr_offset);   // e_shoff
+    u16(40, 52);            // e_ehsize
+    u16(46, 40);            // e_shentsize
+    u16(48, shnum);         // e_shnum
+    u16(50, shnum - 1);     // e_shstrndx
+
+    auto header = [&](size_t index,
+                      uint32_t name,
+                      uint32_t type,
+                      uint32_t flags,
+                      uint64_t address,
+                      uint32_t offset,
+                      size_t size) {
+        const size_t base = shdr_offset + index * 40;
+        u32(base + 0, name);
+        u32(base + 4, type);
+        u32(base + 8, flags);
+        u32(base + 12, address);
+        u32(base + 16, offset);
+        u32(base + 20, size);
+        u32(base + 32, 4);
+    };
+    for (size_t i = 0; i < p_sections.size(); i++) {
+        const auto& section = p_sections[i];
+        header(i + 1,
+               names[i],
+               section.type,
+               section.flags,
+               section.address,
+               offsets[i],
+               section.data.size());
+    }
+    header(
+      shnum - 1, shstrtab_name, SHT_STRTAB, 0, 0, shstrtab_offset,
+      shstrtab.size());
+    return out;
+}
+
+// The unwind tables arm-none-eabi-ld would emit for functions at 0x8000,
+// 0x8010, 0x8020 and 0x8030:
+// - 0x8000: inline __aeabi_unwind_cpp_pr0 entry
+// - 0x8010: __gxx_personality_v0 entry in .ARM.extab, with a GCC LSDA
+//   that catches the typeinfo at 0xa000 (TARGET2 as R_ARM_ABS32)
+// - 0x8020: __aeabi_unwind_cpp_pr1 entry in .ARM.extab
+// - 0x8030: EXIDX_CANTUNWIND
+std::vector<std::byte> make_unwind_elf(std::endian p_order)
+{
+    auto word = [p_order](std::vector<std::byte>& p_out, uint64_t p_value) {
+        put(p_out, p_out.size(), p_value, 4, p_order);
+    };
+    auto bytes = [](std::vector<std::byte>& p_out,
+                    std::initializer_list<uint8_t> p_values) {
+        for (uint8_t value : p_values) {
+            p_out.push_back(std::byte{ value });
+        }
+    };
+
+    // .ARM.extab
+    std::vector<std::byte> extab;
+    const uint64_t generic = extab_address + extab.size();
+    word(extab, prel31(generic, personality_address));
+    word(extab, 0x01'84'0f'b0);  // one more word; pop {r4, r5}, ...
+    word(extab, 0xb0'b0'b0'b0);
+    // LSDA: no LPStart, absptr type table, uleb128 call sites
+    bytes(extab, { 0xff, 0x00, 0x0c, 0x01, 0x04 });
+    bytes(extab, { 0x04, 0x04, 0x08, 0x01 });  // call site, action 1
+    bytes(extab, { 0x01, 0x00 });              // type 1, end of chain
+    put(extab, extab.size(), typeinfo_address, 4, p_order);
+    extab.resize((extab.size() + 3) & ~size_t{ 3 });
+    const uint64_t compact = extab_address + extab.size();
+    word(extab, 0x81'01'a8'b0);  // pr1, one more word
+    word(extab, 0x97'b0'b0'b0);
+    word(extab, 0);  // descriptors: none
+
+    // .ARM.exidx
+    std::vector<std::byte> exidx;
+    auto entry = [&](uint64_t p_function, uint64_t p_data) {
+        const uint64_t place = exidx_address + exidx.size();
+        word(exidx, prel31(place, p_function));
+        word(exidx, p_data);
+    };
+    entry(text_address, 0x80'a8'b0'b0);
+    entry(text_address + 0x10,
+          prel31(exidx_address + exidx.size() + 4, generic));
+    entry(text_address + 0x20,
+          prel31(exidx_address + exidx.size() + 4, compact));
+    entry(text_address + 0x30, 1);
+
+    return make_elf(
+      p_order,
+      { { ".text",
+          SHT_PROGBITS,
+          SHF_ALLOC | SHF_EXECINSTR,
+          text_address,
+          std::vector<std::byte>(0x40) },
+        { ".ARM.exidx", SHT_ARM_EXIDX, SHF_ALLOC, exidx_address, exidx },
+        { ".ARM.extab", SHT_PROGBITS, SHF_ALLOC, extab_address, extab } });
+}
+
+section_view_s view(uint64_t p_address, const std::vector<std::byte>& p_data)
+{
+    GElf_Shdr header{};
+    header.sh_addr = p_address;
+    header.sh_size = p_data.size();
+    return section_view_s{ header, p_data };
+}
+}  // namespace
+
+boost::ut::suite<"Arm_Exidx_Test"> arm_exidx_test = [] {
+    using namespace boost::ut;
+
+    "Decodes every entry model in either byte order"_test = [] {
+        for (auto order : { std::endian::little, std::endian::big }) {
+            const auto image = make_unwind_elf(order);
+            ElfParser elf(image,
+                          order == std::endian::little ? "little" : "big");
+            auto exidx_section = elf.get_section_view(".ARM.exidx");
+            auto extab_section = elf.get_section_view(".ARM.extab");
+            expect(exidx_section.has_value() && extab_section.has_value());
+            if (!exidx_section.has_value() || !extab_section.has_value()) {
+                continue;
+            }
+            auto exidx = ArmExidx::parse(
+              *exidx_section, *extab_section, elf.get_encoding());
+            expect(exidx.has_value());
+            if (!exidx.has_value()) {
+                continue;
+            }
+            expect(exidx->size() == 4_u);
+            expect(!exidx->find(text_address - 1).has_value());
+
+            auto inline_entry = exidx->find(text_address + 4);
+            expect(inline_entry.has_value());
+            expect(inline_entry->model == exidx_model::INLINE);
+            expect(inline_entry->pc_begin == text_address);
+            expect(inline_entry->pc_end == text_address + 0x10);
+            expect(inline_entry->opcodes
+                   == std::vector<uint8_t>{ 0xa8, 0xb0, 0xb0 });
+            expect(!inline_entry->extab.has_value());
+
+            auto generic = exidx->find(text_address + 0x1f);
+            expect(generic.has_value());
+            expect(generic->model == exidx_model::GENERIC);
+            expect(generic->pc_begin == text_address + 0x10);
+            expect(generic->personality == std::optional(personality_address));
+            expect(generic->extab == std::optional(extab_address));
+            expect(generic->opcodes
+                   == std::vector<uint8_t>{
+                     0x84, 0x0f, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0 });
+            expect(generic->lsda == std::optional(extab_address + 12));
+
+            auto compact = exidx->find(text_address + 0x20);
+            expect(compact.has_value());
+            expect(compact->model == exidx_model::COMPACT);
+            expect(compact->personality_index == 1_u);
+            expect(compact->opcodes
+                   == std::vector<uint8_t>{
+                     0xa8, 0xb0, 0x97, 0xb0, 0xb0, 0xb0 });
+            expect(compact->lsda.has_value()) << "pr1 descriptors";
+
+            auto last = exidx->find(0xffff'0000);
+            expect(last.has_value());
+            expect(last->model == exidx_model::CANT_UNWIND);
+            expect(last->pc_begin == text_address + 0x30);
+            expect(last->pc_end == uint64_t{ 1 } << 32);
+
+            auto all = exidx->entries();
+            expect(all.has_value() && all->size() == 4_u);
+        }
+    };
+
+    "Embedded GCC LSDAs decode with 4-byte pointers"_test = [] {
+        for (auto order : { std::endian::little, std::endian::big }) {
+            const auto image = make_unwind_elf(order);
+            ElfParser elf(image,
+                          order == std::endian::little ? "little" : "big");
+            auto exidx_section = elf.get_section_view(".ARM.exidx");
+            auto extab_section = elf.get_section_view(".ARM.extab");
+            expect(exidx_section.has_value() && extab_section.has_value());
+            if (!exidx_section.has_value() || !extab_section.has_value()) {
+                continue;
+            }
+            auto exidx = ArmExidx::parse(
+              *exidx_section, *extab_section, elf.get_encoding());
+            auto entry = exidx.has_value()
+                           ? exidx->find(text_address + 0x10)
+                           : std::nullopt;
+            expect(entry.has_value() && entry->lsda.has_value());
+            if (!entry.has_value() || !entry->lsda.has_value()) {
+                continue;
+            }
+            const size_t offset = *entry->lsda - exidx->extab().header.sh_addr;
+
+            const section_view_s& extab = exidx->extab();
+            LsdaContext context;
+            context.table_address = extab.header.sh_addr;
+            context.pointer_size = 4;
+            context.order = order;
+            auto lsda = LsdaParser::decode(extab.data, offset, context);
+            expect(lsda.has_value());
+            if (!lsda.has_value()) {
+                continue;
+            }
+            expect(lsda->call_sites.size() == 1_u);
+            expect(lsda->call_sites[0].start == 4_u);
+            expect(lsda->call_sites[0].landing_pad == 8_u);
+            expect(lsda->resolve_type(1) == std::optional(typeinfo_address));
+
+            // read as 8-byte absptr, the entry takes in the action table
+            auto wide
+              = LsdaParser::decode(extab.data, offset, extab.header.sh_addr);
+            expect(!wide.has_value()
+                   || wide->resolve_type(1)
+                        != std::optional(typeinfo_address));
+
+            // read in the other byte order, the type is swapped
+            context.order = order == std::endian::little ? std::endian::big
+                                                         : std::endian::little;
+            auto swapped = LsdaParser::decode(extab.data, offset, context);
+            expect(swapped.has_value()
+                   && swapped->resolve_type(1)
+                        != std::optional(typeinfo_address));
+        }
+    };
+
+    "Unwind table bytes are attributed to their function"_test = [] {
+        const auto image = make_unwind_elf(std::endian::little);
+        ElfParser elf(image, "little");
+        // a Thumb function: bit 0 of the symbol is set
+        const std::vector<symbol_s> records = {
+            { "", 0, 0, 0, 0, 0 },
+            { "_Z5parseIiEvi",
+              text_address + 0x11,
+              0x10,
+              ELF64_ST_INFO(STB_GLOBAL, STT_FUNC),
+              0,
+              1 },
+        };
+        const SymbolTable symbols(records);
+        const auto report = safe::attribute_eh_bytes(elf, symbols);
+        expect(report.functions.size() == 4_u);
+        expect(report.shared.arm_exidx == 0_u);
+        expect(report.shared.arm_extab == 0_u);
+
+        auto parse = std::ranges::find(report.functions,
+                                       text_address + 0x10,
+                                       &safe::eh_function_bytes_s::address);
+        expect(parse != report.functions.end());
+        if (parse == report.functions.end()) {
+            return;
+        }
+        expect(parse->name == "void parse<int>(int)");
+        expect(parse->family == "void parse<>");
+        expect(parse->bytes.arm_exidx == 8_u);
+        expect(parse->bytes.arm_extab == 28_u) << "entry, LSDA and padding";
+        expect(parse->bytes.landing_pads == 8_u) << "pad to end of function";
+        expect(parse == report.functions.begin()) << "largest first";
+    };
+
+    "Malformed tables are reported"_test = [] {
+        auto le32 = [](std::initializer_list<uint32_t> p_words) {
+            std::vector<std::byte> out;
+            for (uint32_t value : p_words) {
+                put(out, out.size(), value, 4, std::endian::little);
+            }
+            return out;
+        };
+        const elf_reader::encoding_s encoding{ ELFCLASS32,
+                                               std::endian::little };
+
+        const auto odd = le32({ 0, 1, 0 });
+        expect(ArmExidx::parse(view(exidx_address, odd), std::nullopt, encoding)
+                 .error()
+               == arm_exidx_error::TRUNCATED);
+
+        const auto high_bit = le32({ 0x8000'0000, 1 });
+        expect(
+          ArmExidx::parse(view(exidx_address, high_bit), std::nullopt, encoding)
+            .error()
+          == arm_exidx_error::BAD_PREL31);
+
+        // inline entries may only use pr0; the second points nowhere
+        const auto bad = le32({ 0, 0x83'00'b0'b0, 0x10, 0x100 });
+        auto exidx
+          = ArmExidx::parse(view(exidx_address, bad), std::nullopt, encoding);
+        expect(exidx.has_value());
+        if (!exidx.has_value()) {
+            return;
+        }
+        expect(exidx->entry_at(0).error()
+               == arm_exidx_error::UNSUPPORTED_PERSONALITY);
+        expect(exidx->entry_at(1).error()
+               == arm_exidx_error::BAD_EXTAB_POINTER);
+        expect(exidx->entry_at(2).error() == arm_exidx_error::TRUNCATED);
+        expect(!exidx->find(exidx_address + 0x20).has_value());
+        expect(!exidx->entries().has_value());
+
+        // a generic entry whose word count runs past .ARM.extab
+        const auto short_extab = le32({ 0x100, 0x05'b0'b0'b0 });
+        const auto one = le32({ 0, prel31(exidx_address + 4, extab_address) });
+        auto truncated = ArmExidx::parse(view(exidx_address, one),
+                                         view(extab_address, short_extab),
+                                         encoding);
+        expect(truncated.has_value());
+        if (truncated.has_value()) {
+            expect(truncated->entry_at(0).error()
+                   == arm_exidx_error::TRUNCATED);
+        }
+    };
+
+    // built by testing_programs/arm/build.sh for a Cortex-M0; poll() catches
+    // the sensor_error that it and read_sensor() throw
+    const std::string_view firmware = "../../testing_programs/arm/firmware.elf";
+
+    "Firmware catch sites are found through .ARM.exidx"_test = [firmware] {
+        ElfParser elf(firmware);
+        auto sym = elf.get_compact_symbol_table();
+        auto text = elf.get_section_view(".text");
+        auto exidx_section = elf.get_section_view(".ARM.exidx");
+        auto extab_section = elf.get_section_view(".ARM.extab");
+        expect(sym.has_value() && text.has_value() && exidx_section.has_value()
+               && extab_section.has_value())
+          << "firmware sections fail\n";
+        if (!sym.has_value() || !text.has_value()
+            || !exidx_section.has_value() || !extab_section.has_value()) {
+            return;
+        }
+        expect(!elf.get_section_view(".gcc_except_table").has_value());
+
+        auto exidx = ArmExidx::parse(
+          *exidx_section, *extab_section, elf.get_encoding());
+        expect(exidx.has_value());
+        if (!exidx.has_value()) {
+            return;
+        }
+        auto poll = (*sym)->find("_Z4polli");
+        auto typeinfo = (*sym)->find("_ZTI12sensor_error");
+        expect(poll.has_value() && typeinfo.has_value());
+        if (!poll.has_value() || !typeinfo.has_value()) {
+            return;
+        }
+        auto entry = exidx->find((*sym)->value(*poll) & ~uint64_t{ 1 });
+        expect(entry.has_value() && entry->model == exidx_model::GENERIC
+               && entry->lsda.has_value());
+
+        safe::Validator val(**sym, *text, { .machine = EM_ARM });
+        val.load_arm_exidx(*exidx);
+        for (std::string_view thrower : { "_Z11read_sensori", "_Z4polli" }) {
+            auto thrown = val.find_typeinfo(thrower);
+            expect(thrown.has_value() && thrown->size() == 1_u
+                   && thrown->front().value == (*sym)->value(*typeinfo))
+              << thrower << "\n";
+        }
+
+        auto caught = val.analyze_exceptions("_Z4polli");
+        expect(caught.has_value());
+        if (!caught.has_value()) {
+            return;
+        }
+        expect(caught->size() == 1_u);
+        expect(caught->front().thrown.name == "_ZTI12sensor_error");
+        expect(!caught->front().handlers.empty());
+        // read_sensor has an inline pr0 entry and so no LSDA
+        expect(val.analyze_exceptions("_Z11read_sensori").error()
+               == safe::CorrelateError::NoCatchRecords);
+    };
+
+#if defined(__unix__) || defined(__APPLE__)
+    "The default analysis reads EHABI images"_test = [firmware] {
+        const std::string output = "arm_firmware_report.txt";
+        const int status = std::system(
+          std::format("./safe {} > {}", firmware, output).c_str());
+        expect(status == 0) << "no .gcc_except_table must not be an error\n";
+        std::ifstream in(output);
+        bool caught = false;
+        for (std::string line; std::getline(in, line);) {
+            caught = caught || line == "\tThrows: typeinfo for sensor_error";
+        }
+        expect(caught);
+    };
+#endif
+};
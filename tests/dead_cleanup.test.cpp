@@ -0,0 +1,156 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <string_view>
+
+#include "dead_cleanup.hpp"
+#include "elf_parser.hpp"
+#include "symbol_value.hpp"
+#include "throw_summary.hpp"
+
+boost::ut::suite<"Dead_Cleanup_Test"> dead_cleanup_test = [] {
+    using namespace boost::ut;
+#if defined(__unix__) || defined(__APPLE__)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+
+    "May-throw summary follows calls through the PLT and the LSDA"_test = [] {
+        ElfParser elf("../../testing_programs/build/cleanup_pads");
+        auto symbols = elf.get_compact_symbol_table();
+        expect(symbols.has_value());
+        if (!symbols.has_value()) {
+            return;
+        }
+        const safe::ThrowSummary summary(elf, **symbols);
+        expect(summary.supported());
+
+        expect(summary.may_throw(symbol_value(elf, "_Z8may_faili")));
+        expect(summary.may_throw(symbol_value(elf, "_Z11mixed_callsi")));
+        expect(!summary.may_throw(symbol_value(elf, "scale")));
+        // the destructor is noexcept: its call to puts is not covered
+        expect(!summary.may_throw(symbol_value(elf, "_ZN5guardD2Ev")));
+        expect(!summary.may_throw(symbol_value(elf, "_Z12only_c_callsi")));
+
+        // may_fail reaches __cxa_throw through its PLT entry
+        const uint64_t may_fail = symbol_value(elf, "_Z8may_faili");
+        const bool throws = std::ranges::any_of(
+          summary.calls(), [&](const safe::machine_call_s& p_call) {
+              return summary.functions().function_at(p_call.address)
+                       ->start
+                       == may_fail
+                     && summary.callee_name(p_call) == "__cxa_throw";
+          });
+        expect(throws);
+    };
+
+    "Cleanups guarding only calls that cannot throw are dead"_test = [] {
+        ElfParser elf("../../testing_programs/build/cleanup_pads");
+        auto symbols = elf.get_compact_symbol_table();
+        expect(symbols.has_value());
+        if (!symbols.has_value()) {
+            return;
+        }
+        const auto report = safe::find_dead_cleanups(elf, **symbols);
+        expect(report.supported);
+        expect(report.undecodable == 0_u);
+        expect(report.dead_regions >= 1_u);
+        expect(report.cleanup_regions > report.dead_regions);
+
+        auto only_c
+          = std::ranges::find(report.functions,
+                              symbol_value(elf, "_Z12only_c_callsi"),
+                              &safe::dead_cleanup_function_s::address);
+        expect(only_c != report.functions.end());
+        if (only_c == report.functions.end()) {
+            return;
+        }
+        expect(only_c->name == "only_c_calls(int)");
+        expect(only_c->dead.size() == only_c->cleanup_regions);
+        // every landing pad is dead, so the whole LSDA goes
+        expect(only_c->savings.call_sites > 0_u);
+        expect(only_c->savings.landing_pads > 0_u);
+        expect(only_c->savings.except_table > 0_u);
+        std::vector<std::string> callees;
+        for (const auto& region : only_c->dead) {
+            expect(region.start < region.end);
+            callees.insert(
+              callees.end(), region.callees.begin(), region.callees.end());
+        }
+        expect(std::ranges::find(callees, "puts") != callees.end());
+        expect(std::ranges::find(callees, "scale") != callees.end());
+
+        // mixed_calls guards may_fail with the same cleanup
+        auto mixed = std::ranges::find(report.functions,
+                                       symbol_value(elf, "_Z11mixed_callsi"),
+                                       &safe::dead_cleanup_function_s::address);
+        if (mixed != report.functions.end()) {
+            expect(mixed->savings.landing_pads == 0_u);
+            expect(mixed->savings.except_table == 0_u);
+        }
+
+        uint64_t total = 0;
+        for (const auto& function : report.functions) {
+            total += function.savings.total();
+        }
+        expect(total == report.savings.total());
+    };
+
+    "Throws of a .cold part reach the function jumping to it"_test = [] {
+        ElfParser elf("../../testing_programs/build/cold_split");
+        auto symbols = elf.get_compact_symbol_table();
+        expect(symbols.has_value());
+        if (!symbols.has_value()) {
+            return;
+        }
+        // check(int) only reaches __cxa_throw with a jcc to its .cold part
+        const safe::ThrowSummary summary(elf, **symbols);
+        expect(summary.may_throw(symbol_value(elf, "_Z5checki")));
+        expect(summary.may_throw(symbol_value(elf, "_Z4useri")));
+
+        // so the guard of user(int) runs when check(int) throws
+        const auto report = safe::find_dead_cleanups(elf, **symbols);
+        expect(std::ranges::find(report.functions,
+                                 symbol_value(elf, "_Z4useri"),
+                                 &safe::dead_cleanup_function_s::address)
+               == report.functions.end());
+        expect(std::ranges::find(report.callees,
+                                 "check(int)",
+                                 &safe::noexcept_candidate_s::name)
+               == report.callees.end());
+    };
+
+    "Calls to an unsymbolized function may throw"_test = [] {
+        // cleanup_pads without the symbol of may_fail(int)
+        ElfParser elf("../../testing_programs/build/cleanup_pads_nosym");
+        auto symbols = elf.get_compact_symbol_table();
+        expect(symbols.has_value());
+        if (!symbols.has_value()) {
+            return;
+        }
+        expect(symbol_value(elf, "_Z8may_faili") == 0_u);
+        const safe::ThrowSummary summary(elf, **symbols);
+        expect(summary.may_throw(symbol_value(elf, "_Z11mixed_callsi")));
+
+        const auto report = safe::find_dead_cleanups(elf, **symbols);
+        auto mixed = std::ranges::find(report.functions,
+                                       symbol_value(elf, "_Z11mixed_callsi"),
+                                       &safe::dead_cleanup_function_s::address);
+        if (mixed != report.functions.end()) {
+            expect(mixed->dead.empty()) << "may_fail(int) throws through it";
+        }
+    };
+
+    "Catch handlers are not cleanups"_test = [] {
+        ElfParser elf("../../testing_programs/build/pie_catch");
+        auto symbols = elf.get_compact_symbol_table();
+        expect(symbols.has_value());
+        if (!symbols.has_value()) {
+            return;
+        }
+        const auto report = safe::find_dead_cleanups(elf, **symbols);
+        expect(report.dead_regions == 0_u);
+        expect(report.functions.empty());
+    };
+};
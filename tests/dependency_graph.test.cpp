@@ -0,0 +1,165 @@
+#include <gelf.h>
+
+
+#include <boost/ut.hpp>
+
+
+#include <atomic>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+#include "dependency_graph.hpp"
+#include "elf_parser.hpp"
+#include "parallel.hpp"
+#include "symbol_table.hpp"
+
+
+boost::ut::suite<"Dependency_Graph_Test"> dependency_graph_test = [] {
+    using namespace boost::ut;
+#if defined(__unix__) || defined(__APPLE__)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+
+
+    "Dynamic_Section"_test = [] {
+        "Dynamic symbols of a stripped library"_test = []() {
+            ElfParser elf("../../testing_programs/build/libdemo_two_stripped.so");
+            expect(!elf.get_compact_symbol_table().has_value())
+              << "Stripped library must not have .symtab";
+
+            auto dynamic = elf.get_dynamic_symbol_table();
+            expect(dynamic.has_value()) << "Expect a dynamic symbol table";
+            if (!dynamic.has_value()) {
+                return;
+            }
+
+            auto index = (*dynamic)->find("_Z3bazi");
+            expect(index.has_value()) << "Expect _Z3bazi in .dynsym";
+            if (index.has_value()) {
+                expect((*dynamic)->shndx(*index) != SHN_UNDEF)
+                  << "_Z3bazi must be defined by the library";
+            }
+        };
+
+        "DT_NEEDED and DT_RUNPATH entries"_test = []() {
+            ElfParser elf("../../testing_programs/build/demo_dynamic");
+            auto needed = elf.get_needed_libraries();
+            bool needs_demo_two = false;
+            for (std::string_view name : needed) {
+                needs_demo_two = needs_demo_two || name == "libdemo_two.so";
+            }
+            expect(needs_demo_two) << "Expect DT_NEEDED libdemo_two.so";
+
+            auto paths = elf.get_run_paths();
+            expect(paths.size() == 1_u) << "Expect one run path";
+            if (!paths.empty()) {
+                expect(paths[0] == std::string_view("$ORIGIN"))
+                  << "Run path must be kept unexpanded";
+            }
+        };
+
+        "Static executable has no dependencies"_test = []() {
+            ElfParser elf("../../testing_programs/build/simple");
+            expect(elf.get_needed_libraries().empty())
+              << "Static executable must not have DT_NEEDED";
+        };
+    };
+
+
+    "Dependency_Graph"_test = [] {
+        const std::filesystem::path executable
+          = "../../testing_programs/build/demo_dynamic";
+
+        "Resolves the closure and parses each object once"_test =
+          [executable]() {
+              safe::DependencyGraph graph;
+              std::vector<std::filesystem::path> roots{ executable,
+                                                        executable };
+              auto root_indices = graph.load(roots);
+              expect(root_indices.size() == 2_u) << "Expect both roots";
+              if (root_indices.size() != 2) {
+                  return;
+              }
+              expect(root_indices[0] == root_indices[1])
+                << "The same root must map to one object";
+
+              auto objects = graph.objects();
+              const auto& root = objects[root_indices[0]];
+              expect(root.unresolved.empty()) << "Expect every DT_NEEDED found";
+
+              bool found_demo_two = false;
+              for (size_t dependency : root.dependencies) {
+                  found_demo_two
+                    = found_demo_two
+                      || objects[dependency].path.filename() == "libdemo_two.so";
+              }
+              expect(found_demo_two) << "Expect libdemo_two.so via $ORIGIN";
+
+              // libc is needed by several objects but must be loaded once
+              std::set<std::filesystem::path> paths;
+              size_t libc_count = 0;
+              for (const auto& object : objects) {
+                  expect(object.elf != nullptr) << "Every object is parsed";
+                  paths.insert(object.path);
+                  if (object.path.filename().string().starts_with("libc.so")) {
+                      libc_count++;
+                  }
+              }
+              expect(paths.size() == objects.size())
+                << "Objects must not repeat";
+              expect(libc_count == 1_u) << "Expect libc once";
+
+              // Loading again must not parse anything new
+              const size_t count = objects.size();
+              graph.load(roots);
+              expect(graph.objects().size() == count)
+                << "Reloading must reuse the parsed objects";
+          };
+
+        "Sysroot without libraries leaves names unresolved"_test =
+          [executable]() {
+              const auto sysroot
+                = std::filesystem::temp_directory_path() / "safe_empty_sysroot";
+              std::filesystem::create_directories(sysroot);
+
+              safe::DependencyGraph graph({ .sysroot = sysroot,
+                                            .search_dirs = { "/usr/lib" } });
+              auto root_indices = graph.load(std::span(&executable, 1));
+              expect(root_indices.size() == 1_u) << "Expect the root";
+
+              const auto& root = graph.objects()[0];
+              bool libc_unresolved = false;
+              for (const auto& name : root.unresolved) {
+                  libc_unresolved = libc_unresolved || name == "libc.so.6";
+              }
+              expect(libc_unresolved)
+                << "libc.so.6 must not be found outside the sysroot";
+          };
+
+        "Analysis visits every object exactly once"_test = [executable]() {
+            safe::DependencyGraph graph({ .max_threads = 4 });
+            graph.load(std::span(&executable, 1));
+
+            std::atomic<size_t> calls{ 0 };
+            auto results
+              = graph.analyze([&calls](const safe::shared_object_s& p_object) {
+                    calls++;
+                    return p_object.path.string();
+                });
+
+            expect(calls.load() == graph.objects().size())
+              << "Expect one call per object";
+            bool in_order = results.size() == graph.objects().size();
+            for (size_t i = 0; in_order && i < results.size(); i++) {
+                in_order = results[i] == graph.objects()[i].path.string();
+            }
+            expect(in_order) << "Results must follow objects() order";
+        };
+    };
+};
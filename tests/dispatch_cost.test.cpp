@@ -0,0 +1,108 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "dispatch_cost.hpp"
+#include "eh_frame.hpp"
+#include "elf_parser.hpp"
+#include "symbol_value.hpp"
+
+boost::ut::suite<"Dispatch_Cost_Test"> dispatch_cost_test = [] {
+    using namespace boost::ut;
+#if defined(__unix__) || defined(__APPLE__)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+
+    "Call-site records are scanned up to the covering one"_test = [] {
+        ElfParser elf("../../testing_programs/build/pie_catch");
+        auto section = elf.get_section_view(".eh_frame");
+        auto hdr = elf.get_section_view(".eh_frame_hdr");
+        auto except_table = elf.get_section_view(".gcc_except_table");
+        expect(section.has_value() && hdr.has_value()
+               && except_table.has_value());
+        if (!section.has_value() || !hdr.has_value()
+            || !except_table.has_value()) {
+            return;
+        }
+        auto eh_frame = EhFrame::parse(*section, *hdr, elf.get_encoding());
+        expect(eh_frame.has_value());
+        if (!eh_frame.has_value()) {
+            return;
+        }
+
+        const auto report
+          = safe::profile_dispatch_cost(*eh_frame, *except_table);
+        expect(report.search == safe::fde_search::HDR_TABLE);
+        expect(report.undecodable == 0_u);
+        expect(report.functions.size() == report.fdes);
+        expect(std::ranges::is_sorted(
+          report.functions, std::ranges::greater{}, [](const auto& p_cost) {
+              return p_cost.worst_steps();
+          }));
+        const auto steps = static_cast<size_t>(std::bit_width(report.fdes));
+        for (const auto& cost : report.functions) {
+            expect(cost.fde_lookup == steps);
+            expect(cost.worst_records <= cost.call_sites);
+        }
+
+        // main's call sites are sorted and cover its calls one after the
+        // other: the k-th is found after k records
+        auto main_cost = std::ranges::find(report.functions,
+                                           symbol_value(elf, "main"),
+                                           &safe::dispatch_cost_s::pc_begin);
+        expect(main_cost != report.functions.end());
+        if (main_cost == report.functions.end()) {
+            return;
+        }
+        expect(main_cost->call_sites > 1_u);
+        expect(main_cost->worst_records == main_cost->call_sites);
+        expect(main_cost->worst_bytes > 0_u);
+        expect(main_cost->worst_pc > main_cost->pc_begin
+               && main_cost->worst_pc <= main_cost->pc_end);
+        const double mean
+          = static_cast<double>(main_cost->call_sites + 1) / 2.0;
+        expect(main_cost->mean_records == mean);
+    };
+
+    "Without a search table the FDEs are walked in order"_test = [] {
+        ElfParser elf("../../testing_programs/build/pie_catch");
+        auto section = elf.get_section_view(".eh_frame");
+        expect(section.has_value());
+        if (!section.has_value()) {
+            return;
+        }
+        auto eh_frame
+          = EhFrame::parse(*section, std::nullopt, elf.get_encoding());
+        expect(eh_frame.has_value());
+        if (!eh_frame.has_value()) {
+            return;
+        }
+
+        const auto report
+          = safe::profile_dispatch_cost(*eh_frame, std::nullopt);
+        expect(report.search == safe::fde_search::LINEAR);
+        std::vector<size_t> positions;
+        for (const auto& cost : report.functions) {
+            expect(cost.call_sites == 0_u);
+            positions.push_back(cost.fde_lookup);
+        }
+        std::ranges::sort(positions);
+        for (size_t i = 0; i < positions.size(); i++) {
+            expect(positions[i] == i + 1);
+        }
+        expect(report.functions.front().fde_lookup == report.fdes);
+
+        // registered frames are sorted once, then binary searched
+        const auto registered = safe::profile_dispatch_cost(
+          *eh_frame, std::nullopt, 8, true);
+        expect(registered.search == safe::fde_search::REGISTERED);
+        expect(registered.functions.front().fde_lookup
+               == static_cast<size_t>(std::bit_width(registered.fdes)));
+    };
+};
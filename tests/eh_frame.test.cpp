@@ -0,0 +1,271 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "abi_parse.hpp"
+#include "eh_frame.hpp"
+#include "elf_parser.hpp"
+#include "symbol_value.hpp"
+#include "validator.hpp"
+
+namespace {
+std::optional<EhFrame> load_eh_frame(const ElfParser& p_elf,
+                                     bool p_use_hdr = true)
+{
+    auto eh_frame = p_elf.get_section_view(".eh_frame");
+    if (!eh_frame.has_value()) {
+        return std::nullopt;
+    }
+    std::optional<section_view_s> hdr;
+    if (auto section = p_elf.get_section_view(".eh_frame_hdr");
+        p_use_hdr && section.has_value()) {
+        hdr = *section;
+    }
+    auto parsed = EhFrame::parse(*eh_frame, hdr, p_elf.get_encoding());
+    if (!parsed.has_value()) {
+        return std::nullopt;
+    }
+    return std::move(*parsed);
+}
+}  // namespace
+
+boost::ut::suite<"Eh_Frame_Test"> eh_frame_test = [] {
+    using namespace boost::ut;
+#if defined(__unix__) || defined(__APPLE__)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+
+    "Search table lookup matches the section walk"_test = [] {
+        ElfParser elf("../../testing_programs/build/demo_class");
+        auto indexed = load_eh_frame(elf);
+        auto walked = load_eh_frame(elf, false);
+        expect(indexed.has_value() && walked.has_value())
+          << "Expect .eh_frame to parse";
+        if (!indexed.has_value() || !walked.has_value()) {
+            return;
+        }
+        expect(indexed->has_search_table()) << "Expect .eh_frame_hdr";
+        expect(!walked->has_search_table());
+        expect(indexed->size() == walked->size());
+
+        auto fdes = indexed->fdes();
+        expect(fdes.has_value() && !fdes->empty());
+        for (const auto& fde : fdes.value()) {
+            if (fde.pc_end == fde.pc_begin) {
+                continue;
+            }
+            for (uint64_t pc : { fde.pc_begin, fde.pc_end - 1 }) {
+                auto by_hdr = indexed->find(pc);
+                auto by_walk = walked->find(pc);
+                expect(by_hdr.has_value() && by_walk.has_value()
+                       && by_hdr->offset == fde.offset
+                       && by_walk->offset == fde.offset)
+                  << "FDE at " << fde.offset << " not found for " << pc;
+            }
+            auto cie = indexed->cie_at(fde.cie_offset);
+            expect(cie.has_value() && cie->augmentation.starts_with('z'));
+        }
+        expect(!indexed->find(0).has_value());
+
+        auto main_fde = indexed->find(symbol_value(elf, "main"));
+        expect(main_fde.has_value() && main_fde->lsda.has_value())
+          << "main has try/catch and so an LSDA";
+    };
+
+    "Per-function LSDA"_test = [] {
+        ElfParser elf("../../testing_programs/build/simple");
+        auto eh_frame = load_eh_frame(elf);
+        auto except_table = elf.get_section_view(".gcc_except_table");
+        expect(eh_frame.has_value() && except_table.has_value());
+        if (!eh_frame.has_value() || !except_table.has_value()) {
+            return;
+        }
+
+        auto fde = eh_frame->find(symbol_value(elf, "main"));
+        expect(fde.has_value() && fde->lsda.has_value());
+        if (!fde.has_value() || !fde->lsda.has_value()) {
+            return;
+        }
+        const uint64_t table_address = except_table->header.sh_addr;
+        expect(*fde->lsda >= table_address
+               && *fde->lsda < table_address + except_table->data.size());
+
+        LsdaParser lsda(
+          except_table->data, *fde->lsda - table_address, table_address);
+        // catch (int&), catch (std::string&), catch (std::invalid_argument&)
+        expect(lsda.type_table.size() == 3_u) << lsda.type_table.size();
+        std::vector<int64_t> catches;
+        for (const auto& scope : lsda.get_scopes()) {
+            for (const auto& handler : lsda.handlers(scope)) {
+                if (handler.type == HandlerType::Catch) {
+                    catches.push_back(handler.type_index);
+                }
+            }
+        }
+        std::ranges::sort(catches);
+        expect(catches == std::vector<int64_t>{ 1, 2, 3 });
+        for (int64_t type_index : catches) {
+            auto type = lsda.resolve_type(type_index);
+            expect(type.has_value() && *type != 0);
+        }
+    };
+
+    "Validator reads the thrower's own LSDA"_test = [] {
+        ElfParser elf("../../testing_programs/build/simple");
+        auto eh_frame = load_eh_frame(elf);
+        auto symbols = elf.get_symbol_table();
+        auto text = elf.get_section_view(".text");
+        auto except_table = elf.get_section_view(".gcc_except_table");
+        expect(eh_frame.has_value() && symbols.has_value()
+               && text.has_value() && except_table.has_value());
+        if (!eh_frame.has_value() || !symbols.has_value()
+            || !text.has_value() || !except_table.has_value()) {
+            return;
+        }
+
+        safe::Validator val(*symbols, *text, { .write_logs = false });
+        val.load_eh_frame(*eh_frame, *except_table);
+        // baa() has no handlers of its own, only main() catches
+        auto baa = val.analyze_exceptions("_Z3baav");
+        expect(!baa.has_value()
+               && baa.error() == safe::CorrelateError::NoCatchRecords);
+        // foo() only runs a cleanup while constructing the exception
+        auto foo = val.analyze_exceptions("_Z3fooi");
+        expect(foo.has_value()) << "Expect foo's cleanup landing pad";
+        if (foo.has_value()) {
+            for (const auto& match : *foo) {
+                for (const auto* handler : match.handlers) {
+                    expect(handler->kind == HandlerType::Cleanup);
+                }
+            }
+        }
+    };
+
+    "Big-endian ELF32 records"_test = [] {
+        // CIE "zPLR" and one FDE, as a 32-bit big-endian target emits them
+        const std::vector<uint8_t> bytes = {
+            // CIE: length, id, version, "zPLR", code/data align, RA
+            0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x01, 'z', 'P',
+            'L', 'R', 0x00, 0x01, 0x7c, 0x0e,
+            // augmentation data: P udata4, L pcrel|sdata4, R pcrel|sdata4
+            0x07, 0x03, 0x00, 0x00, 0x80, 0x00, 0x1b, 0x1b,
+            // DW_CFA_nop padding
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+            // FDE: length, CIE pointer, pc_begin, pc_range, aug, lsda
+            0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x24, 0xff, 0xff,
+            0xff, 0xd8, 0x00, 0x00, 0x00, 0x40, 0x04, 0x00, 0x00, 0x0f,
+            0xd0, 0x00, 0x00, 0x00,
+            // terminator
+            0x00, 0x00, 0x00, 0x00
+        };
+        std::vector<std::byte> data;
+        for (uint8_t value : bytes) {
+            data.push_back(static_cast<std::byte>(value));
+        }
+        section_view_s section{};
+        section.header.sh_addr = 0x1000;
+        section.data = data;
+
+        auto eh_frame = EhFrame::parse(
+          section,
+          std::nullopt,
+          { .elf_class = ELFCLASS32, .order = std::endian::big });
+        expect(eh_frame.has_value()) << "Expect the records to parse";
+        if (!eh_frame.has_value()) {
+            return;
+        }
+        auto cie = eh_frame->cie_at(0);
+        expect(cie.has_value() && cie->augmentation == "zPLR");
+        if (cie.has_value()) {
+            expect(cie->data_alignment == -4);
+            expect(cie->personality == std::optional<uint64_t>(0x8000));
+        }
+
+        // pc_begin sits at 0x1000 + 40 and points 40 bytes back
+        auto fde = eh_frame->find(0x1000 + 0x3f);
+        expect(fde.has_value()) << "Expect the FDE to cover 0x103f";
+        if (fde.has_value()) {
+            expect(fde->pc_begin == 0x1000_u);
+            expect(fde->pc_end == 0x1040_u);
+            expect(fde->lsda == std::optional<uint64_t>(0x1000 + 49 + 0xfd0));
+        }
+        expect(!eh_frame->find(0x1040).has_value());
+    };
+
+    "CFA instructions interpreted up to an address"_test = [] {
+        std::vector<uint8_t> bytes = {
+            // CIE: length, id, version, "zR", code/data align, RA
+            0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 'z', 'R',
+            0x00, 0x01, 0x78, 0x10,
+            // augmentation data: R pcrel|sdata4
+            0x01, 0x1b,
+            // def_cfa r7+8, offset r16
+            0x0c, 0x07, 0x08, 0x90, 0x01,
+            // FDE: length, CIE pointer, pc_begin, pc_range, aug
+            0x1a, 0x00, 0x00, 0x00, 0x1a, 0x00, 0x00, 0x00, 0xe2, 0x0f,
+            0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00,
+            // advance_loc 1, def_cfa_offset 16, offset r6
+            0x41, 0x0e, 0x10, 0x86, 0x02,
+            // advance_loc1 16, remember_state, def_cfa_offset 8
+            0x02, 0x10, 0x0a, 0x0e, 0x08,
+            // advance_loc 4, restore_state, nop
+            0x44, 0x0b, 0x00,
+            // terminator
+            0x00, 0x00, 0x00, 0x00
+        };
+        auto to_bytes = [&bytes] {
+            std::vector<std::byte> data;
+            for (uint8_t value : bytes) {
+                data.push_back(static_cast<std::byte>(value));
+            }
+            return data;
+        };
+        const elf_reader::encoding_s encoding{ .elf_class = ELFCLASS64,
+                                               .order = std::endian::little };
+
+        const auto data = to_bytes();
+        section_view_s section{};
+        section.header.sh_addr = 0x1000;
+        section.data = data;
+        auto eh_frame = EhFrame::parse(section, std::nullopt, encoding);
+        auto fde = eh_frame.has_value() ? eh_frame->find(0x2000)
+                                        : std::nullopt;
+        expect(fde.has_value() && fde->pc_begin == 0x2000_u);
+        if (!fde.has_value()) {
+            return;
+        }
+        const std::vector<uint64_t> pcs
+          = { 0x2000, 0x2001, 0x2005, 0x2011, 0x2012, 0x2040 };
+        auto counts = eh_frame->cfa_instruction_counts(*fde, pcs);
+        expect(counts.has_value());
+        if (counts.has_value()) {
+            expect(*counts == std::vector<size_t>{ 2, 3, 6, 6, 9, 11 });
+        }
+
+        // an unknown opcode only matters once the walk reaches it
+        bytes[bytes.size() - 5] = 0x3f;
+        const auto broken_data = to_bytes();
+        section.data = broken_data;
+        auto broken = EhFrame::parse(section, std::nullopt, encoding);
+        auto broken_fde = broken.has_value() ? broken->find(0x2000)
+                                             : std::nullopt;
+        expect(broken_fde.has_value());
+        if (!broken_fde.has_value()) {
+            return;
+        }
+        auto near = broken->cfa_instruction_counts(
+          *broken_fde, std::vector<uint64_t>{ 0x2012 });
+        expect(near.has_value() && near->front() == 9_u);
+        expect(broken->cfa_instruction_counts(
+                        *broken_fde, std::vector<uint64_t>{ 0x2040 })
+                 .error()
+               == eh_frame_error::UNSUPPORTED_INSTRUCTION);
+    };
+};
@@ -0,0 +1,92 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+
+#include "eh_size.hpp"
+#include "elf_parser.hpp"
+
+boost::ut::suite<"Eh_Size_Test"> eh_size_test = [] {
+    using namespace boost::ut;
+#if defined(__unix__) || defined(__APPLE__)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+
+    "Template instantiations share a family"_test = [] {
+        using safe::template_family;
+        expect(template_family("std::vector<int, std::allocator<int> >::"
+                               "push_back(int const&)")
+               == "std::vector<>::push_back");
+        expect(template_family("void check<double>(double)")
+               == template_family("void check<int>(int)"));
+        expect(template_family("bool operator< <int>(Foo<int> const&, int)")
+               == "bool operator< <>");
+        expect(template_family("operator<<(std::ostream&, int)")
+               == "operator<<");
+        expect(template_family("Foo<int>::operator->() const")
+               == "Foo<>::operator->");
+        expect(template_family("parse(int) [clone .cold]") == "parse");
+        expect(template_family("run()::{lambda()#1}::operator()() const")
+               == "run()::{lambda()#1}::operator()");
+        expect(template_family("(anonymous namespace)::counter")
+               == "(anonymous namespace)::counter");
+        expect(template_family("my_operator<int>(int)") == "my_operator<>");
+    };
+
+    "Every byte of the tables has an owner"_test = [] {
+        ElfParser elf("../../testing_programs/build/pie_catch");
+        auto symbols = elf.get_compact_symbol_table();
+        auto eh_frame = elf.get_section_view(".eh_frame");
+        auto hdr = elf.get_section_view(".eh_frame_hdr");
+        auto except_table = elf.get_section_view(".gcc_except_table");
+        expect(symbols.has_value() && eh_frame.has_value() && hdr.has_value()
+               && except_table.has_value());
+        if (!symbols.has_value() || !eh_frame.has_value() || !hdr.has_value()
+            || !except_table.has_value()) {
+            return;
+        }
+
+        const auto report = safe::attribute_eh_bytes(elf, **symbols);
+        safe::eh_bytes_s sum = report.shared;
+        for (const auto& function : report.functions) {
+            sum += function.bytes;
+        }
+        expect(sum.eh_frame == eh_frame->data.size());
+        expect(sum.eh_frame_hdr == hdr->data.size());
+        expect(sum.except_table == except_table->data.size());
+        expect(report.shared.except_table < except_table->data.size());
+        expect(std::ranges::is_sorted(
+          report.functions, std::ranges::greater{}, [](const auto& p_row) {
+              return p_row.bytes.total();
+          }));
+
+        // main and check(int) own the two LSDAs; main catches, so it has
+        // landing pad code
+        auto main_row = std::ranges::find(
+          report.functions, "main", &safe::eh_function_bytes_s::name);
+        expect(main_row != report.functions.end());
+        if (main_row != report.functions.end()) {
+            expect(main_row->bytes.except_table > 0_u);
+            expect(main_row->bytes.eh_frame > 0_u);
+            expect(main_row->bytes.eh_frame_hdr == 8_u);
+            expect(main_row->bytes.landing_pads > 0_u);
+        }
+        auto check_row = std::ranges::find(
+          report.functions, "check(int)", &safe::eh_function_bytes_s::name);
+        expect(check_row != report.functions.end());
+        if (check_row != report.functions.end()) {
+            expect(check_row->family == "check");
+        }
+
+        const auto families = safe::group_by_family(report.functions);
+        expect(families.size() <= report.functions.size());
+        safe::eh_bytes_s family_sum;
+        for (const auto& family : families) {
+            family_sum += family.bytes;
+        }
+        expect(family_sum.total() + report.shared.total() == sum.total());
+    };
+};
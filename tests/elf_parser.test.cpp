@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <array>
 #include <gelf.h>
 #include <libelf.h>
@@ -8,6 +9,8 @@
 
 #include <string_view>
 #include <filesystem>
+#include <format>
+#include <string>
 
 
 #include "elf_parser.hpp"
@@ -65,6 +68,65 @@ boost::ut::suite<"Elf_Parser_Test"> elf_parser_test = [] {
           };
 
 
+        "Validate the Section View matches the Section copy"_test =
+          [test_file]() {
+              ElfParser elf(test_file);
+              auto copy = elf.get_section(".text");
+              auto view = elf.get_section_view(".text");
+              expect(copy.has_value() && view.has_value())
+                << "Expect finding .text\n";
+
+
+              expect(view->header.sh_offset == copy->header.sh_offset)
+                << "View and copy must describe the same section\n";
+              expect(view->data.size() == copy->data.size())
+                << "Expect view size: " << copy->data.size() << ". Got"
+                << view->data.size() << "\n";
+              expect(std::equal(
+                view->data.begin(), view->data.end(), copy->data.begin()))
+                << "View bytes must match the copied bytes\n";
+
+
+              auto missing = elf.get_section_view(".not_a_section");
+              expect(!missing.has_value()
+                     && missing.error() == elf_parser_error::SECTION_NOT_FOUND)
+                << "Unknown section must not be found\n";
+          };
+
+
+        "Validate the Lazy mode matches the Eager mode"_test =
+          [test_file]() {
+              ElfParser eager(test_file);
+              ElfParser lazy(test_file, { .mode = elf_load_mode::LAZY });
+
+
+              auto eager_phdr = eager.get_program_header().value();
+              auto lazy_phdr = lazy.get_program_header().value();
+              expect(eager_phdr.size() == lazy_phdr.size())
+                << "Expect number of programs: " << eager_phdr.size()
+                << ". Got" << lazy_phdr.size() << "\n";
+
+
+              auto eager_sym = eager.get_symbol_table().value();
+              auto lazy_sym = lazy.get_symbol_table().value();
+              expect(eager_sym.size() == lazy_sym.size())
+                << "Expect number of symbols: " << eager_sym.size() << ". Got"
+                << lazy_sym.size() << "\n";
+              for (size_t i = 0; i < eager_sym.size() && i < lazy_sym.size();
+                   i++) {
+                  expect(eager_sym[i].name == lazy_sym[i].name
+                         && eager_sym[i].value == lazy_sym[i].value)
+                    << "Symbol " << i << " differs: " << eager_sym[i].name
+                    << " vs " << lazy_sym[i].name << "\n";
+              }
+
+
+              // a second call must hand out the cached table
+              expect(lazy.get_symbol_table()->data() == lazy_sym.data())
+                << "Lazy symbol table must be decoded only once\n";
+          };
+
+
         "Validate the Symbol Table"_test = [test_file]() {
             ElfParser elf(test_file);
             auto sym = elf.get_symbol_table();
@@ -105,4 +167,120 @@ boost::ut::suite<"Elf_Parser_Test"> elf_parser_test = [] {
             expect(size == 121) << "main size should be 121";
         };
     };
+
+
+    "Separate_Debug_File"_test = [] {
+        namespace fs = std::filesystem;
+        const fs::path build = "../../testing_programs/build";
+
+        "Stripped binary points at its debug file"_test = [build]() {
+            ElfParser elf((build / "demo_stripped").string(),
+                          { .mode = elf_load_mode::LAZY });
+            expect(!elf.get_section_view(".symtab").has_value())
+              << "Stripped binary must not have .symtab";
+            expect(elf.get_build_id().size() == 20_u)
+              << "Expect a SHA-1 build ID";
+
+            auto link = elf.get_debug_link();
+            expect(link.has_value()) << "Expect .gnu_debuglink";
+            if (link.has_value()) {
+                expect(link->file == "demo_stripped.debug")
+                  << "Got " << link->file;
+            }
+        };
+
+        "Debuglink next to the binary"_test = [build]() {
+            ElfParser elf((build / "demo_stripped").string(),
+                          { .mode = elf_load_mode::LAZY });
+            auto debug_file = elf.get_debug_file();
+            expect(debug_file.has_value() && debug_file->ends_with(".debug"))
+              << "Expect demo_stripped.debug to be found";
+
+            auto main_symbol = elf.find_symbol("main");
+            expect(main_symbol.has_value())
+              << "Expect main from the debug file";
+            auto text = elf.get_section_view(".text");
+            expect(text.has_value() && !text->data.empty())
+              << "Code must still come from the stripped binary";
+            if (main_symbol.has_value() && text.has_value()) {
+                expect(main_symbol->value >= text->header.sh_addr
+                       && main_symbol->value
+                            < text->header.sh_addr + text->data.size());
+            }
+        };
+
+        "Build-id tree"_test = [build]() {
+            ElfParser probe((build / "demo_stripped").string(),
+                            { .mode = elf_load_mode::LAZY });
+            std::string hex;
+            for (std::byte value : probe.get_build_id()) {
+                hex += std::format("{:02x}", static_cast<uint8_t>(value));
+            }
+
+            // the binary alone in a directory, so its debuglink cannot match
+            const fs::path root = fs::temp_directory_path() / "safe_debug_tree";
+            fs::remove_all(root);
+            fs::create_directories(root / "bin");
+            const fs::path id_dir
+              = root / "debug" / ".build-id" / hex.substr(0, 2);
+            fs::create_directories(id_dir);
+            fs::copy_file(build / "demo_stripped",
+                          root / "bin" / "demo_stripped");
+            const fs::path debug_path = id_dir / (hex.substr(2) + ".debug");
+
+            // a debug file of another build must be rejected
+            fs::copy_file(build / "demo_class", debug_path);
+            {
+                ElfParser elf((root / "bin" / "demo_stripped").string(),
+                              { .mode = elf_load_mode::LAZY,
+                                .debug_directories
+                                = { (root / "debug").string() } });
+                expect(!elf.get_debug_file().has_value())
+                  << "Build ID mismatch must be rejected";
+                expect(!elf.get_compact_symbol_table().has_value());
+            }
+
+            fs::remove(debug_path);
+            fs::copy_file(build / "demo_stripped.debug", debug_path);
+            ElfParser elf(
+              (root / "bin" / "demo_stripped").string(),
+              { .mode = elf_load_mode::LAZY,
+                .debug_directories = { (root / "debug").string() } });
+            auto debug_file = elf.get_debug_file();
+            expect(debug_file.has_value()
+                   && debug_file->find(".build-id") != std::string::npos)
+              << "Expect the build-id path to be used";
+            expect(elf.find_symbol("main").has_value());
+        };
+
+        "Debuglink without a build ID"_test = [build]() {
+            ElfParser elf((build / "demo_no_id").string(),
+                          { .mode = elf_load_mode::LAZY });
+            expect(elf.get_build_id().empty()) << "Expect no build ID";
+            auto debug_file = elf.get_debug_file();
+            expect(debug_file.has_value()
+                   && debug_file->ends_with("demo_no_id.debug"))
+              << "Expect the debuglink name and CRC to match";
+            expect(elf.find_symbol("main").has_value());
+
+            // a debug file of another build under the same name
+            const fs::path root = fs::temp_directory_path() / "safe_debuglink";
+            fs::remove_all(root);
+            fs::create_directories(root);
+            fs::copy_file(build / "demo_no_id", root / "demo_no_id");
+            fs::copy_file(build / "demo_stripped.debug",
+                          root / "demo_no_id.debug");
+            {
+                ElfParser checked((root / "demo_no_id").string(),
+                                  { .mode = elf_load_mode::LAZY });
+                expect(!checked.get_debug_file().has_value())
+                  << "CRC mismatch must be rejected";
+            }
+            // without the CRC, the name alone is matched
+            ElfParser unchecked((root / "demo_no_id").string(),
+                                { .mode = elf_load_mode::LAZY,
+                                  .verify_debuglink_crc = false });
+            expect(unchecked.get_debug_file().has_value());
+        };
+    };
 };
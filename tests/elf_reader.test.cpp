@@ -0,0 +1,258 @@
+#include <gelf.h>
+
+
+#include <boost/ut.hpp>
+
+
+#include <bit>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+#include "elf_parser.hpp"
+#include "elf_reader.hpp"
+#include "symbol_table.hpp"
+
+
+namespace {
+// Stores p_value as p_width bytes in p_order at p_offset
+void put(std::vector<std::byte>& p_out,
+         size_t p_offset,
+         uint64_t p_value,
+         size_t p_width,
+         std::endian p_order)
+{
+    for (size_t i = 0; i < p_width; i++) {
+        const size_t shift = p_order == std::endian::little
+                               ? i * 8
+                               : (p_width - 1 - i) * 8;
+        p_out[p_offset + i] = static_cast<std::byte>((p_value >> shift) & 0xff);
+    }
+}
+
+void put_string(std::vector<std::byte>& p_out,
+                size_t p_offset,
+                std::string_view p_string)
+{
+    for (size_t i = 0; i < p_string.size(); i++) {
+        p_out[p_offset + i] = static_cast<std::byte>(p_string[i]);
+    }
+}
+
+// A minimal ELF32 ARM executable: one PT_LOAD, .text, .symtab, .strtab and
+// .shstrtab, with the function symbol "_Z3fooi" at 0x8000 of size 8.
+std::vector<std::byte> make_elf32(std::endian p_order)
+{
+    constexpr size_t phdr_offset = 52;
+    constexpr size_t text_offset = 84;
+    constexpr size_t strtab_offset = 92;
+    constexpr std::string_view strtab("\0_Z3fooi\0data_sym\0", 18);
+    constexpr size_t symtab_offset = 112;  // 3 symbols of 16 bytes
+    constexpr size_t shstrtab_offset = 160;
+    constexpr std::string_view shstrtab(
+      "\0.text\0.symtab\0.strtab\0.shstrtab\0", 33);
+    constexpr size_t shdr_offset = 196;  // 5 headers of 40 bytes
+
+    std::vector<std::byte> out(shdr_offset + 5 * 40);
+    auto u16 = [&](size_t offset, uint64_t value) {
+        put(out, offset, value, 2, p_order);
+    };
+    auto u32 = [&](size_t offset, uint64_t value) {
+        put(out, offset, value, 4, p_order);
+    };
+
+    put_string(out, 0, "\x7f" "ELF");
+    out[EI_CLASS] = std::byte{ ELFCLASS32 };
+    out[EI_DATA] = p_order == std::endian::little ? std::byte{ ELFDATA2LSB }
+                                                  : std::byte{ ELFDATA2MSB };
+    out[EI_VERSION] = std::byte{ EV_CURRENT };
+    u16(16, ET_EXEC);
+    u16(18, EM_ARM);
+    u32(20, EV_CURRENT);
+    u32(24, 0x8000);       // e_entry
+    u32(28, phdr_offset);  // e_phoff
+    u32(32, shdr_offset);  // e_shoff
+    u16(40, 52);           // e_ehsize
+    u16(42, 32);           // e_phentsize
+    u16(44, 1);            // e_phnum
+    u16(46, 40);           // e_shentsize
+    u16(48, 5);            // e_shnum
+    u16(50, 4);            // e_shstrndx
+
+    u32(phdr_offset + 0, PT_LOAD);
+    u32(phdr_offset + 4, text_offset);
+    u32(phdr_offset + 8, 0x8000);
+    u32(phdr_offset + 12, 0x8000);
+    u32(phdr_offset + 16, 8);
+    u32(phdr_offset + 20, 8);
+    u32(phdr_offset + 24, PF_R | PF_X);
+    u32(phdr_offset + 28, 4);
+
+    u32(text_offset, 0xe12fff1e);  // bx lr
+
+    put_string(out, strtab_offset, strtab);
+
+    // symbol 1: _Z3fooi, global function in .text
+    u32(symtab_offset + 16 + 0, 1);
+    u32(symtab_offset + 16 + 4, 0x8000);
+    u32(symtab_offset + 16 + 8, 8);
+    out[symtab_offset + 16 + 12]
+      = static_cast<std::byte>(ELF32_ST_INFO(STB_GLOBAL, STT_FUNC));
+    u16(symtab_offset + 16 + 14, 1);
+    // symbol 2: data_sym, local object with an absolute value
+    u32(symtab_offset + 32 + 0, 9);
+    u32(symtab_offset + 32 + 4, 0xdeadbeef);
+    u32(symtab_offset + 32 + 8, 4);
+    out[symtab_offset + 32 + 12]
+      = static_cast<std::byte>(ELF32_ST_INFO(STB_LOCAL, STT_OBJECT));
+    u16(symtab_offset + 32 + 14, SHN_ABS);
+
+    put_string(out, shstrtab_offset, shstrtab);
+
+    auto section = [&](size_t index,
+                       uint32_t name,
+                       uint32_t type,
+                       uint32_t flags,
+                       uint32_t addr,
+                       uint32_t offset,
+                       uint32_t size,
+                       uint32_t link,
+                       uint32_t info,
+                       uint32_t entsize) {
+        const size_t base = shdr_offset + index * 40;
+        u32(base + 0, name);
+        u32(base + 4, type);
+        u32(base + 8, flags);
+        u32(base + 12, addr);
+        u32(base + 16, offset);
+        u32(base + 20, size);
+        u32(base + 24, link);
+        u32(base + 28, info);
+        u32(base + 32, 4);
+        u32(base + 36, entsize);
+    };
+    section(
+      1, 1, SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, 0x8000, text_offset, 8, 0,
+      0, 0);
+    section(2, 7, SHT_SYMTAB, 0, 0, symtab_offset, 48, 3, 2, 16);
+    section(3, 15, SHT_STRTAB, 0, 0, strtab_offset, strtab.size(), 0, 0, 0);
+    section(4, 23, SHT_STRTAB, 0, 0, shstrtab_offset, shstrtab.size(), 0, 0, 0);
+    return out;
+}
+
+std::string write_fixture(std::string_view p_name,
+                          const std::vector<std::byte>& p_bytes)
+{
+    const auto path = std::filesystem::temp_directory_path() / p_name;
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(p_bytes.data()),
+               static_cast<std::streamsize>(p_bytes.size()));
+    return path.string();
+}
+}  // namespace
+
+
+boost::ut::suite<"Elf_Reader_Test"> elf_reader_test = [] {
+    using namespace boost::ut;
+
+    "Elf_Reader"_test = [] {
+        "Loads fields in either byte order"_test = []() {
+            const std::byte little[] = { std::byte{ 0x78 },
+                                         std::byte{ 0x56 },
+                                         std::byte{ 0x34 },
+                                         std::byte{ 0x12 } };
+            expect(elf_reader::load<uint32_t, std::endian::little>(little)
+                   == 0x12345678_u);
+            expect(elf_reader::load<uint32_t, std::endian::big>(little)
+                   == 0x78563412_u);
+        };
+
+        "Identifies class and byte order"_test = []() {
+            auto big = make_elf32(std::endian::big);
+            auto encoding = elf_reader::identify(big);
+            expect(encoding.has_value()) << "Expect a valid ELF identification";
+            if (encoding.has_value()) {
+                expect(encoding->elf_class == ELFCLASS32);
+                expect(encoding->order == std::endian::big);
+            }
+
+            big[0] = std::byte{ 0 };
+            expect(!elf_reader::identify(big).has_value())
+              << "Bad magic must be rejected";
+        };
+
+        "Record span uses the given stride"_test = []() {
+            using sym_t = elf_reader::sym_ref<ELFCLASS32, std::endian::little>;
+            std::vector<std::byte> bytes(2 * 20 + 16);
+            bytes[20 + 4] = std::byte{ 0x2a };  // st_value of symbol 1
+            elf_reader::record_span<sym_t> symbols(bytes, 20);
+            expect(symbols.size() == 3_u) << "Last record needs no padding";
+            expect(symbols[1].st_value() == 0x2a_u);
+
+            elf_reader::record_span<sym_t> too_small(bytes, 8);
+            expect(too_small.empty()) << "Stride below record size is empty";
+        };
+    };
+
+    "Elf_Parser_32"_test = [] {
+        for (std::endian order : { std::endian::little, std::endian::big }) {
+            const bool big = order == std::endian::big;
+            const std::string path = write_fixture(
+              big ? "safe_elf32_msb.elf" : "safe_elf32_lsb.elf",
+              make_elf32(order));
+            ElfParser elf(path);
+
+            auto header = elf.get_elf_header();
+            expect(header.has_value()) << "Expect an ELF header";
+            if (!header.has_value()) {
+                continue;
+            }
+            expect(header->e_machine == EM_ARM) << "Expect EM_ARM";
+            expect(header->e_entry == 0x8000_u) << "Expect entry 0x8000";
+            expect(header->e_shnum == 5_u) << "Expect 5 sections";
+            expect(elf.get_encoding().elf_class == ELFCLASS32);
+
+            auto text = elf.get_section_view(".text");
+            expect(text.has_value()) << "Expect .text";
+            if (text.has_value()) {
+                expect(text->header.sh_addr == 0x8000_u);
+                expect(text->data.size() == 8_u);
+            }
+
+            auto segments = elf.get_program_header();
+            expect(segments.has_value() && segments->size() == 1)
+              << "Expect one program header";
+            if (segments.has_value() && segments->size() == 1) {
+                expect((*segments)[0].p_type == PT_LOAD);
+                expect((*segments)[0].p_flags == (PF_R | PF_X));
+                expect((*segments)[0].p_vaddr == 0x8000_u);
+            }
+
+            auto symbols = elf.get_symbol_table();
+            expect(symbols.has_value() && symbols->size() == 3)
+              << "Expect 3 symbols";
+            if (!symbols.has_value() || symbols->size() != 3) {
+                continue;
+            }
+            const symbol_s& foo = (*symbols)[1];
+            expect(foo.name == "_Z3fooi") << "Got name " << foo.name;
+            expect(foo.value == 0x8000_u);
+            expect(foo.size == 8_u);
+            expect(GELF_ST_TYPE(foo.info) == STT_FUNC);
+            expect(foo.shndx == 1_u);
+
+            const symbol_s& data = (*symbols)[2];
+            expect(data.name == "data_sym") << "Got name " << data.name;
+            expect(data.value == 0xdeadbeef_u);
+            expect(data.shndx == SHN_ABS);
+
+            auto found = elf.find_symbol("data_sym");
+            expect(found.has_value() && found->value == 0xdeadbeef)
+              << "Expect find_symbol to decode the 32-bit record";
+        }
+    };
+};
@@ -0,0 +1,162 @@
+#include <gelf.h>
+
+
+#include <boost/ut.hpp>
+
+
+#include <string_view>
+#include <vector>
+
+
+#include "elf_parser.hpp"
+#include "function_index.hpp"
+#include "symbol_table.hpp"
+
+
+namespace {
+symbol_s make_function(std::string name, uint64_t value, uint64_t size)
+{
+    return symbol_s{ std::move(name),
+                     value,
+                     size,
+                     static_cast<unsigned char>(GELF_ST_INFO(STB_GLOBAL,
+                                                             STT_FUNC)),
+                     0,
+                     1 };
+}
+}  // namespace
+
+
+boost::ut::suite<"Function_Index_Test"> function_index_test = [] {
+    using namespace boost::ut;
+
+
+    "Function_Index"_test = [] {
+        "Recovers extents of size-0 functions"_test = [] {
+            GElf_Shdr text{};
+            text.sh_flags = SHF_ALLOC | SHF_EXECINSTR;
+            text.sh_addr = 0x1000;
+            text.sh_size = 0x100;
+
+
+            std::vector<symbol_s> records = {
+                symbol_s{ "", 0, 0, 0, 0, SHN_UNDEF },
+                make_function("sized", 0x1000, 0x20),
+                make_function("asm_stub", 0x1020, 0),
+                make_function("after_stub", 0x1040, 0x10),
+                make_function("last_stub", 0x1080, 0),
+            };
+            SymbolTable table(records);
+            FunctionIndex index(table, std::span(&text, 1));
+
+
+            expect(index.size() == 4_u) << "Expect 4 functions. Got"
+                                         << index.size() << "\n";
+
+
+            auto stub = index.function_at(0x1030);
+            expect(stub.has_value() && table.name(stub->symbol) == "asm_stub")
+              << "0x1030 must map to asm_stub\n";
+            expect(stub.has_value() && stub->end == 0x1040 && stub->inferred)
+              << "asm_stub must end at the next function\n";
+
+
+            auto last = index.function_at(0x10ff);
+            expect(last.has_value() && table.name(last->symbol) == "last_stub")
+              << "0x10ff must map to last_stub\n";
+            expect(last.has_value() && last->end == 0x1100)
+              << "last_stub must end at the end of .text\n";
+
+
+            expect(!index.function_at(0x1050).has_value())
+              << "Padding after a sized function belongs to no function\n";
+            expect(!index.function_at(0xfff).has_value())
+              << "Addresses before .text belong to no function\n";
+        };
+
+
+        "Folds aliases into one interval"_test = [] {
+            GElf_Shdr text{};
+            text.sh_flags = SHF_ALLOC | SHF_EXECINSTR;
+            text.sh_addr = 0x2000;
+            text.sh_size = 0x40;
+
+
+            std::vector<symbol_s> records = {
+                make_function("alias_without_size", 0x2000, 0),
+                make_function("real_name", 0x2000, 0x40),
+            };
+            SymbolTable table(records);
+            FunctionIndex index(table, std::span(&text, 1));
+
+
+            expect(index.size() == 1_u) << "Aliases must share an interval\n";
+            auto func = index.function_at(0x2010);
+            expect(func.has_value() && table.name(func->symbol) == "real_name")
+              << "The sized symbol must represent the alias set\n";
+        };
+
+
+        "Falls back to the enclosing function past a nested one"_test = [] {
+            GElf_Shdr text{};
+            text.sh_flags = SHF_ALLOC | SHF_EXECINSTR;
+            text.sh_addr = 0x3000;
+            text.sh_size = 0x100;
+
+
+            // inner lies inside outer; overlap starts inside it and runs on
+            // past its end; after follows both
+            std::vector<symbol_s> records = {
+                make_function("outer", 0x3000, 0x80),
+                make_function("inner", 0x3010, 0x10),
+                make_function("overlap", 0x3040, 0x50),
+                make_function("after", 0x30c0, 0x10),
+            };
+            SymbolTable table(records);
+            FunctionIndex index(table, std::span(&text, 1));
+
+
+            auto name_at = [&](uint64_t p_address) {
+                auto func = index.function_at(p_address);
+                return func.has_value() ? table.name(func->symbol)
+                                        : std::string_view{};
+            };
+            expect(name_at(0x3008) == "outer");
+            expect(name_at(0x3018) == "inner");
+            expect(name_at(0x3020) == "outer")
+              << "Past inner, the address is still in outer\n";
+            expect(name_at(0x3048) == "overlap");
+            expect(name_at(0x3088) == "overlap")
+              << "Past outer, the address is still in overlap\n";
+            expect(name_at(0x30a0).empty()) << "0x30a0 is in no function\n";
+            expect(name_at(0x30c4) == "after");
+            expect(name_at(0x30d0).empty());
+        };
+
+
+        "Maps every defined function of a binary"_test = [] {
+#if defined(__unix__) || defined(__APPLE__)
+            std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+            std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+            ElfParser elf("../../testing_programs/build/simple",
+                          { .mode = elf_load_mode::LAZY });
+            const SymbolTable& table = *elf.get_compact_symbol_table().value();
+            FunctionIndex index(table, elf.get_section_headers());
+
+
+            expect(index.size() > 0_u) << "Expect indexed functions\n";
+            bool all_found = true;
+            for (const auto& extent : index.functions()) {
+                if (extent.end == extent.start) {
+                    continue;
+                }
+                auto found = index.function_at(extent.end - 1);
+                all_found = all_found && found.has_value()
+                            && found->start == extent.start;
+            }
+            expect(all_found) << "Every extent must map back to itself\n";
+        };
+    };
+};
@@ -0,0 +1,82 @@
+#include <boost/ut.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include "leb128.hpp"
+
+namespace {
+std::vector<uint8_t> encode_unsigned(uint64_t p_value)
+{
+    std::vector<uint8_t> out;
+    do {
+        uint8_t byte = p_value & 0x7f;
+        p_value >>= 7;
+        if (p_value != 0) {
+            byte |= 0x80;
+        }
+        out.push_back(byte);
+    } while (p_value != 0);
+    return out;
+}
+
+std::vector<uint8_t> encode_signed(int64_t p_value)
+{
+    std::vector<uint8_t> out;
+    while (true) {
+        const uint8_t byte = p_value & 0x7f;
+        p_value >>= 7;
+        const bool done = (p_value == 0 && (byte & 0x40) == 0)
+                          || (p_value == -1 && (byte & 0x40) != 0);
+        out.push_back(done ? byte : byte | 0x80);
+        if (done) {
+            return out;
+        }
+    }
+}
+
+// the decoders read a whole word, so pad with continuation-free garbage
+std::vector<uint8_t> padded(std::vector<uint8_t> p_bytes)
+{
+    p_bytes.resize(p_bytes.size() + 8, 0xff);
+    return p_bytes;
+}
+}  // namespace
+
+boost::ut::suite<"Leb128_Test"> leb128_test = [] {
+    using namespace boost::ut;
+
+    "Unsigned values of every length"_test = [] {
+        for (unsigned bits = 0; bits < 56; ++bits) {
+            for (uint64_t value : { uint64_t{ 1 } << bits,
+                                    (uint64_t{ 1 } << bits) - 1,
+                                    (uint64_t{ 1 } << bits) | 0x55 }) {
+                const auto encoded = encode_unsigned(value);
+                const auto decoded
+                  = leb128::decode_unsigned(padded(encoded).data());
+                expect(decoded.value == value) << value;
+                expect(decoded.length == encoded.size()) << value;
+            }
+        }
+    };
+
+    "Signed values of every length"_test = [] {
+        for (unsigned bits = 0; bits < 55; ++bits) {
+            const auto magnitude = static_cast<int64_t>(uint64_t{ 1 } << bits);
+            for (int64_t value :
+                 { magnitude, -magnitude, magnitude - 1, -magnitude + 1 }) {
+                const auto encoded = encode_signed(value);
+                const auto decoded
+                  = leb128::decode_signed(padded(encoded).data());
+                expect(static_cast<int64_t>(decoded.value) == value) << value;
+                expect(decoded.length == encoded.size()) << value;
+            }
+        }
+    };
+
+    "Numbers longer than a word are left to the caller"_test = [] {
+        const auto encoded = encode_unsigned(uint64_t{ 1 } << 60);
+        expect(encoded.size() == 9_u);
+        expect(leb128::decode_unsigned(padded(encoded).data()).length == 0_u);
+    };
+};
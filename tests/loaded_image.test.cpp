@@ -0,0 +1,95 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "abi_parse.hpp"
+#include "eh_frame.hpp"
+#include "elf_parser.hpp"
+#include "loaded_image.hpp"
+#include "symbol_value.hpp"
+
+boost::ut::suite<"Loaded_Image_Test"> loaded_image_test = [] {
+    using namespace boost::ut;
+#if defined(__unix__) || defined(__APPLE__)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+
+    "DW.ref slots resolve through their relocations"_test = [] {
+        ElfParser elf("../../testing_programs/build/pie_catch");
+        const safe::LoadedImage image(elf);
+        expect(image.pointer_size() == 8_u);
+        expect(image.relocated_slots() > 0_u);
+        expect(image.unresolved_slots() > 0_u) << "libstdc++ typeinfo";
+
+        // R_X86_64_RELATIVE to the typeinfo defined in the executable
+        const uint64_t local = symbol_value(elf, "DW.ref._ZTI11parse_error");
+        expect(local != 0_u);
+        expect(image.read_pointer(local)
+               == std::optional(symbol_value(elf, "_ZTI11parse_error")));
+        // R_X86_64_64 against an undefined symbol
+        const uint64_t external
+          = symbol_value(elf, "DW.ref._ZTISt9exception");
+        expect(external != 0_u);
+        expect(!image.read_pointer(external).has_value());
+        expect(!image.read_pointer(0).has_value());
+    };
+
+    "Indirect type entries resolve to typeinfo"_test = [] {
+        ElfParser elf("../../testing_programs/build/pie_catch");
+        auto eh_frame_section = elf.get_section_view(".eh_frame");
+        auto except_table = elf.get_section_view(".gcc_except_table");
+        expect(eh_frame_section.has_value() && except_table.has_value());
+        if (!eh_frame_section.has_value() || !except_table.has_value()) {
+            return;
+        }
+        auto eh_frame = EhFrame::parse(
+          *eh_frame_section, std::nullopt, elf.get_encoding());
+        expect(eh_frame.has_value());
+        if (!eh_frame.has_value()) {
+            return;
+        }
+        auto fde = eh_frame->find(symbol_value(elf, "main"));
+        expect(fde.has_value() && fde->lsda.has_value());
+        if (!fde.has_value() || !fde->lsda.has_value()) {
+            return;
+        }
+
+        const safe::LoadedImage image(elf);
+        const uint64_t table_address = except_table->header.sh_addr;
+        const size_t offset = *fde->lsda - table_address;
+        auto resolved = LsdaParser::decode(
+          except_table->data,
+          offset,
+          table_address,
+          [&image](uint64_t p_slot) { return image.read_pointer(p_slot); });
+        auto raw = LsdaParser::decode(except_table->data, offset, table_address);
+        expect(resolved.has_value() && raw.has_value());
+        if (!resolved.has_value() || !raw.has_value()) {
+            return;
+        }
+
+        // catch (const parse_error&), catch (const std::exception&)
+        const uint64_t parse_error = symbol_value(elf, "_ZTI11parse_error");
+        std::vector<std::optional<uint64_t>> types;
+        std::vector<std::optional<uint64_t>> slots;
+        for (int64_t index = 1; index <= 2; ++index) {
+            types.push_back(resolved->resolve_type(index));
+            slots.push_back(raw->resolve_type(index));
+        }
+        expect(std::ranges::count(types, std::optional(parse_error)) == 1);
+        expect(std::ranges::count(types, std::optional<uint64_t>()) == 1)
+          << "std::exception lives in libstdc++";
+        expect(std::ranges::count(slots, std::optional(parse_error)) == 0)
+          << "without the image entries stay slot addresses";
+        expect(std::ranges::find(resolved->get_diagnostics(),
+                                 LsdaError::UnresolvedType,
+                                 &LsdaDiagnostic::reason)
+               != resolved->get_diagnostics().end());
+    };
+};
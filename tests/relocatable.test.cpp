@@ -0,0 +1,251 @@
+#include <gelf.h>
+
+
+#include <boost/ut.hpp>
+
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+
+#include "archive.hpp"
+#include "elf_parser.hpp"
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+#include "relocatable.hpp"
+#include "validator.hpp"
+
+
+namespace {
+std::vector<std::byte> to_bytes(std::string_view p_text)
+{
+    std::vector<std::byte> out;
+    for (char c : p_text) {
+        out.push_back(static_cast<std::byte>(c));
+    }
+    return out;
+}
+
+// 60-byte member header with a 16-character name field
+std::string ar_header(std::string_view p_name, size_t p_size)
+{
+    std::string header(60, ' ');
+    header.replace(0, p_name.size(), p_name);
+    const std::string size = std::to_string(p_size);
+    header.replace(48, size.size(), size);
+    header.replace(58, 2, "`\n");
+    return header;
+}
+
+std::vector<std::string> throwing_functions(
+  const ElfParser& p_elf,
+  const std::unordered_set<std::string>& p_discarded = {})
+{
+    safe::RelocatableObject object(p_elf, p_discarded);
+    safe::Validator val(
+      object.symbols(), object.text(), { .write_logs = false });
+    std::vector<std::string> names;
+    for (const auto& func : val.find_thrown_functions()) {
+        names.push_back(func.name);
+    }
+    std::ranges::sort(names);
+    return names;
+}
+
+bool contains(const std::vector<std::string>& p_names, std::string_view p_name)
+{
+    return std::ranges::find(p_names, p_name) != p_names.end();
+}
+}  // namespace
+
+
+boost::ut::suite<"Relocatable_Test"> relocatable_test = [] {
+    using namespace boost::ut;
+#if defined(__unix__) || defined(__APPLE__)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+
+
+    "Archive"_test = [] {
+        "Members of a GNU archive"_test = []() {
+            auto mapping
+              = MappedFile::open("../../testing_programs/build/libdemo.a");
+            expect(mapping.has_value()) << "Expect libdemo.a to be mapped";
+            if (!mapping.has_value()) {
+                return;
+            }
+            expect(Archive::is_archive(mapping->bytes()));
+
+            auto archive = Archive::parse(mapping->bytes());
+            expect(archive.has_value()) << "Expect a valid archive";
+            if (!archive.has_value()) {
+                return;
+            }
+            auto members = archive->members();
+            expect(members.size() == 3_u) << "Symbol index is not a member";
+            if (members.size() != 3) {
+                return;
+            }
+            expect(members[0].name == "demo_class.o");
+            expect(members[1].name == "demo_three.o");
+            expect(members[2].name == "demo_four.o");
+            for (const auto& member : members) {
+                expect(elf_reader::identify(member.data).has_value())
+                  << member.name << " should be an ELF object";
+            }
+        };
+
+        "Long, BSD and padded member names"_test = []() {
+            const std::string long_name = "a_member_name_longer_than_16.o";
+            const std::string names = long_name + "/\n";
+            std::string text = "!<arch>\n";
+            text += ar_header("//", names.size()) + names;
+            text += ar_header("/0", 3) + "abc" + "\n";  // odd size is padded
+            text += ar_header("#1/8", 8 + 2) + std::string("bsd.o\0\0\0", 8)
+                    + "xy";
+            text += ar_header("short.o/", 2) + "zz";
+
+            auto archive = Archive::parse(to_bytes(text));
+            expect(archive.has_value()) << "Expect a valid archive";
+            if (!archive.has_value() || archive->members().size() != 3) {
+                expect(false) << "Expect 3 members";
+                return;
+            }
+            auto members = archive->members();
+            expect(members[0].name == long_name) << members[0].name;
+            expect(members[0].data.size() == 3_u);
+            expect(members[1].name == "bsd.o") << members[1].name;
+            expect(members[1].data.size() == 2_u) << "Name is not data";
+            expect(members[2].name == "short.o") << members[2].name;
+        };
+
+        "Malformed archives"_test = []() {
+            expect(Archive::parse(to_bytes("!<thin>\n")).error()
+                   == archive_error::THIN_ARCHIVE);
+            expect(Archive::parse(to_bytes("\x7f" "ELF")).error()
+                   == archive_error::NOT_AN_ARCHIVE);
+
+            std::string truncated = "!<arch>\n" + ar_header("a.o/", 100) + "x";
+            expect(Archive::parse(to_bytes(truncated)).error()
+                   == archive_error::TRUNCATED);
+
+            std::string bad_name = "!<arch>\n" + ar_header("/42", 0);
+            expect(Archive::parse(to_bytes(bad_name)).error()
+                   == archive_error::BAD_NAME);
+        };
+    };
+
+    "Relocatable_Object"_test = [] {
+        "Relocations resolve typeinfo references"_test = []() {
+            ElfParser elf("../../testing_programs/build/demo_class.o");
+            auto header = elf.get_elf_header();
+            expect(header.has_value() && header->e_type == ET_REL)
+              << "Expect an ET_REL object";
+
+            safe::RelocatableObject object(elf);
+            expect(object.unsupported_relocations() == 0_u)
+              << "Expect every relocation to be applied";
+            expect(object.text().header.sh_addr
+                   == safe::RelocatableObject::base_address);
+            expect(!object.except_table().data.empty())
+              << "Expect .gcc_except_table to be laid out";
+
+            // bar() lives in its own .text section in the linked binary,
+            // but must land inside the merged code here
+            auto bar = std::ranges::find(object.symbols(),
+                                         std::string_view("_Z3barv"),
+                                         &symbol_s::name);
+            expect(bar != object.symbols().end()) << "Expect _Z3barv";
+            if (bar != object.symbols().end()) {
+                const auto text = object.text();
+                expect(bar->value >= text.header.sh_addr
+                       && bar->value < text.header.sh_addr + text.data.size());
+            }
+
+            safe::Validator val(
+              object.symbols(), object.text(), { .write_logs = false });
+            auto thrown = val.find_typeinfo("_Z3barv");
+            expect(thrown.has_value() && thrown->size() == 1)
+              << "Expect one thrown type in bar()";
+            if (thrown.has_value() && thrown->size() == 1) {
+                expect((*thrown)[0].name == "_ZTIi")
+                  << "Got " << (*thrown)[0].name;
+            }
+
+            auto names = throwing_functions(elf);
+            expect(contains(names, "_ZN1A6methodEv")) << "A::method throws";
+            expect(!contains(names, "_Z3bazi")) << "baz is not defined here";
+        };
+
+        "COMDAT groups are discarded on request"_test = []() {
+            ElfParser elf("../../testing_programs/build/demo_four.o");
+            auto groups = safe::RelocatableObject::comdat_groups(elf);
+            auto group = std::ranges::find(groups,
+                                           std::string("_Z14checked_divideii"),
+                                           &safe::comdat_group_s::signature);
+            expect(group != groups.end())
+              << "Expect a COMDAT group for the inline function";
+            if (group == groups.end()) {
+                return;
+            }
+
+            expect(contains(throwing_functions(elf), "_Z14checked_divideii"));
+
+            const std::unordered_set<std::string> discarded{
+                "_Z14checked_divideii"
+            };
+            safe::RelocatableObject object(elf, discarded);
+            expect(object.discarded_sections() == group->sections.size());
+            for (uint32_t section : group->sections) {
+                expect(!object.section_address(section).has_value());
+            }
+            auto divide
+              = std::ranges::find(object.symbols(),
+                                  std::string_view("_Z14checked_divideii"),
+                                  &symbol_s::name);
+            expect(divide != object.symbols().end()
+                   && divide->shndx == SHN_UNDEF)
+              << "Symbols of discarded sections become external";
+            expect(!contains(throwing_functions(elf, discarded),
+                             "_Z14checked_divideii"));
+        };
+
+        "Parallel member analysis matches serial"_test = []() {
+            auto mapping
+              = MappedFile::open("../../testing_programs/build/libdemo.a");
+            auto archive = Archive::parse(mapping.value().bytes());
+            auto members = archive.value().members();
+
+            std::vector<std::unique_ptr<ElfParser>> objects;
+            for (const auto& member : members) {
+                objects.push_back(std::make_unique<ElfParser>(
+                  member.data,
+                  member.name,
+                  elf_parser_options_s{ .mode = elf_load_mode::LAZY }));
+            }
+
+            std::vector<std::vector<std::string>> serial;
+            for (const auto& object : objects) {
+                serial.push_back(throwing_functions(*object));
+            }
+            std::vector<std::vector<std::string>> parallel(objects.size());
+            safe::parallel_for(objects.size(), [&](size_t p_index) {
+                parallel[p_index] = throwing_functions(*objects[p_index]);
+            });
+            expect(serial == parallel);
+
+            // the inline function is reported by both users until deduped
+            size_t reported = 0;
+            for (const auto& names : serial) {
+                reported += contains(names, "_Z14checked_divideii") ? 1 : 0;
+            }
+            expect(reported == 2_u);
+        };
+    };
+};
@@ -0,0 +1,157 @@
+#include <gelf.h>
+
+
+#include <boost/ut.hpp>
+
+
+#include <string_view>
+
+
+#include "elf_parser.hpp"
+#include "symbol_table.hpp"
+
+
+boost::ut::suite<"Symbol_Table_Test"> symbol_table_test = [] {
+    using namespace boost::ut;
+#if defined(__unix__) || defined(__APPLE__)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+
+
+    "Symbol_Table"_test = [] {
+        std::string_view test_file = "../../testing_programs/build/simple";
+
+
+        "Compact table matches the symbol records"_test = [test_file]() {
+            ElfParser elf(test_file);
+            auto records = elf.get_symbol_table().value();
+            const SymbolTable& table = *elf.get_compact_symbol_table().value();
+
+
+            expect(table.size() == records.size())
+              << "Expect number of symbols: " << records.size() << ". Got"
+              << table.size() << "\n";
+
+
+            bool all_match = true;
+            for (size_t i = 0; i < records.size() && i < table.size(); i++) {
+                all_match = all_match && table.name(i) == records[i].name
+                            && table.value(i) == records[i].value
+                            && table.symbol_size(i) == records[i].size
+                            && table.info(i) == records[i].info
+                            && table.shndx(i) == records[i].shndx;
+            }
+            expect(all_match) << "Compact columns must match symbol_s records";
+        };
+
+
+        "Defined function filter"_test = [test_file]() {
+            ElfParser elf(test_file, { .mode = elf_load_mode::LAZY });
+            const SymbolTable& table = *elf.get_compact_symbol_table().value();
+
+
+            auto functions = table.defined_of_type(STT_FUNC);
+            expect(functions.size() > 0_u) << "Expect defined functions";
+
+
+            bool found_main = false;
+            for (uint32_t index : functions) {
+                expect(GELF_ST_TYPE(table.info(index)) == STT_FUNC
+                       && table.shndx(index) != SHN_UNDEF)
+                  << table.name(index) << " is not a defined function\n";
+                found_main = found_main || table.name(index) == "main";
+            }
+            expect(found_main) << "main must be a defined function\n";
+
+
+            symbol_s main_symbol = table.to_symbol(functions.front());
+            expect(main_symbol.name == table.name(functions.front()))
+              << "Materialized symbol must keep its name\n";
+        };
+
+
+        "Names are NUL terminated"_test = [test_file]() {
+            ElfParser elf(test_file, { .mode = elf_load_mode::LAZY });
+            const SymbolTable& table = *elf.get_compact_symbol_table().value();
+
+
+            bool terminated = true;
+            for (std::string_view name : table.names()) {
+                terminated = terminated
+                             && (name.empty() || name.data()[name.size()] == '\0');
+            }
+            expect(terminated) << "Names must be usable as C strings\n";
+        };
+
+        "Name index finds the first symbol with a name"_test = [test_file]() {
+            ElfParser elf(test_file, { .mode = elf_load_mode::LAZY });
+            const SymbolTable& table = *elf.get_compact_symbol_table().value();
+
+
+            bool all_found = true;
+            for (size_t i = 0; i < table.size(); i++) {
+                std::string_view name = table.name(i);
+                if (name.empty()) {
+                    continue;
+                }
+                auto found = table.find(name);
+                all_found = all_found && found.has_value()
+                            && table.name(*found) == name && *found <= i;
+            }
+            expect(all_found) << "Every named symbol must be found\n";
+            expect(!table.find("not_a_symbol_name").has_value())
+              << "Unknown names must not be found\n";
+
+
+            auto main_symbol = elf.find_symbol("main");
+            expect(main_symbol.has_value() && main_symbol->name == "main")
+              << "ElfParser must find main\n";
+            auto missing = elf.find_symbol("not_a_symbol_name");
+            expect(!missing.has_value()
+                   && missing.error() == elf_parser_error::SYMBOL_NOT_FOUND)
+              << "Unknown names must report SYMBOL_NOT_FOUND\n";
+        };
+
+
+        "GNU and SysV hash sections agree"_test = [] {
+            ElfParser elf("../../testing_programs/build/libdemo_two.so",
+                          { .mode = elf_load_mode::LAZY });
+            auto dynsym = elf.get_section_view(".dynsym").value();
+            auto dynstr = elf.get_section_view(".dynstr").value();
+            auto gnu_hash = elf.get_section_view(".gnu.hash").value();
+            auto sysv_hash = elf.get_section_view(".hash").value();
+
+
+            auto gnu = ElfHashTable::gnu(gnu_hash.data, 8);
+            auto sysv = ElfHashTable::sysv(sysv_hash.data);
+            expect(gnu.has_value() && sysv.has_value())
+              << "Expect both hash sections to parse\n";
+
+
+            SymbolTable table(
+              dynsym.data, dynsym.header.sh_entsize, dynstr.data);
+            auto from_gnu = gnu->find("_Z3bazi", table.names());
+            auto from_sysv = sysv->find("_Z3bazi", table.names());
+            auto from_index = table.find("_Z3bazi");
+            expect(from_gnu.has_value() && from_gnu == from_sysv
+                   && from_gnu == from_index)
+              << "All lookups must find baz(int) at the same index\n";
+            expect(!gnu->find("_Z3bazv", table.names()).has_value()
+                   && !sysv->find("_Z3bazv", table.names()).has_value())
+              << "Unknown names must not be found\n";
+
+
+            ElfParser stripped(
+              "../../testing_programs/build/libdemo_two_stripped.so",
+              { .mode = elf_load_mode::LAZY });
+            expect(!stripped.get_compact_symbol_table().has_value())
+              << "Stripped library must not have .symtab\n";
+            auto baz = stripped.find_symbol("_Z3bazi");
+            expect(baz.has_value()
+                   && baz->value == elf.find_symbol("_Z3bazi")->value)
+              << "ElfParser must find baz(int) through the hash section\n";
+        };
+    };
+};
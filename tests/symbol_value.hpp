@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include "elf_parser.hpp"
+#include "symbol_table.hpp"
+
+// Address of the symbol named p_name, or 0 if the image has none. The name
+// index of the compact symbol table finds it without a scan.
+inline uint64_t symbol_value(const ElfParser& p_elf, std::string_view p_name)
+{
+    auto symbols = p_elf.get_compact_symbol_table();
+    if (!symbols.has_value()) {
+        return 0;
+    }
+    auto index = (*symbols)->find(p_name);
+    return index.has_value() ? (*symbols)->value(*index) : 0;
+}
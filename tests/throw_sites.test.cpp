@@ -0,0 +1,111 @@
+#include <boost/ut.hpp>
+
+#include <cstdlib>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "elf_parser.hpp"
+#include "symbol_value.hpp"
+#include "throw_sites.hpp"
+#include "validator.hpp"
+
+namespace {
+std::vector<const safe::throw_site_s*> sites_of(
+  const safe::throw_site_report_s& p_report,
+  uint64_t p_function)
+{
+    std::vector<const safe::throw_site_s*> sites;
+    for (const safe::throw_site_s& site : p_report.sites) {
+        if (site.function == p_function) {
+            sites.push_back(&site);
+        }
+    }
+    return sites;
+}
+}  // namespace
+
+boost::ut::suite<"Throw_Sites_Test"> throw_sites_test = [] {
+    using namespace boost::ut;
+#if defined(__unix__) || defined(__APPLE__)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+
+    "Typeinfo and size of each throw of a static binary"_test = [] {
+        ElfParser elf("../../testing_programs/build/simple");
+        auto symbols = elf.get_compact_symbol_table();
+        expect(symbols.has_value());
+        if (!symbols.has_value()) {
+            return;
+        }
+        const auto report = safe::find_throw_sites(elf, **symbols);
+        expect(report.supported);
+
+        // throw std::invalid_argument, 67, "error" and 6, in that order
+        auto foo = sites_of(report, symbol_value(elf, "_Z3fooi"));
+        expect(foo.size() == 4_u);
+        if (foo.size() != 4) {
+            return;
+        }
+        constexpr std::string_view types[] = {
+            "_ZTISt16invalid_argument", "_ZTIi", "_ZTIPKc", "_ZTIi"
+        };
+        constexpr uint64_t sizes[] = { 16, 4, 8, 4 };
+        for (size_t i = 0; i < foo.size(); i++) {
+            expect(foo[i]->typeinfo_name == types[i]) << foo[i]->typeinfo_name;
+            expect(foo[i]->typeinfo == symbol_value(elf, types[i]));
+            expect(foo[i]->exception_size == sizes[i]);
+        }
+
+        auto baa = sites_of(report, symbol_value(elf, "_Z3baav"));
+        expect(baa.size() == 1_u);
+        if (!baa.empty()) {
+            expect(baa[0]->typeinfo_name == "_ZTIPKc");
+        }
+        // only the functions that throw are decoded
+        expect(report.functions < symbols.value()->size() / 10);
+    };
+
+    "Throws through the PLT of a PIE"_test = [] {
+        ElfParser elf("../../testing_programs/build/pie_catch");
+        auto symbols = elf.get_compact_symbol_table();
+        expect(symbols.has_value());
+        if (!symbols.has_value()) {
+            return;
+        }
+        const auto report = safe::find_throw_sites(elf, **symbols);
+        expect(report.unresolved == 0_u);
+
+        auto check = sites_of(report, symbol_value(elf, "_Z5checki"));
+        expect(check.size() == 2_u);
+        if (check.size() != 2) {
+            return;
+        }
+        expect(check[0]->typeinfo_name == "_ZTI11parse_error");
+        expect(check[0]->exception_size == 4u);
+        // copied from libstdc++, so its name carries the symbol version
+        expect(check[1]->typeinfo_name.starts_with("_ZTISt13runtime_error"));
+        expect(check[1]->exception_size == 16u);
+        expect(sites_of(report, symbol_value(elf, "main")).empty());
+    };
+
+    "Validator reports the types thrown, not those caught"_test = [] {
+        ElfParser elf("../../testing_programs/build/pie_catch");
+        auto symbols = elf.get_compact_symbol_table();
+        auto text = elf.get_section_view(".text");
+        expect(symbols.has_value() && text.has_value());
+        if (!symbols.has_value() || !text.has_value()) {
+            return;
+        }
+        const auto report = safe::find_throw_sites(elf, **symbols);
+        safe::Validator val(**symbols, *text, { .write_logs = false });
+        val.load_throw_sites(report.sites);
+
+        auto thrown = val.find_typeinfo("_Z5checki");
+        expect(thrown.has_value() && thrown->size() == 2_u);
+        auto caught = val.find_typeinfo("main");
+        expect(caught.has_value() && caught->empty());
+    };
+};
@@ -0,0 +1,72 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "eh_frame.hpp"
+#include "elf_parser.hpp"
+#include "symbol_value.hpp"
+#include "unwind_cost.hpp"
+
+boost::ut::suite<"Unwind_Cost_Test"> unwind_cost_test = [] {
+    using namespace boost::ut;
+#if defined(__unix__) || defined(__APPLE__)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+
+    "Functions are ranked by their costliest call site"_test = [] {
+        ElfParser elf("../../testing_programs/build/pie_catch");
+        auto section = elf.get_section_view(".eh_frame");
+        auto except_table = elf.get_section_view(".gcc_except_table");
+        expect(section.has_value() && except_table.has_value());
+        if (!section.has_value() || !except_table.has_value()) {
+            return;
+        }
+        auto eh_frame
+          = EhFrame::parse(*section, std::nullopt, elf.get_encoding());
+        expect(eh_frame.has_value());
+        if (!eh_frame.has_value()) {
+            return;
+        }
+
+        const auto report = safe::profile_unwind_cost(*eh_frame, *except_table);
+        expect(report.undecodable == 0_u);
+        expect(report.functions.size() == eh_frame->fdes()->size());
+        expect(std::ranges::is_sorted(report.functions,
+                                      std::ranges::greater{},
+                                      &safe::unwind_cost_s::worst_instructions));
+        for (const auto& cost : report.functions) {
+            expect(cost.worst_instructions >= cost.cie_instructions);
+            expect(cost.worst_pc > cost.pc_begin
+                   && cost.worst_pc <= cost.pc_end);
+        }
+
+        // main has a try block: its call sites come from the LSDA, and the
+        // frame is set up before the first call
+        const uint64_t main_address = symbol_value(elf, "main");
+        auto main_cost = std::ranges::find(
+          report.functions, main_address, &safe::unwind_cost_s::pc_begin);
+        expect(main_cost != report.functions.end());
+        if (main_cost != report.functions.end()) {
+            expect(main_cost->call_sites > 0_u);
+            expect(main_cost->worst_instructions
+                   > main_cost->cie_instructions);
+        }
+
+        // without the table every function is charged its whole program
+        const auto bound = safe::profile_unwind_cost(*eh_frame, std::nullopt);
+        auto main_bound = std::ranges::find(
+          bound.functions, main_address, &safe::unwind_cost_s::pc_begin);
+        expect(main_bound != bound.functions.end());
+        if (main_bound != bound.functions.end()
+            && main_cost != report.functions.end()) {
+            expect(main_bound->call_sites == 0_u);
+            expect(main_bound->worst_instructions
+                   >= main_cost->worst_instructions);
+        }
+    };
+};
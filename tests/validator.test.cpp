@@ -2,10 +2,13 @@
 #include "abi_parse.hpp"
 #include "elf_parser.hpp"
 #include "gcc_parse.hpp"
+#include "throw_sites.hpp"
 
 #include <boost/ut.hpp>
 
+#include <algorithm>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <iostream>
 #include <print>
@@ -43,18 +46,21 @@ boost::ut::suite<"Validator_Test"> validator_test = [] {
             std::unordered_set<std::string_view> expected_typeinfo_foo
               = {   "typeinfo for std::invalid_argument",
                     "typeinfo for int",
-                    "typeinfo for std::runtime_error",
-                    "typeinfo for char const*",
-                    "typeinfo for double" };
+                    "typeinfo for char const*" };
 
             std::println("Thrown objects from _Z3fooi");
+            std::unordered_set<std::string> found_foo;
             for (auto& obj : throw_obj_foo) {
                 std::string mangled = val.demangle(obj.name.c_str()).value_or(obj.name);
                 std::string type_name = mangled;
                 std::println("  {}", type_name);
                 expect(expected_typeinfo_foo.contains(type_name)) <<
                 "Got: " << type_name << "\n";
+                found_foo.insert(type_name);
             }
+            // only the operands of instructions are looked up, so each
+            // type foo throws is found and nothing else
+            expect(found_foo.size() == expected_typeinfo_foo.size());
 
             std::vector<symbol_s> throw_obj_baa
               = val.find_typeinfo("_Z3baav").value();
@@ -102,5 +108,123 @@ boost::ut::suite<"Validator_Test"> validator_test = [] {
             }
             expect(any_caught) << "No thrown types matched any catch handlers\n";
         };
+
+        "Windowed scan matches the full scan"_test = [test_file] {
+            ElfParser elf(test_file, { .mode = elf_load_mode::LAZY });
+            auto sym = elf.get_compact_symbol_table();
+            auto text = elf.get_section_view(".text");
+            expect(sym.has_value() && text.has_value()) << "sym/text fail\n";
+            if (!sym.has_value() || !text.has_value()) {
+                return;
+            }
+
+            auto names = [](const std::vector<symbol_s>& functions) {
+                std::vector<std::string> out;
+                for (const auto& func : functions) {
+                    out.push_back(func.name);
+                }
+                return out;
+            };
+            safe::Validator full(
+              *sym.value(), text.value(), { .write_logs = false });
+            const auto expected_names = names(full.find_thrown_functions());
+
+            // larger than any single function of the fixture
+            constexpr size_t window_size = 64 * 1024;
+            std::vector<std::span<const std::byte>> windows;
+            safe::Validator windowed(
+              *sym.value(),
+              text.value(),
+              { .write_logs = false,
+                .window_size = window_size,
+                .release =
+                  [&](std::span<const std::byte> p_bytes) {
+                      windows.push_back(p_bytes);
+                      elf.release_pages(p_bytes);
+                  } });
+            expect(names(windowed.find_thrown_functions()) == expected_names)
+              << "Windowed scan must report the same functions in order\n";
+
+            expect(windows.size() > 1_u) << "Expect .text to be split\n";
+            for (size_t i = 1; i < windows.size(); i++) {
+                expect(windows[i].data() >= windows[i - 1].data()
+                                              + windows[i - 1].size())
+                  << "Windows must advance through .text\n";
+            }
+            for (auto window : windows) {
+                expect(window.size() <= window_size)
+                  << "Windows must respect the size cap\n";
+            }
+
+            // released pages are read back from the file
+            expect(names(windowed.find_thrown_functions()) == expected_names);
+
+            // the throw-site pre-pass walks the code in the same windows
+            const auto full_sites = safe::find_throw_sites(elf, **sym);
+            std::vector<std::span<const std::byte>> site_windows;
+            const auto windowed_sites = safe::find_throw_sites(
+              elf,
+              **sym,
+              { .window_size = window_size,
+                .release =
+                  [&](std::span<const std::byte> p_bytes) {
+                      site_windows.push_back(p_bytes);
+                      elf.release_pages(p_bytes);
+                  } });
+            expect(!full_sites.sites.empty());
+            expect(windowed_sites.sites.size() == full_sites.sites.size())
+              << "Windowed pre-pass must find the same throw sites\n";
+            for (size_t i = 0; i < full_sites.sites.size()
+                               && i < windowed_sites.sites.size();
+                 i++) {
+                expect(windowed_sites.sites[i].call
+                         == full_sites.sites[i].call
+                       && windowed_sites.sites[i].typeinfo_name
+                            == full_sites.sites[i].typeinfo_name);
+            }
+            expect(site_windows.size() > 1_u)
+              << "Expect the code to be split\n";
+            for (auto window : site_windows) {
+                expect(window.size() <= window_size)
+                  << "Windows must respect the size cap\n";
+            }
+        };
+
+#if defined(__unix__) || defined(__APPLE__)
+        "Streaming mode prints the same report"_test = [test_file] {
+            // the report, without the peak memory line streaming adds
+            auto report = [](const std::string& p_flags,
+                             std::string_view p_file) {
+                const std::string output = "max_memory_report.txt";
+                const int status = std::system(
+                  std::format("./safe {} {} > {}", p_flags, p_file, output)
+                    .c_str());
+                std::vector<std::string> lines;
+                std::ifstream in(output);
+                for (std::string line; std::getline(in, line);) {
+                    if (!line.starts_with("Peak resident memory")) {
+                        lines.push_back(line);
+                    }
+                }
+                return std::pair(status, lines);
+            };
+
+            const auto [status, normal] = report("", test_file);
+            expect(status == 0 && !normal.empty());
+            const auto [bounded_status, bounded]
+              = report("--max-memory 256", test_file);
+            expect(bounded_status == 0);
+            expect(bounded == normal)
+              << "--max-memory must not change the report\n";
+
+            // a budget below what the process needs is refused
+            const auto [refused_status, refused]
+              = report("--max-memory 1", test_file);
+            expect(refused_status != 0);
+            expect(std::ranges::any_of(refused, [](const std::string& p_line) {
+                return p_line.starts_with("Memory budget of 1 MiB exceeded");
+            }));
+        };
+#endif
     };
 };
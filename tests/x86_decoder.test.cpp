@@ -0,0 +1,201 @@
+#include <boost/ut.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+#include "elf_parser.hpp"
+#include "x86_decoder.hpp"
+
+namespace {
+std::vector<std::byte> bytes(std::initializer_list<uint8_t> p_values)
+{
+    std::vector<std::byte> out;
+    for (uint8_t value : p_values) {
+        out.push_back(std::byte{ value });
+    }
+    return out;
+}
+
+size_t length_of(std::initializer_list<uint8_t> p_values)
+{
+    auto instruction = safe::decode_x86_64(bytes(p_values), 0);
+    return instruction.has_value() ? instruction->length : 0;
+}
+}  // namespace
+
+boost::ut::suite<"X86_Decoder_Test"> x86_decoder_test = [] {
+    using namespace boost::ut;
+#if defined(__unix__) || defined(__APPLE__)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.sh");
+#elif defined(_WIN32)
+    std::system("cd ../../testing_programs/ && ./generate_and_build.ps1");
+#endif
+
+    "Instruction lengths"_test = [] {
+        expect(length_of({ 0x55 }) == 1_u);                    // push %rbp
+        expect(length_of({ 0x48, 0x89, 0xe5 }) == 3_u);        // mov %rsp,%rbp
+        expect(length_of({ 0x41, 0x54 }) == 2_u);              // push %r12
+        expect(length_of({ 0x48, 0x83, 0xec, 0x10 }) == 4_u);  // sub $16,%rsp
+        // cmpl $0x5,-0x14(%rbp)
+        expect(length_of({ 0x83, 0x7d, 0xec, 0x05 }) == 4_u);
+        // movl $0x43,(%rax)
+        expect(length_of({ 0xc7, 0x00, 0x43, 0, 0, 0 }) == 6_u);
+        // movabs $imm64,%rax
+        expect(length_of({ 0x48, 0xb8, 1, 2, 3, 4, 5, 6, 7, 8 }) == 10_u);
+        // mov 0x10(%rsp,%rbx,8),%rax: SIB and disp8
+        expect(length_of({ 0x48, 0x8b, 0x44, 0xdc, 0x10 }) == 5_u);
+        // mov 0x0(,%rbx,8),%rax: SIB without base takes a disp32
+        expect(length_of({ 0x48, 0x8b, 0x04, 0xdd, 0, 0, 0, 0 }) == 8_u);
+        // testb $1,%al and testl $1,%eax; not %eax has no immediate
+        expect(length_of({ 0xf6, 0xc0, 0x01 }) == 3_u);
+        expect(length_of({ 0xf7, 0xc0, 1, 0, 0, 0 }) == 6_u);
+        expect(length_of({ 0xf7, 0xd0 }) == 2_u);
+        // nopw 0x0(%rax,%rax,1) with a 0x66 prefix
+        expect(length_of({ 0x66, 0x0f, 0x1f, 0x44, 0x00, 0x00 }) == 6_u);
+        // movw $1,(%rax): 0x66 shrinks the immediate
+        expect(length_of({ 0x66, 0xc7, 0x00, 0x01, 0x00 }) == 5_u);
+        expect(length_of({ 0xc3 }) == 1_u);  // ret
+        expect(length_of({ 0xf3, 0x0f, 0x1e, 0xfa }) == 4_u);  // endbr64
+    };
+
+    "Vector encodings"_test = [] {
+        // vmovdqu (%rsi),%ymm0: two-byte VEX
+        expect(length_of({ 0xc5, 0xfe, 0x6f, 0x06 }) == 4_u);
+        // vpshufb %ymm1,%ymm2,%ymm3: three-byte VEX, map 0F38
+        auto vex3 = safe::decode_x86_64(
+          bytes({ 0xc4, 0xe2, 0x6d, 0x00, 0xd9 }), 0);
+        expect(vex3.has_value() && vex3->length == 5 && vex3->map == 2
+               && vex3->vector);
+        // vpalignr $8,%xmm1,%xmm2,%xmm3: map 0F3A takes an imm8
+        expect(length_of({ 0xc4, 0xe3, 0x69, 0x0f, 0xd9, 0x08 }) == 6_u);
+        // vmovdqu64 (%rsi),%zmm0: EVEX
+        expect(length_of({ 0x62, 0xf1, 0xfe, 0x48, 0x6f, 0x06 }) == 6_u);
+        // pshufd $0x1b,%xmm1,%xmm0: legacy SSE with an imm8
+        expect(length_of({ 0x66, 0x0f, 0x70, 0xc1, 0x1b }) == 5_u);
+    };
+
+    "Invalid and truncated instructions"_test = [] {
+        // push %es and salc
+        expect(!safe::decode_x86_64(bytes({ 0x06 }), 0).has_value());
+        expect(!safe::decode_x86_64(bytes({ 0xd6 }), 0).has_value());
+        expect(!safe::decode_x86_64(bytes({ 0xe8, 0x00 }), 0).has_value());
+        expect(!safe::decode_x86_64(bytes({ 0x48 }), 0).has_value());
+        // sixteen bytes of prefixes leave no room for the opcode
+        std::vector<std::byte> prefixes(16, std::byte{ 0x66 });
+        prefixes.push_back(std::byte{ 0x90 });
+        expect(!safe::decode_x86_64(prefixes, 0).has_value());
+    };
+
+    "Operands"_test = [] {
+        // lea 0xbf5a7(%rip),%rax at 0x401f52
+        auto lea = safe::decode_x86_64(
+          bytes({ 0x48, 0x8d, 0x05, 0xa7, 0xf5, 0x0b, 0x00 }), 0x401f52);
+        expect(lea.has_value());
+        expect(lea->rex_w && lea->opcode == 0x8d && lea->reg == 0);
+        expect(lea->rip_target == 0x4c1500u);
+
+        // lea 0xbf0aa(%rip),%rcx; mov %rcx,%rsi
+        auto lea_rcx = safe::decode_x86_64(
+          bytes({ 0x48, 0x8d, 0x0d, 0xaa, 0xf0, 0x0b, 0x00 }), 0x401f7f);
+        expect(lea_rcx.has_value() && lea_rcx->reg == 1);
+        expect(lea_rcx->rip_target == 0x4c1030u);
+        auto mov = safe::decode_x86_64(bytes({ 0x48, 0x89, 0xce }), 0);
+        expect(mov.has_value() && mov->reg == 1 && mov->rm_register == 6);
+
+        // movl $0x5,0x10(%rip): the immediate follows the displacement
+        auto store = safe::decode_x86_64(
+          bytes({ 0xc7, 0x05, 0x10, 0, 0, 0, 0x05, 0, 0, 0 }), 0x1000);
+        expect(store.has_value() && store->length == 10);
+        expect(store->rip_target == 0x101au);
+        expect(store->immediate == 5);
+
+        // mov $0x10,%edi; mov %r9,%r8 with REX.R and REX.B
+        auto imm = safe::decode_x86_64(bytes({ 0xbf, 0x10, 0, 0, 0 }), 0);
+        expect(imm.has_value() && imm->reg == 7 && imm->immediate == 16);
+        auto extended = safe::decode_x86_64(bytes({ 0x4d, 0x89, 0xc8 }), 0);
+        expect(extended.has_value() && extended->reg == 9
+               && extended->rm_register == 8);
+        // sub $-8,%rsp is sign-extended
+        auto negative
+          = safe::decode_x86_64(bytes({ 0x48, 0x83, 0xec, 0xf8 }), 0);
+        expect(negative.has_value() && negative->immediate == -8);
+    };
+
+    "Branch targets"_test = [] {
+        // call 4035e0 <__cxa_throw> at 0x401f5f
+        auto call = safe::decode_x86_64(
+          bytes({ 0xe8, 0x7c, 0x16, 0x00, 0x00 }), 0x401f5f);
+        expect(call.has_value() && call->branch_target == 0x4035e0u);
+        expect(!call->immediate.has_value());
+        // jne 401f64 at 0x401f27
+        auto jne = safe::decode_x86_64(bytes({ 0x75, 0x3b }), 0x401f27);
+        expect(jne.has_value() && jne->branch_target == 0x401f64u);
+        // jne rel32 backwards
+        auto jne32 = safe::decode_x86_64(
+          bytes({ 0x0f, 0x85, 0xfa, 0xff, 0xff, 0xff }), 0x2000);
+        expect(jne32.has_value() && jne32->branch_target == 0x2000u);
+    };
+
+    "Sweep skips bytes that start no instruction"_test = [] {
+        // push %rbp; (bad); lea 0x10(%rip),%rax; ret
+        auto instructions = safe::sweep_x86_64(
+          bytes({ 0x55, 0x06, 0x48, 0x8d, 0x05, 0x10, 0, 0, 0, 0xc3 }),
+          0x100);
+        expect(instructions.size() == 3_u);
+        if (instructions.size() != 3) {
+            return;
+        }
+        expect(instructions[0].address == 0x100u);
+        expect(instructions[1].address == 0x102u);
+        expect(instructions[1].rip_target == 0x119u);
+        expect(instructions[2].address == 0x109u);
+    };
+
+    "References of a compiled function"_test = [] {
+        ElfParser elf("../../testing_programs/build/simple");
+        auto text = elf.get_section_view(".text");
+        auto symbols = elf.get_symbol_table();
+        expect(text.has_value() && symbols.has_value());
+        if (!text.has_value() || !symbols.has_value()) {
+            return;
+        }
+        auto foo = std::ranges::find(*symbols, "_Z3fooi", &symbol_s::name);
+        auto typeinfo = std::ranges::find(
+          *symbols, "_ZTISt16invalid_argument", &symbol_s::name);
+        auto cxa_throw
+          = std::ranges::find(*symbols, "__cxa_throw", &symbol_s::name);
+        expect(foo != symbols->end() && typeinfo != symbols->end()
+               && cxa_throw != symbols->end());
+        if (foo == symbols->end() || typeinfo == symbols->end()
+            || cxa_throw == symbols->end()) {
+            return;
+        }
+
+        const uint64_t offset = foo->value - text->header.sh_addr;
+        auto references = safe::x86_references(
+          std::span(text->data).subspan(offset, foo->size), foo->value);
+        expect(!references.empty());
+        expect(std::ranges::all_of(
+          references, [&](const safe::x86_reference_s& p_reference) {
+              return p_reference.instruction >= foo->value
+                     && p_reference.instruction < foo->value + foo->size;
+          }));
+        expect(std::ranges::any_of(
+          references, [&](const safe::x86_reference_s& p_reference) {
+              return p_reference.kind == safe::x86_reference_kind::ADDRESS
+                     && p_reference.target == typeinfo->value;
+          }));
+        expect(std::ranges::any_of(
+          references, [&](const safe::x86_reference_s& p_reference) {
+              return p_reference.kind == safe::x86_reference_kind::CALL
+                     && p_reference.target == cxa_throw->value;
+          }));
+        // one reference per instruction, not per byte
+        expect(references.size() < foo->size / 4);
+    };
+};